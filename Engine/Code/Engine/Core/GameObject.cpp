@@ -159,7 +159,7 @@ void GameObject::RenderWithBorder(Renderer* renderer)
 		const Transform& transform_inner = m_renderable->m_transform;
 		const Vector3& scale_inner = transform_inner.GetLocalScale();
 		const Vector3& translation_inner = transform_inner.GetLocalPosition();
-		const Vector3& rot_inner = transform_inner.GetLocalRotation();
+		const Quaternion& rot_inner = transform_inner.GetLocalQuaternion();
 		Vector3 scale_outer = scale_inner * 1.1f;
 		Transform transform_outer = Transform(translation_inner, rot_inner, scale_outer);
 
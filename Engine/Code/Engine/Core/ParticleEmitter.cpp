@@ -1,5 +1,9 @@
 #include "Engine/Core/ParticleEmitter.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/FastMath.hpp"
+#include "Engine/Math/Random.hpp"
+
+#include <vector>
 
 ParticleEmitter::ParticleEmitter(Vector3 pos, float spawnRate, float rotation, float azimuth, float particleLifetime)
 {
@@ -20,11 +24,52 @@ ParticleEmitter::~ParticleEmitter()
 
 Vector3 ParticleEmitter::SpawnVelocity()
 {
-	float rot = GetRandomFloatInRange(0.f, m_rotation);
-	float azi = GetRandomFloatInRange(0.f, m_azimuth);
+	RandomGenerator& random = GetThreadRandom();
+	float rot = random.NextFloatInRange(0.f, m_rotation);
+	float azi = random.NextFloatInRange(0.f, m_azimuth);
 
 	Vector3 direction = PolarToCartesian(RAD, rot, azi);
 	direction.NormalizeAndGetLength();
 
 	return direction;
+}
+
+
+void ParticleEmitter::SpawnVelocities(Vector3* out, uint count, bool fastTrig)
+{
+	// angles drawn in bulk first, rotations then azimuths
+	std::vector<float> angles(2 * count);
+	RandomGenerator& random = GetThreadRandom();
+	random.FillFloatsInRange(angles.data(), count, 0.f, m_rotation);
+	random.FillFloatsInRange(angles.data() + count, count, 0.f, m_azimuth);
+
+	uint idx = 0;
+	if (fastTrig)
+	{
+		// unit length already, no normalize
+	#if MATH_SIMD_SSE
+		MATH_ALIGN16 float dirX[4], dirY[4], dirZ[4];
+		for (; idx + 4 <= count; idx += 4)
+		{
+			__m128 sinRot, cosRot, sinAzi, cosAzi;
+			SIMDFastSinCosDegrees4(_mm_loadu_ps(angles.data() + idx), &sinRot, &cosRot);
+			SIMDFastSinCosDegrees4(_mm_loadu_ps(angles.data() + count + idx), &sinAzi, &cosAzi);
+			_mm_store_ps(dirX, _mm_mul_ps(sinAzi, cosRot));
+			_mm_store_ps(dirY, cosAzi);
+			_mm_store_ps(dirZ, _mm_mul_ps(sinAzi, sinRot));
+			for (uint lane = 0; lane < 4; ++lane)
+				out[idx + lane] = Vector3(dirX[lane], dirY[lane], dirZ[lane]);
+		}
+	#endif
+		for (; idx < count; ++idx)
+			FastPolarToCartesian(RAD, angles[idx], angles[count + idx], out[idx].x, out[idx].y, out[idx].z);
+		return;
+	}
+
+	for (; idx < count; ++idx)
+	{
+		Vector3 direction = PolarToCartesian(RAD, angles[idx], angles[count + idx]);
+		direction.NormalizeAndGetLength();
+		out[idx] = direction;
+	}
 }
\ No newline at end of file
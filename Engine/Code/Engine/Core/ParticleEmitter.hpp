@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/Math/Vector3.hpp"
+#include "Engine/Core/EngineCommon.hpp"
 
 class ParticleEmitter
 {
@@ -22,4 +23,5 @@ public:
 	~ParticleEmitter();
 
 	Vector3 SpawnVelocity();
+	void SpawnVelocities(Vector3* out, uint count, bool fastTrig = false);		// fastTrig: FastMath.hpp sin/cos, 4 at a time
 };
\ No newline at end of file
@@ -1,89 +1,7 @@
 #include "Engine/Core/Quaternion.hpp"
 #include "Engine/Math/MathUtils.hpp"
 
-const Quaternion Quaternion::IDENTITY = Quaternion(1.f, 0.f, 0.f, 0.f);		// no rotation
-
-Quaternion::Quaternion()
-	: m_real(0.f), m_imaginary(Vector3::ZERO)
-{
-	// quaternion zero identity
-}
-
-
-Quaternion::~Quaternion()
-{
-
-}
-
-
-Quaternion::Quaternion(float scalar, Vector3 vector)
-	: m_real(scalar), m_imaginary(vector)
-{
-
-}
-
-
-Quaternion::Quaternion(const Quaternion& copy)
-{
-	m_real = copy.m_real;
-	m_imaginary = copy.m_imaginary;
-}
-
-
-Quaternion::Quaternion(float real, float x, float y, float z)
-	: m_real(real), m_imaginary(Vector3(x, y, z))
-{
-
-}
-
-Quaternion& Quaternion::operator=(const Quaternion& copy)
-{
-	m_real = copy.m_real;
-	m_imaginary = copy.m_imaginary;
-
-	return *this;
-}
-
-
-Quaternion Quaternion::operator+(const Quaternion& rhs) const 
-{
-	Quaternion quaternion;
-
-	quaternion.m_real = m_real + rhs.m_real;
-	quaternion.m_imaginary = m_imaginary + rhs.m_imaginary;
-
-	return quaternion;
-}
-
-
-Quaternion Quaternion::operator-(const Quaternion& rhs) const 
-{
-	Quaternion quaternion;
-
-	quaternion.m_real = m_real - rhs.m_real;
-	quaternion.m_imaginary = m_imaginary - rhs.m_imaginary;
-
-	return quaternion;
-}
-
-
-Quaternion Quaternion::operator*(const Quaternion& rhs) const
-{
-	float real = m_real * rhs.m_real - DotProduct(m_imaginary, rhs.m_imaginary);
-	Vector3 imaginary = rhs.m_imaginary * m_real + m_imaginary * rhs.m_real + m_imaginary.Cross(rhs.m_imaginary);
-
-	return Quaternion(real, imaginary);
-}
-
-
-Quaternion Quaternion::operator*(const float scalar) const 
-{
-	float real = m_real * scalar;
-	Vector3 imaginary = m_imaginary * scalar;
-
-	return Quaternion(real, imaginary);
-}
-
+static_assert(sizeof(Quaternion) == 4 * sizeof(float), "SIMD kernels expect a packed quaternion");
 
 void Quaternion::operator+=(const Quaternion& rhs)
 {
@@ -99,17 +17,6 @@ void Quaternion::operator-=(const Quaternion& rhs)
 }
 
 
-void Quaternion::operator*=(const Quaternion& rhs)
-{
-	Quaternion copy = *this;
-
-	Quaternion multiply = copy * rhs;
-
-	m_real = multiply.m_real;
-	m_imaginary = multiply.m_imaginary;
-}
-
-
 void Quaternion::operator*=(const float scalar)
 {
 	m_real *= scalar;
@@ -315,4 +222,4 @@ Quaternion Quaternion::FromEuler(const Vector3& euler)
 	q = Quaternion::FromMatrix(mat);
 
 	return q;
-}
+}
\ No newline at end of file
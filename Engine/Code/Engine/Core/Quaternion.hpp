@@ -6,23 +6,24 @@
 class Quaternion
 {
 public:
+	// real then imaginary, read as 4 packed floats by the SIMD kernels
 	float m_real;
 	Vector3 m_imaginary;
 
 	const static Quaternion IDENTITY;
 
 public:
-	Quaternion();
-	Quaternion(float real, float x, float y, float z);
-	Quaternion(float real, Vector3 imaginary);
-	~Quaternion();
-	Quaternion(const Quaternion& copy);
+	constexpr Quaternion();
+	constexpr Quaternion(float real, float x, float y, float z);
+	constexpr Quaternion(float real, Vector3 imaginary);
+	~Quaternion() = default;
+	constexpr Quaternion(const Quaternion& copy);
 	
-	Quaternion& operator=(const Quaternion& copy);
-	Quaternion operator+(const Quaternion& rhs) const;
-	Quaternion operator-(const Quaternion& rhs) const;
+	constexpr Quaternion& operator=(const Quaternion& copy);
+	constexpr Quaternion operator+(const Quaternion& rhs) const;
+	constexpr Quaternion operator-(const Quaternion& rhs) const;
 	Quaternion operator*(const Quaternion& rhs) const;
-	Quaternion operator*(const float scalar) const;
+	constexpr Quaternion operator*(const float scalar) const;
 	void operator+=(const Quaternion& rhs);
 	void operator-=(const Quaternion& rhs);
 	void operator*=(const Quaternion& rhs);
@@ -47,4 +48,66 @@ public:
 
 	static Quaternion FromEuler(const Vector3& euler);
 	//Vector3 ToEuler() const;
-};
\ No newline at end of file
+};
+
+////////////////////////////////////// Inline //////////////////////////////////////
+constexpr Quaternion::Quaternion()
+	: m_real(0.f), m_imaginary(Vector3::ZERO)
+{
+	// quaternion zero identity
+}
+
+constexpr Quaternion::Quaternion(float real, float x, float y, float z)
+	: m_real(real), m_imaginary(Vector3(x, y, z))
+{
+
+}
+
+constexpr Quaternion::Quaternion(float real, Vector3 imaginary)
+	: m_real(real), m_imaginary(imaginary)
+{
+
+}
+
+constexpr Quaternion::Quaternion(const Quaternion& copy)
+	: m_real(copy.m_real), m_imaginary(copy.m_imaginary)
+{
+
+}
+
+inline constexpr Quaternion Quaternion::IDENTITY = Quaternion(1.f, 0.f, 0.f, 0.f);		// no rotation
+
+constexpr Quaternion& Quaternion::operator=(const Quaternion& copy)
+{
+	m_real = copy.m_real;
+	m_imaginary = copy.m_imaginary;
+
+	return *this;
+}
+
+constexpr Quaternion Quaternion::operator+(const Quaternion& rhs) const
+{
+	return Quaternion(m_real + rhs.m_real, m_imaginary + rhs.m_imaginary);
+}
+
+constexpr Quaternion Quaternion::operator-(const Quaternion& rhs) const
+{
+	return Quaternion(m_real - rhs.m_real, m_imaginary - rhs.m_imaginary);
+}
+
+constexpr Quaternion Quaternion::operator*(const float scalar) const
+{
+	return Quaternion(m_real * scalar, m_imaginary * scalar);
+}
+
+inline Quaternion Quaternion::operator*(const Quaternion& rhs) const
+{
+	Quaternion res;
+	SIMDQuatMul(&m_real, &rhs.m_real, &res.m_real);
+	return res;
+}
+
+inline void Quaternion::operator*=(const Quaternion& rhs)
+{
+	SIMDQuatMul(&m_real, &rhs.m_real, &m_real);
+}
\ No newline at end of file
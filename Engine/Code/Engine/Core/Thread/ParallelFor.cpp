@@ -0,0 +1,138 @@
+#include "Engine/Core/Thread/ParallelFor.hpp"
+#include "Engine/Core/Thread/Thread.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+struct sParallelForJob
+{
+	std::atomic<uint>	m_next;
+	uint				m_count;
+	ParallelForCB		m_cb;
+	void*				m_arg;
+
+	// guarded by the pool lock
+	uint				m_helpers_wanted;		// pool workers that may still join
+	uint				m_helpers_running;		// pool workers inside the job
+};
+
+// workers are started once and sleep on m_wake between jobs, so a call costs a wakeup, not a thread
+struct sParallelForPool
+{
+	std::mutex						m_lock;
+	std::condition_variable			m_wake;
+	std::condition_variable			m_done;
+	std::vector<sParallelForJob*>	m_jobs;		// jobs still taking helpers, oldest first
+	uint							m_worker_count = 0;
+};
+
+static void RunParallelForJob(sParallelForJob* job)
+{
+	// workers pull indices until none are left, so uneven items balance out
+	for (uint idx = job->m_next++; idx < job->m_count; idx = job->m_next++)
+		job->m_cb(idx, job->m_arg);
+}
+
+static void ParallelForPoolWorker(void* arg)
+{
+	sParallelForPool* pool = (sParallelForPool*)(arg);
+
+	std::unique_lock<std::mutex> lock(pool->m_lock);
+	for (;;)
+	{
+		pool->m_wake.wait(lock, [pool]() { return !pool->m_jobs.empty(); });
+
+		sParallelForJob* job = pool->m_jobs.front();
+		if (--job->m_helpers_wanted == 0)
+			pool->m_jobs.erase(pool->m_jobs.begin());
+		job->m_helpers_running++;
+
+		lock.unlock();
+		RunParallelForJob(job);
+		lock.lock();
+
+		if (--job->m_helpers_running == 0)
+			pool->m_done.notify_all();
+	}
+}
+
+static sParallelForPool* StartParallelForPool()
+{
+	sParallelForPool* pool = new sParallelForPool();
+
+	// the calling thread always works too
+	uint cores = ThreadGetCoreCount();
+	pool->m_worker_count = (cores > 1) ? (cores - 1) : 0;
+	for (uint i = 0; i < pool->m_worker_count; ++i)
+		ThreadCreateAndDetach("parallel_for", ParallelForPoolWorker, pool);
+
+	return pool;
+}
+
+static sParallelForPool* GetParallelForPool()
+{
+	// never torn down, workers may still be waiting on it at exit
+	static sParallelForPool* pool = StartParallelForPool();
+	return pool;
+}
+
+void ParallelFor(uint count, ParallelForCB cb, void* userData, uint max_threads)
+{
+	if (count == 0)
+		return;
+
+	sParallelForPool* pool = GetParallelForPool();
+
+	uint helpers = pool->m_worker_count;
+	if (max_threads != 0 && max_threads - 1 < helpers)
+		helpers = max_threads - 1;
+	if (count - 1 < helpers)
+		helpers = count - 1;
+
+	sParallelForJob job;
+	job.m_next = 0;
+	job.m_count = count;
+	job.m_cb = cb;
+	job.m_arg = userData;
+	job.m_helpers_wanted = helpers;
+	job.m_helpers_running = 0;
+
+	if (helpers > 0)
+	{
+		{
+			std::lock_guard<std::mutex> guard(pool->m_lock);
+			pool->m_jobs.push_back(&job);
+		}
+
+		if (helpers == pool->m_worker_count)
+			pool->m_wake.notify_all();
+		else
+		{
+			for (uint i = 0; i < helpers; ++i)
+				pool->m_wake.notify_one();
+		}
+	}
+
+	// the calling thread is one of the workers
+	RunParallelForJob(&job);
+
+	if (helpers > 0)
+	{
+		// helpers that have not shown up by now are not needed, wait for the ones inside
+		std::unique_lock<std::mutex> lock(pool->m_lock);
+		if (job.m_helpers_wanted > 0)
+		{
+			for (std::vector<sParallelForJob*>::iterator it = pool->m_jobs.begin(); it != pool->m_jobs.end(); ++it)
+			{
+				if (*it == &job)
+				{
+					pool->m_jobs.erase(it);
+					break;
+				}
+			}
+		}
+		pool->m_done.wait(lock, [&job]() { return job.m_helpers_running == 0; });
+	}
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+
+typedef void (*ParallelForCB) (uint idx, void* userData);
+
+// runs cb once for every idx in [0, count), spread over up to max_threads threads
+// (0 means one per core) including the calling one; returns when all are done.
+// The other threads come from a pool started on first use, cb may call ParallelFor again
+void ParallelFor(uint count, ParallelForCB cb, void* userData = nullptr, uint max_threads = 0);
\ No newline at end of file
@@ -188,6 +188,13 @@ void ThreadSleep(uint ms)
 	::Sleep((DWORD)ms);
 }
 
+uint ThreadGetCoreCount()
+{
+	SYSTEM_INFO info;
+	::GetSystemInfo(&info);
+	return (uint)info.dwNumberOfProcessors;
+}
+
 
 // test
 
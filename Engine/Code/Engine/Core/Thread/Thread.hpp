@@ -29,6 +29,7 @@ void ThreadCreateAndDetach(const char* name, const size_t stackSize, ThreadCB cb
 void ThreadSleep(uint ms);
 void ThreadYield();
 void ThreadYield(int& current, const int count);
+uint ThreadGetCoreCount();
 
 // debug
 void ThreadSetName(const char* name);
@@ -1,9 +1,21 @@
 #include "Engine/Core/Transform.hpp"
 
+#include <algorithm>
+
+Matrix44 sTransform::GetRotationMatrix() const
+{
+	return Quaternion::GetMatrixRotation(m_rotation);
+}
+
+Vector3 sTransform::GetEulerAngles() const
+{
+	return Matrix44::DecomposeMatrixIntoEuler(GetRotationMatrix());
+}
+
 Matrix44 sTransform::GetMatrixEulerTranspose() const
 {
 	Matrix44 scaleMatrix = Matrix44::MakeScale3D(m_scale.x, m_scale.y, m_scale.z);
-	Matrix44 rotationMatrix = Matrix44::MakeRotationDegrees3DTranspose(m_euler);
+	Matrix44 rotationMatrix = Quaternion::GetMatrixRotation(m_rotation.GetConjugate());		// transpose of the unit rotation
 	Matrix44 translationMatrix = Matrix44::MakeTranslation3D(m_position);
 
 	// t * r * s
@@ -15,17 +27,21 @@ Matrix44 sTransform::GetMatrixEulerTranspose() const
 	return res;
 }
 
-Matrix44 sTransform::ToWorld() const
+eMatrixClass sTransform::GetMatrixClass() const
 {
-	Matrix44 scaleMatrix = Matrix44::MakeScale3D(m_scale.x, m_scale.y, m_scale.z);
-	Matrix44 rotationMatrix = Matrix44::MakeRotationDegrees3D(m_euler);
-	Matrix44 translationMatrix = Matrix44::MakeTranslation3D(m_position);
+	// the rotation is kept unit length, only scale keeps trs from being rigid
+	if (m_scale == Vector3::ONE)
+		return MAT_CLASS_RIGID;
+	return MAT_CLASS_AFFINE;
+}
 
-	// trs
-	Matrix44 res = Matrix44::IDENTITY;
-	res.Append(translationMatrix);
-	res.Append(rotationMatrix);
-	res.Append(scaleMatrix);
+Matrix44 sTransform::ToWorld() const
+{
+	// trs written out: rotation columns scaled, position as translation
+	Matrix44 res = Quaternion::GetMatrixWithPosition(m_rotation, m_position);
+	res.Ix *= m_scale.x; res.Iy *= m_scale.x; res.Iz *= m_scale.x;
+	res.Jx *= m_scale.y; res.Jy *= m_scale.y; res.Jz *= m_scale.y;
+	res.Kx *= m_scale.z; res.Ky *= m_scale.z; res.Kz *= m_scale.z;
 
 	return res;
 }
@@ -33,7 +49,7 @@ Matrix44 sTransform::ToWorld() const
 Matrix44 sTransform::ToLocalOrthogonal() const
 {
 	Matrix44 scaleMatrix = Matrix44::MakeScale3D(1.f / m_scale.x, 1.f / m_scale.y, 1.f / m_scale.z);
-	Matrix44 rotationMatrix = Matrix44::MakeRotationDegrees3D(m_euler).Transpose();		// assumes bases are orthogonal
+	Matrix44 rotationMatrix = Quaternion::GetMatrixRotation(m_rotation.GetConjugate());		// assumes bases are orthogonal
 	Matrix44 translationMatrix = Matrix44::MakeTranslation3D(-m_position);
 
 	// srt
@@ -48,7 +64,7 @@ Matrix44 sTransform::ToLocalOrthogonal() const
 Matrix44 sTransform::ToLocalGeneral() const
 {
 	Matrix44 scaleMatrix = Matrix44::MakeScale3D(1.f / m_scale.x, 1.f / m_scale.y, 1.f / m_scale.z);
-	Matrix44 rotationMatrix = Matrix44::MakeRotationDegrees3D(m_euler).Invert();
+	Matrix44 rotationMatrix = Quaternion::GetMatrixRotation(m_rotation.GetInverse());
 	Matrix44 translationMatrix = Matrix44::MakeTranslation3D(-m_position);
 
 	Matrix44 res = Matrix44::IDENTITY;
@@ -61,20 +77,13 @@ Matrix44 sTransform::ToLocalGeneral() const
 
 Matrix44 sTransform::ToWorldNonScale() const
 {
-	Matrix44 rotationMatrix = Matrix44::MakeRotationDegrees3D(m_euler);
-	Matrix44 translationMatrix = Matrix44::MakeTranslation3D(m_position);
-
 	// tr
-	Matrix44 res = Matrix44::IDENTITY;
-	res.Append(translationMatrix);
-	res.Append(rotationMatrix);
-
-	return res;
+	return Quaternion::GetMatrixWithPosition(m_rotation, m_position);
 }
 
 Matrix44 sTransform::ToLocalOrtho() const
 {
-	Matrix44 rotationMatrix = Matrix44::MakeRotationDegrees3D(m_euler).Transpose();		// assumes bases are orthogonal
+	Matrix44 rotationMatrix = Quaternion::GetMatrixRotation(m_rotation.GetConjugate());		// assumes bases are orthogonal
 	Matrix44 translationMatrix = Matrix44::MakeTranslation3D(-m_position);
 
 	// srt
@@ -87,7 +96,7 @@ Matrix44 sTransform::ToLocalOrtho() const
 
 Matrix44 sTransform::ToLocalGen() const
 {
-	Matrix44 rotationMatrix = Matrix44::MakeRotationDegrees3D(m_euler).Invert();
+	Matrix44 rotationMatrix = Quaternion::GetMatrixRotation(m_rotation.GetInverse());
 	Matrix44 translationMatrix = Matrix44::MakeTranslation3D(-m_position);
 
 	Matrix44 res = Matrix44::IDENTITY;
@@ -107,14 +116,22 @@ void sTransform::Translate( Vector3 offset )
 	m_position += offset;
 }
 
+void sTransform::SetRotation(const Quaternion& rot)
+{
+	m_rotation = rot;
+	m_rotation.Normalize();
+}
+
 void sTransform::SetRotationEuler( Vector3 euler )
 {
-	m_euler = euler;
+	m_rotation = Quaternion::FromEuler(euler);
 }
 
 void sTransform::Rotate(Vector3 euler)
 {
-	m_euler += euler;
+	// q_delta * q composes to R(q) * R(q_delta)
+	m_rotation = Quaternion::FromEuler(euler) * m_rotation;
+	m_rotation.Normalize();
 }
 
 void sTransform::SetScale(Vector3 s)
@@ -125,35 +142,90 @@ void sTransform::SetScale(Vector3 s)
 ////////////////////////////////////////////// TRANSFORM ///////////////////////////////////////////////
 
 Transform::Transform(const Vector3& pos, const Vector3& euler, const Vector3& scale)
+	: m_localTransform(pos, euler, scale)
 {
-	m_localTransform = sTransform(pos, euler, scale);;
+
+}
+
+Transform::Transform(const Vector3& pos, const Quaternion& rot, const Vector3& scale)
+	: m_localTransform(pos, rot, scale)
+{
+
 }
 
 Transform::Transform()
 {
-	m_localTransform = sTransform();
+
+}
+
+Transform::Transform(const Transform& copy)
+	: m_localTransform(copy.m_localTransform)
+{
+	SetParentTransform(copy.m_parentTransform);
 }
 
 Transform::~Transform()
 {
+	SetParentTransform(nullptr);
+
+	for (Transform* child : m_children)
+	{
+		child->m_parentTransform = nullptr;
+		child->MarkWorldDirty();
+	}
+}
+
+void Transform::operator=(const Transform& copy)
+{
+	if (this == &copy)
+		return;
+
+	m_localTransform = copy.m_localTransform;
+	SetParentTransform(copy.m_parentTransform);
+	MarkLocalDirty();
+}
+
+void Transform::MarkLocalDirty()
+{
+	m_localDirty = true;
+	MarkWorldDirty();
+}
+
+void Transform::MarkWorldDirty()
+{
+	// a dirty world implies dirty descendants, so stop at the first one already marked
+	if (m_worldDirty)
+		return;
+
+	m_worldDirty = true;
+	for (Transform* child : m_children)
+		child->MarkWorldDirty();
+}
+
+void Transform::AddChild(Transform* child)
+{
+	m_children.push_back(child);
+}
 
+void Transform::RemoveChild(Transform* child)
+{
+	m_children.erase(std::remove(m_children.begin(), m_children.end(), child), m_children.end());
 }
 
-Matrix44 Transform::GetLocalMatrix() const
+const Matrix44& Transform::GetLocalMatrix() const
 {
-	Matrix44 local;
-	if (m_parentTransform == nullptr)
+	if (m_localDirty)
 	{
-		local = MAT_LOCAL_IDENTITY;
+		m_localMatrix = m_localTransform.ToWorld();
+		m_localDirty = false;
 	}
-	return local;
+	return m_localMatrix;
 }
 
 
 Matrix44 Transform::GetLocalRotationMatrix() const
 {
-	Matrix44 rot = Matrix44::MakeRotationDegrees3D(m_localTransform.m_euler);
-	return rot;
+	return m_localTransform.GetRotationMatrix();
 }
 
 Matrix44 Transform::GetLocalMatrixEulerTranspose() const
@@ -164,28 +236,47 @@ Matrix44 Transform::GetLocalMatrixEulerTranspose() const
 
 Matrix44 Transform::GetTRMatrix() const
 {
-	Matrix44 loc = Matrix44::MakeTranslation3D(m_localTransform.m_position);
-	Matrix44 rot = Matrix44::MakeRotationDegrees3D(m_localTransform.m_euler);
-	Matrix44 res = Matrix44::IDENTITY;
-	res.Append(loc);
-	res.Append(rot);
-
-	return res;
+	return m_localTransform.ToWorldNonScale();
 }
 
 
-Matrix44 Transform::GetWorldMatrix() const
+const Matrix44& Transform::GetWorldMatrix() const
 {
-	Matrix44 world;
-	Matrix44 toWorld;
-	if (m_parentTransform == nullptr)
+	if (m_worldDirty)
 	{
-		toWorld = m_localTransform.ToWorld();
-		Matrix44 local = GetLocalMatrix();
-
-		world = toWorld * local;
+		const Matrix44& local = GetLocalMatrix();
+		eMatrixClass localClass = m_localTransform.GetMatrixClass();
+
+		if (m_parentTransform != nullptr)
+		{
+			m_worldMatrix = m_parentTransform->GetWorldMatrix() * local;
+
+			// a product of trs matrices stays affine, and stays rigid only if every one of them is
+			eMatrixClass parentClass = m_parentTransform->GetWorldMatrixClass();
+			m_worldClass = (parentClass == MAT_CLASS_RIGID && localClass == MAT_CLASS_RIGID) ? MAT_CLASS_RIGID : MAT_CLASS_AFFINE;
+		}
+		else
+		{
+			m_worldMatrix = local;
+			m_worldClass = localClass;
+		}
+
+		m_worldDirty = false;
 	}
-	return world;
+	return m_worldMatrix;
+}
+
+
+Matrix44 Transform::GetWorldMatrixInverse() const
+{
+	return GetWorldMatrix().Invert(GetWorldMatrixClass());
+}
+
+
+eMatrixClass Transform::GetWorldMatrixClass() const
+{
+	GetWorldMatrix();
+	return m_worldClass;
 }
 
 
@@ -207,9 +298,9 @@ Matrix44 Transform::GetWorldMatrixEulerTranspose() const
 }
 
 
-Vector3 Transform::TransformLocalToWorldPos(Vector3 local, Transform transform)
+Vector3 Transform::TransformLocalToWorldPos(Vector3 local, const Transform& transform)
 {
-	Matrix44 toWorld = transform.m_localTransform.ToWorld();
+	const Matrix44& toWorld = transform.GetLocalMatrix();
 	Vector4 localPos = local.ToVector4(1.f);
 	Vector4 worldPos = toWorld * localPos;
 	Vector3 world = worldPos.ToVector3();
@@ -234,7 +325,7 @@ Vector3 Transform::TransformWorldToLocalPosGeneral(const Vector3& world, const T
 	return local;
 }
 
-Vector3 Transform::LocalToWorldPos(Vector3 local, Transform transform)
+Vector3 Transform::LocalToWorldPos(Vector3 local, const Transform& transform)
 {
 	Matrix44 toWorld = transform.m_localTransform.ToWorldNonScale();
 	Vector4 localPos = local.ToVector4(1.f);
@@ -266,110 +357,102 @@ void Transform::TransformRotationAtoBCoord(Matrix44&, const Transform&, const Tr
 
 }
 
-Vector3 Transform::TransformDirToWorld(Vector3 dir_local, Transform transform)
+Vector3 Transform::TransformDirToWorld(Vector3 dir_local, const Transform& transform)
 {
-	Matrix44 toWorld = transform.m_localTransform.ToWorld();
+	Matrix44 toWorld = transform.GetLocalMatrix();
 	Vector3 dir_world = toWorld.TransformDisplacement3D(dir_local);
 	return dir_world;
 }
 
-Vector3 Transform::TransformDirToLocal(Vector3 dir_world, Transform transform)
+Vector3 Transform::TransformDirToLocal(Vector3 dir_world, const Transform& transform)
 {
-	Matrix44 toWorld = transform.m_localTransform.ToWorld();	// try using to world this time :)
+	Matrix44 toWorld = transform.GetLocalMatrix();	// try using to world this time :)
 	Vector3 dir_local = toWorld.TransformDisplacementInverse3D(dir_world);
 	return dir_local;
 }
 
 Vector3 Transform::GetWorldPosition() const
 {
-	Vector3 worldPosition;
-	if (m_parentTransform == nullptr)
-	{
-		Matrix44 worldModel = GetWorldMatrix();
-		worldPosition = Vector3(worldModel.Tx, worldModel.Ty, worldModel.Tz);
-	}
-	return worldPosition;
+	const Matrix44& worldModel = GetWorldMatrix();
+	return Vector3(worldModel.Tx, worldModel.Ty, worldModel.Tz);
 }
 
 
 Vector3 Transform::GetWorldScale() const
 {
-	Vector3 worldScale;
-	if (m_parentTransform == nullptr)
-	{
-		Matrix44 worldModel = GetWorldMatrix();
-		worldScale = Vector3(worldModel.Ix, worldModel.Jy, worldModel.Kz);
-	}
-	return worldScale;
+	// length of each basis, the diagonal is only the scale without rotation
+	const Matrix44& worldModel = GetWorldMatrix();
+	return Vector3(worldModel.GetRight().GetLength(), worldModel.GetUp().GetLength(), worldModel.GetForward().GetLength());
 }
 
 Vector3 Transform::GetWorldForward() const
 {
-	Vector4 worldForward;
-	if (m_parentTransform == nullptr)
-	{
-		Matrix44 toWorld = m_localTransform.ToWorld();
-		Vector4 localForward = GetLocalForward().ToVector4(0.f);
-		worldForward = toWorld * localForward;
-	}
-	return worldForward.ToVector3();
+	return GetWorldMatrix().GetForward();
 }
 
 Vector3 Transform::GetWorldUp() const
 {
-	Vector4 worldUp;
-	if (m_parentTransform == nullptr)
-	{
-		Matrix44 toWorld = m_localTransform.ToWorld();
-		Vector4 localUp = GetLocalUp().ToVector4(0.f);
-		worldUp = toWorld * localUp;
-	}
-	return worldUp.ToVector3();
+	return GetWorldMatrix().GetUp();
 }
 
 Vector3 Transform::GetWorldRight() const
 {
-	Vector4 worldRight;
-	if (m_parentTransform == nullptr)
-	{
-		Matrix44 toWorld = m_localTransform.ToWorld();
-		Vector4 localRight = GetLocalRight().ToVector4(0.f);
-		worldRight = toWorld * localRight;
-	}
-	return worldRight.ToVector3();
+	return GetWorldMatrix().GetRight();
 }
 
 void Transform::SetLocalPosition(Vector3 pos)
 {
 	m_localTransform.SetPosition(pos);
+	MarkLocalDirty();
 }
 
 void Transform::TranslateLocal( Vector3 offset )
 {
 	m_localTransform.Translate(offset);
+	MarkLocalDirty();
 }
 
 
 void Transform::SetLocalRotation( Vector3 euler )
 {
 	m_localTransform.SetRotationEuler(euler);
+	MarkLocalDirty();
+}
+
+void Transform::SetLocalRotation(const Quaternion& rot)
+{
+	m_localTransform.SetRotation(rot);
+	MarkLocalDirty();
 }
 
 void Transform::RotateLocal( Vector3 euler )
 {
 	m_localTransform.Rotate(euler);
+	MarkLocalDirty();
 }
 
 
 void Transform::SetLocalScale( Vector3 s )
 {
 	m_localTransform.SetScale(s);
+	MarkLocalDirty();
 }
 
 
 void Transform::SetParentTransform(Transform* parentTransform)
 {
+	if (parentTransform == m_parentTransform)
+		return;
+
+	if (m_parentTransform != nullptr)
+		m_parentTransform->RemoveChild(this);
+
 	m_parentTransform = parentTransform;
+
+	if (m_parentTransform != nullptr)
+		m_parentTransform->AddChild(this);
+
+	MarkWorldDirty();
 }
 
 
@@ -388,5 +471,4 @@ Vector3 Transform::GetLocalUp() const
 Vector3 Transform::GetLocalRight() const
 {
 	return Vector3(1.f, 0.f, 0.f);
-}
-
+}
\ No newline at end of file
@@ -2,105 +2,144 @@
 
 #include "Engine/Math/Vector3.hpp"
 #include "Engine/Math/Matrix44.hpp"
+#include "Engine/Core/Quaternion.hpp"
 
-#define MAT_LOCAL_IDENTITY Matrix44::IDENTITY
+#include <vector>
 
 struct sTransform
 {
 	sTransform()
 		: m_position(Vector3::ZERO)
-		, m_euler(Vector3::ZERO)
+		, m_rotation(Quaternion::IDENTITY)
 		, m_scale(Vector3::ONE) {}
 
 	sTransform(const Vector3& pos, const Vector3& euler, const Vector3& scale)
-		: m_position(pos), m_euler(euler), m_scale(scale)
+		: m_position(pos), m_rotation(Quaternion::FromEuler(euler)), m_scale(scale)
 	{
-		
+
+	}
+
+	sTransform(const Vector3& pos, const Quaternion& rot, const Vector3& scale)
+		: m_position(pos), m_rotation(rot), m_scale(scale)
+	{
+		m_rotation.Normalize();
 	}
 
-	Vector3  m_position; 
-	Vector3  m_euler; 
-	Vector3  m_scale; 
+	Vector3		m_position;
+	Quaternion	m_rotation;		// unit length
+	Vector3		m_scale;
 
-	void		SetPosition( Vector3 pos ); 
-	void		SetScale( Vector3 s ); 
-	void		SetRotationEuler( Vector3 euler ); 
+	void		SetPosition( Vector3 pos );
+	void		SetScale( Vector3 s );
+	void		SetRotation( const Quaternion& rot );
+	void		SetRotationEuler( Vector3 euler );
 
-	void		Translate( Vector3 offset ); 
-	void		Rotate( Vector3 euler ); 
-	
-	Vector3		GetEulerAngles() const {return m_euler;}
+	void		Translate( Vector3 offset );
+	void		Rotate( Vector3 euler );		// applied in the local frame, after the current rotation
+
+	Vector3		GetEulerAngles() const;
+	Quaternion	GetRotation() const {return m_rotation;}
 	Vector3		GetPosition() const {return m_position;}
 	Vector3		GetScale() const {return m_scale;}
 
+	Matrix44	GetRotationMatrix() const;
 	Matrix44	GetMatrixEulerTranspose() const;
+	eMatrixClass GetMatrixClass() const;
 
 	// basis transform
 	// scale
 	Matrix44 ToWorld() const;
-	Matrix44 ToLocalOrthogonal() const;	
-	Matrix44 ToLocalGeneral() const;	
+	Matrix44 ToLocalOrthogonal() const;
+	Matrix44 ToLocalGeneral() const;
 
 	// non-scale
 	Matrix44 ToWorldNonScale() const;
-	Matrix44 ToLocalOrtho() const;  
-	Matrix44 ToLocalGen() const;	
+	Matrix44 ToLocalOrtho() const;
+	Matrix44 ToLocalGen() const;
 };
 
-class Transform 
+/*
+ * Local and world matrices are cached and rebuilt lazily. Changing a transform marks its world
+ * matrix dirty along with every child below it, so a getter only pays for the matrices that changed.
+ * Children are tracked by pointer: a transform detaches itself from its parent and children when destroyed.
+ */
+class Transform
 {
 public:
 	Transform();
 	Transform(const Vector3& pos, const Vector3& euler, const Vector3& scale);
+	Transform(const Vector3& pos, const Quaternion& rot, const Vector3& scale);
+	Transform(const Transform& copy);		// joins the same parent, children are not copied
 	~Transform();
 
+	void operator=(const Transform& copy);
+
 	// local mat
-	Matrix44	GetLocalMatrix() const; 
+	const Matrix44&	GetLocalMatrix() const;
 	Matrix44    GetLocalRotationMatrix() const;
 	Vector3		GetLocalPosition() const { return m_localTransform.m_position; }
-	Vector3		GetLocalRotation() const {return m_localTransform.m_euler;}
-	Vector3		GetLocalScale() const {return m_localTransform.m_scale;}
+	Vector3		GetLocalRotation() const { return m_localTransform.GetEulerAngles(); }
+	Quaternion	GetLocalQuaternion() const { return m_localTransform.m_rotation; }
+	Vector3		GetLocalScale() const { return m_localTransform.m_scale; }
 	Vector3		GetLocalForward() const;
 	Vector3		GetLocalUp() const;
 	Vector3		GetLocalRight() const;
 
-	void		SetLocalScale( Vector3 s ); 
-	void		SetLocalRotation( Vector3 euler ); 
-	void		SetLocalPosition( Vector3 pos ); 
+	void		SetLocalScale( Vector3 s );
+	void		SetLocalRotation( Vector3 euler );
+	void		SetLocalRotation( const Quaternion& rot );
+	void		SetLocalPosition( Vector3 pos );
 
-	Matrix44	GetWorldMatrix() const;
+	const Matrix44&	GetWorldMatrix() const;
+	Matrix44	GetWorldMatrixInverse() const;
+	eMatrixClass GetWorldMatrixClass() const;
 	Vector3		GetWorldPosition() const;
 	Vector3		GetWorldScale() const;
 	Vector3		GetWorldForward() const;
 	Vector3		GetWorldUp() const;
 	Vector3		GetWorldRight() const;
 
-	void		TranslateLocal( Vector3 offset ); 
-	void		RotateLocal( Vector3 euler ); 
+	void		TranslateLocal( Vector3 offset );
+	void		RotateLocal( Vector3 euler );
 
 	// world mat
 	void		SetParentTransform(Transform* parentTransform);
+	Transform*	GetParentTransform() const { return m_parentTransform; }
 
 	Matrix44    GetTRMatrix() const;
 	Matrix44	GetLocalMatrixEulerTranspose() const;
 	Matrix44    GetWorldMatrixEulerTranspose() const;
 
 	// scale
-	static Vector3 TransformLocalToWorldPos(Vector3 local, Transform transform);
+	static Vector3 TransformLocalToWorldPos(Vector3 local, const Transform& transform);
 	static Vector3 TransformWorldToLocalPosOrthogonal(const Vector3& world, const Transform& transform);	// assumes orthogonal bases
 	static Vector3 TransformWorldToLocalPosGeneral(const Vector3& world, const Transform& transform);	// no assumption on bases
 
 	// non-scale
-	static Vector3 LocalToWorldPos(Vector3 local, Transform transform);
-	static Vector3 WorldToLocalOrthogonal(const Vector3& world, const Transform& transform);	
-	static Vector3 WorldToLocalGeneral(const Vector3& world, const Transform& transform);	
+	static Vector3 LocalToWorldPos(Vector3 local, const Transform& transform);
+	static Vector3 WorldToLocalOrthogonal(const Vector3& world, const Transform& transform);
+	static Vector3 WorldToLocalGeneral(const Vector3& world, const Transform& transform);
 	static void TransformRotationAtoBCoord(Matrix44& rotation, const Transform& A, const Transform& B);
 
 	// dir
-	static Vector3 TransformDirToWorld(Vector3 dir_local, Transform transform);
-	static Vector3 TransformDirToLocal(Vector3 dir_world, Transform transform);
+	static Vector3 TransformDirToWorld(Vector3 dir_local, const Transform& transform);
+	static Vector3 TransformDirToLocal(Vector3 dir_world, const Transform& transform);
 
-public:
-	sTransform m_localTransform; 
+private:
+	void		MarkLocalDirty();
+	void		MarkWorldDirty();
+	void		AddChild(Transform* child);
+	void		RemoveChild(Transform* child);
+
+private:
+	sTransform m_localTransform;
 	Transform* m_parentTransform = nullptr;
+	std::vector<Transform*> m_children;
+
+	// caches, rebuilt by the const getters
+	mutable Matrix44 m_localMatrix;
+	mutable Matrix44 m_worldMatrix;
+	mutable eMatrixClass m_worldClass = MAT_CLASS_RIGID;
+	mutable bool m_localDirty = true;
+	mutable bool m_worldDirty = true;		// if set, it is also set on every descendant
 };
\ No newline at end of file
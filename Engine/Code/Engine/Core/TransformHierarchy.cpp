@@ -0,0 +1,357 @@
+#include "Engine/Core/TransformHierarchy.hpp"
+#include "Engine/Core/Thread/ParallelFor.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <string.h>
+
+static Matrix44 ComposeLocalMatrix(const Vector3& pos, const Quaternion& rot, const Vector3& scale)
+{
+	// trs written out, same as sTransform::ToWorld
+	Matrix44 res = Quaternion::GetMatrixWithPosition(rot, pos);
+	res.Ix *= scale.x; res.Iy *= scale.x; res.Iz *= scale.x;
+	res.Jx *= scale.y; res.Jy *= scale.y; res.Jz *= scale.y;
+	res.Kx *= scale.z; res.Ky *= scale.z; res.Kz *= scale.z;
+	return res;
+}
+
+template <typename T>
+static void GatherInOrder(std::vector<T>& values, const std::vector<uint>& order)
+{
+	std::vector<T> sorted;
+	sorted.reserve(order.size());
+	for (uint old_idx : order)
+		sorted.push_back(values[old_idx]);
+	values.swap(sorted);
+}
+
+TransformHierarchy::TransformHierarchy()
+{
+
+}
+
+TransformHierarchy::~TransformHierarchy()
+{
+
+}
+
+sTransformHandle TransformHierarchy::CreateNode(const Vector3& pos, const Quaternion& rot, const Vector3& scale, sTransformHandle parent)
+{
+	uint parentIdx = TRANSFORM_NODE_NONE;
+	if (parent.m_slot != TRANSFORM_NODE_NONE)
+	{
+		parentIdx = GetDenseIndex(parent);
+		ASSERT_OR_DIE(parentIdx != TRANSFORM_NODE_NONE, "Parent transform handle is stale");
+	}
+
+	uint slot;
+	if (!m_freeSlots.empty())
+	{
+		slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	else
+	{
+		slot = (uint)m_denseOf.size();
+		m_denseOf.push_back(TRANSFORM_NODE_NONE);
+		m_generation.push_back(0);
+	}
+
+	uint idx = (uint)m_position.size();
+	m_denseOf[slot] = idx;
+
+	Quaternion unitRot = rot;
+	unitRot.Normalize();
+
+	m_position.push_back(pos);
+	m_rotation.push_back(unitRot);
+	m_scale.push_back(scale);
+	m_world.push_back(Matrix44::IDENTITY);
+	m_parent.push_back(parentIdx);
+	m_slotOf.push_back(slot);
+	m_dirty.push_back(1);
+	m_alive.push_back(1);
+
+	// appended at the end, which is only the right level if the parent is on the deepest one
+	m_orderStale = true;
+
+	sTransformHandle handle;
+	handle.m_slot = slot;
+	handle.m_generation = m_generation[slot];
+	return handle;
+}
+
+void TransformHierarchy::DestroyNode(sTransformHandle node)
+{
+	uint idx = GetDenseIndex(node);
+	if (idx == TRANSFORM_NODE_NONE)
+		return;
+
+	// the dense entry stays until Rebuild so indices held by children remain meaningful
+	m_alive[idx] = 0;
+	++m_deadCount;
+	m_orderStale = true;
+
+	m_denseOf[node.m_slot] = TRANSFORM_NODE_NONE;
+	++m_generation[node.m_slot];
+	m_freeSlots.push_back(node.m_slot);
+}
+
+bool TransformHierarchy::IsValid(sTransformHandle node) const
+{
+	return GetDenseIndex(node) != TRANSFORM_NODE_NONE;
+}
+
+uint TransformHierarchy::GetDenseIndex(sTransformHandle node) const
+{
+	if (node.m_slot >= (uint)m_denseOf.size())
+		return TRANSFORM_NODE_NONE;
+	if (m_generation[node.m_slot] != node.m_generation)
+		return TRANSFORM_NODE_NONE;
+	return m_denseOf[node.m_slot];
+}
+
+void TransformHierarchy::SetParent(sTransformHandle node, sTransformHandle parent)
+{
+	uint idx = GetDenseIndex(node);
+	ASSERT_OR_DIE(idx != TRANSFORM_NODE_NONE, "Transform handle is stale");
+
+	uint parentIdx = TRANSFORM_NODE_NONE;
+	if (parent.m_slot != TRANSFORM_NODE_NONE)
+	{
+		parentIdx = GetDenseIndex(parent);
+		ASSERT_OR_DIE(parentIdx != TRANSFORM_NODE_NONE, "Parent transform handle is stale");
+
+		for (uint ancestor = parentIdx; ancestor != TRANSFORM_NODE_NONE; ancestor = m_parent[ancestor])
+			ASSERT_OR_DIE(ancestor != idx, "Transform cannot be parented under its own subtree");
+	}
+
+	if (m_parent[idx] == parentIdx)
+		return;
+
+	m_parent[idx] = parentIdx;
+	m_dirty[idx] = 1;
+	m_orderStale = true;
+}
+
+sTransformHandle TransformHierarchy::GetParent(sTransformHandle node) const
+{
+	sTransformHandle handle;
+
+	uint idx = GetDenseIndex(node);
+	if (idx == TRANSFORM_NODE_NONE)
+		return handle;
+
+	uint parentIdx = m_parent[idx];
+	if (parentIdx == TRANSFORM_NODE_NONE || !m_alive[parentIdx])
+		return handle;
+
+	handle.m_slot = m_slotOf[parentIdx];
+	handle.m_generation = m_generation[handle.m_slot];
+	return handle;
+}
+
+void TransformHierarchy::SetLocalPosition(sTransformHandle node, const Vector3& pos)
+{
+	uint idx = GetDenseIndex(node);
+	ASSERT_OR_DIE(idx != TRANSFORM_NODE_NONE, "Transform handle is stale");
+	m_position[idx] = pos;
+	m_dirty[idx] = 1;
+}
+
+void TransformHierarchy::SetLocalRotation(sTransformHandle node, const Quaternion& rot)
+{
+	uint idx = GetDenseIndex(node);
+	ASSERT_OR_DIE(idx != TRANSFORM_NODE_NONE, "Transform handle is stale");
+	m_rotation[idx] = rot;
+	m_rotation[idx].Normalize();
+	m_dirty[idx] = 1;
+}
+
+void TransformHierarchy::SetLocalScale(sTransformHandle node, const Vector3& scale)
+{
+	uint idx = GetDenseIndex(node);
+	ASSERT_OR_DIE(idx != TRANSFORM_NODE_NONE, "Transform handle is stale");
+	m_scale[idx] = scale;
+	m_dirty[idx] = 1;
+}
+
+Vector3 TransformHierarchy::GetLocalPosition(sTransformHandle node) const
+{
+	uint idx = GetDenseIndex(node);
+	ASSERT_OR_DIE(idx != TRANSFORM_NODE_NONE, "Transform handle is stale");
+	return m_position[idx];
+}
+
+Quaternion TransformHierarchy::GetLocalRotation(sTransformHandle node) const
+{
+	uint idx = GetDenseIndex(node);
+	ASSERT_OR_DIE(idx != TRANSFORM_NODE_NONE, "Transform handle is stale");
+	return m_rotation[idx];
+}
+
+Vector3 TransformHierarchy::GetLocalScale(sTransformHandle node) const
+{
+	uint idx = GetDenseIndex(node);
+	ASSERT_OR_DIE(idx != TRANSFORM_NODE_NONE, "Transform handle is stale");
+	return m_scale[idx];
+}
+
+const Matrix44& TransformHierarchy::GetWorldMatrix(sTransformHandle node) const
+{
+	uint idx = GetDenseIndex(node);
+	ASSERT_OR_DIE(idx != TRANSFORM_NODE_NONE, "Transform handle is stale");
+	return m_world[idx];
+}
+
+Vector3 TransformHierarchy::GetWorldPosition(sTransformHandle node) const
+{
+	const Matrix44& world = GetWorldMatrix(node);
+	return Vector3(world.Tx, world.Ty, world.Tz);
+}
+
+void TransformHierarchy::Update()
+{
+	if (m_orderStale)
+		Rebuild();
+
+	for (uint level = 0; level + 1 < (uint)m_levelStart.size(); ++level)
+		UpdateLevel(m_levelStart[level], m_levelStart[level + 1]);
+
+	if (!m_dirty.empty())
+		memset(m_dirty.data(), 0, m_dirty.size());
+}
+
+void TransformHierarchy::UpdateLevel(uint begin, uint end)
+{
+	uint count = end - begin;
+	if (count < TRANSFORM_HIERARCHY_PARALLEL_MIN)
+	{
+		UpdateRange(begin, end);
+		return;
+	}
+
+	// every parent sits on an earlier level, so the nodes of one level only read finished matrices
+	m_jobBegin = begin;
+	m_jobEnd = end;
+	uint chunks = (count + TRANSFORM_HIERARCHY_CHUNK - 1) / TRANSFORM_HIERARCHY_CHUNK;
+	ParallelFor(chunks, UpdateChunk, this);
+}
+
+void TransformHierarchy::UpdateChunk(uint chunk, void* userData)
+{
+	TransformHierarchy* hierarchy = (TransformHierarchy*)(userData);
+
+	uint begin = hierarchy->m_jobBegin + chunk * TRANSFORM_HIERARCHY_CHUNK;
+	uint end = begin + TRANSFORM_HIERARCHY_CHUNK;
+	if (end > hierarchy->m_jobEnd)
+		end = hierarchy->m_jobEnd;
+
+	hierarchy->UpdateRange(begin, end);
+}
+
+void TransformHierarchy::UpdateRange(uint begin, uint end)
+{
+	for (uint idx = begin; idx < end; ++idx)
+	{
+		uint parentIdx = m_parent[idx];
+
+		// a moved parent moves the whole subtree, carried down one level at a time
+		if (parentIdx != TRANSFORM_NODE_NONE && m_dirty[parentIdx])
+			m_dirty[idx] = 1;
+
+		if (!m_dirty[idx])
+			continue;
+
+		Matrix44 local = ComposeLocalMatrix(m_position[idx], m_rotation[idx], m_scale[idx]);
+		if (parentIdx == TRANSFORM_NODE_NONE)
+			m_world[idx] = local;
+		else
+			m_world[idx] = m_world[parentIdx] * local;
+	}
+}
+
+void TransformHierarchy::Rebuild()
+{
+	uint count = (uint)m_position.size();
+
+	// children of destroyed nodes become roots
+	for (uint idx = 0; idx < count; ++idx)
+	{
+		uint parentIdx = m_parent[idx];
+		if (m_alive[idx] && parentIdx != TRANSFORM_NODE_NONE && !m_alive[parentIdx])
+		{
+			m_parent[idx] = TRANSFORM_NODE_NONE;
+			m_dirty[idx] = 1;
+		}
+	}
+
+	// depth of every live node, walking up only until a known depth
+	std::vector<uint> depth(count, TRANSFORM_NODE_NONE);
+	std::vector<uint> chain;
+	uint maxDepth = 0;
+	for (uint idx = 0; idx < count; ++idx)
+	{
+		if (!m_alive[idx] || depth[idx] != TRANSFORM_NODE_NONE)
+			continue;
+
+		uint walk = idx;
+		while (walk != TRANSFORM_NODE_NONE && depth[walk] == TRANSFORM_NODE_NONE)
+		{
+			chain.push_back(walk);
+			walk = m_parent[walk];
+		}
+
+		uint d = (walk == TRANSFORM_NODE_NONE) ? 0 : depth[walk] + 1;
+		while (!chain.empty())
+		{
+			depth[chain.back()] = d;
+			if (d > maxDepth)
+				maxDepth = d;
+			++d;
+			chain.pop_back();
+		}
+	}
+
+	// counting sort by depth, stable so siblings keep their relative order
+	uint liveCount = count - m_deadCount;
+	m_levelStart.assign(liveCount > 0 ? maxDepth + 2 : 0, 0);
+	for (uint idx = 0; idx < count; ++idx)
+	{
+		if (m_alive[idx])
+			++m_levelStart[depth[idx] + 1];
+	}
+	for (uint level = 1; level < (uint)m_levelStart.size(); ++level)
+		m_levelStart[level] += m_levelStart[level - 1];
+
+	std::vector<uint> order(liveCount);
+	std::vector<uint> newIndex(count, TRANSFORM_NODE_NONE);
+	std::vector<uint> cursor(m_levelStart);
+	for (uint idx = 0; idx < count; ++idx)
+	{
+		if (!m_alive[idx])
+			continue;
+
+		uint pos = cursor[depth[idx]]++;
+		order[pos] = idx;
+		newIndex[idx] = pos;
+	}
+
+	GatherInOrder(m_position, order);
+	GatherInOrder(m_rotation, order);
+	GatherInOrder(m_scale, order);
+	GatherInOrder(m_world, order);
+	GatherInOrder(m_parent, order);
+	GatherInOrder(m_slotOf, order);
+	GatherInOrder(m_dirty, order);
+	m_alive.assign(liveCount, 1);
+
+	for (uint idx = 0; idx < liveCount; ++idx)
+	{
+		if (m_parent[idx] != TRANSFORM_NODE_NONE)
+			m_parent[idx] = newIndex[m_parent[idx]];
+		m_denseOf[m_slotOf[idx]] = idx;
+	}
+
+	m_deadCount = 0;
+	m_orderStale = false;
+}
\ No newline at end of file
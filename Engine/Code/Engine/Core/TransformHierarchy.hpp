@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Engine/Math/Vector3.hpp"
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Core/Quaternion.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <vector>
+
+#define TRANSFORM_NODE_NONE 0xffffffffu
+#define TRANSFORM_HIERARCHY_CHUNK 1024				// nodes per parallel job
+#define TRANSFORM_HIERARCHY_PARALLEL_MIN 8192		// smaller levels run on the calling thread
+
+// stays valid while the node lives, however the nodes get reordered
+struct sTransformHandle
+{
+	uint m_slot = TRANSFORM_NODE_NONE;
+	uint m_generation = 0;
+
+	bool operator==(const sTransformHandle& rhs) const { return m_slot == rhs.m_slot && m_generation == rhs.m_generation; }
+	bool operator!=(const sTransformHandle& rhs) const { return !(*this == rhs); }
+};
+
+/*
+ * Many transforms kept as parallel arrays sorted by depth, so parents always come before children.
+ * Update walks the levels in order; nodes within a level are independent and split over threads.
+ * Creating, destroying or reparenting only marks the order stale, it is re-sorted once at the next Update.
+ * World matrices read between updates are from the last Update.
+ */
+class TransformHierarchy
+{
+public:
+	TransformHierarchy();
+	~TransformHierarchy();
+
+	sTransformHandle CreateNode(const Vector3& pos, const Quaternion& rot, const Vector3& scale,
+		sTransformHandle parent = sTransformHandle());
+	void		DestroyNode(sTransformHandle node);		// children become roots, keeping their local values
+	bool		IsValid(sTransformHandle node) const;
+
+	void		SetParent(sTransformHandle node, sTransformHandle parent);
+	sTransformHandle GetParent(sTransformHandle node) const;
+
+	void		SetLocalPosition(sTransformHandle node, const Vector3& pos);
+	void		SetLocalRotation(sTransformHandle node, const Quaternion& rot);
+	void		SetLocalScale(sTransformHandle node, const Vector3& scale);
+	Vector3		GetLocalPosition(sTransformHandle node) const;
+	Quaternion	GetLocalRotation(sTransformHandle node) const;
+	Vector3		GetLocalScale(sTransformHandle node) const;
+
+	const Matrix44& GetWorldMatrix(sTransformHandle node) const;
+	Vector3		GetWorldPosition(sTransformHandle node) const;
+
+	void		Update();
+
+	uint		GetNodeCount() const { return (uint)m_position.size() - m_deadCount; }
+	uint		GetLevelCount() const { return m_levelStart.empty() ? 0 : (uint)m_levelStart.size() - 1; }
+
+private:
+	uint		GetDenseIndex(sTransformHandle node) const;
+	void		Rebuild();
+	void		UpdateLevel(uint begin, uint end);
+	void		UpdateRange(uint begin, uint end);
+
+	static void	UpdateChunk(uint chunk, void* userData);
+
+private:
+	// dense, sorted by depth after Rebuild; appended to in between
+	std::vector<Vector3> m_position;
+	std::vector<Quaternion> m_rotation;
+	std::vector<Vector3> m_scale;
+	std::vector<Matrix44> m_world;
+	std::vector<uint> m_parent;			// dense index, TRANSFORM_NODE_NONE for roots
+	std::vector<uint> m_slotOf;			// dense index to handle slot
+	std::vector<unsigned char> m_dirty;		// bytes so threads can write neighbours
+	std::vector<unsigned char> m_alive;
+
+	// handle slots
+	std::vector<uint> m_denseOf;		// slot to dense index
+	std::vector<uint> m_generation;
+	std::vector<uint> m_freeSlots;
+
+	std::vector<uint> m_levelStart;		// level d is [m_levelStart[d], m_levelStart[d + 1])
+	uint m_deadCount = 0;
+	bool m_orderStale = false;
+
+	// the level being updated, read by the parallel chunks
+	uint m_jobBegin = 0;
+	uint m_jobEnd = 0;
+};
\ No newline at end of file
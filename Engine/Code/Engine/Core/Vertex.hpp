@@ -77,7 +77,7 @@ struct VertexLit
 	static VertexAttribute const s_attributes[];
 	static VertexLayout const s_layout;
 
-	VertexLit(sVertexBuilder builder)
+	VertexLit(const sVertexBuilder& builder)
 	{
 		m_pos = builder.m_position;
 		m_color = builder.m_color;
@@ -99,7 +99,7 @@ struct Vertex_3DPCU
 	static VertexAttribute const s_attributes[]; 
 	static VertexLayout const s_layout; 
 
-	Vertex_3DPCU(sVertexBuilder builder)
+	Vertex_3DPCU(const sVertexBuilder& builder)
 	{
 		m_pos = builder.m_position;
 		m_color = builder.m_color;
@@ -0,0 +1,142 @@
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <float.h>
+
+AABB3::AABB3(const Vector3& mins, const Vector3& maxs)
+	: m_min(mins)
+	, m_max(maxs)
+{
+
+}
+
+
+AABB3::AABB3(const Vector3& center, float radiusX, float radiusY, float radiusZ)
+	: m_min(Vector3(center.x - radiusX, center.y - radiusY, center.z - radiusZ))
+	, m_max(Vector3(center.x + radiusX, center.y + radiusY, center.z + radiusZ))
+{
+
+}
+
+
+void AABB3::StretchToIncludePoint(const Vector3& point)
+{
+	m_min.x = fminf(m_min.x, point.x);
+	m_min.y = fminf(m_min.y, point.y);
+	m_min.z = fminf(m_min.z, point.z);
+
+	m_max.x = fmaxf(m_max.x, point.x);
+	m_max.y = fmaxf(m_max.y, point.y);
+	m_max.z = fmaxf(m_max.z, point.z);
+}
+
+
+void AABB3::StretchToIncludeBox(const AABB3& box)
+{
+	StretchToIncludePoint(box.m_min);
+	StretchToIncludePoint(box.m_max);
+}
+
+
+void AABB3::AddPadding(const Vector3& padding)
+{
+	m_min -= padding;
+	m_max += padding;
+}
+
+
+void AABB3::Translate(const Vector3& translation)
+{
+	m_min += translation;
+	m_max += translation;
+}
+
+
+bool AABB3::IsPointInside(const Vector3& point) const
+{
+	return !(point.x > m_max.x || point.x < m_min.x ||
+		point.y > m_max.y || point.y < m_min.y ||
+		point.z > m_max.z || point.z < m_min.z);
+}
+
+
+bool AABB3::Overlaps(const AABB3& other) const
+{
+	return !(other.m_min.x > m_max.x || other.m_max.x < m_min.x ||
+		other.m_min.y > m_max.y || other.m_max.y < m_min.y ||
+		other.m_min.z > m_max.z || other.m_max.z < m_min.z);
+}
+
+
+Vector3 AABB3::GetDimensions() const
+{
+	return m_max - m_min;
+}
+
+
+Vector3 AABB3::GetCenter() const
+{
+	return (m_min + m_max) * .5f;
+}
+
+
+Vector3 AABB3::GetHalfExt() const
+{
+	return (m_max - m_min) * .5f;
+}
+
+
+Vector3 AABB3::GetClosestPoint(const Vector3& point) const
+{
+	return Vector3(ClampFloat(point.x, m_min.x, m_max.x),
+		ClampFloat(point.y, m_min.y, m_max.y),
+		ClampFloat(point.z, m_min.z, m_max.z));
+}
+
+
+float AABB3::GetSurfaceArea() const
+{
+	Vector3 dim = GetDimensions();
+	return 2.f * (dim.x * dim.y + dim.y * dim.z + dim.z * dim.x);
+}
+
+
+float AABB3::GetDistSquared(const Vector3& point) const
+{
+	Vector3 closest = GetClosestPoint(point);
+	return (closest - point).GetLengthSquared();
+}
+
+
+bool AABB3::RaycastSlab(const Vector3& start, const Vector3& inv_dir, float max_t, float& t) const
+{
+	float t1 = (m_min.x - start.x) * inv_dir.x;
+	float t2 = (m_max.x - start.x) * inv_dir.x;
+	float t_near = fminf(t1, t2);
+	float t_far = fmaxf(t1, t2);
+
+	t1 = (m_min.y - start.y) * inv_dir.y;
+	t2 = (m_max.y - start.y) * inv_dir.y;
+	t_near = fmaxf(t_near, fminf(t1, t2));
+	t_far = fminf(t_far, fmaxf(t1, t2));
+
+	t1 = (m_min.z - start.z) * inv_dir.z;
+	t2 = (m_max.z - start.z) * inv_dir.z;
+	t_near = fmaxf(t_near, fminf(t1, t2));
+	t_far = fminf(t_far, fmaxf(t1, t2));
+
+	// starting inside the box counts as a hit at t = 0
+	t_near = fmaxf(t_near, 0.f);
+
+	if (t_near > t_far || t_near > max_t)
+		return false;
+
+	t = t_near;
+	return true;
+}
+
+
+AABB3 AABB3::MakeEmpty()
+{
+	return AABB3(Vector3(FLT_MAX), Vector3(-FLT_MAX));
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Engine/Math/Vector3.hpp"
+
+class AABB3
+{
+public:
+	Vector3 m_min;
+	Vector3 m_max;
+
+	~AABB3(){}
+	AABB3(){}
+	explicit AABB3(const Vector3& mins, const Vector3& maxs);
+	explicit AABB3(const Vector3& center, float radiusX, float radiusY, float radiusZ);
+
+	void StretchToIncludePoint(const Vector3& point);
+	void StretchToIncludeBox(const AABB3& box);
+	void AddPadding(const Vector3& padding);
+	void Translate(const Vector3& translation);
+
+	bool IsPointInside(const Vector3& point) const;
+	bool Overlaps(const AABB3& other) const;
+	Vector3 GetDimensions() const;
+	Vector3 GetCenter() const;
+	Vector3 GetHalfExt() const;
+	Vector3 GetClosestPoint(const Vector3& point) const;
+	float GetSurfaceArea() const;
+	float GetDistSquared(const Vector3& point) const;
+
+	// slab test; start is the ray origin, inv_dir the per-axis reciprocal of the ray direction
+	bool RaycastSlab(const Vector3& start, const Vector3& inv_dir, float max_t, float& t) const;
+
+	static AABB3 MakeEmpty();
+};
\ No newline at end of file
@@ -1,15 +1,162 @@
 #include "Engine/Math/CubicSpline.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/MathSIMD.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
 
+#include <algorithm>
 
-CubicSpline2D::CubicSpline2D(const Vector2* positionsArray, int numPoints, const Vector2* velocitiesArray)
+#define CUBIC_SPLINE_BATCH_CHUNK 64		// parameters mapped per pass before a batch evaluation
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Batch kernels
+//
+// Four parameters per pass; each lane has its own 4 control points (in the order their terms are
+// summed by the single forms above) so the results match those bit for bit
+/////////////////////////////////////////////////////////////////////////////////////////////////
+#if MATH_SIMD_SSE
+static inline void HermiteBasis4( __m128 t, __m128* out_basis )
+{
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 two = _mm_set1_ps(2.f);
+	__m128 s = _mm_sub_ps(one, t);
+	__m128 ss = _mm_mul_ps(s, s);
+	__m128 tt = _mm_mul_ps(t, t);
+	out_basis[0] = _mm_mul_ps(ss, _mm_add_ps(one, _mm_mul_ps(two, t)));		// start pos
+	out_basis[1] = _mm_mul_ps(tt, _mm_add_ps(one, _mm_mul_ps(two, s)));		// end pos
+	out_basis[2] = _mm_mul_ps(ss, t);										// start vel
+	out_basis[3] = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(-1.f), s), t), t);	// end vel
+}
+
+
+static inline void BezierBasis4( __m128 t, __m128* out_basis )
+{
+	__m128 three = _mm_set1_ps(3.f);
+	__m128 s = _mm_sub_ps(_mm_set1_ps(1.f), t);
+	out_basis[0] = _mm_mul_ps(_mm_mul_ps(s, s), s);
+	out_basis[1] = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(three, s), s), t);
+	out_basis[2] = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(three, s), t), t);
+	out_basis[3] = _mm_mul_ps(_mm_mul_ps(t, t), t);
+}
+
+
+// terms of all 4 lanes splatted per component, for lanes that share their control points
+static inline void SplatControls( const float* const terms[4], int numFloats, __m128 out_controls[][4] )
+{
+	for (int component = 0; component < numFloats; ++component)
+	{
+		for (int term = 0; term < 4; ++term)
+			out_controls[component][term] = _mm_set1_ps(terms[term][component]);
+	}
+}
+
+
+// terms of each lane gathered per component, for lanes on different curves
+static inline void GatherControls( const float* const laneTerms[4][4], int numFloats, __m128 out_controls[][4] )
+{
+	for (int component = 0; component < numFloats; ++component)
+	{
+		for (int term = 0; term < 4; ++term)
+		{
+			out_controls[component][term] = _mm_setr_ps(laneTerms[0][term][component], laneTerms[1][term][component],
+				laneTerms[2][term][component], laneTerms[3][term][component]);
+		}
+	}
+}
+
+
+// writes 4 consecutive points of numFloats floats each
+static inline void CombineBasis4( const __m128* basis, const __m128 controls[][4], int numFloats, float* out )
+{
+	__m128 sums[4];
+	for (int component = 0; component < numFloats; ++component)
+	{
+		__m128 sum = _mm_mul_ps(controls[component][0], basis[0]);
+		sum = _mm_add_ps(sum, _mm_mul_ps(controls[component][1], basis[1]));
+		sum = _mm_add_ps(sum, _mm_mul_ps(controls[component][2], basis[2]));
+		sums[component] = _mm_add_ps(sum, _mm_mul_ps(controls[component][3], basis[3]));
+	}
+
+	if (numFloats == 2)
+	{
+		_mm_storeu_ps(out, _mm_unpacklo_ps(sums[0], sums[1]));
+		_mm_storeu_ps(out + 4, _mm_unpackhi_ps(sums[0], sums[1]));
+	}
+	else if (numFloats == 3)
+	{
+		__m128 xyLow = _mm_unpacklo_ps(sums[0], sums[1]);		// x0 y0 x1 y1
+		__m128 xyHigh = _mm_unpackhi_ps(sums[0], sums[1]);		// x2 y2 x3 y3
+		_mm_storeu_ps(out, SIMD_SHUFFLE(xyLow, SIMD_SHUFFLE(sums[2], sums[0], 0, 0, 1, 1), 0, 1, 0, 2));
+		_mm_storeu_ps(out + 4, SIMD_SHUFFLE(SIMD_SHUFFLE(sums[1], sums[2], 1, 1, 1, 1), xyHigh, 0, 2, 0, 1));
+		_mm_storeu_ps(out + 8, SIMD_SHUFFLE(SIMD_SHUFFLE(sums[2], xyHigh, 2, 2, 2, 2), SIMD_SHUFFLE(xyHigh, sums[2], 3, 3, 3, 3), 0, 2, 0, 2));
+	}
+	else
+	{
+		MATH_ALIGN16 float lanes[4];
+		for (int component = 0; component < numFloats; ++component)
+		{
+			_mm_store_ps(lanes, sums[component]);
+			for (int lane = 0; lane < 4; ++lane)
+				out[lane * numFloats + component] = lanes[lane];
+		}
+	}
+}
+#endif
+
+
+template< typename T >
+void EvaluateCubicBezier( const T& startPos, const T& guidePos1, const T& guidePos2, const T& endPos, const float* ts, int count, T* out )
+{
+	int idx = 0;
+#if MATH_SIMD_SSE
+	const int numFloats = sizeof(T) / sizeof(float);
+	const float* const terms[4] = { &startPos.x, &guidePos1.x, &guidePos2.x, &endPos.x };
+	__m128 controls[numFloats][4];
+	SplatControls(terms, numFloats, controls);
+	__m128 basis[4];
+	for (; idx + 4 <= count; idx += 4)
+	{
+		BezierBasis4(_mm_loadu_ps(ts + idx), basis);
+		CombineBasis4(basis, controls, numFloats, &out[idx].x);
+	}
+#endif
+
+	for (; idx < count; ++idx)
+		out[idx] = EvaluateCubicBezier(startPos, guidePos1, guidePos2, endPos, ts[idx]);
+}
+
+
+template< typename T >
+void EvaluateCubicHermite( const T& startPos, const T& startVel, const T& endPos, const T& endVel, const float* ts, int count, T* out )
+{
+	int idx = 0;
+#if MATH_SIMD_SSE
+	const int numFloats = sizeof(T) / sizeof(float);
+	const float* const terms[4] = { &startPos.x, &endPos.x, &startVel.x, &endVel.x };
+	__m128 controls[numFloats][4];
+	SplatControls(terms, numFloats, controls);
+	__m128 basis[4];
+	for (; idx + 4 <= count; idx += 4)
+	{
+		HermiteBasis4(_mm_loadu_ps(ts + idx), basis);
+		CombineBasis4(basis, controls, numFloats, &out[idx].x);
+	}
+#endif
+
+	for (; idx < count; ++idx)
+		out[idx] = EvaluateCubicHermite(startPos, startVel, endPos, endVel, ts[idx]);
+}
+
+
+
+template< typename T >
+CubicSpline<T>::CubicSpline(const T* positionsArray, int numPoints, const T* velocitiesArray)
 {
 	if (velocitiesArray != nullptr)
 	{
 		for (int dataCount = 0; dataCount < numPoints; ++dataCount)
 		{
-			Vector2 pos = positionsArray[dataCount];
-			Vector2 vel = velocitiesArray[dataCount];
+			T pos = positionsArray[dataCount];
+			T vel = velocitiesArray[dataCount];
 			m_positions.push_back(pos);
 			m_velocities.push_back(vel);
 		}
@@ -18,8 +165,8 @@ CubicSpline2D::CubicSpline2D(const Vector2* positionsArray, int numPoints, const
 	{
 		for (int dataCount = 0; dataCount < numPoints; ++dataCount)
 		{
-			Vector2 pos = positionsArray[dataCount];
-			Vector2 vel = Vector2(0.f, 0.f);
+			T pos = positionsArray[dataCount];
+			T vel = T::ZERO;
 			m_positions.push_back(pos);
 			m_velocities.push_back(vel);
 		}
@@ -27,21 +174,25 @@ CubicSpline2D::CubicSpline2D(const Vector2* positionsArray, int numPoints, const
 }
 
 
-void	CubicSpline2D::AppendPoint( const Vector2& position, const Vector2& velocity )
+template< typename T >
+void	CubicSpline<T>::AppendPoint( const T& position, const T& velocity )
 {
 	m_positions.push_back(position);
 	m_velocities.push_back(velocity);
+
+	m_arcLengths.clear();
 }
 
 
-void	CubicSpline2D::AppendPoints( const Vector2* positionsArray, int numPoints, const Vector2* velocitiesArray )
+template< typename T >
+void	CubicSpline<T>::AppendPoints( const T* positionsArray, int numPoints, const T* velocitiesArray )
 {
 	if (velocitiesArray != nullptr)
 	{
 		for (int dataCount = 0; dataCount < numPoints; ++dataCount)
 		{
-			Vector2 pos = positionsArray[dataCount];
-			Vector2 vel = velocitiesArray[dataCount];
+			T pos = positionsArray[dataCount];
+			T vel = velocitiesArray[dataCount];
 			m_positions.push_back(pos);
 			m_velocities.push_back(vel);
 		}
@@ -50,62 +201,83 @@ void	CubicSpline2D::AppendPoints( const Vector2* positionsArray, int numPoints,
 	{
 		for (int dataCount = 0; dataCount < numPoints; ++dataCount)
 		{
-			Vector2 pos = positionsArray[dataCount];
-			Vector2 vel = Vector2(0.f, 0.f);
+			T pos = positionsArray[dataCount];
+			T vel = T::ZERO;
 			m_positions.push_back(pos);
 			m_velocities.push_back(vel);
 		}
 	}
+
+	m_arcLengths.clear();
 }
 
 
-void	CubicSpline2D::InsertPoint( int insertBeforeIndex, const Vector2& position, const Vector2& velocity )
+template< typename T >
+void	CubicSpline<T>::InsertPoint( int insertBeforeIndex, const T& position, const T& velocity )
 {
-	std::vector<Vector2>::iterator posIt = m_positions.begin() + insertBeforeIndex;
+	typename std::vector<T>::iterator posIt = m_positions.begin() + insertBeforeIndex;
 	m_positions.insert(posIt, position);
 
-	std::vector<Vector2>::iterator velIt = m_velocities.begin() + insertBeforeIndex;
+	typename std::vector<T>::iterator velIt = m_velocities.begin() + insertBeforeIndex;
 	m_velocities.insert(velIt, velocity);
+
+	m_arcLengths.clear();
 }
 
 
-void	CubicSpline2D::RemovePoint( int pointIndex )
+template< typename T >
+void	CubicSpline<T>::RemovePoint( int pointIndex )
 {
-	std::vector<Vector2>::iterator posIt = m_positions.begin() + pointIndex;
+	typename std::vector<T>::iterator posIt = m_positions.begin() + pointIndex;
 	m_positions.erase(posIt);
 
-	std::vector<Vector2>::iterator velIt = m_velocities.begin() + pointIndex;
+	typename std::vector<T>::iterator velIt = m_velocities.begin() + pointIndex;
 	m_velocities.erase(velIt);
+
+	m_arcLengths.clear();
 }
 
 
-void	CubicSpline2D::RemoveAllPoints()
+template< typename T >
+void	CubicSpline<T>::RemoveAllPoints()
 {
 	m_positions.clear();
 	m_velocities.clear();
+
+	m_arcLengths.clear();
 }
 
 
-void	CubicSpline2D::SetPoint( int pointIndex, const Vector2& newPosition, const Vector2& newVelocity )
+template< typename T >
+void	CubicSpline<T>::SetPoint( int pointIndex, const T& newPosition, const T& newVelocity )
 {
 	m_positions[pointIndex] = newPosition;
 	m_velocities[pointIndex] = newVelocity;
+
+	m_arcLengths.clear();
 }
 
 
-void	CubicSpline2D::SetPosition( int pointIndex, const Vector2& newPosition )
+template< typename T >
+void	CubicSpline<T>::SetPosition( int pointIndex, const T& newPosition )
 {
 	m_positions[pointIndex] = newPosition;
+
+	m_arcLengths.clear();
 }
 
 
-void	CubicSpline2D::SetVelocity( int pointIndex, const Vector2& newVelocity )
+template< typename T >
+void	CubicSpline<T>::SetVelocity( int pointIndex, const T& newVelocity )
 {
 	m_velocities[pointIndex] = newVelocity;
+
+	m_arcLengths.clear();
 }
 
 
-void	CubicSpline2D::SetCardinalVelocities( float tension, const Vector2& startVelocity, const Vector2& endVelocity )
+template< typename T >
+void	CubicSpline<T>::SetCardinalVelocities( float tension, const T& startVelocity, const T& endVelocity )
 {
 	for (size_t dataCount = 0; dataCount < m_velocities.size(); ++dataCount)
 	{
@@ -119,57 +291,283 @@ void	CubicSpline2D::SetCardinalVelocities( float tension, const Vector2& startVe
 		}
 		else
 		{
-			m_velocities[dataCount] = (1 - tension) * (m_positions[dataCount + 1] - m_positions[dataCount - 1]) / 2.f;
+			m_velocities[dataCount] = (m_positions[dataCount + 1] - m_positions[dataCount - 1]) * (1 - tension) / 2.f;
 		}
 	}
+
+	m_arcLengths.clear();
 }
 
 
-const Vector2	CubicSpline2D::GetPosition( int pointIndex )
+template< typename T >
+const T	CubicSpline<T>::GetPosition( int pointIndex )
 {
 	return m_positions[pointIndex];
 }
 
 
-const Vector2	CubicSpline2D::GetVelocity( int pointIndex )
+template< typename T >
+const T	CubicSpline<T>::GetVelocity( int pointIndex )
 {
 	return m_velocities[pointIndex];
 }
 
 
-int				CubicSpline2D::GetPositions( std::vector<Vector2>& out_positions ) const
+template< typename T >
+int				CubicSpline<T>::GetPositions( std::vector<T>& out_positions ) const
 {
 	out_positions = m_positions;
 	return (int) out_positions.size();
 }
 
 
-int				CubicSpline2D::GetVelocities( std::vector<Vector2>& out_velocities ) const 
+template< typename T >
+int				CubicSpline<T>::GetVelocities( std::vector<T>& out_velocities ) const 
 {
 	out_velocities = m_velocities;
 	return (int) out_velocities.size();
 }
 
 
-Vector2			CubicSpline2D::EvaluateAtCumulativeParametric( float t ) const
+template< typename T >
+T			CubicSpline<T>::EvaluateAtCumulativeParametric( float t ) const
 {
-	int startIndex = static_cast<int>(floor(t));
+	int startIndex = ClampInt(static_cast<int>(floor(t)), 0, GetNumPoints() - 2);		// t at the very end stays on the last curve
 	int endIndex = startIndex + 1;
-	Vector2 startPos = m_positions[startIndex];
-	Vector2 startVel = m_velocities[startIndex];
-	Vector2 endPos = m_positions[endIndex];
-	Vector2 endVel = m_velocities[endIndex];
+	T startPos = m_positions[startIndex];
+	T startVel = m_velocities[startIndex];
+	T endPos = m_positions[endIndex];
+	T endVel = m_velocities[endIndex];
 
 	float local_t = t - static_cast<float>(startIndex);
 
-	Vector2 res = EvaluateCubicHermite(startPos, startVel, endPos, endVel, local_t);
+	T res = EvaluateCubicHermite(startPos, startVel, endPos, endVel, local_t);
 	return res;
 }
 
 
-Vector2			CubicSpline2D::EvaluateAtNormalizedParametric( float t ) const
+template< typename T >
+T			CubicSpline<T>::EvaluateAtNormalizedParametric( float t ) const
 {
 	int numCurve = GetNumPoints() - 1;
 	float cumulative_t = RangeMapFloat(t, 0.f, 1.f, 0.f, static_cast<float>(numCurve) * 1.f);
 	return EvaluateAtCumulativeParametric(cumulative_t);
-}
\ No newline at end of file
+}
+
+
+// sorted parameters mostly keep all 4 lanes on one curve, whose control points then stay splatted;
+// lanes on different curves gather theirs
+template< typename T >
+void			CubicSpline<T>::EvaluateAtCumulativeParametric( const float* ts, int count, T* out ) const
+{
+	int idx = 0;
+#if MATH_SIMD_SSE
+	const int numFloats = sizeof(T) / sizeof(float);
+	const __m128i lastCurve = _mm_set1_epi32(GetNumPoints() - 2);
+	MATH_ALIGN16 int curves[4];
+	__m128 controls[numFloats][4];
+	__m128 basis[4];
+	int splatCurve = -1;
+	for (; idx + 4 <= count; idx += 4)
+	{
+		// floor, then clamped to [0, lastCurve] like the single form
+		__m128 t = _mm_loadu_ps(ts + idx);
+		__m128i curve = _mm_cvttps_epi32(t);
+		curve = _mm_add_epi32(curve, _mm_castps_si128(_mm_cmplt_ps(t, _mm_cvtepi32_ps(curve))));
+		curve = _mm_andnot_si128(_mm_cmplt_epi32(curve, _mm_setzero_si128()), curve);
+		__m128i over = _mm_cmpgt_epi32(curve, lastCurve);
+		curve = _mm_or_si128(_mm_andnot_si128(over, curve), _mm_and_si128(over, lastCurve));
+		_mm_store_si128((__m128i*)curves, curve);
+
+		HermiteBasis4(_mm_sub_ps(t, _mm_cvtepi32_ps(curve)), basis);
+
+		if (curves[0] == curves[1] && curves[0] == curves[2] && curves[0] == curves[3])
+		{
+			if (curves[0] != splatCurve)
+			{
+				const float* const terms[4] = { &m_positions[curves[0]].x, &m_positions[curves[0] + 1].x,
+					&m_velocities[curves[0]].x, &m_velocities[curves[0] + 1].x };
+				SplatControls(terms, numFloats, controls);
+				splatCurve = curves[0];
+			}
+		}
+		else
+		{
+			const float* laneTerms[4][4];
+			for (int lane = 0; lane < 4; ++lane)
+			{
+				laneTerms[lane][0] = &m_positions[curves[lane]].x;
+				laneTerms[lane][1] = &m_positions[curves[lane] + 1].x;
+				laneTerms[lane][2] = &m_velocities[curves[lane]].x;
+				laneTerms[lane][3] = &m_velocities[curves[lane] + 1].x;
+			}
+			GatherControls(laneTerms, numFloats, controls);
+			splatCurve = -1;
+		}
+
+		CombineBasis4(basis, controls, numFloats, &out[idx].x);
+	}
+#endif
+
+	for (; idx < count; ++idx)
+		out[idx] = EvaluateAtCumulativeParametric(ts[idx]);
+}
+
+
+template< typename T >
+void			CubicSpline<T>::EvaluateAtNormalizedParametric( const float* ts, int count, T* out ) const
+{
+	float numCurve = static_cast<float>(GetNumPoints() - 1) * 1.f;
+	float cumulative_t[CUBIC_SPLINE_BATCH_CHUNK];
+	for (int start = 0; start < count; start += CUBIC_SPLINE_BATCH_CHUNK)
+	{
+		int chunk = std::min(count - start, CUBIC_SPLINE_BATCH_CHUNK);
+		for (int idx = 0; idx < chunk; ++idx)
+			cumulative_t[idx] = RangeMapFloat(ts[start + idx], 0.f, 1.f, 0.f, numCurve);
+		EvaluateAtCumulativeParametric(cumulative_t, chunk, out + start);
+	}
+}
+
+
+// derivative of the Hermite form in EvaluateAtCumulativeParametric
+template< typename T >
+float			CubicSpline<T>::GetSpeedAtCumulativeParametric( float t ) const
+{
+	int startIndex = ClampInt(static_cast<int>(floor(t)), 0, GetNumPoints() - 2);
+	float local_t = t - static_cast<float>(startIndex);
+	float tt = local_t * local_t;
+
+	float coefStartPos = (6.f * tt) - (6.f * local_t);
+	float coefEndPos = -coefStartPos;
+	float coefStartVel = (3.f * tt) - (4.f * local_t) + 1.f;
+	float coefEndVel = (3.f * tt) - (2.f * local_t);
+
+	T velocity = m_positions[startIndex] * coefStartPos + m_positions[startIndex + 1] * coefEndPos
+		+ m_velocities[startIndex] * coefStartVel + m_velocities[startIndex + 1] * coefEndVel;
+	return velocity.GetLength();
+}
+
+
+// 5 point Gauss-Legendre on the speed, exact for degree 9 polynomials; the speed is smooth over a table step
+template< typename T >
+float			CubicSpline<T>::GetLengthBetweenCumulativeParametrics( float t0, float t1 ) const
+{
+	static const float NODES[5] = { 0.f, -0.5384693101f, 0.5384693101f, -0.9061798459f, 0.9061798459f };
+	static const float WEIGHTS[5] = { 0.5688888889f, 0.4786286705f, 0.4786286705f, 0.2369268851f, 0.2369268851f };
+
+	float half = 0.5f * (t1 - t0);
+	float mid = 0.5f * (t0 + t1);
+	float length = 0.f;
+	for (int node = 0; node < 5; ++node)
+		length += WEIGHTS[node] * GetSpeedAtCumulativeParametric(mid + half * NODES[node]);
+	return length * half;
+}
+
+
+template< typename T >
+void	CubicSpline<T>::BuildArcLengthTable( int samplesPerCurve )
+{
+	ASSERT_OR_DIE(GetNumPoints() >= 2, "arc length needs at least one curve");
+	ASSERT_OR_DIE(samplesPerCurve > 0, "arc length needs at least one sample per curve");
+
+	int numEntries = (GetNumPoints() - 1) * samplesPerCurve + 1;
+	float step = 1.f / static_cast<float>(samplesPerCurve);
+
+	m_arcSamplesPerCurve = samplesPerCurve;
+	m_arcLengths.resize(numEntries);
+	m_arcLengths[0] = 0.f;
+	for (int entry = 1; entry < numEntries; ++entry)
+	{
+		float t0 = static_cast<float>(entry - 1) * step;
+		m_arcLengths[entry] = m_arcLengths[entry - 1] + GetLengthBetweenCumulativeParametrics(t0, t0 + step);
+	}
+}
+
+
+template< typename T >
+float			CubicSpline<T>::GetLength() const
+{
+	ASSERT_OR_DIE(HasArcLengthTable(), "spline changed since BuildArcLengthTable");
+	return m_arcLengths.back();
+}
+
+
+// the table brackets the parameter, then Newton steps on the length integral move it to where the
+// real speed puts it; a step that leaves the bracket (speed near 0 at a cusp) bisects instead
+template< typename T >
+float			CubicSpline<T>::GetCumulativeParametricAtDistance( float distance ) const
+{
+	ASSERT_OR_DIE(HasArcLengthTable(), "spline changed since BuildArcLengthTable");
+
+	std::vector<float>::const_iterator upper = std::upper_bound(m_arcLengths.begin(), m_arcLengths.end(), distance);
+	if (upper == m_arcLengths.begin())
+		return 0.f;
+	if (upper == m_arcLengths.end())
+		return static_cast<float>(m_arcLengths.size() - 1) / static_cast<float>(m_arcSamplesPerCurve);
+
+	int entry = (int)(upper - m_arcLengths.begin()) - 1;
+	float span = m_arcLengths[entry + 1] - m_arcLengths[entry];
+	float fraction = (span > 0.f) ? (distance - m_arcLengths[entry]) / span : 0.f;
+
+	float step = 1.f / static_cast<float>(m_arcSamplesPerCurve);
+	float entryT = static_cast<float>(entry) * step;
+	float low = entryT;
+	float high = entryT + step;
+	float t = entryT + fraction * step;
+	for (int iteration = 0; iteration < CUBIC_SPLINE_ARC_NEWTON_STEPS; ++iteration)
+	{
+		float error = m_arcLengths[entry] + GetLengthBetweenCumulativeParametrics(entryT, t) - distance;
+		if (fabsf(error) <= 0.0001f * span)		// close to float precision on the distance
+			break;
+
+		if (error > 0.f)
+			high = t;
+		else
+			low = t;
+
+		float speed = GetSpeedAtCumulativeParametric(t);
+		float next = (speed > 0.f) ? t - (error / speed) : low;
+		t = (next >= low && next <= high) ? next : 0.5f * (low + high);
+	}
+	return t;
+}
+
+
+template< typename T >
+T			CubicSpline<T>::EvaluateAtDistance( float distance ) const
+{
+	return EvaluateAtCumulativeParametric(GetCumulativeParametricAtDistance(distance));
+}
+
+
+template< typename T >
+T			CubicSpline<T>::EvaluateAtNormalizedDistance( float fraction ) const
+{
+	return EvaluateAtDistance(fraction * GetLength());
+}
+
+
+template< typename T >
+void			CubicSpline<T>::EvaluateAtDistance( const float* distances, int count, T* out ) const
+{
+	float cumulative_t[CUBIC_SPLINE_BATCH_CHUNK];
+	for (int start = 0; start < count; start += CUBIC_SPLINE_BATCH_CHUNK)
+	{
+		int chunk = std::min(count - start, CUBIC_SPLINE_BATCH_CHUNK);
+		for (int idx = 0; idx < chunk; ++idx)
+			cumulative_t[idx] = GetCumulativeParametricAtDistance(distances[start + idx]);
+		EvaluateAtCumulativeParametric(cumulative_t, chunk, out + start);
+	}
+}
+
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Instantiations
+/////////////////////////////////////////////////////////////////////////////////////////////////
+template class CubicSpline<Vector2>;
+template class CubicSpline<Vector3>;
+
+template void EvaluateCubicBezier<Vector2>( const Vector2&, const Vector2&, const Vector2&, const Vector2&, const float*, int, Vector2* );
+template void EvaluateCubicBezier<Vector3>( const Vector3&, const Vector3&, const Vector3&, const Vector3&, const float*, int, Vector3* );
+template void EvaluateCubicHermite<Vector2>( const Vector2&, const Vector2&, const Vector2&, const Vector2&, const float*, int, Vector2* );
+template void EvaluateCubicHermite<Vector3>( const Vector3&, const Vector3&, const Vector3&, const Vector3&, const float*, int, Vector3* );
\ No newline at end of file
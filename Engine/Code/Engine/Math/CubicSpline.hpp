@@ -1,6 +1,10 @@
 #pragma once
 #include <vector>
 #include "Engine/Math/Vector2.hpp"
+#include "Engine/Math/Vector3.hpp"
+
+#define CUBIC_SPLINE_ARC_SAMPLES 64		// arc length table entries per curve
+#define CUBIC_SPLINE_ARC_NEWTON_STEPS 3	// refinements of a distance lookup against the real speed
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 // Standalone curve utility functions
@@ -15,7 +19,7 @@ T EvaluateQuadraticBezier( const T& startPos, const T& actualCurveMidPos, const
 	T lineMidPoint = ((endPos - startPos) / 2.f) + startPos;
 	T lineMidPointToGuideMidPos = (actualCurveMidPos - lineMidPoint) * 2.f;
 	T guideMidPos = lineMidPoint + lineMidPointToGuideMidPos;
-	return (s * s * startPos + 2 * s * t * guideMidPos + t * t * endPos);
+	return (startPos * (s * s) + guideMidPos * (2 * s * t) + endPos * (t * t));
 }
 
 
@@ -23,7 +27,7 @@ template< typename T >
 T EvaluateCubicBezier( const T& startPos, const T& guidePos1, const T& guidePos2, const T& endPos, float t )
 {
 	float s = 1 - t;
-	return (s * s * s * startPos + 3 * s * s * t * guidePos1 + 3 * s * t * t * guidePos2 + t * t * t * endPos);
+	return (startPos * (s * s * s) + guidePos1 * (3 * s * s * t) + guidePos2 * (3 * s * t * t) + endPos * (t * t * t));
 }
 
 
@@ -35,46 +39,76 @@ T EvaluateCubicHermite( const T& startPos, const T& startVel, const T& endPos, c
 	float coefEndPos = t * t * (1 + (2 * s));
 	float coefStartVel = s * s * t;
 	float coefEndVel = (-1.f) * s * t * t;
-	return (coefStartPos * startPos + coefEndPos * endPos + coefStartVel * startVel + coefEndVel * endVel);
+	return (startPos * coefStartPos + endPos * coefEndPos + startVel * coefStartVel + endVel * coefEndVel);
 }
 
 
+// Batch forms: out[i] is the single form at ts[i], the basis runs 4 parameters at a time with SSE
+// (defined for Vector2 and Vector3 in CubicSpline.cpp)
+template< typename T >
+void EvaluateCubicBezier( const T& startPos, const T& guidePos1, const T& guidePos2, const T& endPos, const float* ts, int count, T* out );
+
+template< typename T >
+void EvaluateCubicHermite( const T& startPos, const T& startVel, const T& endPos, const T& endVel, const float* ts, int count, T* out );
+
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
-// CubicSpline2D
+// CubicSpline
 // 
-// Cubic Hermite/Bezier spline of Vector2 positions / velocities
+// Cubic Hermite/Bezier spline of Vector2 or Vector3 positions / velocities
+// The distance functions move at constant speed along the curve: BuildArcLengthTable integrates
+// the speed between table entries, and lookups refine the table guess with Newton steps on the
+// speed itself. Any change to the points drops the table again
 /////////////////////////////////////////////////////////////////////////////////////////////////
-class CubicSpline2D
+template< typename T >
+class CubicSpline
 {
 public:
-	CubicSpline2D() {}
-	explicit CubicSpline2D( const Vector2* positionsArray, int numPoints, const Vector2* velocitiesArray=nullptr );
-	~CubicSpline2D() {}
+	CubicSpline() {}
+	explicit CubicSpline( const T* positionsArray, int numPoints, const T* velocitiesArray=nullptr );
+	~CubicSpline() {}
 
 	// Mutators
-	void		AppendPoint( const Vector2& position, const Vector2& velocity=Vector2::ZERO );
-	void		AppendPoints( const Vector2* positionsArray, int numPoints, const Vector2* velocitiesArray=nullptr );
-	void		InsertPoint( int insertBeforeIndex, const Vector2& position, const Vector2& velocity=Vector2::ZERO );
+	void		AppendPoint( const T& position, const T& velocity=T::ZERO );
+	void		AppendPoints( const T* positionsArray, int numPoints, const T* velocitiesArray=nullptr );
+	void		InsertPoint( int insertBeforeIndex, const T& position, const T& velocity=T::ZERO );
 	void		RemovePoint( int pointIndex );
 	void		RemoveAllPoints();
-	void		SetPoint( int pointIndex, const Vector2& newPosition, const Vector2& newVelocity );
-	void		SetPosition( int pointIndex, const Vector2& newPosition );
-	void		SetVelocity( int pointIndex, const Vector2& newVelocity );
-	void		SetCardinalVelocities( float tension=0.f, const Vector2& startVelocity=Vector2::ZERO, const Vector2& endVelocity=Vector2::ZERO );
+	void		SetPoint( int pointIndex, const T& newPosition, const T& newVelocity );
+	void		SetPosition( int pointIndex, const T& newPosition );
+	void		SetVelocity( int pointIndex, const T& newVelocity );
+	void		SetCardinalVelocities( float tension=0.f, const T& startVelocity=T::ZERO, const T& endVelocity=T::ZERO );
+	void		BuildArcLengthTable( int samplesPerCurve=CUBIC_SPLINE_ARC_SAMPLES );
 
 	// Accessors
 	int				GetNumPoints() const { return (int) m_positions.size(); }
-	const Vector2	GetPosition( int pointIndex );
-	const Vector2	GetVelocity( int pointIndex );
-	int				GetPositions( std::vector<Vector2>& out_positions ) const;
-	int				GetVelocities( std::vector<Vector2>& out_velocities ) const;
-	Vector2			EvaluateAtCumulativeParametric( float t ) const;
-	Vector2			EvaluateAtNormalizedParametric( float t ) const;
+	const T			GetPosition( int pointIndex );
+	const T			GetVelocity( int pointIndex );
+	int				GetPositions( std::vector<T>& out_positions ) const;
+	int				GetVelocities( std::vector<T>& out_velocities ) const;
+	T				EvaluateAtCumulativeParametric( float t ) const;
+	T				EvaluateAtNormalizedParametric( float t ) const;
+	void			EvaluateAtCumulativeParametric( const float* ts, int count, T* out ) const;
+	void			EvaluateAtNormalizedParametric( const float* ts, int count, T* out ) const;
 
-protected:
-	std::vector<Vector2>	m_positions;
-	std::vector<Vector2>	m_velocities;
-};
+	// Arc length (need BuildArcLengthTable)
+	bool			HasArcLengthTable() const { return !m_arcLengths.empty(); }
+	float			GetLength() const;
+	float			GetCumulativeParametricAtDistance( float distance ) const;
+	T				EvaluateAtDistance( float distance ) const;
+	T				EvaluateAtNormalizedDistance( float fraction ) const;
+	void			EvaluateAtDistance( const float* distances, int count, T* out ) const;
 
+protected:
+	float			GetSpeedAtCumulativeParametric( float t ) const;
+	float			GetLengthBetweenCumulativeParametrics( float t0, float t1 ) const;		// accurate over one table step
 
+protected:
+	std::vector<T>		m_positions;
+	std::vector<T>		m_velocities;
+	std::vector<float>	m_arcLengths;				// length up to entry i, which sits at cumulative parametric i / m_arcSamplesPerCurve
+	int					m_arcSamplesPerCurve = 0;
+};
 
+typedef CubicSpline<Vector2> CubicSpline2D;
+typedef CubicSpline<Vector3> CubicSpline3D;
\ No newline at end of file
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "Engine/Math/MathSIMD.hpp"
+
+#include <cmath>
+
+/*
+ * Polynomial approximations for hot loops that can give up the last bits of libm. Sin/cos reduce to
+ * a quarter turn around 0 (whole multiples of 90 degrees come off exactly in the degree forms) and use
+ * the minimax polynomials of the cephes sinf/cosf; atan2 folds into [0, 1] and uses the degree 9
+ * odd minimax polynomial of Abramowitz & Stegun 4.4.49; rsqrt is the hardware estimate plus one
+ * Newton step. Measured worst case over their ranges:
+ *   FastSinCosDegrees		|x| <= 1e5 degrees		9e-8 absolute
+ *   FastSinCos				|x| <= 8192 radians		1e-7 absolute, growing with |x| beyond that
+ *   FastAtan2				any finite (y, x)		1.2e-5 radians (7e-4 degrees)
+ *   FastRsqrt				normal positive x		3e-7 relative (exact 1 / sqrtf without SSE)
+ * The SIMD forms give the same results lane for lane.
+ */
+
+#define FAST_MATH_PI 3.14159265358979323846f
+#define FAST_MATH_HALF_PI 1.57079632679489661923f
+#define FAST_MATH_DEG_TO_RAD 0.0174532925199432958f
+#define FAST_MATH_RAD_TO_DEG 57.2957795130823208768f
+
+// pi/2 in three parts, the first two short enough that quadrant * part is exact (Cody & Waite)
+#define FAST_MATH_HALF_PI_1 1.5703125f
+#define FAST_MATH_HALF_PI_2 4.837512969970703125e-4f
+#define FAST_MATH_HALF_PI_3 7.54978995489188216e-8f
+
+#define FAST_MATH_SIN_C1 -1.6666654611e-1f
+#define FAST_MATH_SIN_C2 8.3321608736e-3f
+#define FAST_MATH_SIN_C3 -1.9515295891e-4f
+#define FAST_MATH_COS_C1 4.166664568298827e-2f
+#define FAST_MATH_COS_C2 -1.388731625493765e-3f
+#define FAST_MATH_COS_C3 2.443315711809948e-5f
+
+#define FAST_MATH_ATAN_C1 0.9998660f
+#define FAST_MATH_ATAN_C3 -0.3302995f
+#define FAST_MATH_ATAN_C5 0.1801410f
+#define FAST_MATH_ATAN_C7 -0.0851330f
+#define FAST_MATH_ATAN_C9 0.0208351f
+
+////////////////////////////////////// Scalar //////////////////////////////////////
+// r in [-pi/4, pi/4], quadrant is how many quarter turns were taken off
+inline void FastSinCosQuadrant(float r, int quadrant, float& outSin, float& outCos)
+{
+	float z = r * r;
+	float sinR = r + ((r * z) * (((FAST_MATH_SIN_C3 * z) + FAST_MATH_SIN_C2) * z + FAST_MATH_SIN_C1));
+	float cosR = (1.f - (0.5f * z)) + ((z * z) * (((FAST_MATH_COS_C3 * z) + FAST_MATH_COS_C2) * z + FAST_MATH_COS_C1));
+
+	switch (quadrant & 3)
+	{
+	case 0: outSin = sinR;	outCos = cosR;	break;
+	case 1: outSin = cosR;	outCos = -sinR;	break;
+	case 2: outSin = -sinR;	outCos = -cosR;	break;
+	default: outSin = -cosR; outCos = sinR;	break;
+	}
+}
+
+inline int FastRoundToInt(float value)
+{
+	return (int)(value + ((value >= 0.f) ? 0.5f : -0.5f));
+}
+
+inline void FastSinCos(float radians, float& outSin, float& outCos)
+{
+	int quadrant = FastRoundToInt(radians * (1.f / FAST_MATH_HALF_PI));
+	float q = (float)quadrant;
+	float r = ((radians - (q * FAST_MATH_HALF_PI_1)) - (q * FAST_MATH_HALF_PI_2)) - (q * FAST_MATH_HALF_PI_3);
+	FastSinCosQuadrant(r, quadrant, outSin, outCos);
+}
+
+inline void FastSinCosDegrees(float degrees, float& outSin, float& outCos)
+{
+	int quadrant = FastRoundToInt(degrees * (1.f / 90.f));
+	float r = (degrees - ((float)quadrant * 90.f)) * FAST_MATH_DEG_TO_RAD;
+	FastSinCosQuadrant(r, quadrant, outSin, outCos);
+}
+
+inline float FastSin(float radians)				{ float s, c; FastSinCos(radians, s, c); return s; }
+inline float FastCos(float radians)				{ float s, c; FastSinCos(radians, s, c); return c; }
+inline float FastSinDegrees(float degrees)		{ float s, c; FastSinCosDegrees(degrees, s, c); return s; }
+inline float FastCosDegrees(float degrees)		{ float s, c; FastSinCosDegrees(degrees, s, c); return c; }
+
+inline float FastAtan2(float y, float x)
+{
+	float absY = fabsf(y);
+	float absX = fabsf(x);
+	float high = (absY > absX) ? absY : absX;
+	float low = (absY > absX) ? absX : absY;
+	if (high == 0.f)
+		return 0.f;
+
+	float t = low / high;
+	float z = t * t;
+	float angle = t * ((((((((FAST_MATH_ATAN_C9 * z) + FAST_MATH_ATAN_C7) * z) + FAST_MATH_ATAN_C5) * z) + FAST_MATH_ATAN_C3) * z) + FAST_MATH_ATAN_C1);
+	if (absY > absX)
+		angle = FAST_MATH_HALF_PI - angle;
+	if (x < 0.f)
+		angle = FAST_MATH_PI - angle;
+	return std::signbit(y) ? -angle : angle;		// -0 counts as below, like atan2
+}
+
+inline float FastAtan2Degrees(float y, float x)
+{
+	return FastAtan2(y, x) * FAST_MATH_RAD_TO_DEG;
+}
+
+inline float FastRsqrt(float value)
+{
+#if MATH_SIMD_SSE
+	__m128 x = _mm_set_ss(value);
+	__m128 estimate = _mm_rsqrt_ss(x);
+	__m128 halfXEE = _mm_mul_ss(_mm_mul_ss(_mm_mul_ss(_mm_set_ss(0.5f), x), estimate), estimate);
+	return _mm_cvtss_f32(_mm_mul_ss(estimate, _mm_sub_ss(_mm_set_ss(1.5f), halfXEE)));
+#else
+	return 1.f / sqrtf(value);
+#endif
+}
+
+// same layout as PolarToCartesian( radius, rotationDeg, azimuthDeg )
+inline void FastPolarToCartesian(float radius, float rotationDeg, float azimuthDeg, float& outX, float& outY, float& outZ)
+{
+	float sinRot, cosRot, sinAzi, cosAzi;
+	FastSinCosDegrees(rotationDeg, sinRot, cosRot);
+	FastSinCosDegrees(azimuthDeg, sinAzi, cosAzi);
+	outX = radius * sinAzi * cosRot;
+	outY = radius * cosAzi;
+	outZ = radius * sinAzi * sinRot;
+}
+
+////////////////////////////////////// SIMD //////////////////////////////////////
+#if MATH_SIMD_SSE
+	inline void SIMDFastSinCosQuadrant4(__m128 r, __m128i quadrant, __m128* outSin, __m128* outCos)
+	{
+		__m128 z = _mm_mul_ps(r, r);
+		__m128 sinPoly = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(FAST_MATH_SIN_C3), z), _mm_set1_ps(FAST_MATH_SIN_C2)), z), _mm_set1_ps(FAST_MATH_SIN_C1));
+		__m128 sinR = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, z), sinPoly));
+		__m128 cosPoly = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(FAST_MATH_COS_C3), z), _mm_set1_ps(FAST_MATH_COS_C2)), z), _mm_set1_ps(FAST_MATH_COS_C1));
+		__m128 cosR = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.f), _mm_mul_ps(_mm_set1_ps(0.5f), z)), _mm_mul_ps(_mm_mul_ps(z, z), cosPoly));
+
+		// odd quadrants swap sin and cos, then the signs follow the quadrant bits
+		__m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+		__m128 sinOut = _mm_or_ps(_mm_andnot_ps(swap, sinR), _mm_and_ps(swap, cosR));
+		__m128 cosOut = _mm_or_ps(_mm_andnot_ps(swap, cosR), _mm_and_ps(swap, sinR));
+		__m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+		__m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+		*outSin = _mm_xor_ps(sinOut, sinSign);
+		*outCos = _mm_xor_ps(cosOut, cosSign);
+	}
+
+	// rounds half away from zero like FastRoundToInt
+	inline __m128i SIMDFastRoundToInt4(__m128 value)
+	{
+		__m128 half = _mm_or_ps(_mm_set1_ps(0.5f), _mm_and_ps(value, _mm_set1_ps(-0.f)));
+		return _mm_cvttps_epi32(_mm_add_ps(value, half));
+	}
+
+	inline void SIMDFastSinCos4(__m128 radians, __m128* outSin, __m128* outCos)
+	{
+		__m128i quadrant = SIMDFastRoundToInt4(_mm_mul_ps(radians, _mm_set1_ps(1.f / FAST_MATH_HALF_PI)));
+		__m128 q = _mm_cvtepi32_ps(quadrant);
+		__m128 r = _mm_sub_ps(radians, _mm_mul_ps(q, _mm_set1_ps(FAST_MATH_HALF_PI_1)));
+		r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(FAST_MATH_HALF_PI_2)));
+		r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(FAST_MATH_HALF_PI_3)));
+		SIMDFastSinCosQuadrant4(r, quadrant, outSin, outCos);
+	}
+
+	inline void SIMDFastSinCosDegrees4(__m128 degrees, __m128* outSin, __m128* outCos)
+	{
+		__m128i quadrant = SIMDFastRoundToInt4(_mm_mul_ps(degrees, _mm_set1_ps(1.f / 90.f)));
+		__m128 r = _mm_sub_ps(degrees, _mm_mul_ps(_mm_cvtepi32_ps(quadrant), _mm_set1_ps(90.f)));
+		SIMDFastSinCosQuadrant4(_mm_mul_ps(r, _mm_set1_ps(FAST_MATH_DEG_TO_RAD)), quadrant, outSin, outCos);
+	}
+
+	inline __m128 SIMDFastAtan2_4(__m128 y, __m128 x)
+	{
+		__m128 signBit = _mm_set1_ps(-0.f);
+		__m128 absY = _mm_andnot_ps(signBit, y);
+		__m128 absX = _mm_andnot_ps(signBit, x);
+		__m128 steep = _mm_cmpgt_ps(absY, absX);
+		__m128 high = _mm_max_ps(absY, absX);
+		__m128 low = _mm_min_ps(absY, absX);
+		__m128 nonZero = _mm_cmpneq_ps(high, _mm_setzero_ps());
+
+		__m128 t = _mm_div_ps(low, _mm_or_ps(_mm_and_ps(nonZero, high), _mm_andnot_ps(nonZero, _mm_set1_ps(1.f))));
+		__m128 z = _mm_mul_ps(t, t);
+		__m128 poly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(FAST_MATH_ATAN_C9), z), _mm_set1_ps(FAST_MATH_ATAN_C7));
+		poly = _mm_add_ps(_mm_mul_ps(poly, z), _mm_set1_ps(FAST_MATH_ATAN_C5));
+		poly = _mm_add_ps(_mm_mul_ps(poly, z), _mm_set1_ps(FAST_MATH_ATAN_C3));
+		poly = _mm_add_ps(_mm_mul_ps(poly, z), _mm_set1_ps(FAST_MATH_ATAN_C1));
+		__m128 angle = _mm_mul_ps(t, poly);
+
+		angle = _mm_or_ps(_mm_andnot_ps(steep, angle), _mm_and_ps(steep, _mm_sub_ps(_mm_set1_ps(FAST_MATH_HALF_PI), angle)));
+		__m128 behind = _mm_cmplt_ps(x, _mm_setzero_ps());
+		angle = _mm_or_ps(_mm_andnot_ps(behind, angle), _mm_and_ps(behind, _mm_sub_ps(_mm_set1_ps(FAST_MATH_PI), angle)));
+		return _mm_and_ps(nonZero, _mm_xor_ps(angle, _mm_and_ps(y, signBit)));
+	}
+
+	inline __m128 SIMDFastRsqrt4(__m128 x)
+	{
+		__m128 estimate = _mm_rsqrt_ps(x);
+		__m128 halfXEE = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), estimate), estimate);
+		return _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(1.5f), halfXEE));
+	}
+#endif
\ No newline at end of file
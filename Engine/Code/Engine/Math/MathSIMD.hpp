@@ -0,0 +1,238 @@
+#pragma once
+
+/*
+ * SIMD kernels behind the math types. Every kernel works on plain float arrays
+ * (a Vector4, a quaternion as real then imaginary, a Matrix44 as its 16 column major floats)
+ * and has a scalar path that gives the same results, so callers never see which one is used.
+ * Define ENGINE_MATH_SCALAR to force the scalar path. The engine builds for SSE2, so the __AVX__ paths
+ * (TransformBatch, CollisionQuery) are compiled out; RawNoiseBatchAVX2.cpp is the one file built with
+ * /arch:AVX2 and is only called once cpuid reports AVX2.
+ */
+
+#if !defined(ENGINE_MATH_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define MATH_SIMD_SSE 1
+	#include <xmmintrin.h>
+	#include <emmintrin.h>
+#else
+	#define MATH_SIMD_SSE 0
+#endif
+
+// x86 msvc can not pass over aligned types by value, only align where it is free
+#if defined(_M_IX86)
+	#define MATH_ALIGN16
+#else
+	#define MATH_ALIGN16 alignas(16)
+#endif
+
+#if MATH_SIMD_SSE
+	// lanes picked from a (x, y) then b (z, w)
+	#define SIMD_SHUFFLE(a, b, x, y, z, w) _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x))
+	#define SIMD_SWIZZLE(v, x, y, z, w) SIMD_SHUFFLE(v, v, x, y, z, w)
+
+	// 2x2 blocks stored as (m00, m01, m10, m11)
+	inline __m128 SIMDMat2Mul(__m128 a, __m128 b)
+	{
+		return _mm_add_ps(_mm_mul_ps(a, SIMD_SWIZZLE(b, 0, 3, 0, 3)),
+			_mm_mul_ps(SIMD_SWIZZLE(a, 1, 0, 3, 2), SIMD_SWIZZLE(b, 2, 1, 2, 1)));
+	}
+
+	// adj(a) * b
+	inline __m128 SIMDMat2AdjMul(__m128 a, __m128 b)
+	{
+		return _mm_sub_ps(_mm_mul_ps(SIMD_SWIZZLE(a, 3, 3, 0, 0), b),
+			_mm_mul_ps(SIMD_SWIZZLE(a, 1, 1, 2, 2), SIMD_SWIZZLE(b, 2, 3, 0, 1)));
+	}
+
+	// a * adj(b)
+	inline __m128 SIMDMat2MulAdj(__m128 a, __m128 b)
+	{
+		return _mm_sub_ps(_mm_mul_ps(a, SIMD_SWIZZLE(b, 3, 0, 3, 0)),
+			_mm_mul_ps(SIMD_SWIZZLE(a, 1, 0, 3, 2), SIMD_SWIZZLE(b, 2, 1, 2, 1)));
+	}
+#endif
+
+////////////////////////////////////// Vector4 //////////////////////////////////////
+inline void SIMDVec4Add(const float* a, const float* b, float* out)
+{
+#if MATH_SIMD_SSE
+	_mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#else
+	out[0] = a[0] + b[0]; out[1] = a[1] + b[1]; out[2] = a[2] + b[2]; out[3] = a[3] + b[3];
+#endif
+}
+
+inline void SIMDVec4Sub(const float* a, const float* b, float* out)
+{
+#if MATH_SIMD_SSE
+	_mm_storeu_ps(out, _mm_sub_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)));
+#else
+	out[0] = a[0] - b[0]; out[1] = a[1] - b[1]; out[2] = a[2] - b[2]; out[3] = a[3] - b[3];
+#endif
+}
+
+inline void SIMDVec4Scale(const float* a, float s, float* out)
+{
+#if MATH_SIMD_SSE
+	_mm_storeu_ps(out, _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(s)));
+#else
+	out[0] = a[0] * s; out[1] = a[1] * s; out[2] = a[2] * s; out[3] = a[3] * s;
+#endif
+}
+
+////////////////////////////////////// Matrix44 //////////////////////////////////////
+// out = m * v, m column major
+inline void SIMDMat44MulVec4(const float* m, const float* v, float* out)
+{
+#if MATH_SIMD_SSE
+	__m128 res = _mm_mul_ps(_mm_loadu_ps(m), _mm_set1_ps(v[0]));
+	res = _mm_add_ps(res, _mm_mul_ps(_mm_loadu_ps(m + 4), _mm_set1_ps(v[1])));
+	res = _mm_add_ps(res, _mm_mul_ps(_mm_loadu_ps(m + 8), _mm_set1_ps(v[2])));
+	res = _mm_add_ps(res, _mm_mul_ps(_mm_loadu_ps(m + 12), _mm_set1_ps(v[3])));
+	_mm_storeu_ps(out, res);
+#else
+	float x = v[0], y = v[1], z = v[2], w = v[3];
+	for (int row = 0; row < 4; ++row)
+		out[row] = m[row] * x + m[row + 4] * y + m[row + 8] * z + m[row + 12] * w;
+#endif
+}
+
+// out = a * b, out may alias either side
+inline void SIMDMat44Mul(const float* a, const float* b, float* out)
+{
+#if MATH_SIMD_SSE
+	__m128 i = _mm_loadu_ps(a);
+	__m128 j = _mm_loadu_ps(a + 4);
+	__m128 k = _mm_loadu_ps(a + 8);
+	__m128 t = _mm_loadu_ps(a + 12);
+
+	__m128 res[4];
+	for (int col = 0; col < 4; ++col)
+	{
+		const float* c = b + col * 4;
+		res[col] = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(i, _mm_set1_ps(c[0])), _mm_mul_ps(j, _mm_set1_ps(c[1]))),
+			_mm_add_ps(_mm_mul_ps(k, _mm_set1_ps(c[2])), _mm_mul_ps(t, _mm_set1_ps(c[3]))));
+	}
+
+	_mm_storeu_ps(out, res[0]);
+	_mm_storeu_ps(out + 4, res[1]);
+	_mm_storeu_ps(out + 8, res[2]);
+	_mm_storeu_ps(out + 12, res[3]);
+#else
+	float res[16];
+	for (int col = 0; col < 4; ++col)
+	{
+		const float* c = b + col * 4;
+		for (int row = 0; row < 4; ++row)
+			res[col * 4 + row] = a[row] * c[0] + a[row + 4] * c[1] + a[row + 8] * c[2] + a[row + 12] * c[3];
+	}
+	for (int idx = 0; idx < 16; ++idx)
+		out[idx] = res[idx];
+#endif
+}
+
+// general inverse, returns the determinant; out is left untouched when it is 0
+inline float SIMDMat44Inverse(const float* m, float* out)
+{
+#if MATH_SIMD_SSE
+	// 2x2 block method; inverse(transpose) is transpose(inverse) so the storage order does not matter
+	__m128 c0 = _mm_loadu_ps(m);
+	__m128 c1 = _mm_loadu_ps(m + 4);
+	__m128 c2 = _mm_loadu_ps(m + 8);
+	__m128 c3 = _mm_loadu_ps(m + 12);
+
+	__m128 A = _mm_movelh_ps(c0, c1);
+	__m128 B = _mm_movehl_ps(c1, c0);
+	__m128 C = _mm_movelh_ps(c2, c3);
+	__m128 D = _mm_movehl_ps(c3, c2);
+
+	// (|A|, |B|, |C|, |D|)
+	__m128 det_sub = _mm_sub_ps(
+		_mm_mul_ps(SIMD_SHUFFLE(c0, c2, 0, 2, 0, 2), SIMD_SHUFFLE(c1, c3, 1, 3, 1, 3)),
+		_mm_mul_ps(SIMD_SHUFFLE(c0, c2, 1, 3, 1, 3), SIMD_SHUFFLE(c1, c3, 0, 2, 0, 2)));
+	__m128 det_A = SIMD_SWIZZLE(det_sub, 0, 0, 0, 0);
+	__m128 det_B = SIMD_SWIZZLE(det_sub, 1, 1, 1, 1);
+	__m128 det_C = SIMD_SWIZZLE(det_sub, 2, 2, 2, 2);
+	__m128 det_D = SIMD_SWIZZLE(det_sub, 3, 3, 3, 3);
+
+	__m128 D_C = SIMDMat2AdjMul(D, C);
+	__m128 A_B = SIMDMat2AdjMul(A, B);
+
+	__m128 X = _mm_sub_ps(_mm_mul_ps(det_D, A), SIMDMat2Mul(B, D_C));
+	__m128 W = _mm_sub_ps(_mm_mul_ps(det_A, D), SIMDMat2Mul(C, A_B));
+	__m128 Y = _mm_sub_ps(_mm_mul_ps(det_B, C), SIMDMat2MulAdj(D, A_B));
+	__m128 Z = _mm_sub_ps(_mm_mul_ps(det_C, B), SIMDMat2MulAdj(A, D_C));
+
+	// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+	__m128 tr = _mm_mul_ps(A_B, SIMD_SWIZZLE(D_C, 0, 2, 1, 3));
+	tr = _mm_add_ps(tr, SIMD_SWIZZLE(tr, 1, 0, 3, 2));
+	tr = _mm_add_ps(tr, SIMD_SWIZZLE(tr, 2, 3, 0, 1));
+	__m128 det_M = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_A, det_D), _mm_mul_ps(det_B, det_C)), tr);
+
+	float det = _mm_cvtss_f32(det_M);
+	if (det == 0.f)
+		return 0.f;
+
+	__m128 r_det = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), det_M);
+	X = _mm_mul_ps(X, r_det);
+	Y = _mm_mul_ps(Y, r_det);
+	Z = _mm_mul_ps(Z, r_det);
+	W = _mm_mul_ps(W, r_det);
+
+	// adjugate of each block folded into the store
+	_mm_storeu_ps(out, SIMD_SHUFFLE(X, Y, 3, 1, 3, 1));
+	_mm_storeu_ps(out + 4, SIMD_SHUFFLE(X, Y, 2, 0, 2, 0));
+	_mm_storeu_ps(out + 8, SIMD_SHUFFLE(Z, W, 3, 1, 3, 1));
+	_mm_storeu_ps(out + 12, SIMD_SHUFFLE(Z, W, 2, 0, 2, 0));
+	return det;
+#else
+	float inv[16];
+
+	inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+	inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+	inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+	inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+	inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+	inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+	inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+	inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+	inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+	inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+	inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+	inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+	inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+	inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+	inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+	inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+	float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+	if (det == 0.f)
+		return 0.f;
+
+	float inv_det = 1.f / det;
+	for (int idx = 0; idx < 16; ++idx)
+		out[idx] = inv[idx] * inv_det;
+	return det;
+#endif
+}
+
+////////////////////////////////////// Quaternion //////////////////////////////////////
+// (real, i, j, k) layout, out = a * b
+inline void SIMDQuatMul(const float* a, const float* b, float* out)
+{
+#if MATH_SIMD_SSE
+	__m128 q = _mm_loadu_ps(b);
+
+	__m128 res = _mm_mul_ps(_mm_set1_ps(a[0]), q);
+	res = _mm_add_ps(res, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(a[1]), SIMD_SWIZZLE(q, 1, 0, 3, 2)), _mm_setr_ps(-1.f, 1.f, -1.f, 1.f)));
+	res = _mm_add_ps(res, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(a[2]), SIMD_SWIZZLE(q, 2, 3, 0, 1)), _mm_setr_ps(-1.f, 1.f, 1.f, -1.f)));
+	res = _mm_add_ps(res, _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(a[3]), SIMD_SWIZZLE(q, 3, 2, 1, 0)), _mm_setr_ps(-1.f, -1.f, 1.f, 1.f)));
+	_mm_storeu_ps(out, res);
+#else
+	float w = a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3];
+	float x = a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2];
+	float y = a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1];
+	float z = a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0];
+	out[0] = w; out[1] = x; out[2] = y; out[3] = z;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#define MATH_TABLE_SIN_SIZE 1024		// samples over a full turn
+#define MATH_TABLE_EASE_SIZE 256		// samples over [0, 1]
+
+/*
+ * Lookup tables generated by the compiler, so nothing is filled in at startup.
+ * Lookups lerp between samples: sin is good to about 5e-6, the easing tables to about 1e-5.
+ */
+
+template <uint N>
+struct sMathTable
+{
+	float m_values[N + 1];		// one extra sample so the last interval lerps without wrapping
+
+	constexpr float operator[](uint idx) const { return m_values[idx]; }
+};
+
+// only for generating tables: folded into [0, pi/2] then a series that is exact to float precision
+constexpr double ConstSin(double radians)
+{
+	constexpr double pi = 3.14159265358979323846;
+
+	while (radians < 0.0)
+		radians += 2.0 * pi;
+	while (radians >= 2.0 * pi)
+		radians -= 2.0 * pi;
+
+	double sign = 1.0;
+	if (radians > pi)
+	{
+		radians -= pi;
+		sign = -1.0;
+	}
+	if (radians > .5 * pi)
+		radians = pi - radians;
+
+	double sqr = radians * radians;
+	double term = radians;
+	double sum = radians;
+	for (int n = 1; n < 9; ++n)
+	{
+		term *= -sqr / (double)((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+	return sign * sum;
+}
+
+constexpr sMathTable<MATH_TABLE_SIN_SIZE> MakeSinTable()
+{
+	sMathTable<MATH_TABLE_SIN_SIZE> table = {};
+	for (uint idx = 0; idx <= MATH_TABLE_SIN_SIZE; ++idx)
+		table.m_values[idx] = (float)ConstSin(6.28318530717958647692 * (double)idx / (double)MATH_TABLE_SIN_SIZE);
+	return table;
+}
+
+constexpr sMathTable<MATH_TABLE_EASE_SIZE> MakeSmoothStep3Table()
+{
+	sMathTable<MATH_TABLE_EASE_SIZE> table = {};
+	for (uint idx = 0; idx <= MATH_TABLE_EASE_SIZE; ++idx)
+		table.m_values[idx] = SmoothStep3((float)idx / (float)MATH_TABLE_EASE_SIZE);
+	return table;
+}
+
+inline constexpr sMathTable<MATH_TABLE_SIN_SIZE> SIN_TABLE = MakeSinTable();
+inline constexpr sMathTable<MATH_TABLE_EASE_SIZE> SMOOTHSTEP3_TABLE = MakeSmoothStep3Table();
+
+////////////////////////////////////// Lookup //////////////////////////////////////
+template <uint N>
+inline float SampleMathTable(const sMathTable<N>& table, float pos)
+{
+	// pos is in samples, already in [0, N]
+	uint idx = (uint)pos;
+	if (idx >= N)
+		idx = N - 1;
+	float frac = pos - (float)idx;
+	return table.m_values[idx] + (table.m_values[idx + 1] - table.m_values[idx]) * frac;
+}
+
+inline float SinDegreesTable(float degrees)
+{
+	float turns = degrees * (1.f / 360.f);
+	turns -= floorf(turns);
+	return SampleMathTable(SIN_TABLE, turns * (float)MATH_TABLE_SIN_SIZE);
+}
+
+inline float CosDegreesTable(float degrees)
+{
+	return SinDegreesTable(degrees + 90.f);
+}
+
+inline float SmoothStep3Table(float t)
+{
+	t = (t < 0.f) ? 0.f : ((t > 1.f) ? 1.f : t);
+	return SampleMathTable(SMOOTHSTEP3_TABLE, t * (float)MATH_TABLE_EASE_SIZE);
+}
\ No newline at end of file
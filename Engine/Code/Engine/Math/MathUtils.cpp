@@ -1,17 +1,8 @@
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Random.hpp"
 #include "Engine/Core/Transform.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 
-float ConvertDegreesToRadians(float degrees)
-{
-	return degrees * (PI / 180.f);
-}
-
-float ConvertRadiansToDegrees(float radians)
-{
-	return radians * (180.f / PI);
-}
-
 float CosDegrees(float degrees)
 {
 	return cosf(ConvertDegreesToRadians(degrees));
@@ -22,40 +13,35 @@ float SinDegrees(float degrees)
 	return sinf(ConvertDegreesToRadians(degrees));
 }
 
+// all of these draw from the calling thread's generator, see Random.hpp
 float GetRandomFloatInRange(float minInclusive, float maxInclusive)
 {
-	return (GetRandomFloatZeroToOne() * (maxInclusive - minInclusive)) + minInclusive;
+	return GetThreadRandom().NextFloatInRange(minInclusive, maxInclusive);
 }
 
 float GetRandomFloatZeroToOne()
 {
-	return static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+	return GetThreadRandom().NextFloatZeroToOne();
 }
 
 int GetRandomIntInRange(int minInclusive, int maxInclusive)
 {
-	return GetRandomIntLessThan(maxInclusive - minInclusive + 1) + minInclusive;
+	return GetThreadRandom().NextIntInRange(minInclusive, maxInclusive);
 }
 
 int GetRandomIntLessThan(int maxNotInclusive)
 {
-	return rand() % maxNotInclusive;
+	return GetThreadRandom().NextIntLessThan(maxNotInclusive);
 }
 
 Vector3 GetRandomVector3(const Vector3& v1, const Vector3& v2)
 {
-	float rand_x = GetRandomFloatInRange(v1.x, v2.x);
-	float rand_y = GetRandomFloatInRange(v1.y, v2.y);
-	float rand_z = GetRandomFloatInRange(v1.z, v2.z);
-	return Vector3(rand_x, rand_y, rand_z);
+	return GetThreadRandom().NextVector3InRange(v1, v2);
 }
 
 Vector3 GetRandomVector3()
 {
-	float rand_x = GetRandomFloatInRange(-1.f, 1.f);
-	float rand_y = GetRandomFloatInRange(-1.f, 1.f);
-	float rand_z = GetRandomFloatInRange(-1.f, 1.f);
-	Vector3 res = Vector3(rand_x, rand_y, rand_z);
+	Vector3 res = GetThreadRandom().NextVector3InRange(Vector3(-1.f), Vector3(1.f));
 	return res.GetNormalized();
 }
 
@@ -131,14 +117,7 @@ float ClampZeroToFloat(float valueClampTo, float value)
 
 bool CheckRandomChance( float chanceForSuccess )
 {
-	float random = GetRandomFloatInRange(0.0f, 1.0f);
-
-	if (random <= chanceForSuccess)
-	{
-		return true;
-	}
-
-	return false;
+	return GetThreadRandom().NextChance(chanceForSuccess);
 }
 
 float GetAngularDisplacement( float startDegrees, float endDegrees )
@@ -228,11 +207,6 @@ float DotProduct( const Vector2& a, const Vector2& b )
 	return (a.x * b.x) + (a.y * b.y);
 }
 
-float DotProduct( const Vector3& a, const Vector3& b )
-{
-	return (a.x * b.x) + (a.y * b.y) + (a.z * b.z);
-}
-
 float DotProduct( const Vector4& a, const Vector4& b )
 {
 	return (a.x * b.x) + (a.y * b.y) + (a.z * b.z) + (a.w * b.w);
@@ -524,41 +498,6 @@ uint16_t BufferSizeHardCode16(std::string str)
 	return code;
 }
 
-float	SmoothStart2( float t )
-{
-	return t * t;
-}
-
-float	SmoothStart3( float t )
-{
-	return t * t * t;
-}
-
-float	SmoothStart4( float t )
-{
-	return t * t * t * t;
-}
-
-float	SmoothStop2( float t )
-{
-	return 1 - ((1 - t) * (1 - t));
-}
-
-float	SmoothStop3( float t )
-{
-	return 1 - ((1 - t) * (1 - t) * (1 - t));
-}
-
-float	SmoothStop4( float t )
-{
-	return 1 - ((1 - t) * (1 - t) * (1 - t) * (1 - t));
-}
-
-float	SmoothStep3( float t )
-{
-	return SmoothStart2(t) + t * (SmoothStop2(t) - SmoothStart2(t));
-}
-
 float Interpolate( float start, float end, float fractionTowardEnd )
 {
 	return (start + ((end - start) * fractionTowardEnd));
@@ -1104,6 +1043,12 @@ float DistPointToPlaneUnsigned(const Vector3& pt, const Vector3& vert1, const Ve
 	return abs(DistPointToPlaneSigned(pt, vert1, vert2, vert3));
 }
 
+Matrix33 GetOuterProduct(const Vector3& a, const Vector3& b)
+{
+	// column-basis, column n is a scaled by the n-th component of b
+	return Matrix33(a * b.x, a * b.y, a * b.z);
+}
+
 Matrix33 GetCanonicalTetrahedronCovariance()
 {
 	float a = 1.f / 60.f;
@@ -1128,14 +1073,14 @@ Matrix33 GetInertiaTensorFromCovariance(const Matrix33& cov)
 
 Matrix33 TranslateCovariance(const Matrix33& cov, const Vector3& com, const float& mass, const Vector3& offset)
 {
-	float dot1 = DotProduct(offset, com);
-	float dot2 = DotProduct(com, offset);
-	float dot3 = DotProduct(offset, offset);
+	// C' = C + m * (d * c^T + c * d^T + d * d^T), these are outer products not dot products
+	Matrix33 shift = GetOuterProduct(offset, com) + GetOuterProduct(com, offset) + GetOuterProduct(offset, offset);
+	shift *= mass;
 
-	return (cov + mass * (dot1 + dot2 + dot3));
+	return (cov + shift);
 }
 
 bool AreFloatsCloseEnough(const float& f1, const float& f2)
 {	
 	return (abs(f1 - f2) < 0.01f);
-}
+}
\ No newline at end of file
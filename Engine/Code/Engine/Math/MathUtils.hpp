@@ -15,8 +15,8 @@
 #define SLERP_ANGLE_THRESHOLD 0.05f
 
 // radians and degree 
-float ConvertRadiansToDegrees(float radians);
-float ConvertDegreesToRadians(float degrees);
+constexpr float ConvertRadiansToDegrees(float radians);
+constexpr float ConvertDegreesToRadians(float degrees);
 float CosDegrees(float degrees);
 float SinDegrees(float degrees);
 
@@ -50,7 +50,7 @@ float RoundToNearest05(float inValue);
 float GetAngularDisplacement( float startDegrees, float endDegrees );
 float TurnToward( float currentDegrees, float goalDegrees, float maxTurnDegrees );
 float DotProduct( const Vector2& a, const Vector2& b );
-float DotProduct( const Vector3& a, const Vector3& b );
+constexpr float DotProduct( const Vector3& a, const Vector3& b );
 float DotProduct( const Vector4& a, const Vector4& b );
 
 // bitflag utilities
@@ -71,13 +71,13 @@ std::vector<uint8_t> BinaryFromDecimal16(size_t decimal);
 uint16_t BufferSizeHardCode16(std::string str);
 
 // easing function
-float	SmoothStart2( float t ); // 2nd-degree smooth start (a.k.a. �quadratic ease in�)
-float	SmoothStart3( float t ); // 3rd-degree smooth start (a.k.a. �cubic ease in�)
-float	SmoothStart4( float t ); // 4th-degree smooth start (a.k.a. �quartic ease in�)
-float	SmoothStop2( float t ); // 2nd-degree smooth start (a.k.a. �quadratic ease out�)
-float	SmoothStop3( float t ); // 3rd-degree smooth start (a.k.a. �cubic ease out�)
-float	SmoothStop4( float t ); // 4th-degree smooth start (a.k.a. �quartic ease out�)
-float	SmoothStep3( float t ); // 3rd-degree smooth start/stop (a.k.a. �smoothstep�)
+constexpr float	SmoothStart2( float t ); // 2nd-degree smooth start (a.k.a. �quadratic ease in�)
+constexpr float	SmoothStart3( float t ); // 3rd-degree smooth start (a.k.a. �cubic ease in�)
+constexpr float	SmoothStart4( float t ); // 4th-degree smooth start (a.k.a. �quartic ease in�)
+constexpr float	SmoothStop2( float t ); // 2nd-degree smooth start (a.k.a. �quadratic ease out�)
+constexpr float	SmoothStop3( float t ); // 3rd-degree smooth start (a.k.a. �cubic ease out�)
+constexpr float	SmoothStop4( float t ); // 4th-degree smooth start (a.k.a. �quartic ease out�)
+constexpr float	SmoothStep3( float t ); // 3rd-degree smooth start/stop (a.k.a. �smoothstep�)
 
 // interpolation
 int			  Interpolate( int start, int end, float fractionTowardEnd );
@@ -130,9 +130,61 @@ float DistPointToEdge(const Vector3& pt, const Vector3& vert1, const Vector3& ve
 float DistPointToPlaneSigned(const Vector3& pt, const Vector3& vert1, const Vector3& vert2, const Vector3& vert3);
 float DistPointToPlaneUnsigned(const Vector3& pt, const Vector3& vert1, const Vector3& vert2, const Vector3& vert3);
 
+Matrix33 GetOuterProduct(const Vector3& a, const Vector3& b);
 Matrix33 GetCanonicalTetrahedronCovariance();
 Matrix33 GetInertiaTensorFromCovariance(const Matrix33& cov);
 Matrix33 TranslateCovariance(const Matrix33& cov, const Vector3& com, const float& mass, const Vector3& offset);
 
 // approximation
-bool AreFloatsCloseEnough(const float& f1, const float& f2);
\ No newline at end of file
+bool AreFloatsCloseEnough(const float& f1, const float& f2);
+
+////////////////////////////////////// Inline //////////////////////////////////////
+constexpr float DotProduct( const Vector3& a, const Vector3& b )
+{
+	return (a.x * b.x) + (a.y * b.y) + (a.z * b.z);
+}
+
+constexpr float ConvertDegreesToRadians(float degrees)
+{
+	return degrees * (PI / 180.f);
+}
+
+constexpr float ConvertRadiansToDegrees(float radians)
+{
+	return radians * (180.f / PI);
+}
+
+constexpr float	SmoothStart2( float t )
+{
+	return t * t;
+}
+
+constexpr float	SmoothStart3( float t )
+{
+	return t * t * t;
+}
+
+constexpr float	SmoothStart4( float t )
+{
+	return t * t * t * t;
+}
+
+constexpr float	SmoothStop2( float t )
+{
+	return 1 - ((1 - t) * (1 - t));
+}
+
+constexpr float	SmoothStop3( float t )
+{
+	return 1 - ((1 - t) * (1 - t) * (1 - t));
+}
+
+constexpr float	SmoothStop4( float t )
+{
+	return 1 - ((1 - t) * (1 - t) * (1 - t) * (1 - t));
+}
+
+constexpr float	SmoothStep3( float t )
+{
+	return SmoothStart2(t) + t * (SmoothStop2(t) - SmoothStart2(t));
+}
\ No newline at end of file
@@ -2,37 +2,6 @@
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 
-const Matrix33 Matrix33::IDENTITY = Matrix33();
-const Matrix33 Matrix33::ZERO = Matrix33(0.f);
-
-Matrix33::Matrix33()
-{
-	Ix = 1.f; 	Jx = 0.f;	Kx = 0.f;	
-	Iy = 0.f;	Jy = 1.f;	Ky = 0.f;	
-	Iz = 0.f;	Jz = 0.f;	Kz = 1.f;	
-}
-
-Matrix33::Matrix33(float entry)
-{
-	Ix = entry; Jx = entry;	Kx = entry;	
-	Iy = entry;	Jy = entry;	Ky = entry;	
-	Iz = entry;	Jz = entry;	Kz = entry;	
-}
-
-Matrix33::Matrix33(const Vector3& i, const Vector3& j, const Vector3& k)
-{
-	Ix = i.x; Jx = j.x; Kx = k.x;
-	Iy = i.y; Jy = j.y; Ky = k.y;
-	Iz = i.z; Jz = j.z; Kz = k.z;
-}
-
-Matrix33::Matrix33(const float* entries)
-{
-	Ix = entries[0];	Jx = entries[3];	Kx = entries[6];
-	Iy = entries[1];	Jy = entries[4];	Ky = entries[7];
-	Iz = entries[2];	Jz = entries[5];	Kz = entries[8];
-}
-
 void Matrix33::operator+=(const Matrix33& rhs)
 {
 	Ix += rhs.Ix; Jx += rhs.Jx; Kx += rhs.Kx;
@@ -40,17 +9,6 @@ void Matrix33::operator+=(const Matrix33& rhs)
 	Iz += rhs.Iz; Jz += rhs.Jz; Kz += rhs.Kz;
 }
 
-Matrix33 Matrix33::operator+(const Matrix33& rhs) const
-{
-	Matrix33 res;
-
-	res.Ix = Ix + rhs.Ix; res.Jx = Jx + rhs.Jx; res.Kx = Kx + rhs.Kx;
-	res.Iy = Iy + rhs.Iy; res.Jy = Jy + rhs.Jy; res.Ky = Ky + rhs.Ky;
-	res.Iz = Iz + rhs.Iz; res.Jz = Jz + rhs.Jz; res.Kz = Kz + rhs.Kz;
-
-	return res;
-}
-
 Matrix33 Matrix33::operator+(const float& rhs) const
 {
 	Matrix33 res = *this;
@@ -69,19 +27,6 @@ void Matrix33::operator-=(const Matrix33& rhs)
 	Iz -= rhs.Iz; Jz -= rhs.Jz; Kz -= rhs.Kz;
 }
 
-Vector3 Matrix33::operator*(const Vector3& rhs) const
-{
-	Vector3 row1 = Vector3(Ix, Jx, Kx);
-	Vector3 row2 = Vector3(Iy, Jy, Ky);
-	Vector3 row3 = Vector3(Iz, Jz, Kz);
-
-	float x = DotProduct(row1, rhs);
-	float y = DotProduct(row2, rhs);
-	float z = DotProduct(row3, rhs);
-
-	return Vector3(x, y, z);
-}
-
 void Matrix33::operator*(const float rhs)
 {
 	Ix *= rhs;		Jx *= rhs;		Kx *= rhs;
@@ -89,31 +34,6 @@ void Matrix33::operator*(const float rhs)
 	Iz *= rhs;		Jz *= rhs;		Kz *= rhs;
 }
 
-Matrix33 Matrix33::operator*(const Matrix33& rhs) const
-{
-	Matrix33 res;
-
-	Vector3 my_row1 = Vector3(Ix, Jx, Kx);
-	Vector3 my_row2 = Vector3(Iy, Jy, Ky);
-	Vector3 my_row3 = Vector3(Iz, Jz, Kz);
-
-	Vector3 other_col1 = Vector3(rhs.Ix, rhs.Iy, rhs.Iz);
-	Vector3 other_col2 = Vector3(rhs.Jx, rhs.Jy, rhs.Jz);
-	Vector3 other_col3 = Vector3(rhs.Kx, rhs.Ky, rhs.Kz);
-
-	res.Ix = DotProduct(my_row1, other_col1);
-	res.Iy = DotProduct(my_row2, other_col1);
-	res.Iz = DotProduct(my_row3, other_col1);
-	res.Jx = DotProduct(my_row1, other_col2);
-	res.Jy = DotProduct(my_row2, other_col2);
-	res.Jz = DotProduct(my_row3, other_col2);
-	res.Kx = DotProduct(my_row1, other_col3);
-	res.Ky = DotProduct(my_row2, other_col3);
-	res.Kz = DotProduct(my_row3, other_col3);
-
-	return res;
-}
-
 void Matrix33::operator*=(const Matrix33& rhs)
 {
 	Vector3 my_row1 = Vector3(Ix, Jx, Kx);
@@ -161,18 +81,6 @@ const float Matrix33::operator[](const int idx) const
 	}
 }
 
-float Matrix33::GetDeterminant() const
-{
-	float det = Ix * Jy * Kz + Iy * Jz * Kx + Iz * Jx * Ky
-		- Ix * Jz * Ky - Iz * Jy * Kx  - Iy * Jx * Kz;
-	return det;
-}
-
-float Matrix33::GetTrace() const
-{
-	return Ix + Jy + Kz;
-}
-
 void Matrix33::SetRight(Vector3 right)
 {
 	Ix = right.x; Iy = right.y; Iz = right.z;
@@ -234,20 +142,6 @@ void Matrix33::AsInverse(const Matrix33& mat)
 	Iz = invertedMat.Iz;	Jz = invertedMat.Jz;	Kz = invertedMat.Kz;
 }
 
-Matrix33 Matrix33::GetTranspose() const
-{
-	Vector3 newI = Vector3(Ix, Jx, Kx);
-	Vector3 newJ = Vector3(Iy, Jy, Ky);
-	Vector3 newK = Vector3(Iz, Jz, Kz);
-	return Matrix33(newI, newJ, newK);
-}
-
-Vector3 Matrix33::MultiplyTranspose(const Vector3& v) const
-{
-	Matrix33 t = this->GetTranspose();
-	return t * v;
-}
-
 Matrix33 Matrix33::FromEuler(const Vector3& euler)
 {
 	Matrix33 res = IDENTITY;
@@ -305,4 +199,4 @@ void Matrix33::Append(const Matrix33& mat)
 	Iz = t_Iz * mat.Ix + t_Jz * mat.Iy + t_Kz * mat.Iz;
 	Jz = t_Iz * mat.Jx + t_Jz * mat.Jy + t_Kz * mat.Jz;
 	Kz = t_Iz * mat.Kx + t_Jz * mat.Ky * t_Kz * mat.Kz;
-}
+}
\ No newline at end of file
@@ -9,28 +9,28 @@ public:
 	static const Matrix33 IDENTITY;
 	static const Matrix33 ZERO;
 
-	Matrix33();
-	~Matrix33(){}
-	explicit Matrix33(float entry);
-	explicit Matrix33(const float* entries);
-	explicit Matrix33(const Vector3& i, const Vector3& j, const Vector3& k);
+	constexpr Matrix33();
+	~Matrix33() = default;
+	constexpr explicit Matrix33(float entry);
+	constexpr explicit Matrix33(const float* entries);
+	constexpr explicit Matrix33(const Vector3& i, const Vector3& j, const Vector3& k);
 
 	Matrix33 operator+(const float& rhs) const;
-	Matrix33 operator+(const Matrix33& rhs) const;
-	Matrix33 operator*(const Matrix33& rhs) const;
+	constexpr Matrix33 operator+(const Matrix33& rhs) const;
+	constexpr Matrix33 operator*(const Matrix33& rhs) const;
 	void operator*=(const Matrix33& rhs);
 	void operator*=(const float scale);
 	void operator+=(const Matrix33& rhs);
 	void operator-=(const Matrix33& rhs);
-	Vector3 operator*(const Vector3& rhs) const;
+	constexpr Vector3 operator*(const Vector3& rhs) const;
 	void operator*(const float rhs);
 	const float operator[](const int idx) const;
 
-	float GetDeterminant() const;
-	float GetTrace() const;
-	Vector3 GetI() const { return Vector3(Ix, Iy, Iz); }
-	Vector3 GetJ() const { return Vector3(Jx, Jy, Jz); }
-	Vector3 GetK() const { return Vector3(Kx, Ky, Kz); }
+	constexpr float GetDeterminant() const;
+	constexpr float GetTrace() const;
+	constexpr Vector3 GetI() const { return Vector3(Ix, Iy, Iz); }
+	constexpr Vector3 GetJ() const { return Vector3(Jx, Jy, Jz); }
+	constexpr Vector3 GetK() const { return Vector3(Kx, Ky, Kz); }
 
 	void SetRight(Vector3 right);
 	void SetUp(Vector3 up);
@@ -43,10 +43,93 @@ public:
 	void AsInverse(const Matrix33& mat);
 
 	// transpose
-	Matrix33 GetTranspose() const;
-	Vector3 MultiplyTranspose(const Vector3& v) const;		// why do i even need this...
+	constexpr Matrix33 GetTranspose() const;
+	constexpr Vector3 MultiplyTranspose(const Vector3& v) const;		// why do i even need this...
 
 	static Matrix33 FromEuler(const Vector3& euler);
 
 	void Append(const Matrix33& mat);
-};
\ No newline at end of file
+};
+
+////////////////////////////////////// Inline //////////////////////////////////////
+constexpr Matrix33::Matrix33()
+	: Ix(1.f), Iy(0.f), Iz(0.f)
+	, Jx(0.f), Jy(1.f), Jz(0.f)
+	, Kx(0.f), Ky(0.f), Kz(1.f)
+{
+
+}
+
+constexpr Matrix33::Matrix33(float entry)
+	: Ix(entry), Iy(entry), Iz(entry)
+	, Jx(entry), Jy(entry), Jz(entry)
+	, Kx(entry), Ky(entry), Kz(entry)
+{
+
+}
+
+constexpr Matrix33::Matrix33(const float* entries)
+	: Ix(entries[0]), Iy(entries[1]), Iz(entries[2])
+	, Jx(entries[3]), Jy(entries[4]), Jz(entries[5])
+	, Kx(entries[6]), Ky(entries[7]), Kz(entries[8])
+{
+
+}
+
+constexpr Matrix33::Matrix33(const Vector3& i, const Vector3& j, const Vector3& k)
+	: Ix(i.x), Iy(i.y), Iz(i.z)
+	, Jx(j.x), Jy(j.y), Jz(j.z)
+	, Kx(k.x), Ky(k.y), Kz(k.z)
+{
+
+}
+
+inline constexpr Matrix33 Matrix33::IDENTITY = Matrix33();
+inline constexpr Matrix33 Matrix33::ZERO = Matrix33(0.f);
+
+constexpr Matrix33 Matrix33::operator+(const Matrix33& rhs) const
+{
+	Matrix33 res;
+
+	res.Ix = Ix + rhs.Ix; res.Jx = Jx + rhs.Jx; res.Kx = Kx + rhs.Kx;
+	res.Iy = Iy + rhs.Iy; res.Jy = Jy + rhs.Jy; res.Ky = Ky + rhs.Ky;
+	res.Iz = Iz + rhs.Iz; res.Jz = Jz + rhs.Jz; res.Kz = Kz + rhs.Kz;
+
+	return res;
+}
+
+constexpr Vector3 Matrix33::operator*(const Vector3& rhs) const
+{
+	return Vector3(Ix * rhs.x + Jx * rhs.y + Kx * rhs.z,
+		Iy * rhs.x + Jy * rhs.y + Ky * rhs.z,
+		Iz * rhs.x + Jz * rhs.y + Kz * rhs.z);
+}
+
+constexpr Matrix33 Matrix33::operator*(const Matrix33& rhs) const
+{
+	// each column of the result is this times that column of rhs
+	return Matrix33((*this) * rhs.GetI(), (*this) * rhs.GetJ(), (*this) * rhs.GetK());
+}
+
+constexpr float Matrix33::GetDeterminant() const
+{
+	return Ix * Jy * Kz + Iy * Jz * Kx + Iz * Jx * Ky
+		- Ix * Jz * Ky - Iz * Jy * Kx - Iy * Jx * Kz;
+}
+
+constexpr float Matrix33::GetTrace() const
+{
+	return Ix + Jy + Kz;
+}
+
+constexpr Matrix33 Matrix33::GetTranspose() const
+{
+	return Matrix33(Vector3(Ix, Jx, Kx), Vector3(Iy, Jy, Ky), Vector3(Iz, Jz, Kz));
+}
+
+constexpr Vector3 Matrix33::MultiplyTranspose(const Vector3& v) const
+{
+	return Vector3(Ix * v.x + Iy * v.y + Iz * v.z,
+		Jx * v.x + Jy * v.y + Jz * v.z,
+		Kx * v.x + Ky * v.y + Kz * v.z);
+}
\ No newline at end of file
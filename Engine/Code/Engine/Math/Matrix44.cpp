@@ -3,32 +3,7 @@
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 
-const Matrix44 Matrix44::IDENTITY = Matrix44();
-const Matrix44 Matrix44::ZERO = Matrix44(0.f);
-
-Matrix44::Matrix44()
-{
-	Ix = 1.f; 	Jx = 0.f;	Kx = 0.f;	Tx = 0.f;
-	Iy = 0.f;	Jy = 1.f;	Ky = 0.f;	Ty = 0.f;
-	Iz = 0.f;	Jz = 0.f;	Kz = 1.f;	Tz = 0.f;
-	Iw = 0.f;	Jw = 0.f;	Kw = 0.f;	Tw = 1.f;
-}
-
-Matrix44::Matrix44(float entry)
-{
-	Ix = entry; Jx = entry;	Kx = entry;	Tx = entry;
-	Iy = entry;	Jy = entry;	Ky = entry;	Ty = entry;
-	Iz = entry;	Jz = entry;	Kz = entry;	Tz = entry;
-	Iw = entry; Jw = entry; Kw = entry; Tw = entry;
-}
-
-Matrix44::Matrix44(const float* entries)
-{
-	Ix = entries[0]; 	Jx = entries[4];	Kx = entries[8];	Tx = entries[12];
-	Iy = entries[1];	Jy = entries[5];	Ky = entries[9];	Ty = entries[13];
-	Iz = entries[2];	Jz = entries[6];	Kz = entries[10];	Tz = entries[14];
-	Iw = entries[3];	Jw = entries[7];	Kw = entries[11];	Tw = entries[15];
-}
+static_assert(sizeof(Matrix44) == 16 * sizeof(float), "SIMD kernels expect 16 packed floats");
 
 Matrix44::Matrix44(const Vector2& iBasis, const Vector2& jBasis, const Vector2& translation)
 {
@@ -38,19 +13,6 @@ Matrix44::Matrix44(const Vector2& iBasis, const Vector2& jBasis, const Vector2&
 	Iw = 0.f;		Jw = 0.f;		Kw = 0.f;	Tw = 1.f;
 }
 
-Matrix44::Matrix44( const Vector4& i, const Vector4& j, const Vector4& k, const Vector4& t )
-{
-	Ix = i.x; Jx = j.x; Kx = k.x; Tx = t.x;
-	Iy = i.y; Jy = j.y; Ky = k.y; Ty = t.y;
-	Iz = i.z; Jz = j.z; Kz = k.z; Tz = t.z;
-	Iw = i.w; Jw = j.w; Kw = k.w; Tw = t.w;
-}
-
-Matrix44::~Matrix44()
-{
-
-}
-
 Matrix44 Matrix44::FromBasis(const Vector3& right, const Vector3& up, const Vector3& forward)
 {
 	Matrix44 res;
@@ -353,19 +315,6 @@ void Matrix44::Scale3D(const float xScale, const float yScale, const float zScal
 	this->Append(MakeScale3D(xScale, yScale, zScale));
 }
 
-void Matrix44::Append(const Matrix44& mat)
-{
-	float t_Ix = Ix;	float t_Jx = Jx;	float t_Kx = Kx;	float t_Tx = Tx;
-	float t_Iy = Iy;	float t_Jy = Jy;	float t_Ky = Ky;	float t_Ty = Ty;
-	float t_Iz = Iz;	float t_Jz = Jz;	float t_Kz = Kz;	float t_Tz = Tz;
-	float t_Iw = Iw;	float t_Jw = Jw;	float t_Kw = Kw;	float t_Tw = Tw;
-
-	Ix = t_Ix * mat.Ix + t_Jx * mat.Iy + t_Kx * mat.Iz + t_Tx * mat.Iw;		Jx = t_Ix * mat.Jx + t_Jx * mat.Jy + t_Kx * mat.Jz + t_Tx * mat.Jw;		Kx = t_Ix * mat.Kx + t_Jx * mat.Ky + t_Kx * mat.Kz + t_Tx * mat.Kw;		Tx = t_Ix * mat.Tx + t_Jx * mat.Ty + t_Kx * mat.Tz + t_Tx * mat.Tw;
-	Iy = t_Iy * mat.Ix + t_Jy * mat.Iy + t_Ky * mat.Iz + t_Ty * mat.Iw;		Jy = t_Iy * mat.Jx + t_Jy * mat.Jy + t_Ky * mat.Jz + t_Ty * mat.Jw;		Ky = t_Iy * mat.Kx + t_Jy * mat.Ky + t_Ky * mat.Kz + t_Ty * mat.Kw;		Ty = t_Iy * mat.Tx + t_Jy * mat.Ty + t_Ky * mat.Tz + t_Ty * mat.Tw;
-	Iz = t_Iz * mat.Ix + t_Jz * mat.Iy + t_Kz * mat.Iz + t_Tz * mat.Iw;		Jz = t_Iz * mat.Jx + t_Jz * mat.Jy + t_Kz * mat.Jz + t_Tz * mat.Jw;		Kz = t_Iz * mat.Kx + t_Jz * mat.Ky + t_Kz * mat.Kz + t_Tz * mat.Kw;		Tz = t_Iz * mat.Tx + t_Jz * mat.Ty + t_Kz * mat.Tz + t_Tz * mat.Tw;
-	Iw = t_Iw * mat.Ix + t_Jw * mat.Iy + t_Kw * mat.Iz + t_Tw * mat.Iw;		Jw = t_Iw * mat.Jx + t_Jw * mat.Jy + t_Kw * mat.Jz + t_Tw * mat.Jw;		Kw = t_Iw * mat.Kx + t_Jw * mat.Ky + t_Kw * mat.Kz + t_Tw * mat.Kw;		Tw = t_Iw * mat.Tx + t_Jw * mat.Ty + t_Kw * mat.Tz + t_Tw * mat.Tw;
-}
-
 void Matrix44::SetIdentity()
 {
 	Ix = 1.f; 	Jx = 0.f;	Kx = 0.f;	Tx = 0.f;
@@ -430,351 +379,78 @@ Matrix44 Matrix44::LookAtLocal(Vector3 position, Vector3 target, Vector3 up)
 	return matrix;
 }
 
-Matrix44 Matrix44::operator*(const Matrix44& n) const
+Matrix44 Matrix44::Invert() const
 {
-	Matrix44 res = Matrix44();
-
-	float newIx = Ix * n.Ix + Jx * n.Iy + Kx * n.Iz + Tx * n.Iw;
-	float newIy = Iy * n.Ix + Jy * n.Iy + Ky * n.Iz + Ty * n.Iw;
-	float newIz = Iz * n.Ix + Jz * n.Iy + Kz * n.Iz + Tz * n.Iw;
-	float newIw = Iw * n.Ix + Jw * n.Iy + Kw * n.Iz + Tw * n.Iw;
-
-	float newJx = Ix * n.Jx + Jx * n.Jy + Kx * n.Jz + Tx * n.Jw;
-	float newJy = Iy * n.Jx + Jy * n.Jy + Ky * n.Jz + Ty * n.Jw;
-	float newJz = Iz * n.Jx + Jz * n.Jy + Kz * n.Jz + Tz * n.Jw;
-	float newJw = Iw * n.Jx + Jw * n.Jy + Kw * n.Jz + Tw * n.Jw;
-
-	float newKx = Ix * n.Kx + Jx * n.Ky + Kx * n.Kz + Tx * n.Kw;
-	float newKy = Iy * n.Kx + Jy * n.Ky + Ky * n.Kz + Ty * n.Kw;
-	float newKz = Iz * n.Kx + Jz * n.Ky + Kz * n.Kz + Tz * n.Kw;
-	float newKw = Iw * n.Kx + Jw * n.Ky + Kw * n.Kz + Tw * n.Kw;
-
-	float newTx = Ix * n.Tx + Jx * n.Ty + Kx * n.Tz + Tx * n.Tw;
-	float newTy = Iy * n.Tx + Jy * n.Ty + Ky * n.Tz + Ty * n.Tw;
-	float newTz = Iz * n.Tx + Jz * n.Ty + Kz * n.Tz + Tz * n.Tw;
-	float newTw = Iw * n.Tx + Jw * n.Ty + Kw * n.Tz + Tw * n.Tw;
-
-	float entries[16] = {newIx, newIy, newIz, newIw, newJx, newJy, newJz, newJw, newKx, newKy, newKz, newKw, newTx, newTy, newTz, newTw};
-
-	res.SetValues(entries);
+	// singular matrices come back as identity
+	Matrix44 res;
+	SIMDMat44Inverse(&Ix, &res.Ix);
 	return res;
 }
 
-Vector4 Matrix44::operator*(const Vector4& rhs) const
+Matrix44 Matrix44::Invert(eMatrixClass matClass) const
 {
-	Vector4 row1 = Vector4(Ix, Jx, Kx, Tx);
-	Vector4 row2 = Vector4(Iy, Jy, Ky, Ty);
-	Vector4 row3 = Vector4(Iz, Jz, Kz, Tz);
-	Vector4 row4 = Vector4(Iw, Jw, Kw, Tw);
-
-	float x = DotProduct(row1, rhs);
-	float y = DotProduct(row2, rhs);
-	float z = DotProduct(row3, rhs);
-	float w = DotProduct(row4, rhs);
-
-	return Vector4(x, y, z, w);
+	switch (matClass)
+	{
+	case MAT_CLASS_RIGID:
+		return InvertRigid();
+	case MAT_CLASS_AFFINE:
+		return InvertAffine();
+	default:
+		return Invert();
+	}
 }
 
-Vector3 Matrix44::operator*(const Vector3& rhs) const
+Matrix44 Matrix44::InvertAffine() const
 {
-	Vector3 row1 = Vector3(Ix, Jx, Kx);
-	Vector3 row2 = Vector3(Iy, Jy, Ky);
-	Vector3 row3 = Vector3(Iz, Jz, Kz);
+	// rows of the 3x3 inverse are the cross products of the other two columns over the determinant
+	Vector3 i = Vector3(Ix, Iy, Iz);
+	Vector3 j = Vector3(Jx, Jy, Jz);
+	Vector3 k = Vector3(Kx, Ky, Kz);
 
-	float x = DotProduct(row1, rhs);
-	float y = DotProduct(row2, rhs);
-	float z = DotProduct(row3, rhs);
+	Vector3 row0 = j.Cross(k);
+	Vector3 row1 = k.Cross(i);
+	Vector3 row2 = i.Cross(j);
 
-	// also considers translation
-	x += Tx;
-	y += Ty;
-	z += Tz;
+	Matrix44 res;
+	float det = DotProduct(i, row0);
+	if (det == 0.f)
+		return res;
 
-	return Vector3(x, y, z);
-}
+	float inv_det = 1.f / det;
+	row0 *= inv_det;
+	row1 *= inv_det;
+	row2 *= inv_det;
 
-Matrix44 Matrix44::Invert() const
-{
-	float inv[16];
-	float det;
-	float m[16];
-	float data[16];
-
-	memcpy(m, this, sizeof(Matrix44));
-
-	inv[0] = 
-		m[5]  * m[10] * m[15] - 
-		m[5]  * m[11] * m[14] - 
-		m[9]  * m[6]  * m[15] + 
-		m[9]  * m[7]  * m[14] +
-		m[13] * m[6]  * m[11] - 
-		m[13] * m[7]  * m[10];
-
-	inv[4] = 
-		-m[4]  * m[10] * m[15] + 
-		m[4]  * m[11] * m[14] + 
-		m[8]  * m[6]  * m[15] - 
-		m[8]  * m[7]  * m[14] - 
-		m[12] * m[6]  * m[11] + 
-		m[12] * m[7]  * m[10];
-
-	inv[8] = 
-		m[4]  * m[9] * m[15] - 
-		m[4]  * m[11] * m[13] - 
-		m[8]  * m[5] * m[15] + 
-		m[8]  * m[7] * m[13] + 
-		m[12] * m[5] * m[11] - 
-		m[12] * m[7] * m[9];
-
-	inv[12] = 
-		-m[4]  * m[9] * m[14] + 
-		m[4]  * m[10] * m[13] +
-		m[8]  * m[5] * m[14] - 
-		m[8]  * m[6] * m[13] - 
-		m[12] * m[5] * m[10] + 
-		m[12] * m[6] * m[9];
-
-	inv[1] = 
-		-m[1]  * m[10] * m[15] + 
-		m[1]  * m[11] * m[14] + 
-		m[9]  * m[2] * m[15] - 
-		m[9]  * m[3] * m[14] - 
-		m[13] * m[2] * m[11] + 
-		m[13] * m[3] * m[10];
-
-	inv[5] = 
-		m[0]  * m[10] * m[15] - 
-		m[0]  * m[11] * m[14] - 
-		m[8]  * m[2] * m[15] + 
-		m[8]  * m[3] * m[14] + 
-		m[12] * m[2] * m[11] - 
-		m[12] * m[3] * m[10];
-
-	inv[9] = 
-		-m[0]  * m[9] * m[15] + 
-		m[0]  * m[11] * m[13] + 
-		m[8]  * m[1] * m[15] - 
-		m[8]  * m[3] * m[13] - 
-		m[12] * m[1] * m[11] + 
-		m[12] * m[3] * m[9];
-
-	inv[13] = 
-		m[0]  * m[9] * m[14] - 
-		m[0]  * m[10] * m[13] - 
-		m[8]  * m[1] * m[14] + 
-		m[8]  * m[2] * m[13] + 
-		m[12] * m[1] * m[10] - 
-		m[12] * m[2] * m[9];
-
-	inv[2] = 
-		m[1]  * m[6] * m[15] - 
-		m[1]  * m[7] * m[14] - 
-		m[5]  * m[2] * m[15] + 
-		m[5]  * m[3] * m[14] + 
-		m[13] * m[2] * m[7] - 
-		m[13] * m[3] * m[6];
-
-	inv[6] = 
-		-m[0]  * m[6] * m[15] + 
-		m[0]  * m[7] * m[14] + 
-		m[4]  * m[2] * m[15] - 
-		m[4]  * m[3] * m[14] - 
-		m[12] * m[2] * m[7] + 
-		m[12] * m[3] * m[6];
-
-	inv[10] = 
-		m[0]  * m[5] * m[15] - 
-		m[0]  * m[7] * m[13] - 
-		m[4]  * m[1] * m[15] + 
-		m[4]  * m[3] * m[13] + 
-		m[12] * m[1] * m[7] - 
-		m[12] * m[3] * m[5];
-
-	inv[14] = 
-		-m[0]  * m[5] * m[14] + 
-		m[0]  * m[6] * m[13] + 
-		m[4]  * m[1] * m[14] - 
-		m[4]  * m[2] * m[13] - 
-		m[12] * m[1] * m[6] + 
-		m[12] * m[2] * m[5];
-
-	inv[3] = 
-		-m[1] * m[6] * m[11] + 
-		m[1] * m[7] * m[10] + 
-		m[5] * m[2] * m[11] - 
-		m[5] * m[3] * m[10] - 
-		m[9] * m[2] * m[7] + 
-		m[9] * m[3] * m[6];
-
-	inv[7] = 
-		m[0] * m[6] * m[11] - 
-		m[0] * m[7] * m[10] - 
-		m[4] * m[2] * m[11] + 
-		m[4] * m[3] * m[10] + 
-		m[8] * m[2] * m[7] - 
-		m[8] * m[3] * m[6];
-
-	inv[11] = 
-		-m[0] * m[5] * m[11] + 
-		m[0] * m[7] * m[9] + 
-		m[4] * m[1] * m[11] - 
-		m[4] * m[3] * m[9] - 
-		m[8] * m[1] * m[7] + 
-		m[8] * m[3] * m[5];
-
-	inv[15] = 
-		m[0] * m[5] * m[10] - 
-		m[0] * m[6] * m[9] - 
-		m[4] * m[1] * m[10] + 
-		m[4] * m[2] * m[9] + 
-		m[8] * m[1] * m[6] - 
-		m[8] * m[2] * m[5];
-
-	det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
-	det = 1.f / det;
-
-	for (uint i = 0; i < 16; i++) {
-		data[i] = (float)(inv[i] * det);
-	}
+	res.Ix = row0.x;	res.Jx = row0.y;	res.Kx = row0.z;
+	res.Iy = row1.x;	res.Jy = row1.y;	res.Ky = row1.z;
+	res.Iz = row2.x;	res.Jz = row2.y;	res.Kz = row2.z;
 
-	Matrix44 res;
-	res.SetValues(data);
+	res.Tx = -(row0.x * Tx + row0.y * Ty + row0.z * Tz);
+	res.Ty = -(row1.x * Tx + row1.y * Ty + row1.z * Tz);
+	res.Tz = -(row2.x * Tx + row2.y * Ty + row2.z * Tz);
 
 	return res;
 }
 
-bool Matrix44::Invert(const float m[16], float invOut[16])
+Matrix44 Matrix44::InvertRigid() const
 {
-	float inv[16], det;
-	int i;
-
-	inv[0] = m[5]  * m[10] * m[15] - 
-		m[5]  * m[11] * m[14] - 
-		m[9]  * m[6]  * m[15] + 
-		m[9]  * m[7]  * m[14] +
-		m[13] * m[6]  * m[11] - 
-		m[13] * m[7]  * m[10];
-
-	inv[4] = -m[4]  * m[10] * m[15] + 
-		m[4]  * m[11] * m[14] + 
-		m[8]  * m[6]  * m[15] - 
-		m[8]  * m[7]  * m[14] - 
-		m[12] * m[6]  * m[11] + 
-		m[12] * m[7]  * m[10];
-
-	inv[8] = m[4]  * m[9] * m[15] - 
-		m[4]  * m[11] * m[13] - 
-		m[8]  * m[5] * m[15] + 
-		m[8]  * m[7] * m[13] + 
-		m[12] * m[5] * m[11] - 
-		m[12] * m[7] * m[9];
-
-	inv[12] = -m[4]  * m[9] * m[14] + 
-		m[4]  * m[10] * m[13] +
-		m[8]  * m[5] * m[14] - 
-		m[8]  * m[6] * m[13] - 
-		m[12] * m[5] * m[10] + 
-		m[12] * m[6] * m[9];
-
-	inv[1] = -m[1]  * m[10] * m[15] + 
-		m[1]  * m[11] * m[14] + 
-		m[9]  * m[2] * m[15] - 
-		m[9]  * m[3] * m[14] - 
-		m[13] * m[2] * m[11] + 
-		m[13] * m[3] * m[10];
-
-	inv[5] = m[0]  * m[10] * m[15] - 
-		m[0]  * m[11] * m[14] - 
-		m[8]  * m[2] * m[15] + 
-		m[8]  * m[3] * m[14] + 
-		m[12] * m[2] * m[11] - 
-		m[12] * m[3] * m[10];
-
-	inv[9] = -m[0]  * m[9] * m[15] + 
-		m[0]  * m[11] * m[13] + 
-		m[8]  * m[1] * m[15] - 
-		m[8]  * m[3] * m[13] - 
-		m[12] * m[1] * m[11] + 
-		m[12] * m[3] * m[9];
-
-	inv[13] = m[0]  * m[9] * m[14] - 
-		m[0]  * m[10] * m[13] - 
-		m[8]  * m[1] * m[14] + 
-		m[8]  * m[2] * m[13] + 
-		m[12] * m[1] * m[10] - 
-		m[12] * m[2] * m[9];
-
-	inv[2] = m[1]  * m[6] * m[15] - 
-		m[1]  * m[7] * m[14] - 
-		m[5]  * m[2] * m[15] + 
-		m[5]  * m[3] * m[14] + 
-		m[13] * m[2] * m[7] - 
-		m[13] * m[3] * m[6];
-
-	inv[6] = -m[0]  * m[6] * m[15] + 
-		m[0]  * m[7] * m[14] + 
-		m[4]  * m[2] * m[15] - 
-		m[4]  * m[3] * m[14] - 
-		m[12] * m[2] * m[7] + 
-		m[12] * m[3] * m[6];
-
-	inv[10] = m[0]  * m[5] * m[15] - 
-		m[0]  * m[7] * m[13] - 
-		m[4]  * m[1] * m[15] + 
-		m[4]  * m[3] * m[13] + 
-		m[12] * m[1] * m[7] - 
-		m[12] * m[3] * m[5];
-
-	inv[14] = -m[0]  * m[5] * m[14] + 
-		m[0]  * m[6] * m[13] + 
-		m[4]  * m[1] * m[14] - 
-		m[4]  * m[2] * m[13] - 
-		m[12] * m[1] * m[6] + 
-		m[12] * m[2] * m[5];
-
-	inv[3] = -m[1] * m[6] * m[11] + 
-		m[1] * m[7] * m[10] + 
-		m[5] * m[2] * m[11] - 
-		m[5] * m[3] * m[10] - 
-		m[9] * m[2] * m[7] + 
-		m[9] * m[3] * m[6];
-
-	inv[7] = m[0] * m[6] * m[11] - 
-		m[0] * m[7] * m[10] - 
-		m[4] * m[2] * m[11] + 
-		m[4] * m[3] * m[10] + 
-		m[8] * m[2] * m[7] - 
-		m[8] * m[3] * m[6];
-
-	inv[11] = -m[0] * m[5] * m[11] + 
-		m[0] * m[7] * m[9] + 
-		m[4] * m[1] * m[11] - 
-		m[4] * m[3] * m[9] - 
-		m[8] * m[1] * m[7] + 
-		m[8] * m[3] * m[5];
-
-	inv[15] = m[0] * m[5] * m[10] - 
-		m[0] * m[6] * m[9] - 
-		m[4] * m[1] * m[10] + 
-		m[4] * m[2] * m[9] + 
-		m[8] * m[1] * m[6] - 
-		m[8] * m[2] * m[5];
-
-	det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
-
-	if (det == 0)
-	{
-		return false;
-	}
+	// transpose the rotation, rotate the translation back
+	Matrix44 res;
 
-	det = 1.f / det;
+	res.Ix = Ix;	res.Jx = Iy;	res.Kx = Iz;
+	res.Iy = Jx;	res.Jy = Jy;	res.Ky = Jz;
+	res.Iz = Kx;	res.Jz = Ky;	res.Kz = Kz;
 
-	for (i = 0; i < 16; i++)
-	{
-		invOut[i] = inv[i] * det;
-	}
+	res.Tx = -(Ix * Tx + Iy * Ty + Iz * Tz);
+	res.Ty = -(Jx * Tx + Jy * Ty + Jz * Tz);
+	res.Tz = -(Kx * Tx + Ky * Ty + Kz * Tz);
 
-	return true;
+	return res;
+}
+
+bool Matrix44::Invert(const float m[16], float invOut[16])
+{
+	return SIMDMat44Inverse(m, invOut) != 0.f;
 }
 
 Vector3 Matrix44::MultiplyInverse(const Vector3& vector) const
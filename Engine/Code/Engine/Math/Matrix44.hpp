@@ -3,8 +3,18 @@
 #include "Engine/Math/Vector2.hpp"
 #include "Engine/Math/Vector4.hpp"
 #include "Engine/Math/Matrix33.hpp"
+#include "Engine/Math/MathSIMD.hpp"
 
-class Matrix44
+// what is known about a matrix, picks the inverse
+enum eMatrixClass
+{
+	MAT_CLASS_GENERAL,		// anything, including projections
+	MAT_CLASS_AFFINE,		// last row is 0 0 0 1
+	MAT_CLASS_RIGID			// affine with an orthonormal 3x3 part, rotation plus translation
+};
+
+// column major, the 16 floats are laid out I, J, K, T so the SIMD kernels can load whole columns
+class MATH_ALIGN16 Matrix44
 {
 public:
 	float Ix, Iy, Iz, Iw,   Jx, Jy, Jz, Jw,   Kx, Ky, Kz, Kw,   Tx, Ty, Tz, Tw;
@@ -12,14 +22,14 @@ public:
 	static const Matrix44 ZERO;
 
 public:
-	Matrix44();
-	explicit Matrix44(float entry);
-	explicit Matrix44(const float* entries);
+	constexpr Matrix44();
+	constexpr explicit Matrix44(float entry);
+	constexpr explicit Matrix44(const float* entries);
 	explicit Matrix44(const Vector2& iBasis, const Vector2& jBasis, const Vector2& translation = Vector2(0.f,0.f));
-	explicit Matrix44(const Vector4& i, const Vector4& j, const Vector4& k, const Vector4& t);
+	constexpr explicit Matrix44(const Vector4& i, const Vector4& j, const Vector4& k, const Vector4& t);
 	static Matrix44 FromBasis(const Vector3& right, const Vector3& up, const Vector3& forward);
 	static Matrix44 FromBasisTranslation(const Vector3& right, const Vector3& up, const Vector3& forward, const Vector3& translation);
-	~Matrix44();
+	~Matrix44() = default;
 
 	// basics
 	Vector2 TransformPosition2D(const Vector2& position2D);
@@ -71,6 +81,9 @@ public:
 
 	// inverse
 	Matrix44 Invert() const;
+	Matrix44 Invert(eMatrixClass matClass) const;
+	Matrix44 InvertAffine() const;
+	Matrix44 InvertRigid() const;
 	bool Invert(const float m[16], float invOut[16]);
 	Vector3 MultiplyInverse(const Vector3& vector) const;
 
@@ -94,4 +107,72 @@ public:
 	Matrix33 ExtractMat3() const;
 
 	Matrix44 RotateToward(const Matrix44& rotateTarget, float maxAngleToMove) const;
-};
\ No newline at end of file
+};
+
+////////////////////////////////////// Inline //////////////////////////////////////
+constexpr Matrix44::Matrix44()
+	: Ix(1.f), Iy(0.f), Iz(0.f), Iw(0.f)
+	, Jx(0.f), Jy(1.f), Jz(0.f), Jw(0.f)
+	, Kx(0.f), Ky(0.f), Kz(1.f), Kw(0.f)
+	, Tx(0.f), Ty(0.f), Tz(0.f), Tw(1.f)
+{
+
+}
+
+constexpr Matrix44::Matrix44(float entry)
+	: Ix(entry), Iy(entry), Iz(entry), Iw(entry)
+	, Jx(entry), Jy(entry), Jz(entry), Jw(entry)
+	, Kx(entry), Ky(entry), Kz(entry), Kw(entry)
+	, Tx(entry), Ty(entry), Tz(entry), Tw(entry)
+{
+
+}
+
+constexpr Matrix44::Matrix44(const float* entries)
+	: Ix(entries[0]), Iy(entries[1]), Iz(entries[2]), Iw(entries[3])
+	, Jx(entries[4]), Jy(entries[5]), Jz(entries[6]), Jw(entries[7])
+	, Kx(entries[8]), Ky(entries[9]), Kz(entries[10]), Kw(entries[11])
+	, Tx(entries[12]), Ty(entries[13]), Tz(entries[14]), Tw(entries[15])
+{
+
+}
+
+constexpr Matrix44::Matrix44(const Vector4& i, const Vector4& j, const Vector4& k, const Vector4& t)
+	: Ix(i.x), Iy(i.y), Iz(i.z), Iw(i.w)
+	, Jx(j.x), Jy(j.y), Jz(j.z), Jw(j.w)
+	, Kx(k.x), Ky(k.y), Kz(k.z), Kw(k.w)
+	, Tx(t.x), Ty(t.y), Tz(t.z), Tw(t.w)
+{
+
+}
+
+inline constexpr Matrix44 Matrix44::IDENTITY = Matrix44();
+inline constexpr Matrix44 Matrix44::ZERO = Matrix44(0.f);
+
+inline void Matrix44::Append(const Matrix44& mat)
+{
+	SIMDMat44Mul(&Ix, &mat.Ix, &Ix);
+}
+
+inline Matrix44 Matrix44::operator*(const Matrix44& rhs) const
+{
+	Matrix44 res;
+	SIMDMat44Mul(&Ix, &rhs.Ix, &res.Ix);
+	return res;
+}
+
+inline Vector4 Matrix44::operator*(const Vector4& rhs) const
+{
+	Vector4 res;
+	SIMDMat44MulVec4(&Ix, &rhs.x, &res.x);
+	return res;
+}
+
+inline Vector3 Matrix44::operator*(const Vector3& rhs) const
+{
+	// also considers translation
+	float in[4] = { rhs.x, rhs.y, rhs.z, 1.f };
+	float out[4];
+	SIMDMat44MulVec4(&Ix, in, out);
+	return Vector3(out[0], out[1], out[2]);
+}
\ No newline at end of file
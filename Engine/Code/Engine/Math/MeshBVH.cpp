@@ -0,0 +1,519 @@
+#include "Engine/Math/MeshBVH.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/Thread/ParallelFor.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Renderer/MeshBuilder.hpp"
+
+#include <algorithm>
+#include <float.h>
+
+struct sSAHBin
+{
+	AABB3 m_bound = AABB3::MakeEmpty();
+	uint m_count = 0;
+};
+
+static float SafeInverse(float v)
+{
+	if (abs(v) < 1e-12f)
+		return (v < 0.f) ? -1e30f : 1e30f;
+	return 1.f / v;
+}
+
+static float GetAxis(const Vector3& v, int axis)
+{
+	return (axis == 0) ? v.x : ((axis == 1) ? v.y : v.z);
+}
+
+static void BuildTaskCB(uint idx, void* userData)
+{
+	MeshBVH* bvh = (MeshBVH*)(userData);
+	bvh->BuildTask(idx);
+}
+
+void MeshBVH::Build(const Vector3* positions, const uint* indices, uint tri_count, bool parallel)
+{
+	Clear();
+	if (tri_count == 0)
+		return;
+
+	m_build_bounds.resize(tri_count);
+	m_build_centroids.resize(tri_count);
+	m_build_order.resize(tri_count);
+	for (uint i = 0; i < tri_count; ++i)
+	{
+		const Vector3& a = positions[indices[i * 3]];
+		const Vector3& b = positions[indices[i * 3 + 1]];
+		const Vector3& c = positions[indices[i * 3 + 2]];
+
+		AABB3 bound(a, a);
+		bound.StretchToIncludePoint(b);
+		bound.StretchToIncludePoint(c);
+
+		m_build_bounds[i] = bound;
+		m_build_centroids[i] = bound.GetCenter();
+		m_build_order[i] = i;
+	}
+
+	// top levels here, anything at the parallel depth becomes a task
+	bool defer = parallel && (tri_count >= BVH_PARALLEL_MIN_TRIS);
+	m_nodes.reserve(tri_count * 2 / BVH_LEAF_SIZE + 1);
+	m_nodes.resize(1);
+	BuildNode(m_nodes, 0, 0, tri_count, 0, defer);
+
+	if (!m_build_tasks.empty())
+	{
+		ParallelFor((uint)m_build_tasks.size(), BuildTaskCB, this);
+
+		// splice: the subtree root takes the placeholder slot, the rest goes to the back
+		for (std::vector<sBVHBuildTask>::size_type t = 0; t < m_build_tasks.size(); ++t)
+		{
+			sBVHBuildTask& task = m_build_tasks[t];
+			uint base = (uint)m_nodes.size() - 1;
+
+			for (std::vector<sBVHNode>::size_type n = 0; n < task.m_nodes.size(); ++n)
+			{
+				sBVHNode node = task.m_nodes[n];
+				if (!node.IsLeaf())
+					node.m_offset += base;
+
+				if (n == 0)
+					m_nodes[task.m_node] = node;
+				else
+					m_nodes.push_back(node);
+			}
+		}
+	}
+
+	// triangle data in leaf order
+	m_verts.resize(tri_count * 3);
+	m_tri_index.resize(tri_count);
+	for (uint i = 0; i < tri_count; ++i)
+	{
+		uint tri = m_build_order[i];
+		m_tri_index[i] = tri;
+		m_verts[i * 3] = positions[indices[tri * 3]];
+		m_verts[i * 3 + 1] = positions[indices[tri * 3 + 1]];
+		m_verts[i * 3 + 2] = positions[indices[tri * 3 + 2]];
+	}
+
+	m_build_bounds.clear();
+	m_build_centroids.clear();
+	m_build_order.clear();
+	m_build_tasks.clear();
+}
+
+void MeshBVH::Build(const MeshBuilder& builder, bool parallel)
+{
+	ASSERT_OR_DIE(builder.m_draw.primitive_type == DRAW_TRIANGLE, "BVH needs a triangle list");
+
+	std::vector<Vector3> positions;
+	positions.reserve(builder.m_vertices.size());
+	for (std::vector<sVertexBuilder>::size_type idx = 0; idx < builder.m_vertices.size(); ++idx)
+		positions.push_back(builder.m_vertices[idx].m_position);
+
+	if (builder.m_draw.using_indices)
+	{
+		Build(positions.data(), builder.m_indices.data(), (uint)builder.m_indices.size() / 3, parallel);
+		return;
+	}
+
+	std::vector<uint> indices(positions.size());
+	for (std::vector<uint>::size_type idx = 0; idx < indices.size(); ++idx)
+		indices[idx] = (uint)idx;
+	Build(positions.data(), indices.data(), (uint)indices.size() / 3, parallel);
+}
+
+void MeshBVH::Clear()
+{
+	m_nodes.clear();
+	m_verts.clear();
+	m_tri_index.clear();
+}
+
+void MeshBVH::BuildTask(uint idx)
+{
+	sBVHBuildTask& task = m_build_tasks[idx];
+	task.m_nodes.reserve((task.m_end - task.m_begin) * 2 / BVH_LEAF_SIZE + 1);
+	task.m_nodes.resize(1);
+	BuildNode(task.m_nodes, 0, task.m_begin, task.m_end, task.m_depth, false);
+}
+
+void MeshBVH::BuildNode(std::vector<sBVHNode>& nodes, uint node, uint begin, uint end, uint depth, bool defer)
+{
+	if (defer && depth == BVH_PARALLEL_DEPTH)
+	{
+		sBVHBuildTask task;
+		task.m_node = node;
+		task.m_begin = begin;
+		task.m_end = end;
+		task.m_depth = depth;
+		m_build_tasks.push_back(task);
+		return;
+	}
+
+	AABB3 bound = AABB3::MakeEmpty();
+	for (uint i = begin; i < end; ++i)
+		bound.StretchToIncludeBox(m_build_bounds[m_build_order[i]]);
+	nodes[node].m_bound = bound;
+
+	// past the depth the traversal stack can hold, the rest goes into one leaf
+	bool can_split = (end - begin > BVH_LEAF_SIZE) && (depth < BVH_STACK_SIZE - 2);
+	uint mid = can_split ? SplitSAH(begin, end, bound) : BVH_INVALID;
+	if (mid == BVH_INVALID)
+	{
+		nodes[node].m_offset = begin;
+		nodes[node].m_count = end - begin;
+		return;
+	}
+
+	// nodes may reallocate below, only touch them through indices
+	uint left = (uint)nodes.size();
+	nodes.resize(left + 2);
+	nodes[node].m_offset = left;
+	nodes[node].m_count = 0;
+
+	BuildNode(nodes, left, begin, mid, depth + 1, defer);
+	BuildNode(nodes, left + 1, mid, end, depth + 1, defer);
+}
+
+uint MeshBVH::SplitSAH(uint begin, uint end, const AABB3& bound)
+{
+	uint count = end - begin;
+
+	AABB3 centroid_bound = AABB3::MakeEmpty();
+	for (uint i = begin; i < end; ++i)
+		centroid_bound.StretchToIncludePoint(m_build_centroids[m_build_order[i]]);
+	Vector3 extent = centroid_bound.GetDimensions();
+
+	// sweep the bins of each axis for the cheapest split
+	float best_cost = FLT_MAX;
+	int best_axis = -1;
+	uint best_bin = 0;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		float axis_ext = GetAxis(extent, axis);
+		if (axis_ext <= 0.f)
+			continue;
+
+		float axis_min = GetAxis(centroid_bound.m_min, axis);
+		float scale = BVH_SAH_BINS / axis_ext;
+
+		sSAHBin bins[BVH_SAH_BINS];
+		for (uint i = begin; i < end; ++i)
+		{
+			uint tri = m_build_order[i];
+			uint b = (uint)((GetAxis(m_build_centroids[tri], axis) - axis_min) * scale);
+			b = (b < BVH_SAH_BINS) ? b : (BVH_SAH_BINS - 1);
+			bins[b].m_count++;
+			bins[b].m_bound.StretchToIncludeBox(m_build_bounds[tri]);
+		}
+
+		// right to left prefix areas, then a left to right sweep
+		float right_area[BVH_SAH_BINS];
+		uint right_count[BVH_SAH_BINS];
+		AABB3 acc = AABB3::MakeEmpty();
+		uint acc_count = 0;
+		for (int b = BVH_SAH_BINS - 1; b > 0; --b)
+		{
+			acc_count += bins[b].m_count;
+			if (bins[b].m_count > 0)
+				acc.StretchToIncludeBox(bins[b].m_bound);
+			right_area[b] = (acc_count > 0) ? acc.GetSurfaceArea() : 0.f;
+			right_count[b] = acc_count;
+		}
+
+		acc = AABB3::MakeEmpty();
+		acc_count = 0;
+		for (uint b = 0; b < BVH_SAH_BINS - 1; ++b)
+		{
+			acc_count += bins[b].m_count;
+			if (bins[b].m_count > 0)
+				acc.StretchToIncludeBox(bins[b].m_bound);
+
+			if (acc_count == 0 || right_count[b + 1] == 0)
+				continue;
+
+			float cost = acc.GetSurfaceArea() * acc_count + right_area[b + 1] * right_count[b + 1];
+			if (cost < best_cost)
+			{
+				best_cost = cost;
+				best_axis = axis;
+				best_bin = b;
+			}
+		}
+	}
+
+	// splitting has to beat intersecting everything here, unless the leaf would be too big
+	float leaf_cost = bound.GetSurfaceArea() * count;
+	if (best_axis < 0 || best_cost >= leaf_cost)
+	{
+		if (count <= BVH_MAX_LEAF_SIZE)
+			return BVH_INVALID;
+
+		// no useful plane (e.g. all centroids on top of each other), halve the range
+		uint mid = begin + count / 2;
+		int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : ((extent.y >= extent.z) ? 1 : 2);
+		std::nth_element(m_build_order.begin() + begin, m_build_order.begin() + mid, m_build_order.begin() + end,
+			[this, axis](uint a, uint b) { return GetAxis(m_build_centroids[a], axis) < GetAxis(m_build_centroids[b], axis); });
+		return mid;
+	}
+
+	float axis_min = GetAxis(centroid_bound.m_min, best_axis);
+	float scale = BVH_SAH_BINS / GetAxis(extent, best_axis);
+	std::vector<uint>::iterator split = std::partition(m_build_order.begin() + begin, m_build_order.begin() + end,
+		[this, best_axis, axis_min, scale, best_bin](uint tri)
+	{
+		uint b = (uint)((GetAxis(m_build_centroids[tri], best_axis) - axis_min) * scale);
+		b = (b < BVH_SAH_BINS) ? b : (BVH_SAH_BINS - 1);
+		return b <= best_bin;
+	});
+
+	return (uint)(split - m_build_order.begin());
+}
+
+bool MeshBVH::Raycast(const Vector3& start, const Vector3& dir, float max_dist, sBVHHit& hit) const
+{
+	hit = sBVHHit();
+	if (m_nodes.empty())
+		return false;
+
+	Vector3 inv_dir = Vector3(SafeInverse(dir.x), SafeInverse(dir.y), SafeInverse(dir.z));
+	float closest = max_dist;
+	float t;
+
+	uint stack[BVH_STACK_SIZE];
+	uint top = 0;
+	if (m_nodes[0].m_bound.RaycastSlab(start, inv_dir, closest, t))
+		stack[top++] = 0;
+
+	while (top > 0)
+	{
+		const sBVHNode& node = m_nodes[stack[--top]];
+
+		if (node.IsLeaf())
+		{
+			for (uint i = node.m_offset; i < node.m_offset + node.m_count; ++i)
+			{
+				float dist, u, v;
+				if (RayVsTriangle(start, dir, m_verts[i * 3], m_verts[i * 3 + 1], m_verts[i * 3 + 2], closest, dist, u, v))
+				{
+					closest = dist;
+					hit.m_tri = i;
+					hit.m_dist = dist;
+					hit.m_u = u;
+					hit.m_v = v;
+				}
+			}
+			continue;
+		}
+
+		// visit the nearer child first so the far one is more likely to be culled
+		float t_left, t_right;
+		bool hit_left = m_nodes[node.m_offset].m_bound.RaycastSlab(start, inv_dir, closest, t_left);
+		bool hit_right = m_nodes[node.m_offset + 1].m_bound.RaycastSlab(start, inv_dir, closest, t_right);
+
+		if (hit_left && hit_right)
+		{
+			bool left_first = (t_left <= t_right);
+			stack[top++] = left_first ? (node.m_offset + 1) : node.m_offset;
+			stack[top++] = left_first ? node.m_offset : (node.m_offset + 1);
+		}
+		else if (hit_left)
+			stack[top++] = node.m_offset;
+		else if (hit_right)
+			stack[top++] = node.m_offset + 1;
+	}
+
+	if (!hit.IsValid())
+		return false;
+
+	uint slot = hit.m_tri;
+	const Vector3& a = m_verts[slot * 3];
+	hit.m_tri = m_tri_index[slot];
+	hit.m_pos = start + dir * hit.m_dist;
+	hit.m_normal = (m_verts[slot * 3 + 1] - a).Cross(m_verts[slot * 3 + 2] - a).GetNormalized();
+	return true;
+}
+
+uint MeshBVH::QuerySphere(const Vector3& center, float radius, std::vector<uint>& tris) const
+{
+	if (m_nodes.empty())
+		return 0;
+
+	float radius_sqr = radius * radius;
+	uint found = 0;
+
+	uint stack[BVH_STACK_SIZE];
+	uint top = 0;
+	stack[top++] = 0;
+
+	while (top > 0)
+	{
+		const sBVHNode& node = m_nodes[stack[--top]];
+		if (node.m_bound.GetDistSquared(center) > radius_sqr)
+			continue;
+
+		if (!node.IsLeaf())
+		{
+			stack[top++] = node.m_offset;
+			stack[top++] = node.m_offset + 1;
+			continue;
+		}
+
+		for (uint i = node.m_offset; i < node.m_offset + node.m_count; ++i)
+		{
+			float u, v;
+			Vector3 closest = ClosestPointOnTriangle(center, m_verts[i * 3], m_verts[i * 3 + 1], m_verts[i * 3 + 2], u, v);
+			if ((closest - center).GetLengthSquared() <= radius_sqr)
+			{
+				tris.push_back(m_tri_index[i]);
+				++found;
+			}
+		}
+	}
+
+	return found;
+}
+
+bool MeshBVH::FindClosestPoint(const Vector3& point, float max_dist, sBVHHit& hit) const
+{
+	hit = sBVHHit();
+	if (m_nodes.empty())
+		return false;
+
+	float best_sqr = max_dist * max_dist;
+	uint best_slot = BVH_INVALID;
+
+	uint stack[BVH_STACK_SIZE];
+	uint top = 0;
+	stack[top++] = 0;
+
+	while (top > 0)
+	{
+		const sBVHNode& node = m_nodes[stack[--top]];
+		if (node.m_bound.GetDistSquared(point) > best_sqr)
+			continue;
+
+		if (!node.IsLeaf())
+		{
+			// nearer child on top of the stack, it usually shrinks the search radius the most
+			float d_left = m_nodes[node.m_offset].m_bound.GetDistSquared(point);
+			float d_right = m_nodes[node.m_offset + 1].m_bound.GetDistSquared(point);
+			bool left_first = (d_left <= d_right);
+			stack[top++] = left_first ? (node.m_offset + 1) : node.m_offset;
+			stack[top++] = left_first ? node.m_offset : (node.m_offset + 1);
+			continue;
+		}
+
+		for (uint i = node.m_offset; i < node.m_offset + node.m_count; ++i)
+		{
+			float u, v;
+			Vector3 closest = ClosestPointOnTriangle(point, m_verts[i * 3], m_verts[i * 3 + 1], m_verts[i * 3 + 2], u, v);
+			float dist_sqr = (closest - point).GetLengthSquared();
+			if (dist_sqr <= best_sqr)
+			{
+				best_sqr = dist_sqr;
+				best_slot = i;
+				hit.m_pos = closest;
+				hit.m_u = u;
+				hit.m_v = v;
+			}
+		}
+	}
+
+	if (best_slot == BVH_INVALID)
+		return false;
+
+	const Vector3& a = m_verts[best_slot * 3];
+	hit.m_tri = m_tri_index[best_slot];
+	hit.m_dist = sqrtf(best_sqr);
+	hit.m_normal = (m_verts[best_slot * 3 + 1] - a).Cross(m_verts[best_slot * 3 + 2] - a).GetNormalized();
+	return true;
+}
+
+// Ericson, Real-Time Collision Detection 5.1.5
+Vector3 MeshBVH::ClosestPointOnTriangle(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c, float& u, float& v)
+{
+	Vector3 ab = b - a;
+	Vector3 ac = c - a;
+	Vector3 ap = p - a;
+
+	float d1 = DotProduct(ab, ap);
+	float d2 = DotProduct(ac, ap);
+	if (d1 <= 0.f && d2 <= 0.f)
+	{
+		u = 0.f; v = 0.f;
+		return a;
+	}
+
+	Vector3 bp = p - b;
+	float d3 = DotProduct(ab, bp);
+	float d4 = DotProduct(ac, bp);
+	if (d3 >= 0.f && d4 <= d3)
+	{
+		u = 1.f; v = 0.f;
+		return b;
+	}
+
+	float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f)
+	{
+		u = d1 / (d1 - d3); v = 0.f;
+		return a + ab * u;
+	}
+
+	Vector3 cp = p - c;
+	float d5 = DotProduct(ab, cp);
+	float d6 = DotProduct(ac, cp);
+	if (d6 >= 0.f && d5 <= d6)
+	{
+		u = 0.f; v = 1.f;
+		return c;
+	}
+
+	float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f)
+	{
+		u = 0.f; v = d2 / (d2 - d6);
+		return a + ac * v;
+	}
+
+	float va = d3 * d6 - d5 * d4;
+	if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f)
+	{
+		float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		u = 1.f - w; v = w;
+		return b + (c - b) * w;
+	}
+
+	float denom = 1.f / (va + vb + vc);
+	u = vb * denom;
+	v = vc * denom;
+	return a + ab * u + ac * v;
+}
+
+// Moller-Trumbore, two sided
+bool MeshBVH::RayVsTriangle(const Vector3& start, const Vector3& dir, const Vector3& a, const Vector3& b, const Vector3& c, float max_dist, float& dist, float& u, float& v)
+{
+	Vector3 e1 = b - a;
+	Vector3 e2 = c - a;
+	Vector3 pvec = dir.Cross(e2);
+	float det = DotProduct(e1, pvec);
+	if (abs(det) < 1e-12f)
+		return false;
+
+	float inv_det = 1.f / det;
+	Vector3 tvec = start - a;
+	u = DotProduct(tvec, pvec) * inv_det;
+	if (u < 0.f || u > 1.f)
+		return false;
+
+	Vector3 qvec = tvec.Cross(e1);
+	v = DotProduct(dir, qvec) * inv_det;
+	if (v < 0.f || u + v > 1.f)
+		return false;
+
+	dist = DotProduct(e2, qvec) * inv_det;
+	return dist >= 0.f && dist <= max_dist;
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <vector>
+
+#define BVH_LEAF_SIZE 4
+#define BVH_MAX_LEAF_SIZE 16
+#define BVH_SAH_BINS 12
+#define BVH_PARALLEL_DEPTH 3			// up to 2^3 subtrees built on their own threads
+#define BVH_PARALLEL_MIN_TRIS 4096
+#define BVH_STACK_SIZE 64
+#define BVH_INVALID 0xffffffff
+
+class MeshBuilder;
+
+// 32 bytes; children of an internal node sit next to each other so subtrees built apart can be spliced
+struct sBVHNode
+{
+	AABB3 m_bound;
+	uint m_offset;		// leaf: first triangle, internal: left child (right child is m_offset + 1)
+	uint m_count;		// triangle count, 0 for internal nodes
+
+	bool IsLeaf() const { return m_count > 0; }
+};
+
+struct sBVHHit
+{
+	uint m_tri = BVH_INVALID;		// triangle index in the source index buffer order
+	float m_dist = 0.f;
+	Vector3 m_pos;
+	Vector3 m_normal;				// face normal from winding
+	float m_u = 0.f;				// barycentrics of the second and third vertex
+	float m_v = 0.f;
+
+	bool IsValid() const { return m_tri != BVH_INVALID; }
+};
+
+struct sBVHBuildTask
+{
+	uint m_node;
+	uint m_begin;
+	uint m_end;
+	uint m_depth;
+	std::vector<sBVHNode> m_nodes;
+};
+
+/*
+ * Bounding volume hierarchy over a static triangle mesh.
+ * Built top down with binned SAH; the top levels are split on the calling thread and the subtrees
+ * below BVH_PARALLEL_DEPTH are built in parallel. Triangle vertices are copied in leaf order
+ * so a leaf reads one contiguous block.
+ */
+class MeshBVH
+{
+	std::vector<sBVHNode> m_nodes;
+	std::vector<Vector3> m_verts;			// 3 per triangle, in leaf order
+	std::vector<uint> m_tri_index;			// leaf order -> source triangle
+
+	// build scratch
+	std::vector<AABB3> m_build_bounds;
+	std::vector<Vector3> m_build_centroids;
+	std::vector<uint> m_build_order;
+	std::vector<sBVHBuildTask> m_build_tasks;
+
+public:
+	void Build(const Vector3* positions, const uint* indices, uint tri_count, bool parallel = true);
+	void Build(const MeshBuilder& builder, bool parallel = true);
+	void Clear();
+
+	bool Raycast(const Vector3& start, const Vector3& dir, float max_dist, sBVHHit& hit) const;
+	uint QuerySphere(const Vector3& center, float radius, std::vector<uint>& tris) const;
+	bool FindClosestPoint(const Vector3& point, float max_dist, sBVHHit& hit) const;
+
+	const std::vector<sBVHNode>& GetNodes() const { return m_nodes; }
+	uint GetTriangleCount() const { return (uint)m_tri_index.size(); }
+	AABB3 GetBound() const { return m_nodes.empty() ? AABB3::MakeEmpty() : m_nodes[0].m_bound; }
+
+	static Vector3 ClosestPointOnTriangle(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c, float& u, float& v);
+	static bool RayVsTriangle(const Vector3& start, const Vector3& dir, const Vector3& a, const Vector3& b, const Vector3& c, float max_dist, float& dist, float& u, float& v);
+
+	void BuildTask(uint idx);
+
+private:
+	void BuildNode(std::vector<sBVHNode>& nodes, uint node, uint begin, uint end, uint depth, bool defer);
+	uint SplitSAH(uint begin, uint end, const AABB3& bound);
+};
\ No newline at end of file
@@ -0,0 +1,341 @@
+#include "Engine/Math/NoiseTileCache.hpp"
+#include "Engine/Math/SmoothNoiseGrid.hpp"
+#include "Engine/Math/RawNoise.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+static inline unsigned int FloatBits(float value)
+{
+	unsigned int bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+// rounds toward negative infinity, so tile -1 holds the samples just left of the origin
+static inline int FloorDiv(int value, int divisor)
+{
+	int quotient = value / divisor;
+	if ((value % divisor != 0) && (value < 0))
+		--quotient;
+	return quotient;
+}
+
+////////////////////////////////////// Keys //////////////////////////////////////
+bool sNoiseTileParams::operator==(const sNoiseTileParams& rhs) const
+{
+	return m_function == rhs.m_function && m_scale == rhs.m_scale && m_numOctaves == rhs.m_numOctaves
+		&& m_octavePersistence == rhs.m_octavePersistence && m_octaveScale == rhs.m_octaveScale
+		&& m_renormalize == rhs.m_renormalize && m_seed == rhs.m_seed;
+}
+
+bool sNoiseTileKey::operator==(const sNoiseTileKey& rhs) const
+{
+	return m_tileX == rhs.m_tileX && m_tileY == rhs.m_tileY && m_lod == rhs.m_lod && m_params == rhs.m_params;
+}
+
+size_t sNoiseTileKeyHash::operator()(const sNoiseTileKey& key) const
+{
+	const sNoiseTileParams& params = key.m_params;
+	unsigned int bits = Get1dNoiseUint((int)params.m_function, params.m_seed);
+	bits = Get1dNoiseUint((int)FloatBits(params.m_scale), bits);
+	bits = Get1dNoiseUint((int)params.m_numOctaves, bits);
+	bits = Get1dNoiseUint((int)FloatBits(params.m_octavePersistence), bits);
+	bits = Get1dNoiseUint((int)FloatBits(params.m_octaveScale), bits);
+	bits = Get1dNoiseUint(params.m_renormalize ? 1 : 0, bits);
+	return (size_t)Get3dNoiseUint(key.m_tileX, key.m_tileY, (int)key.m_lod, bits);
+}
+
+////////////////////////////////////// Cache //////////////////////////////////////
+NoiseTileCache::NoiseTileCache(size_t memoryBudget, uint tileSize, float spacing, uint numWorkers)
+	: m_tileSize(tileSize)
+	, m_spacing(spacing)
+	, m_memoryBudget(memoryBudget)
+{
+	ASSERT_OR_DIE(tileSize > 0, "noise tiles need at least one sample per side");
+	ASSERT_OR_DIE(spacing > 0.f, "noise tile spacing must be positive");
+
+	m_tileBytes = (size_t)(tileSize + 1) * (tileSize + 1) * sizeof(float) + sizeof(sTile) + sizeof(sNoiseTileKey);
+
+	if (numWorkers == 0)
+	{
+		uint cores = ThreadGetCoreCount();
+		numWorkers = (cores > 1) ? cores - 1 : 1;
+	}
+	for (uint i = 0; i < numWorkers; ++i)
+		m_workers.push_back(ThreadCreate("noise_tiles", WorkerMain, this));
+}
+
+NoiseTileCache::~NoiseTileCache()
+{
+	m_lock.Enter();
+	m_running = false;
+	m_lock.Leave();
+	m_requestAdded.notify_all();
+
+	if (!m_workers.empty())
+		ThreadJoin(&m_workers[0], m_workers.size());
+}
+
+void NoiseTileCache::Prefetch(const sNoiseTileParams& params, uint lod, float minX, float minY, float maxX, float maxY)
+{
+	float step = GetSampleStep(lod);
+	int tileMinX = FloorDiv((int)floorf(minX / step), (int)m_tileSize);
+	int tileMinY = FloorDiv((int)floorf(minY / step), (int)m_tileSize);
+	int tileMaxX = FloorDiv((int)floorf(maxX / step), (int)m_tileSize);
+	int tileMaxY = FloorDiv((int)floorf(maxY / step), (int)m_tileSize);
+
+	sNoiseTileKey key;
+	key.m_params = params;
+	key.m_lod = lod;
+
+	m_lock.Enter();
+	size_t queued = m_requests.size();
+	for (key.m_tileY = tileMinY; key.m_tileY <= tileMaxY; ++key.m_tileY)
+	{
+		for (key.m_tileX = tileMinX; key.m_tileX <= tileMaxX; ++key.m_tileX)
+		{
+			if (m_tiles.find(key) != m_tiles.end())
+				continue;
+
+			m_tiles[key].m_state = TILE_QUEUED;
+			m_requests.push_back(key);
+		}
+	}
+	queued = m_requests.size() - queued;
+	m_lock.Leave();
+
+	if (queued == 1)
+		m_requestAdded.notify_one();
+	else if (queued > 1)
+		m_requestAdded.notify_all();
+}
+
+bool NoiseTileCache::IsTileReady(const sNoiseTileParams& params, uint lod, int tileX, int tileY)
+{
+	sNoiseTileKey key;
+	key.m_params = params;
+	key.m_tileX = tileX;
+	key.m_tileY = tileY;
+	key.m_lod = lod;
+
+	m_lock.Enter();
+	tTileMap::iterator it = m_tiles.find(key);
+	bool ready = (it != m_tiles.end()) && (it->second.m_state == TILE_READY);
+	m_lock.Leave();
+	return ready;
+}
+
+float NoiseTileCache::SamplePoint(const sNoiseTileParams& params, uint lod, float x, float y)
+{
+	float step = GetSampleStep(lod);
+	int column = (int)floorf((x / step) + 0.5f);
+	int row = (int)floorf((y / step) + 0.5f);
+
+	sNoiseTileKey key;
+	key.m_params = params;
+	key.m_tileX = FloorDiv(column, (int)m_tileSize);
+	key.m_tileY = FloorDiv(row, (int)m_tileSize);
+	key.m_lod = lod;
+
+	uint localX = (uint)(column - key.m_tileX * (int)m_tileSize);
+	uint localY = (uint)(row - key.m_tileY * (int)m_tileSize);
+
+	m_lock.Enter();
+	const float* samples = AcquireTileLocked(key);
+	float value = samples[localY * (m_tileSize + 1) + localX];
+	m_lock.Leave();
+	return value;
+}
+
+float NoiseTileCache::SampleBilinear(const sNoiseTileParams& params, uint lod, float x, float y)
+{
+	sNoiseTileKey lastKey;
+	const float* lastTile = nullptr;
+
+	m_lock.Enter();
+	float value = SampleBilinearLocked(params, lod, x, y, lastKey, lastTile);
+	m_lock.Leave();
+	return value;
+}
+
+// one lock for the whole batch, and neighbouring positions reuse the tile without another lookup
+void NoiseTileCache::SampleBilinear(const sNoiseTileParams& params, uint lod, const Vector2* positions, uint count, float* out)
+{
+	sNoiseTileKey lastKey;
+	const float* lastTile = nullptr;
+
+	m_lock.Enter();
+	for (uint idx = 0; idx < count; ++idx)
+		out[idx] = SampleBilinearLocked(params, lod, positions[idx].x, positions[idx].y, lastKey, lastTile);
+	m_lock.Leave();
+}
+
+void NoiseTileCache::Clear()
+{
+	m_lock.Enter();
+	for (tTileMap::iterator it = m_tiles.begin(); it != m_tiles.end(); )
+	{
+		if (it->second.m_state == TILE_GENERATING)
+			++it;
+		else
+			it = m_tiles.erase(it);
+	}
+	m_lru.clear();
+	m_requests.clear();
+	m_memoryUsed = 0;
+	m_lock.Leave();
+}
+
+float NoiseTileCache::GetSampleStep(uint lod) const
+{
+	return m_spacing * (float)(1u << lod);
+}
+
+////////////////////////////////////// Internal //////////////////////////////////////
+// returns the ready samples of the tile, valid until the lock is left; computes the tile on this
+// thread when it is missing or still queued, and waits when a worker is already on it
+const float* NoiseTileCache::AcquireTileLocked(const sNoiseTileKey& key)
+{
+	for (;;)
+	{
+		tTileMap::iterator it = m_tiles.find(key);
+		if (it != m_tiles.end() && it->second.m_state == TILE_READY)
+		{
+			++m_hits;
+			m_lru.splice(m_lru.begin(), m_lru, it->second.m_lru);
+			return it->second.m_samples.data();
+		}
+
+		if (it != m_tiles.end() && it->second.m_state == TILE_GENERATING)
+		{
+			// m_lock is held, hand it to the wait and take it back without unlocking twice
+			std::unique_lock<std::mutex> lock(m_lock.m_lock, std::adopt_lock);
+			m_tileFinished.wait(lock);
+			lock.release();
+			continue;
+		}
+
+		++m_misses;
+		m_tiles[key].m_state = TILE_GENERATING;
+		m_lock.Leave();
+
+		std::vector<float> samples;
+		GenerateTile(key, samples);
+
+		m_lock.Enter();
+		FinishTileLocked(key, samples);
+		return m_tiles[key].m_samples.data();
+	}
+}
+
+void NoiseTileCache::GenerateTile(const sNoiseTileKey& key, std::vector<float>& samples) const
+{
+	const sNoiseTileParams& params = key.m_params;
+	float step = GetSampleStep(key.m_lod);
+	float minX = (float)((double)key.m_tileX * m_tileSize * step);
+	float minY = (float)((double)key.m_tileY * m_tileSize * step);
+	uint side = m_tileSize + 1;
+
+	samples.resize((size_t)side * side);
+	switch (params.m_function)
+	{
+	case NOISE_TILE_FRACTAL:
+		Compute2dFractalNoiseGrid(minX, minY, step, side, side, samples.data(),
+			params.m_scale, params.m_numOctaves, params.m_octavePersistence, params.m_octaveScale, params.m_renormalize, params.m_seed);
+		break;
+	case NOISE_TILE_PERLIN:
+		Compute2dPerlinNoiseGrid(minX, minY, step, side, side, samples.data(),
+			params.m_scale, params.m_numOctaves, params.m_octavePersistence, params.m_octaveScale, params.m_renormalize, params.m_seed);
+		break;
+	case NOISE_TILE_SIMPLEX:
+		Compute2dSimplexNoiseGrid(minX, minY, step, side, side, samples.data(),
+			params.m_scale, params.m_numOctaves, params.m_octavePersistence, params.m_octaveScale, params.m_renormalize, params.m_seed);
+		break;
+	default:
+		ERROR_AND_DIE("unknown noise tile function");
+	}
+}
+
+// the tile was claimed as generating, so Clear left it in the map
+void NoiseTileCache::FinishTileLocked(const sNoiseTileKey& key, std::vector<float>& samples)
+{
+	sTile& tile = m_tiles[key];
+	tile.m_samples.swap(samples);
+	tile.m_state = TILE_READY;
+	m_lru.push_front(key);
+	tile.m_lru = m_lru.begin();
+	m_memoryUsed += m_tileBytes;
+
+	EvictLocked();
+	m_tileFinished.notify_all();
+}
+
+// the most recent tile always stays, it is the one somebody is about to read
+void NoiseTileCache::EvictLocked()
+{
+	while (m_memoryUsed > m_memoryBudget && m_lru.size() > 1)
+	{
+		m_tiles.erase(m_lru.back());
+		m_lru.pop_back();
+		m_memoryUsed -= m_tileBytes;
+	}
+}
+
+float NoiseTileCache::SampleBilinearLocked(const sNoiseTileParams& params, uint lod, float x, float y, sNoiseTileKey& lastKey, const float*& lastTile)
+{
+	float step = GetSampleStep(lod);
+	float cellX = floorf(x / step);
+	float cellY = floorf(y / step);
+	float fracX = (x / step) - cellX;
+	float fracY = (y / step) - cellY;
+
+	sNoiseTileKey key;
+	key.m_params = params;
+	key.m_tileX = FloorDiv((int)cellX, (int)m_tileSize);
+	key.m_tileY = FloorDiv((int)cellY, (int)m_tileSize);
+	key.m_lod = lod;
+
+	if (lastTile == nullptr || !(key == lastKey))
+	{
+		lastTile = AcquireTileLocked(key);
+		lastKey = key;
+	}
+
+	uint side = m_tileSize + 1;
+	uint localX = (uint)((int)cellX - key.m_tileX * (int)m_tileSize);
+	uint localY = (uint)((int)cellY - key.m_tileY * (int)m_tileSize);
+	const float* row0 = lastTile + localY * side + localX;
+	const float* row1 = row0 + side;
+
+	float bottom = row0[0] + (fracX * (row0[1] - row0[0]));
+	float top = row1[0] + (fracX * (row1[1] - row1[0]));
+	return bottom + (fracY * (top - bottom));
+}
+
+// a request is skipped when a lookup already claimed it; workers sleep on m_requestAdded while the queue is empty
+void NoiseTileCache::WorkerMain(void* userData)
+{
+	NoiseTileCache* cache = (NoiseTileCache*)(userData);
+	std::vector<float> samples;
+
+	std::unique_lock<std::mutex> lock(cache->m_lock.m_lock);
+	for (;;)
+	{
+		cache->m_requestAdded.wait(lock, [cache]() { return !cache->m_running || !cache->m_requests.empty(); });
+		if (!cache->m_running)
+			break;
+
+		sNoiseTileKey key = cache->m_requests.front();
+		cache->m_requests.pop_front();
+
+		tTileMap::iterator it = cache->m_tiles.find(key);
+		if (it == cache->m_tiles.end() || it->second.m_state != TILE_QUEUED)
+			continue;
+		it->second.m_state = TILE_GENERATING;
+
+		lock.unlock();
+		cache->GenerateTile(key, samples);
+		lock.lock();
+
+		cache->FinishTileLocked(key, samples);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Engine/Math/Vector2.hpp"
+#include "Engine/Core/Thread/SpinLock.hpp"
+#include "Engine/Core/Thread/Thread.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#define NOISE_TILE_DEFAULT_SIZE 64			// samples per tile side, one more is stored for the shared edge
+
+enum eNoiseTileFunction
+{
+	NOISE_TILE_FRACTAL,
+	NOISE_TILE_PERLIN,
+	NOISE_TILE_SIMPLEX
+};
+
+// arguments of the Compute2d*NoiseGrid call that fills a tile
+struct sNoiseTileParams
+{
+	eNoiseTileFunction m_function = NOISE_TILE_PERLIN;
+	float m_scale = 1.f;
+	uint m_numOctaves = 1;
+	float m_octavePersistence = 0.5f;
+	float m_octaveScale = 2.f;
+	bool m_renormalize = true;
+	unsigned int m_seed = 0;
+
+	bool operator==(const sNoiseTileParams& rhs) const;
+	bool operator!=(const sNoiseTileParams& rhs) const { return !(*this == rhs); }
+};
+
+struct sNoiseTileKey
+{
+	sNoiseTileParams m_params;
+	int m_tileX = 0;
+	int m_tileY = 0;
+	uint m_lod = 0;
+
+	bool operator==(const sNoiseTileKey& rhs) const;
+};
+
+struct sNoiseTileKeyHash
+{
+	size_t operator()(const sNoiseTileKey& key) const;
+};
+
+/*
+ * 2d noise cached in square tiles so chunks streaming in and out do not resample the same field.
+ * At lod L samples lie spacing * 2^L apart and a tile covers tileSize of them per side; it stores
+ * tileSize + 1 so a bilinear cell never straddles two tiles. Prefetch queues tiles for the worker
+ * threads, which sleep until it does; lookups on a tile that is not ready yet compute it on the
+ * calling thread. Ready tiles are evicted least recently used first once they go over the memory budget.
+ */
+class NoiseTileCache
+{
+public:
+	NoiseTileCache(size_t memoryBudget, uint tileSize = NOISE_TILE_DEFAULT_SIZE, float spacing = 1.f, uint numWorkers = 0);		// 0 workers means one per core but one
+	~NoiseTileCache();
+
+	// queue every tile overlapping the box for the workers
+	void		Prefetch(const sNoiseTileParams& params, uint lod, float minX, float minY, float maxX, float maxY);
+	bool		IsTileReady(const sNoiseTileParams& params, uint lod, int tileX, int tileY);
+
+	float		SamplePoint(const sNoiseTileParams& params, uint lod, float x, float y);		// nearest sample
+	float		SampleBilinear(const sNoiseTileParams& params, uint lod, float x, float y);
+	void		SampleBilinear(const sNoiseTileParams& params, uint lod, const Vector2* positions, uint count, float* out);
+
+	void		Clear();		// drops ready and queued tiles; tiles being generated finish and are kept
+
+	float		GetSampleStep(uint lod) const;
+	size_t		GetMemoryUsed() const { return m_memoryUsed; }
+	size_t		GetMemoryBudget() const { return m_memoryBudget; }
+	uint		GetTileCount() const { return (uint)m_tiles.size(); }
+	uint		GetHitCount() const { return m_hits; }
+	uint		GetMissCount() const { return m_misses; }
+
+private:
+	enum eTileState
+	{
+		TILE_QUEUED,
+		TILE_GENERATING,
+		TILE_READY
+	};
+
+	struct sTile
+	{
+		eTileState m_state = TILE_QUEUED;
+		std::vector<float> m_samples;		// (tileSize + 1)^2, row major
+		std::list<sNoiseTileKey>::iterator m_lru;
+	};
+
+	typedef std::unordered_map<sNoiseTileKey, sTile, sNoiseTileKeyHash> tTileMap;
+
+private:
+	const float* AcquireTileLocked(const sNoiseTileKey& key);
+	void		GenerateTile(const sNoiseTileKey& key, std::vector<float>& samples) const;
+	void		FinishTileLocked(const sNoiseTileKey& key, std::vector<float>& samples);
+	void		EvictLocked();
+	float		SampleBilinearLocked(const sNoiseTileParams& params, uint lod, float x, float y, sNoiseTileKey& lastKey, const float*& lastTile);
+
+	static void	WorkerMain(void* userData);
+
+private:
+	uint		m_tileSize;
+	float		m_spacing;
+	size_t		m_tileBytes;
+	size_t		m_memoryBudget;
+	size_t		m_memoryUsed = 0;
+	uint		m_hits = 0;
+	uint		m_misses = 0;
+
+	SpinLock	m_lock;					// guards the map, the lru list, the request queue, the counters and m_running
+	tTileMap	m_tiles;
+	std::list<sNoiseTileKey> m_lru;		// ready tiles, most recently used first
+
+	std::deque<sNoiseTileKey> m_requests;
+	std::condition_variable m_requestAdded;		// workers wait here while m_requests is empty
+	std::condition_variable m_tileFinished;		// lookups wait here on a tile a worker is generating
+	std::vector<tThreadHandle> m_workers;
+	bool		m_running = true;
+};
\ No newline at end of file
@@ -0,0 +1,348 @@
+#include "Engine/Math/Random.hpp"
+#include "Engine/Math/MathSIMD.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <atomic>
+#include <string.h>
+
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "FillVector3sInRange writes vectors as packed floats");
+
+static std::atomic<uint64_t> s_baseSeed(RANDOM_DEFAULT_SEED);
+static std::atomic<uint> s_threadStreams(0);
+
+static inline uint64_t SplitMix64(uint64_t& state)
+{
+	uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return z ^ (z >> 31);
+}
+
+static inline uint RotateLeft(uint x, int k)
+{
+	return (x << k) | (x >> (32 - k));
+}
+
+// one xoshiro128** step on words spread stride apart
+static inline uint XoshiroNext(uint* s, uint stride)
+{
+	uint s0 = s[0], s1 = s[stride], s2 = s[2 * stride], s3 = s[3 * stride];
+	uint result = RotateLeft(s1 * 5, 7) * 9;
+	uint t = s1 << 9;
+
+	s2 ^= s0;
+	s3 ^= s1;
+	s1 ^= s2;
+	s0 ^= s3;
+	s2 ^= t;
+	s3 = RotateLeft(s3, 11);
+
+	s[0] = s0; s[stride] = s1; s[2 * stride] = s2; s[3 * stride] = s3;
+	return result;
+}
+
+static inline float UintToUnitFloat(uint r)
+{
+	// top 24 bits, exactly representable; the largest one maps to exactly 1
+	return (float)(r >> 8) * (1.f / 16777215.f);
+}
+
+#if MATH_SIMD_SSE
+static inline __m128i SIMDRotateLeft(__m128i x, int k)
+{
+	return _mm_or_si128(_mm_slli_epi32(x, k), _mm_srli_epi32(x, 32 - k));
+}
+
+// the same step on 4 generators at once; * 5 and * 9 as shifts since sse2 has no 32 bit multiply
+static inline __m128i SIMDXoshiroNext(__m128i* s)
+{
+	__m128i times5 = _mm_add_epi32(s[1], _mm_slli_epi32(s[1], 2));
+	__m128i rot = SIMDRotateLeft(times5, 7);
+	__m128i result = _mm_add_epi32(rot, _mm_slli_epi32(rot, 3));
+	__m128i t = _mm_slli_epi32(s[1], 9);
+
+	s[2] = _mm_xor_si128(s[2], s[0]);
+	s[3] = _mm_xor_si128(s[3], s[1]);
+	s[1] = _mm_xor_si128(s[1], s[2]);
+	s[0] = _mm_xor_si128(s[0], s[3]);
+	s[2] = _mm_xor_si128(s[2], t);
+	s[3] = SIMDRotateLeft(s[3], 11);
+
+	return result;
+}
+
+static inline __m128 SIMDUintToUnitFloat(__m128i r)
+{
+	return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(r, 8)), _mm_set1_ps(1.f / 16777215.f));
+}
+
+// high 32 bits of r * range per lane
+static inline __m128i SIMDMulHigh(__m128i r, __m128i range)
+{
+	__m128i even = _mm_srli_epi64(_mm_mul_epu32(r, range), 32);
+	__m128i odd = _mm_mul_epu32(_mm_srli_epi64(r, 32), range);
+	__m128i oddMask = _mm_set_epi32(-1, 0, -1, 0);
+	return _mm_or_si128(even, _mm_and_si128(odd, oddMask));
+}
+#endif
+
+////////////////////////////////////// Generator //////////////////////////////////////
+RandomGenerator::RandomGenerator(uint64_t seed)
+{
+	Seed(seed);
+}
+
+void RandomGenerator::Seed(uint64_t seed)
+{
+	uint64_t mix = seed;
+	uint64_t a = SplitMix64(mix);
+	uint64_t b = SplitMix64(mix);
+	m_state[0] = (uint)a;
+	m_state[1] = (uint)(a >> 32);
+	m_state[2] = (uint)b;
+	m_state[3] = (uint)(b >> 32);
+
+	// all zero is the one state xoshiro never leaves
+	if ((m_state[0] | m_state[1] | m_state[2] | m_state[3]) == 0)
+		m_state[0] = 1;
+
+	m_lanesSeeded = false;
+}
+
+void RandomGenerator::Jump()
+{
+	static const uint JUMP[4] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+
+	uint s[4] = { 0, 0, 0, 0 };
+	for (int i = 0; i < 4; ++i)
+	{
+		for (int b = 0; b < 32; ++b)
+		{
+			if (JUMP[i] & (1u << b))
+			{
+				s[0] ^= m_state[0];
+				s[1] ^= m_state[1];
+				s[2] ^= m_state[2];
+				s[3] ^= m_state[3];
+			}
+			NextUint();
+		}
+	}
+	memcpy(m_state, s, sizeof(s));
+	m_lanesSeeded = false;
+}
+
+RandomGenerator RandomGenerator::MakeStream(uint64_t seed, uint stream)
+{
+	uint64_t mix = seed ^ ((uint64_t)stream * 0xd1342543de82ef95ull);
+	return RandomGenerator(SplitMix64(mix));
+}
+
+uint RandomGenerator::NextUint()
+{
+	return XoshiroNext(m_state, 1);
+}
+
+float RandomGenerator::NextFloatZeroToOne()
+{
+	return UintToUnitFloat(NextUint());
+}
+
+float RandomGenerator::NextFloatInRange(float minInclusive, float maxInclusive)
+{
+	return minInclusive + NextFloatZeroToOne() * (maxInclusive - minInclusive);
+}
+
+int RandomGenerator::NextIntLessThan(int maxNotInclusive)
+{
+	ASSERT_OR_DIE(maxNotInclusive > 0, "Random int bound has to be positive");
+
+	// multiply and keep the high half instead of a modulo, no divide and far less bias
+	return (int)(((uint64_t)NextUint() * (uint64_t)maxNotInclusive) >> 32);
+}
+
+int RandomGenerator::NextIntInRange(int minInclusive, int maxInclusive)
+{
+	uint range = (uint)(maxInclusive - minInclusive) + 1u;
+	uint r = NextUint();
+	if (range != 0)
+		r = (uint)(((uint64_t)r * range) >> 32);
+	return (int)((uint)minInclusive + r);
+}
+
+bool RandomGenerator::NextChance(float chanceForSuccess)
+{
+	// [0, 1) here so 0 never succeeds and 1 always does
+	return (float)(NextUint() >> 8) * (1.f / 16777216.f) < chanceForSuccess;
+}
+
+Vector3 RandomGenerator::NextVector3InRange(const Vector3& min, const Vector3& max)
+{
+	float x = NextFloatInRange(min.x, max.x);
+	float y = NextFloatInRange(min.y, max.y);
+	float z = NextFloatInRange(min.z, max.z);
+	return Vector3(x, y, z);
+}
+
+////////////////////////////////////// Bulk //////////////////////////////////////
+void RandomGenerator::SeedLanes()
+{
+	// each lane gets its own splitmix seeded from the main sequence
+	for (uint lane = 0; lane < 4; ++lane)
+	{
+		uint64_t mix = ((uint64_t)NextUint() << 32) | NextUint();
+		uint64_t a = SplitMix64(mix);
+		uint64_t b = SplitMix64(mix);
+		m_lanes[0 * 4 + lane] = (uint)a;
+		m_lanes[1 * 4 + lane] = (uint)(a >> 32);
+		m_lanes[2 * 4 + lane] = (uint)b;
+		m_lanes[3 * 4 + lane] = (uint)(b >> 32) | 1u;
+	}
+	m_lanesSeeded = true;
+}
+
+void RandomGenerator::FillFloatsPattern(float* out, uint count, const float* mins, const float* scales)
+{
+	if (!m_lanesSeeded)
+		SeedLanes();
+
+	uint idx = 0;
+	uint phase = 0;		// which 4 of the 12 pattern floats
+
+#if MATH_SIMD_SSE
+	__m128i s[4];
+	for (int w = 0; w < 4; ++w)
+		s[w] = _mm_loadu_si128((const __m128i*)(m_lanes + w * 4));
+
+	__m128 minVec[3], scaleVec[3];
+	for (int p = 0; p < 3; ++p)
+	{
+		minVec[p] = _mm_loadu_ps(mins + p * 4);
+		scaleVec[p] = _mm_loadu_ps(scales + p * 4);
+	}
+
+	for (; idx + 4 <= count; idx += 4)
+	{
+		__m128 unit = SIMDUintToUnitFloat(SIMDXoshiroNext(s));
+		_mm_storeu_ps(out + idx, _mm_add_ps(minVec[phase], _mm_mul_ps(unit, scaleVec[phase])));
+		phase = (phase == 2) ? 0 : phase + 1;
+	}
+
+	if (idx < count)
+	{
+		uint raw[4];
+		_mm_storeu_si128((__m128i*)raw, SIMDXoshiroNext(s));
+		for (uint lane = 0; idx < count; ++idx, ++lane)
+			out[idx] = mins[phase * 4 + lane] + UintToUnitFloat(raw[lane]) * scales[phase * 4 + lane];
+	}
+
+	for (int w = 0; w < 4; ++w)
+		_mm_storeu_si128((__m128i*)(m_lanes + w * 4), s[w]);
+#else
+	while (idx < count)
+	{
+		uint raw[4];
+		for (uint lane = 0; lane < 4; ++lane)
+			raw[lane] = XoshiroNext(m_lanes + lane, 4);
+
+		for (uint lane = 0; lane < 4 && idx < count; ++idx, ++lane)
+			out[idx] = mins[phase * 4 + lane] + UintToUnitFloat(raw[lane]) * scales[phase * 4 + lane];
+		phase = (phase == 2) ? 0 : phase + 1;
+	}
+#endif
+}
+
+void RandomGenerator::FillFloatsZeroToOne(float* out, uint count)
+{
+	FillFloatsInRange(out, count, 0.f, 1.f);
+}
+
+void RandomGenerator::FillFloatsInRange(float* out, uint count, float minInclusive, float maxInclusive)
+{
+	float mins[12], scales[12];
+	for (int i = 0; i < 12; ++i)
+	{
+		mins[i] = minInclusive;
+		scales[i] = maxInclusive - minInclusive;
+	}
+	FillFloatsPattern(out, count, mins, scales);
+}
+
+void RandomGenerator::FillVector3sInRange(Vector3* out, uint count, const Vector3& min, const Vector3& max)
+{
+	// 12 floats are 4 whole vectors: x y z x | y z x y | z x y z
+	float mins[12], scales[12];
+	for (int i = 0; i < 12; ++i)
+	{
+		int axis = i % 3;
+		mins[i] = (axis == 0) ? min.x : ((axis == 1) ? min.y : min.z);
+		scales[i] = (axis == 0) ? (max.x - min.x) : ((axis == 1) ? (max.y - min.y) : (max.z - min.z));
+	}
+	FillFloatsPattern(&out->x, count * 3, mins, scales);
+}
+
+void RandomGenerator::FillIntsInRange(int* out, uint count, int minInclusive, int maxInclusive)
+{
+	if (!m_lanesSeeded)
+		SeedLanes();
+
+	uint range = (uint)(maxInclusive - minInclusive) + 1u;		// 0 is the full 32 bit range
+	uint idx = 0;
+
+#if MATH_SIMD_SSE
+	__m128i s[4];
+	for (int w = 0; w < 4; ++w)
+		s[w] = _mm_loadu_si128((const __m128i*)(m_lanes + w * 4));
+
+	__m128i rangeVec = _mm_set1_epi32((int)range);
+	__m128i minVec = _mm_set1_epi32(minInclusive);
+
+	for (; idx + 4 <= count; idx += 4)
+	{
+		__m128i r = SIMDXoshiroNext(s);
+		if (range != 0)
+			r = SIMDMulHigh(r, rangeVec);
+		_mm_storeu_si128((__m128i*)(out + idx), _mm_add_epi32(r, minVec));
+	}
+
+	if (idx < count)
+	{
+		uint raw[4];
+		_mm_storeu_si128((__m128i*)raw, SIMDXoshiroNext(s));
+		for (uint lane = 0; idx < count; ++idx, ++lane)
+		{
+			uint r = (range != 0) ? (uint)(((uint64_t)raw[lane] * range) >> 32) : raw[lane];
+			out[idx] = (int)((uint)minInclusive + r);
+		}
+	}
+
+	for (int w = 0; w < 4; ++w)
+		_mm_storeu_si128((__m128i*)(m_lanes + w * 4), s[w]);
+#else
+	while (idx < count)
+	{
+		uint raw[4];
+		for (uint lane = 0; lane < 4; ++lane)
+			raw[lane] = XoshiroNext(m_lanes + lane, 4);
+
+		for (uint lane = 0; lane < 4 && idx < count; ++idx, ++lane)
+		{
+			uint r = (range != 0) ? (uint)(((uint64_t)raw[lane] * range) >> 32) : raw[lane];
+			out[idx] = (int)((uint)minInclusive + r);
+		}
+	}
+#endif
+}
+
+////////////////////////////////////// Per thread //////////////////////////////////////
+RandomGenerator& GetThreadRandom()
+{
+	thread_local RandomGenerator t_random = RandomGenerator::MakeStream(s_baseSeed.load(), s_threadStreams++);
+	return t_random;
+}
+
+void SeedRandom(uint64_t seed)
+{
+	s_baseSeed = seed;
+	GetThreadRandom().Seed(seed);
+}
\ No newline at end of file
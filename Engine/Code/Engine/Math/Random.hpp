@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Engine/Math/Vector3.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <stdint.h>
+
+#define RANDOM_DEFAULT_SEED 0x853c49e6748fea9bull
+
+/*
+ * xoshiro128** generator. Each thread draws from its own (GetThreadRandom) so nothing is shared or locked;
+ * work split into jobs takes MakeStream(seed, job index) per job to get the same numbers on any thread count.
+ * Bulk fills run 4 extra interleaved generators side by side, SSE when available, with identical scalar results.
+ */
+class RandomGenerator
+{
+public:
+	explicit RandomGenerator(uint64_t seed = RANDOM_DEFAULT_SEED);
+
+	void	Seed(uint64_t seed);
+	void	Jump();		// skips 2^64 draws, sequences before and after never overlap
+	static RandomGenerator MakeStream(uint64_t seed, uint stream);
+
+	uint	NextUint();
+	float	NextFloatZeroToOne();		// [0, 1], like the rand() / RAND_MAX it replaced
+	float	NextFloatInRange(float minInclusive, float maxInclusive);
+	int		NextIntLessThan(int maxNotInclusive);
+	int		NextIntInRange(int minInclusive, int maxInclusive);
+	bool	NextChance(float chanceForSuccess);
+	Vector3 NextVector3InRange(const Vector3& min, const Vector3& max);
+
+	// bulk
+	void	FillFloatsZeroToOne(float* out, uint count);
+	void	FillFloatsInRange(float* out, uint count, float minInclusive, float maxInclusive);
+	void	FillIntsInRange(int* out, uint count, int minInclusive, int maxInclusive);
+	void	FillVector3sInRange(Vector3* out, uint count, const Vector3& min, const Vector3& max);
+
+private:
+	void	SeedLanes();
+	void	FillFloatsPattern(float* out, uint count, const float* mins, const float* scales);		// pattern repeats every 12 floats
+
+private:
+	uint m_state[4];
+	uint m_lanes[16];			// bulk generators, word w of lane l at [w * 4 + l]
+	bool m_lanesSeeded = false;
+};
+
+RandomGenerator&	GetThreadRandom();
+void				SeedRandom(uint64_t seed);		// reseeds this thread, threads that draw for the first time later derive from it
\ No newline at end of file
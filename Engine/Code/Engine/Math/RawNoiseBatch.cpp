@@ -0,0 +1,166 @@
+#include "Engine/Math/RawNoiseBatch.hpp"
+#include "Engine/Math/RawNoise.hpp"
+#include "Engine/Math/RawNoiseBatchAVX2.hpp"
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+// same constants as RawNoise.hpp
+#define NOISE_PRIME1 198491317u
+#define NOISE_PRIME2 6542989u
+
+static const double ONE_OVER_MAX_UINT = (1.0 / (double) 0xFFFFFFFF);
+static const double ONE_OVER_MAX_INT = (1.0 / (double) 0x7FFFFFFF);
+
+////////////////////////////////////// Lanes //////////////////////////////////////
+#if MATH_SIMD_SSE
+static inline __m128 NoiseToFloat4(__m128i bits, eNoiseOutput mode)
+{
+	__m128d lo, hi;
+	if (mode == NOISE_OUT_ZERO_TO_ONE)
+	{
+		__m128i flipped = _mm_xor_si128(bits, _mm_set1_epi32((int)0x80000000u));
+		__m128d offset = _mm_set1_pd(2147483648.0);
+		__m128d scale = _mm_set1_pd(ONE_OVER_MAX_UINT);
+		lo = _mm_mul_pd(scale, _mm_add_pd(_mm_cvtepi32_pd(flipped), offset));
+		hi = _mm_mul_pd(scale, _mm_add_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(flipped, _MM_SHUFFLE(1, 0, 3, 2))), offset));
+	}
+	else
+	{
+		__m128d scale = _mm_set1_pd(ONE_OVER_MAX_INT);
+		lo = _mm_mul_pd(scale, _mm_cvtepi32_pd(bits));
+		hi = _mm_mul_pd(scale, _mm_cvtepi32_pd(_mm_shuffle_epi32(bits, _MM_SHUFFLE(1, 0, 3, 2))));
+	}
+	return _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+}
+#endif
+
+////////////////////////////////////// Range //////////////////////////////////////
+// AVX2 needs the cpu (leaf 7 ebx bit 5) and the os saving the ymm registers (xgetbv bits 1 and 2)
+static bool DetectNoiseAVX2()
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+
+	__cpuid(info, 1);
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)		// osxsave, avx
+		return false;
+	if ((_xgetbv(0) & 0x6) != 0x6)
+		return false;
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	return __builtin_cpu_supports("avx2") != 0;
+#else
+	return false;
+#endif
+}
+
+static bool NoiseHasAVX2()
+{
+	static const bool hasAVX2 = DetectNoiseAVX2();
+	return hasAVX2;
+}
+
+// indices wrap like the int math in RawNoise.hpp, kept unsigned here so the wrap is defined
+static void NoiseRange(unsigned int start, uint count, void* out, eNoiseOutput mode, unsigned int seed)
+{
+	unsigned int* outUint = (unsigned int*)out;
+	float* outFloat = (float*)out;
+	uint idx = 0;
+
+	if (NoiseHasAVX2())
+		idx = NoiseRangeAVX2(start, count, out, mode, seed);
+
+#if MATH_SIMD_SSE
+	__m128i seedVec = _mm_set1_epi32((int)seed);
+	__m128i pos = _mm_add_epi32(_mm_set1_epi32((int)(start + idx)), _mm_setr_epi32(0, 1, 2, 3));
+	__m128i step = _mm_set1_epi32(4);
+	for (; idx + 4 <= count; idx += 4)
+	{
+		__m128i bits = SIMDNoiseHash4(pos, seedVec);
+		if (mode == NOISE_OUT_UINT)
+			_mm_storeu_si128((__m128i*)(outUint + idx), bits);
+		else
+			_mm_storeu_ps(outFloat + idx, NoiseToFloat4(bits, mode));
+		pos = _mm_add_epi32(pos, step);
+	}
+#endif
+
+	for (; idx < count; ++idx)
+	{
+		int index = (int)(start + idx);
+		if (mode == NOISE_OUT_UINT)
+			outUint[idx] = Get1dNoiseUint(index, seed);
+		else if (mode == NOISE_OUT_ZERO_TO_ONE)
+			outFloat[idx] = Get1dNoiseZeroToOne(index, seed);
+		else
+			outFloat[idx] = Get1dNoiseNegOneToOne(index, seed);
+	}
+}
+
+static void NoiseGrid3d(int minX, int minY, int minZ, uint width, uint height, uint depth, void* out, eNoiseOutput mode, unsigned int seed)
+{
+	unsigned int* outWords = (unsigned int*)out;		// uint and float are both 4 bytes
+
+	for (uint z = 0; z < depth; ++z)
+	{
+		unsigned int planeBase = (unsigned int)minX + NOISE_PRIME2 * ((unsigned int)minZ + z);
+		for (uint y = 0; y < height; ++y)
+		{
+			unsigned int rowStart = planeBase + NOISE_PRIME1 * ((unsigned int)minY + y);
+			NoiseRange(rowStart, width, outWords + ((size_t)z * height + y) * width, mode, seed);
+		}
+	}
+}
+
+////////////////////////////////////// API //////////////////////////////////////
+void Get1dNoiseUintRange(int start, uint count, unsigned int* out, unsigned int seed)
+{
+	NoiseRange((unsigned int)start, count, out, NOISE_OUT_UINT, seed);
+}
+
+void Get1dNoiseZeroToOneRange(int start, uint count, float* out, unsigned int seed)
+{
+	NoiseRange((unsigned int)start, count, out, NOISE_OUT_ZERO_TO_ONE, seed);
+}
+
+void Get1dNoiseNegOneToOneRange(int start, uint count, float* out, unsigned int seed)
+{
+	NoiseRange((unsigned int)start, count, out, NOISE_OUT_NEG_ONE_TO_ONE, seed);
+}
+
+void Get2dNoiseUintGrid(int minX, int minY, uint width, uint height, unsigned int* out, unsigned int seed)
+{
+	NoiseGrid3d(minX, minY, 0, width, height, 1, out, NOISE_OUT_UINT, seed);
+}
+
+void Get2dNoiseZeroToOneGrid(int minX, int minY, uint width, uint height, float* out, unsigned int seed)
+{
+	NoiseGrid3d(minX, minY, 0, width, height, 1, out, NOISE_OUT_ZERO_TO_ONE, seed);
+}
+
+void Get2dNoiseNegOneToOneGrid(int minX, int minY, uint width, uint height, float* out, unsigned int seed)
+{
+	NoiseGrid3d(minX, minY, 0, width, height, 1, out, NOISE_OUT_NEG_ONE_TO_ONE, seed);
+}
+
+void Get3dNoiseUintGrid(int minX, int minY, int minZ, uint width, uint height, uint depth, unsigned int* out, unsigned int seed)
+{
+	NoiseGrid3d(minX, minY, minZ, width, height, depth, out, NOISE_OUT_UINT, seed);
+}
+
+void Get3dNoiseZeroToOneGrid(int minX, int minY, int minZ, uint width, uint height, uint depth, float* out, unsigned int seed)
+{
+	NoiseGrid3d(minX, minY, minZ, width, height, depth, out, NOISE_OUT_ZERO_TO_ONE, seed);
+}
+
+void Get3dNoiseNegOneToOneGrid(int minX, int minY, int minZ, uint width, uint height, uint depth, float* out, unsigned int seed)
+{
+	NoiseGrid3d(minX, minY, minZ, width, height, depth, out, NOISE_OUT_NEG_ONE_TO_ONE, seed);
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/MathSIMD.hpp"
+
+/*
+ * Squirrel noise over whole index ranges and lattices, bit for bit the same as the single sample
+ * functions in RawNoise.hpp. A lattice row hashes consecutive indices, so every row runs as one
+ * 1d range 8 wide where the cpu has AVX2 (checked once at run time), 4 wide with SSE2 otherwise.
+ */
+
+// index start + i for i in [0, count)
+void Get1dNoiseUintRange(int start, uint count, unsigned int* out, unsigned int seed = 0);
+void Get1dNoiseZeroToOneRange(int start, uint count, float* out, unsigned int seed = 0);
+void Get1dNoiseNegOneToOneRange(int start, uint count, float* out, unsigned int seed = 0);
+
+// out[y * width + x] is the sample at (minX + x, minY + y)
+void Get2dNoiseUintGrid(int minX, int minY, uint width, uint height, unsigned int* out, unsigned int seed = 0);
+void Get2dNoiseZeroToOneGrid(int minX, int minY, uint width, uint height, float* out, unsigned int seed = 0);
+void Get2dNoiseNegOneToOneGrid(int minX, int minY, uint width, uint height, float* out, unsigned int seed = 0);
+
+// out[(z * height + y) * width + x] is the sample at (minX + x, minY + y, minZ + z)
+void Get3dNoiseUintGrid(int minX, int minY, int minZ, uint width, uint height, uint depth, unsigned int* out, unsigned int seed = 0);
+void Get3dNoiseZeroToOneGrid(int minX, int minY, int minZ, uint width, uint height, uint depth, float* out, unsigned int seed = 0);
+void Get3dNoiseNegOneToOneGrid(int minX, int minY, int minZ, uint width, uint height, uint depth, float* out, unsigned int seed = 0);
+
+#if MATH_SIMD_SSE
+	#if defined(__SSE4_1__) || defined(__AVX__)
+		#include <smmintrin.h>
+	#endif
+
+	// low 32 bits of a * b per lane; sse2 builds it from the two 32x32->64 halves
+	inline __m128i SIMDNoiseMulLo4(__m128i a, __m128i b)
+	{
+	#if defined(__SSE4_1__) || defined(__AVX__)
+		return _mm_mullo_epi32(a, b);
+	#else
+		__m128i even = _mm_mul_epu32(a, b);
+		__m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+		return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+	#endif
+	}
+
+	// Get1dNoiseUint on 4 indices at once (bit constants from RawNoise.cpp), for callers building their own lattice indices
+	inline __m128i SIMDNoiseHash4(__m128i indices, __m128i seed)
+	{
+		__m128i bits = SIMDNoiseMulLo4(indices, _mm_set1_epi32((int)0xD2A80A23u));
+		bits = _mm_add_epi32(bits, seed);
+		bits = _mm_xor_si128(bits, _mm_srli_epi32(bits, 7));
+		bits = _mm_add_epi32(bits, _mm_set1_epi32((int)0xA884F197u));
+		bits = _mm_xor_si128(bits, _mm_srli_epi32(bits, 8));
+		bits = SIMDNoiseMulLo4(bits, _mm_set1_epi32((int)0x1B56C4E9u));
+		bits = _mm_xor_si128(bits, _mm_srli_epi32(bits, 11));
+		return bits;
+	}
+#endif
\ No newline at end of file
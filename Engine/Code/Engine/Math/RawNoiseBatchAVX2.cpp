@@ -0,0 +1,78 @@
+#include "Engine/Math/RawNoiseBatchAVX2.hpp"
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#endif
+
+// same constants as RawNoise.cpp
+#define NOISE_BIT1 0xD2A80A23u
+#define NOISE_BIT2 0xA884F197u
+#define NOISE_BIT3 0x1B56C4E9u
+
+#if defined(__AVX2__)
+static const double ONE_OVER_MAX_UINT = (1.0 / (double) 0xFFFFFFFF);
+static const double ONE_OVER_MAX_INT = (1.0 / (double) 0x7FFFFFFF);
+
+static inline __m256i NoiseHash8(__m256i pos, __m256i seed)
+{
+	__m256i bits = _mm256_mullo_epi32(pos, _mm256_set1_epi32((int)NOISE_BIT1));
+	bits = _mm256_add_epi32(bits, seed);
+	bits = _mm256_xor_si256(bits, _mm256_srli_epi32(bits, 7));
+	bits = _mm256_add_epi32(bits, _mm256_set1_epi32((int)NOISE_BIT2));
+	bits = _mm256_xor_si256(bits, _mm256_srli_epi32(bits, 8));
+	bits = _mm256_mullo_epi32(bits, _mm256_set1_epi32((int)NOISE_BIT3));
+	bits = _mm256_xor_si256(bits, _mm256_srli_epi32(bits, 11));
+	return bits;
+}
+
+// through double like the scalar functions, so the float rounding matches exactly
+static inline __m256 NoiseToFloat8(__m256i bits, eNoiseOutput mode)
+{
+	__m256d lo, hi;
+	if (mode == NOISE_OUT_ZERO_TO_ONE)
+	{
+		// unsigned to double: flip the sign bit, convert signed, add 2^31 back
+		__m256i flipped = _mm256_xor_si256(bits, _mm256_set1_epi32((int)0x80000000u));
+		__m256d offset = _mm256_set1_pd(2147483648.0);
+		__m256d scale = _mm256_set1_pd(ONE_OVER_MAX_UINT);
+		lo = _mm256_mul_pd(scale, _mm256_add_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(flipped)), offset));
+		hi = _mm256_mul_pd(scale, _mm256_add_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(flipped, 1)), offset));
+	}
+	else
+	{
+		__m256d scale = _mm256_set1_pd(ONE_OVER_MAX_INT);
+		lo = _mm256_mul_pd(scale, _mm256_cvtepi32_pd(_mm256_castsi256_si128(bits)));
+		hi = _mm256_mul_pd(scale, _mm256_cvtepi32_pd(_mm256_extracti128_si256(bits, 1)));
+	}
+	return _mm256_set_m128(_mm256_cvtpd_ps(hi), _mm256_cvtpd_ps(lo));
+}
+
+unsigned int NoiseRangeAVX2(unsigned int start, unsigned int count, void* out, eNoiseOutput mode, unsigned int seed)
+{
+	unsigned int* outUint = (unsigned int*)out;
+	float* outFloat = (float*)out;
+	unsigned int idx = 0;
+
+	__m256i seedVec = _mm256_set1_epi32((int)seed);
+	__m256i pos = _mm256_add_epi32(_mm256_set1_epi32((int)start), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+	__m256i step = _mm256_set1_epi32(8);
+	for (; idx + 8 <= count; idx += 8)
+	{
+		__m256i bits = NoiseHash8(pos, seedVec);
+		if (mode == NOISE_OUT_UINT)
+			_mm256_storeu_si256((__m256i*)(outUint + idx), bits);
+		else
+			_mm256_storeu_ps(outFloat + idx, NoiseToFloat8(bits, mode));
+		pos = _mm256_add_epi32(pos, step);
+	}
+
+	// the caller goes on with sse, leave the upper halves clean for it
+	_mm256_zeroupper();
+	return idx;
+}
+#else
+unsigned int NoiseRangeAVX2(unsigned int, unsigned int, void*, eNoiseOutput, unsigned int)
+{
+	return 0;
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+/*
+ * AVX2 lanes of RawNoiseBatch.cpp. RawNoiseBatchAVX2.cpp is the only file built with /arch:AVX2
+ * (x64 only, set on the file in Engine.vcxproj), so the rest of the engine still runs on any SSE2 cpu;
+ * RawNoiseBatch.cpp calls in only after cpuid reports AVX2. Nothing here may come from a header with
+ * inline functions: the linker could keep the AVX2 copy of one for every caller.
+ */
+
+enum eNoiseOutput
+{
+	NOISE_OUT_UINT,
+	NOISE_OUT_ZERO_TO_ONE,
+	NOISE_OUT_NEG_ONE_TO_ONE
+};
+
+// hashes [start, start + n) 8 at a time for the largest n <= count that is a multiple of 8 and returns n;
+// returns 0 when the file was built without AVX2
+unsigned int NoiseRangeAVX2(unsigned int start, unsigned int count, void* out, eNoiseOutput mode, unsigned int seed);
\ No newline at end of file
@@ -740,3 +740,290 @@ float Compute4dPerlinNoise( float posX, float posY, float posZ, float posT, floa
 	return totalNoise;
 }
 
+
+//-----------------------------------------------------------------------------------------------
+// Simplex noise splits space into simplices (triangle, tetrahedron, 5-cell) rather than squares/
+//	cubes, so each sample blends N+1 corners instead of 2^N: 3 vs 4 in 2D, but 5 vs 16 in 4D.
+//
+// Each corner contributes (r^2 - d^2)^4 * dot(gradient, displacement), with r^2 = 0.5 so the
+//	contribution reaches zero before the next simplex and the result is continuous everywhere.
+//	Gradients are the same power-of-two sets used by the Perlin functions above.
+//
+static float ComputeSimplexCornerContribution( float gradientDotDisplacement, float distanceSquared )
+{
+	float falloff = 0.5f - distanceSquared;
+	if( falloff <= 0.f )
+		return 0.f;
+
+	falloff *= falloff;
+	return (falloff * falloff) * gradientDotDisplacement;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// In 2D, the square grid is skewed into rhombi which are split into two triangles.
+//
+float Compute2dSimplexNoise( float posX, float posY, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	const float OCTAVE_OFFSET = 0.636764989593174f; // Translation/bias to add to each octave
+	const float SKEW_2D = 0.366025403784438647f; // (sqrt(3) - 1) / 2
+	const float UNSKEW_2D = 0.211324865405187118f; // (3 - sqrt(3)) / 6
+	const Vector2 gradients[ 8 ] = // Same unit vectors as 2D Perlin
+	{
+		Vector2( +0.923879533f, +0.382683432f ), //  22.5 degrees (ENE)
+		Vector2( +0.382683432f, +0.923879533f ), //  67.5 degrees (NNE)
+		Vector2( -0.382683432f, +0.923879533f ), // 112.5 degrees (NNW)
+		Vector2( -0.923879533f, +0.382683432f ), // 157.5 degrees (WNW)
+		Vector2( -0.923879533f, -0.382683432f ), // 202.5 degrees (WSW)
+		Vector2( -0.382683432f, -0.923879533f ), // 247.5 degrees (SSW)
+		Vector2( +0.382683432f, -0.923879533f ), // 292.5 degrees (SSE)
+		Vector2( +0.923879533f, -0.382683432f )	 // 337.5 degrees (ESE)
+	};
+
+	float totalNoise = 0.f;
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	float invScale = (1.f / scale);
+	Vector2 currentPos( posX * invScale, posY * invScale );
+
+	for( unsigned int octaveNum = 0; octaveNum < numOctaves; ++ octaveNum )
+	{
+		// Skew to find the rhombus cell, then unskew its origin back to measure from it
+		float skew = (currentPos.x + currentPos.y) * SKEW_2D;
+		float cellX = floorf( currentPos.x + skew );
+		float cellY = floorf( currentPos.y + skew );
+		int indexX = (int) cellX;
+		int indexY = (int) cellY;
+		float unskew = (cellX + cellY) * UNSKEW_2D;
+		Vector2 displacement0( currentPos.x - (cellX - unskew), currentPos.y - (cellY - unskew) );
+
+		// Lower (east first) or upper (north first) triangle of the rhombus
+		float stepX = (displacement0.x > displacement0.y) ? 1.f : 0.f;
+		float stepY = 1.f - stepX;
+		Vector2 displacement1( (displacement0.x - stepX) + UNSKEW_2D, (displacement0.y - stepY) + UNSKEW_2D );
+		Vector2 displacement2( (displacement0.x - 1.f) + (2.f * UNSKEW_2D), (displacement0.y - 1.f) + (2.f * UNSKEW_2D) );
+
+		unsigned int noise0 = Get2dNoiseUint( indexX, indexY, seed );
+		unsigned int noise1 = Get2dNoiseUint( indexX + (int) stepX, indexY + (int) stepY, seed );
+		unsigned int noise2 = Get2dNoiseUint( indexX + 1, indexY + 1, seed );
+
+		float contribution0 = ComputeSimplexCornerContribution( DotProduct( gradients[ noise0 & 0x00000007 ], displacement0 ), DotProduct( displacement0, displacement0 ) );
+		float contribution1 = ComputeSimplexCornerContribution( DotProduct( gradients[ noise1 & 0x00000007 ], displacement1 ), DotProduct( displacement1, displacement1 ) );
+		float contribution2 = ComputeSimplexCornerContribution( DotProduct( gradients[ noise2 & 0x00000007 ], displacement2 ), DotProduct( displacement2, displacement2 ) );
+		float blendTotal = contribution0 + contribution1 + contribution2;
+		float noiseThisOctave = blendTotal * (1.f / 0.009995994f); // 2D simplex is in [-.009995994,.009995994]; map to ~[-1,1]
+
+		// Accumulate results and prepare for next octave (if any)
+		totalNoise += noiseThisOctave * currentAmplitude;
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= octavePersistence;
+		currentPos *= octaveScale;
+		currentPos.x += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.y += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		++ seed; // Eliminates octaves "echoing" each other (since each octave is uniquely seeded)
+	}
+
+	// Re-normalize total noise to within [-1,1] and fix octaves pulling us far away from limits
+	if( renormalize && totalAmplitude > 0.f )
+	{
+		totalNoise /= totalAmplitude;				// Amplitude exceeds 1.0 if octaves are used
+		totalNoise = (totalNoise * 0.5f) + 0.5f;	// Map to [0,1]
+		totalNoise = SmoothStep3( totalNoise );		// Push towards extents (octaves pull us away)
+		totalNoise = (totalNoise * 2.0f) - 1.f;		// Map back to [-1,1]
+	}
+
+	return totalNoise;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// In 3D, each skewed cube holds six tetrahedra; ranking the displacement components (how many
+//	of the others each one exceeds) tells which one, and in which order to step along the axes.
+//
+float Compute3dSimplexNoise( float posX, float posY, float posZ, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	const float OCTAVE_OFFSET = 0.636764989593174f; // Translation/bias to add to each octave
+	const float SKEW_3D = 0.333333333333333333f; // (sqrt(4) - 1) / 3
+	const float UNSKEW_3D = 0.166666666666666667f; // (4 - sqrt(4)) / 12
+	const float fSQRT_3_OVER_3 = 0.5773502691896257645091f;
+
+	const Vector3 gradients[ 8 ] = // Same cube-corner unit vectors as 3D Perlin
+	{
+		Vector3( +fSQRT_3_OVER_3, +fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ),
+		Vector3( -fSQRT_3_OVER_3, +fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ),
+		Vector3( +fSQRT_3_OVER_3, -fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ),
+		Vector3( -fSQRT_3_OVER_3, -fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ),
+		Vector3( +fSQRT_3_OVER_3, +fSQRT_3_OVER_3, -fSQRT_3_OVER_3 ),
+		Vector3( -fSQRT_3_OVER_3, +fSQRT_3_OVER_3, -fSQRT_3_OVER_3 ),
+		Vector3( +fSQRT_3_OVER_3, -fSQRT_3_OVER_3, -fSQRT_3_OVER_3 ),
+		Vector3( -fSQRT_3_OVER_3, -fSQRT_3_OVER_3, -fSQRT_3_OVER_3 )
+	};
+
+	float totalNoise = 0.f;
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	float invScale = (1.f / scale);
+	Vector3 currentPos( posX * invScale, posY * invScale, posZ * invScale );
+
+	for( unsigned int octaveNum = 0; octaveNum < numOctaves; ++ octaveNum )
+	{
+		// Skew to find the cube cell, then unskew its origin back to measure from it
+		float skew = (currentPos.x + currentPos.y + currentPos.z) * SKEW_3D;
+		Vector3 cell( floorf( currentPos.x + skew ), floorf( currentPos.y + skew ), floorf( currentPos.z + skew ) );
+		int indexX = (int) cell.x;
+		int indexY = (int) cell.y;
+		int indexZ = (int) cell.z;
+		float unskew = (cell.x + cell.y + cell.z) * UNSKEW_3D;
+		Vector3 displacement0( currentPos.x - (cell.x - unskew), currentPos.y - (cell.y - unskew), currentPos.z - (cell.z - unskew) );
+
+		// Rank the components to pick the tetrahedron; the largest is stepped along first
+		int rankX = 0, rankY = 0, rankZ = 0;
+		if( displacement0.x > displacement0.y ) ++ rankX; else ++ rankY;
+		if( displacement0.x > displacement0.z ) ++ rankX; else ++ rankZ;
+		if( displacement0.y > displacement0.z ) ++ rankY; else ++ rankZ;
+		Vector3 step1( rankX >= 2 ? 1.f : 0.f, rankY >= 2 ? 1.f : 0.f, rankZ >= 2 ? 1.f : 0.f );
+		Vector3 step2( rankX >= 1 ? 1.f : 0.f, rankY >= 1 ? 1.f : 0.f, rankZ >= 1 ? 1.f : 0.f );
+
+		Vector3 displacement1( (displacement0.x - step1.x) + UNSKEW_3D, (displacement0.y - step1.y) + UNSKEW_3D, (displacement0.z - step1.z) + UNSKEW_3D );
+		Vector3 displacement2( (displacement0.x - step2.x) + (2.f * UNSKEW_3D), (displacement0.y - step2.y) + (2.f * UNSKEW_3D), (displacement0.z - step2.z) + (2.f * UNSKEW_3D) );
+		Vector3 displacement3( (displacement0.x - 1.f) + (3.f * UNSKEW_3D), (displacement0.y - 1.f) + (3.f * UNSKEW_3D), (displacement0.z - 1.f) + (3.f * UNSKEW_3D) );
+
+		unsigned int noise0 = Get3dNoiseUint( indexX, indexY, indexZ, seed );
+		unsigned int noise1 = Get3dNoiseUint( indexX + (int) step1.x, indexY + (int) step1.y, indexZ + (int) step1.z, seed );
+		unsigned int noise2 = Get3dNoiseUint( indexX + (int) step2.x, indexY + (int) step2.y, indexZ + (int) step2.z, seed );
+		unsigned int noise3 = Get3dNoiseUint( indexX + 1, indexY + 1, indexZ + 1, seed );
+
+		float contribution0 = ComputeSimplexCornerContribution( DotProduct( gradients[ noise0 & 0x00000007 ], displacement0 ), DotProduct( displacement0, displacement0 ) );
+		float contribution1 = ComputeSimplexCornerContribution( DotProduct( gradients[ noise1 & 0x00000007 ], displacement1 ), DotProduct( displacement1, displacement1 ) );
+		float contribution2 = ComputeSimplexCornerContribution( DotProduct( gradients[ noise2 & 0x00000007 ], displacement2 ), DotProduct( displacement2, displacement2 ) );
+		float contribution3 = ComputeSimplexCornerContribution( DotProduct( gradients[ noise3 & 0x00000007 ], displacement3 ), DotProduct( displacement3, displacement3 ) );
+		float blendTotal = contribution0 + contribution1 + contribution2 + contribution3;
+		float noiseThisOctave = blendTotal * (1.f / 0.009289064f); // 3D simplex is in [-.009289064,.009289064]; map to ~[-1,1]
+
+		// Accumulate results and prepare for next octave (if any)
+		totalNoise += noiseThisOctave * currentAmplitude;
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= octavePersistence;
+		currentPos *= octaveScale;
+		currentPos.x += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.y += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.z += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		++ seed; // Eliminates octaves "echoing" each other (since each octave is uniquely seeded)
+	}
+
+	// Re-normalize total noise to within [-1,1] and fix octaves pulling us far away from limits
+	if( renormalize && totalAmplitude > 0.f )
+	{
+		totalNoise /= totalAmplitude;				// Amplitude exceeds 1.0 if octaves are used
+		totalNoise = (totalNoise * 0.5f) + 0.5f;	// Map to [0,1]
+		totalNoise = SmoothStep3( totalNoise );		// Push towards extents (octaves pull us away)
+		totalNoise = (totalNoise * 2.0f) - 1.f;		// Map back to [-1,1]
+	}
+
+	return totalNoise;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// In 4D, each skewed hypercube holds 24 5-cells, picked by ranking the four components the
+//	same way as in 3D.  Only 5 corners are hashed per octave, vs. 16 for 4D Perlin.
+//
+float Compute4dSimplexNoise( float posX, float posY, float posZ, float posT, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	const float OCTAVE_OFFSET = 0.636764989593174f; // Translation/bias to add to each octave
+	const float SKEW_4D = 0.309016994374947424f; // (sqrt(5) - 1) / 4
+	const float UNSKEW_4D = 0.138196601125010515f; // (5 - sqrt(5)) / 20
+
+	const Vector4 gradients[ 16 ] = // Same hypercube-corner unit vectors as 4D Perlin
+	{
+		Vector4( +0.5f, +0.5f, +0.5f, +0.5f ),
+		Vector4( -0.5f, +0.5f, +0.5f, +0.5f ),
+		Vector4( +0.5f, -0.5f, +0.5f, +0.5f ),
+		Vector4( -0.5f, -0.5f, +0.5f, +0.5f ),
+		Vector4( +0.5f, +0.5f, -0.5f, +0.5f ),
+		Vector4( -0.5f, +0.5f, -0.5f, +0.5f ),
+		Vector4( +0.5f, -0.5f, -0.5f, +0.5f ),
+		Vector4( -0.5f, -0.5f, -0.5f, +0.5f ),
+		Vector4( +0.5f, +0.5f, +0.5f, -0.5f ),
+		Vector4( -0.5f, +0.5f, +0.5f, -0.5f ),
+		Vector4( +0.5f, -0.5f, +0.5f, -0.5f ),
+		Vector4( -0.5f, -0.5f, +0.5f, -0.5f ),
+		Vector4( +0.5f, +0.5f, -0.5f, -0.5f ),
+		Vector4( -0.5f, +0.5f, -0.5f, -0.5f ),
+		Vector4( +0.5f, -0.5f, -0.5f, -0.5f ),
+		Vector4( -0.5f, -0.5f, -0.5f, -0.5f )
+	};
+
+	float totalNoise = 0.f;
+	float totalAmplitude = 0.f;
+	float currentAmplitude = 1.f;
+	float invScale = (1.f / scale);
+	Vector4 currentPos( posX * invScale, posY * invScale, posZ * invScale, posT * invScale );
+
+	for( unsigned int octaveNum = 0; octaveNum < numOctaves; ++ octaveNum )
+	{
+		// Skew to find the hypercube cell, then unskew its origin back to measure from it
+		float skew = (currentPos.x + currentPos.y + currentPos.z + currentPos.w) * SKEW_4D;
+		Vector4 cell( floorf( currentPos.x + skew ), floorf( currentPos.y + skew ), floorf( currentPos.z + skew ), floorf( currentPos.w + skew ) );
+		int indexX = (int) cell.x;
+		int indexY = (int) cell.y;
+		int indexZ = (int) cell.z;
+		int indexT = (int) cell.w;
+		float unskew = (cell.x + cell.y + cell.z + cell.w) * UNSKEW_4D;
+		Vector4 displacement0( currentPos.x - (cell.x - unskew), currentPos.y - (cell.y - unskew), currentPos.z - (cell.z - unskew), currentPos.w - (cell.w - unskew) );
+
+		// Rank the components to pick the 5-cell; the largest is stepped along first
+		int rankX = 0, rankY = 0, rankZ = 0, rankT = 0;
+		if( displacement0.x > displacement0.y ) ++ rankX; else ++ rankY;
+		if( displacement0.x > displacement0.z ) ++ rankX; else ++ rankZ;
+		if( displacement0.x > displacement0.w ) ++ rankX; else ++ rankT;
+		if( displacement0.y > displacement0.z ) ++ rankY; else ++ rankZ;
+		if( displacement0.y > displacement0.w ) ++ rankY; else ++ rankT;
+		if( displacement0.z > displacement0.w ) ++ rankZ; else ++ rankT;
+		Vector4 step1( rankX >= 3 ? 1.f : 0.f, rankY >= 3 ? 1.f : 0.f, rankZ >= 3 ? 1.f : 0.f, rankT >= 3 ? 1.f : 0.f );
+		Vector4 step2( rankX >= 2 ? 1.f : 0.f, rankY >= 2 ? 1.f : 0.f, rankZ >= 2 ? 1.f : 0.f, rankT >= 2 ? 1.f : 0.f );
+		Vector4 step3( rankX >= 1 ? 1.f : 0.f, rankY >= 1 ? 1.f : 0.f, rankZ >= 1 ? 1.f : 0.f, rankT >= 1 ? 1.f : 0.f );
+
+		Vector4 displacement1( (displacement0.x - step1.x) + UNSKEW_4D, (displacement0.y - step1.y) + UNSKEW_4D, (displacement0.z - step1.z) + UNSKEW_4D, (displacement0.w - step1.w) + UNSKEW_4D );
+		Vector4 displacement2( (displacement0.x - step2.x) + (2.f * UNSKEW_4D), (displacement0.y - step2.y) + (2.f * UNSKEW_4D), (displacement0.z - step2.z) + (2.f * UNSKEW_4D), (displacement0.w - step2.w) + (2.f * UNSKEW_4D) );
+		Vector4 displacement3( (displacement0.x - step3.x) + (3.f * UNSKEW_4D), (displacement0.y - step3.y) + (3.f * UNSKEW_4D), (displacement0.z - step3.z) + (3.f * UNSKEW_4D), (displacement0.w - step3.w) + (3.f * UNSKEW_4D) );
+		Vector4 displacement4( (displacement0.x - 1.f) + (4.f * UNSKEW_4D), (displacement0.y - 1.f) + (4.f * UNSKEW_4D), (displacement0.z - 1.f) + (4.f * UNSKEW_4D), (displacement0.w - 1.f) + (4.f * UNSKEW_4D) );
+
+		unsigned int noise0 = Get4dNoiseUint( indexX, indexY, indexZ, indexT, seed );
+		unsigned int noise1 = Get4dNoiseUint( indexX + (int) step1.x, indexY + (int) step1.y, indexZ + (int) step1.z, indexT + (int) step1.w, seed );
+		unsigned int noise2 = Get4dNoiseUint( indexX + (int) step2.x, indexY + (int) step2.y, indexZ + (int) step2.z, indexT + (int) step2.w, seed );
+		unsigned int noise3 = Get4dNoiseUint( indexX + (int) step3.x, indexY + (int) step3.y, indexZ + (int) step3.z, indexT + (int) step3.w, seed );
+		unsigned int noise4 = Get4dNoiseUint( indexX + 1, indexY + 1, indexZ + 1, indexT + 1, seed );
+
+		float contribution0 = ComputeSimplexCornerContribution( DotProduct( gradients[ noise0 & 0x0000000F ], displacement0 ), DotProduct( displacement0, displacement0 ) );
+		float contribution1 = ComputeSimplexCornerContribution( DotProduct( gradients[ noise1 & 0x0000000F ], displacement1 ), DotProduct( displacement1, displacement1 ) );
+		float contribution2 = ComputeSimplexCornerContribution( DotProduct( gradients[ noise2 & 0x0000000F ], displacement2 ), DotProduct( displacement2, displacement2 ) );
+		float contribution3 = ComputeSimplexCornerContribution( DotProduct( gradients[ noise3 & 0x0000000F ], displacement3 ), DotProduct( displacement3, displacement3 ) );
+		float contribution4 = ComputeSimplexCornerContribution( DotProduct( gradients[ noise4 & 0x0000000F ], displacement4 ), DotProduct( displacement4, displacement4 ) );
+		float blendTotal = contribution0 + contribution1 + contribution2 + contribution3 + contribution4;
+		float noiseThisOctave = blendTotal * (1.f / 0.009210832f); // 4D simplex is in [-.009210832,.009210832]; map to ~[-1,1]
+
+		// Accumulate results and prepare for next octave (if any)
+		totalNoise += noiseThisOctave * currentAmplitude;
+		totalAmplitude += currentAmplitude;
+		currentAmplitude *= octavePersistence;
+		currentPos *= octaveScale;
+		currentPos.x += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.y += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.z += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		currentPos.w += OCTAVE_OFFSET; // Add "irrational" offset to de-align octave grids
+		++ seed; // Eliminates octaves "echoing" each other (since each octave is uniquely seeded)
+	}
+
+	// Re-normalize total noise to within [-1,1] and fix octaves pulling us far away from limits
+	if( renormalize && totalAmplitude > 0.f )
+	{
+		totalNoise /= totalAmplitude;				// Amplitude exceeds 1.0 if octaves are used
+		totalNoise = (totalNoise * 0.5f) + 0.5f;	// Map to [0,1]
+		totalNoise = SmoothStep3( totalNoise );		// Push towards extents (octaves pull us away)
+		totalNoise = (totalNoise * 2.0f) - 1.f;		// Map back to [-1,1]
+	}
+
+	return totalNoise;
+}
+
@@ -79,14 +79,18 @@ float Compute4dPerlinNoise( float posX, float posY, float posZ, float posT, floa
 //-----------------------------------------------------------------------------------------------
 // Simplex noise functions (random-access / deterministic)
 //
-// Simplex noise (also by Ken Perlin) is theoretically faster than - and supposedly superior to - 
-//	Perlin noise, in that it is more organic-looking.  I'm not sure I like the look of it better,
-//	however; examples of cross-sectional 4D simplex noise look worse to me than 4D Perlin does.
+// Simplex noise (also by Ken Perlin) blends the N+1 corners of a simplex (2D triangle, 3D
+//	tetrahedron, 4D 5-cell) instead of the 2^N corners of a square/cube cell, so it gets cheaper
+//	than Perlin as dimensions go up (5 corners vs. 16 in 4D).  Gradients and octave handling are
+//	the same as Perlin's above, so the two can be swapped with the same parameters.
 //
-// Also, Simplex noise is based on a regular simplex (2D triangle, 3D tetrahedron, 4-simplex/5-cell)
-//	grid, which is slightly more fiddly, so I haven't bothered writing my own yet.
+// <numOctaves>			Number of layers of noise added together
+// <octavePersistence>	Amplitude multiplier for each subsequent octave (each octave is quieter)
+// <octaveScale>		Frequency multiplier for each subsequent octave (each octave is busier)
+// <renormalize>		If true, uses nonlinear (SmoothStep3) renormalization to within [-1,1]
 //
-TODO("Implement simplex noise in 2D, 3D, 4D (1D simplex is identical to 1D Perlin, I think?)");
-TODO("Test actual simplex noise implementation in 2D/3D to compare speeds (branches vs. ops!)");
+float Compute2dSimplexNoise( float posX, float posY, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+float Compute3dSimplexNoise( float posX, float posY, float posZ, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
+float Compute4dSimplexNoise( float posX, float posY, float posZ, float posT, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
 
 
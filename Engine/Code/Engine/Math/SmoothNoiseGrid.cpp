@@ -0,0 +1,890 @@
+#include "Engine/Math/SmoothNoiseGrid.hpp"
+#include "Engine/Math/RawNoise.hpp"
+#include "Engine/Math/SmoothNoise.hpp"
+#include "Engine/Math/RawNoiseBatch.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/MathSIMD.hpp"
+#include "Engine/Core/Thread/ParallelFor.hpp"
+
+#include <math.h>
+
+#define NOISE_GRID_CHUNK 256								// samples per run, all scratch lives on the stack
+#define NOISE_GRID_MAX_SPAN (NOISE_GRID_CHUNK * 2 + 2)		// wider lattice under a run and corners are hashed one by one
+#define NOISE_GRID_PARALLEL_MIN 16384						// smaller grids stay on the calling thread
+
+// same constants as SmoothNoise.cpp
+#define NOISE_GRID_OCTAVE_OFFSET 0.636764989593174f
+#define NOISE_GRID_PERLIN_2D_NORMALIZE (1.f / 0.662578106f)
+#define NOISE_GRID_PERLIN_3D_NORMALIZE (1.f / 0.793856621f)
+#define NOISE_GRID_SQRT_3_OVER_3 0.5773502691896257645091f
+#define NOISE_GRID_SIMPLEX_2D_NORMALIZE (1.f / 0.009995994f)
+#define NOISE_GRID_SIMPLEX_3D_NORMALIZE (1.f / 0.009289064f)
+#define NOISE_GRID_SIMPLEX_4D_NORMALIZE (1.f / 0.009210832f)
+#define NOISE_GRID_SKEW_2D 0.366025403784438647f
+#define NOISE_GRID_UNSKEW_2D 0.211324865405187118f
+#define NOISE_GRID_SKEW_3D 0.333333333333333333f
+#define NOISE_GRID_UNSKEW_3D 0.166666666666666667f
+#define NOISE_GRID_SKEW_4D 0.309016994374947424f
+#define NOISE_GRID_UNSKEW_4D 0.138196601125010515f
+
+// same constants as RawNoise.hpp
+#define NOISE_GRID_PRIME1 198491317
+#define NOISE_GRID_PRIME2 6542989
+#define NOISE_GRID_PRIME3 357239
+
+static const float PERLIN_2D_GRADIENT_X[8] = { +0.923879533f, +0.382683432f, -0.382683432f, -0.923879533f, -0.923879533f, -0.382683432f, +0.382683432f, +0.923879533f };
+static const float PERLIN_2D_GRADIENT_Y[8] = { +0.382683432f, +0.923879533f, +0.923879533f, +0.382683432f, -0.382683432f, -0.923879533f, -0.923879533f, -0.382683432f };
+
+enum eNoiseGridKind
+{
+	NOISE_GRID_FRACTAL,
+	NOISE_GRID_PERLIN,
+	NOISE_GRID_SIMPLEX
+};
+
+struct sNoiseGridJob
+{
+	eNoiseGridKind	kind;
+	uint			dims;
+	float			minX, minY, minZ, posT, spacing;
+	uint			width, height;
+	float*			out;
+
+	float			scale;
+	uint			numOctaves;
+	float			octavePersistence;
+	float			octaveScale;
+	bool			renormalize;
+	unsigned int	seed;
+};
+
+////////////////////////////////////// Lattice //////////////////////////////////////
+static inline void LatticeRow(int minX, int y, int z, bool is3d, uint width, unsigned int* out, unsigned int seed)
+{
+	if (is3d)
+		Get3dNoiseUintGrid(minX, y, z, width, 1, 1, out, seed);
+	else
+		Get2dNoiseUintGrid(minX, y, width, 1, out, seed);
+}
+
+static inline void LatticeRow(int minX, int y, int z, bool is3d, uint width, float* out, unsigned int seed)
+{
+	if (is3d)
+		Get3dNoiseZeroToOneGrid(minX, y, z, width, 1, 1, out, seed);
+	else
+		Get2dNoiseZeroToOneGrid(minX, y, width, 1, out, seed);
+}
+
+static inline void LatticePoint(int x, int y, int z, bool is3d, unsigned int seed, unsigned int& out)
+{
+	out = is3d ? Get3dNoiseUint(x, y, z, seed) : Get2dNoiseUint(x, y, seed);
+}
+
+static inline void LatticePoint(int x, int y, int z, bool is3d, unsigned int seed, float& out)
+{
+	out = is3d ? Get3dNoiseZeroToOne(x, y, z, seed) : Get2dNoiseZeroToOne(x, y, seed);
+}
+
+// corners[row * 2] is the west and corners[row * 2 + 1] the east corner of each sample's cell,
+// rows going (y, z), (y + 1, z), (y, z + 1), (y + 1, z + 1); only the first two in 2d
+template <typename T>
+static void GatherCorners(const int* cellX, uint count, int y, int z, bool is3d, unsigned int seed, T corners[][NOISE_GRID_CHUNK])
+{
+	uint numRows = is3d ? 4 : 2;
+
+	int lo = cellX[0];
+	int hi = cellX[0];
+	for (uint idx = 1; idx < count; ++idx)
+	{
+		lo = (cellX[idx] < lo) ? cellX[idx] : lo;
+		hi = (cellX[idx] > hi) ? cellX[idx] : hi;
+	}
+
+	if ((unsigned int)hi - (unsigned int)lo <= NOISE_GRID_MAX_SPAN - 2)
+	{
+		// every lattice point under the run hashed once, neighbouring samples share them
+		uint span = (uint)((unsigned int)hi - (unsigned int)lo) + 2;
+		T lattice[NOISE_GRID_MAX_SPAN];
+		for (uint row = 0; row < numRows; ++row)
+		{
+			LatticeRow(lo, y + (int)(row & 1), z + (int)(row >> 1), is3d, span, lattice, seed);
+
+			T* west = corners[row * 2];
+			T* east = corners[row * 2 + 1];
+			for (uint idx = 0; idx < count; ++idx)
+			{
+				uint cell = (uint)((unsigned int)cellX[idx] - (unsigned int)lo);
+				west[idx] = lattice[cell];
+				east[idx] = lattice[cell + 1];
+			}
+		}
+	}
+	else
+	{
+		// octave finer than the sample spacing, nothing to share
+		for (uint row = 0; row < numRows; ++row)
+		{
+			int rowY = y + (int)(row & 1);
+			int rowZ = z + (int)(row >> 1);
+			for (uint idx = 0; idx < count; ++idx)
+			{
+				LatticePoint(cellX[idx], rowY, rowZ, is3d, seed, corners[row * 2][idx]);
+				LatticePoint(cellX[idx] + 1, rowY, rowZ, is3d, seed, corners[row * 2 + 1][idx]);
+			}
+		}
+	}
+}
+
+////////////////////////////////////// Lanes //////////////////////////////////////
+#if MATH_SIMD_SSE
+// same operation order as SmoothStep3 in MathUtils.hpp
+static inline __m128 SmoothStep3x4(__m128 t)
+{
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 start = _mm_mul_ps(t, t);
+	__m128 inv = _mm_sub_ps(one, t);
+	__m128 stop = _mm_sub_ps(one, _mm_mul_ps(inv, inv));
+	return _mm_add_ps(start, _mm_mul_ps(t, _mm_sub_ps(stop, start)));
+}
+
+static inline __m128 Lerp4(__m128 weightHigh, __m128 weightLow, __m128 high, __m128 low)
+{
+	return _mm_add_ps(_mm_mul_ps(weightHigh, high), _mm_mul_ps(weightLow, low));
+}
+
+static inline __m128 PerlinDot2dx4(const unsigned int* hashes, __m128 dispX, __m128 dispY)
+{
+	unsigned int h0 = hashes[0] & 7, h1 = hashes[1] & 7, h2 = hashes[2] & 7, h3 = hashes[3] & 7;
+	__m128 gradX = _mm_setr_ps(PERLIN_2D_GRADIENT_X[h0], PERLIN_2D_GRADIENT_X[h1], PERLIN_2D_GRADIENT_X[h2], PERLIN_2D_GRADIENT_X[h3]);
+	__m128 gradY = _mm_setr_ps(PERLIN_2D_GRADIENT_Y[h0], PERLIN_2D_GRADIENT_Y[h1], PERLIN_2D_GRADIENT_Y[h2], PERLIN_2D_GRADIENT_Y[h3]);
+	return _mm_add_ps(_mm_mul_ps(gradX, dispX), _mm_mul_ps(gradY, dispY));
+}
+
+// 3d gradients are the cube corners, hash bits 0, 1, 2 hold the signs of x, y, z
+static inline __m128 PerlinDot3dx4(__m128i bits, __m128 dispX, __m128 dispY, __m128 dispZ)
+{
+	__m128 signX = _mm_castsi128_ps(_mm_slli_epi32(bits, 31));
+	__m128 signY = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(bits, _mm_set1_epi32(2)), 30));
+	__m128 signZ = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(bits, _mm_set1_epi32(4)), 29));
+	__m128 grad = _mm_set1_ps(NOISE_GRID_SQRT_3_OVER_3);
+	__m128 dotX = _mm_xor_ps(_mm_mul_ps(grad, dispX), signX);
+	__m128 dotY = _mm_xor_ps(_mm_mul_ps(grad, dispY), signY);
+	__m128 dotZ = _mm_xor_ps(_mm_mul_ps(grad, dispZ), signZ);
+	return _mm_add_ps(_mm_add_ps(dotX, dotY), dotZ);
+}
+
+// 4d gradients are the hypercube corners, hash bits 0 to 3 hold the signs of x, y, z, t
+static inline __m128 PerlinDot4dx4(__m128i bits, __m128 dispX, __m128 dispY, __m128 dispZ, __m128 dispT)
+{
+	__m128 signX = _mm_castsi128_ps(_mm_slli_epi32(bits, 31));
+	__m128 signY = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(bits, _mm_set1_epi32(2)), 30));
+	__m128 signZ = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(bits, _mm_set1_epi32(4)), 29));
+	__m128 signT = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(bits, _mm_set1_epi32(8)), 28));
+	__m128 grad = _mm_set1_ps(0.5f);
+	__m128 dotX = _mm_xor_ps(_mm_mul_ps(grad, dispX), signX);
+	__m128 dotY = _mm_xor_ps(_mm_mul_ps(grad, dispY), signY);
+	__m128 dotZ = _mm_xor_ps(_mm_mul_ps(grad, dispZ), signZ);
+	__m128 dotT = _mm_xor_ps(_mm_mul_ps(grad, dispT), signT);
+	return _mm_add_ps(_mm_add_ps(_mm_add_ps(dotX, dotY), dotZ), dotT);
+}
+
+// floorf for |v| < 2^31, the range the int lattice indices cover anyway
+static inline __m128 Floor4(__m128 v)
+{
+	__m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+	return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, v), _mm_set1_ps(1.f)));
+}
+
+static inline __m128 StepMask4(__m128i mask)
+{
+	return _mm_and_ps(_mm_castsi128_ps(mask), _mm_set1_ps(1.f));
+}
+
+// (0.5 - d^2)^4 * dot, zero outside the radius; same as ComputeSimplexCornerContribution
+static inline __m128 SimplexCorner4(__m128 gradientDotDisplacement, __m128 distanceSquared)
+{
+	__m128 falloff = _mm_sub_ps(_mm_set1_ps(0.5f), distanceSquared);
+	__m128 inside = _mm_cmpgt_ps(falloff, _mm_setzero_ps());
+	falloff = _mm_mul_ps(falloff, falloff);
+	return _mm_and_ps(inside, _mm_mul_ps(_mm_mul_ps(falloff, falloff), gradientDotDisplacement));
+}
+
+static inline __m128 SimplexCorner2dx4(__m128i hashes, __m128 dispX, __m128 dispY)
+{
+	MATH_ALIGN16 unsigned int lanes[4];
+	_mm_storeu_si128((__m128i*)lanes, hashes);
+	__m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dispX, dispX), _mm_mul_ps(dispY, dispY));
+	return SimplexCorner4(PerlinDot2dx4(lanes, dispX, dispY), distanceSquared);
+}
+
+static inline __m128 SimplexCorner3dx4(__m128i hashes, __m128 dispX, __m128 dispY, __m128 dispZ)
+{
+	__m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dispX, dispX), _mm_mul_ps(dispY, dispY)), _mm_mul_ps(dispZ, dispZ));
+	return SimplexCorner4(PerlinDot3dx4(hashes, dispX, dispY, dispZ), distanceSquared);
+}
+
+static inline __m128 SimplexCorner4dx4(__m128i hashes, __m128 dispX, __m128 dispY, __m128 dispZ, __m128 dispT)
+{
+	__m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dispX, dispX), _mm_mul_ps(dispY, dispY)), _mm_mul_ps(dispZ, dispZ)), _mm_mul_ps(dispT, dispT));
+	return SimplexCorner4(PerlinDot4dx4(hashes, dispX, dispY, dispZ, dispT), distanceSquared);
+}
+#endif
+
+static inline float PerlinDot2d(unsigned int hash, float dispX, float dispY)
+{
+	return (PERLIN_2D_GRADIENT_X[hash & 7] * dispX) + (PERLIN_2D_GRADIENT_Y[hash & 7] * dispY);
+}
+
+static inline float PerlinDot3d(unsigned int hash, float dispX, float dispY, float dispZ)
+{
+	float gradX = (hash & 1) ? -NOISE_GRID_SQRT_3_OVER_3 : NOISE_GRID_SQRT_3_OVER_3;
+	float gradY = (hash & 2) ? -NOISE_GRID_SQRT_3_OVER_3 : NOISE_GRID_SQRT_3_OVER_3;
+	float gradZ = (hash & 4) ? -NOISE_GRID_SQRT_3_OVER_3 : NOISE_GRID_SQRT_3_OVER_3;
+	return (gradX * dispX) + (gradY * dispY) + (gradZ * dispZ);
+}
+
+////////////////////////////////////// Octaves //////////////////////////////////////
+// each adds one octave over a run into total, written out the same way as its SmoothNoise.cpp loop body
+static void Fractal2dOctave(const float* posX, const float* cellMinX, uint count, float posY, float cellMinY,
+	const float corners[][NOISE_GRID_CHUNK], float amplitude, float* total)
+{
+	float weightNorth = SmoothStep3(posY - cellMinY);
+	float weightSouth = 1.f - weightNorth;
+	uint idx = 0;
+
+#if MATH_SIMD_SSE
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 half = _mm_set1_ps(0.5f);
+	__m128 two = _mm_set1_ps(2.f);
+	__m128 amp = _mm_set1_ps(amplitude);
+	__m128 north = _mm_set1_ps(weightNorth);
+	__m128 south = _mm_set1_ps(weightSouth);
+	for (; idx + 4 <= count; idx += 4)
+	{
+		__m128 east = SmoothStep3x4(_mm_sub_ps(_mm_loadu_ps(posX + idx), _mm_loadu_ps(cellMinX + idx)));
+		__m128 west = _mm_sub_ps(one, east);
+
+		__m128 blendSouth = Lerp4(east, west, _mm_loadu_ps(corners[1] + idx), _mm_loadu_ps(corners[0] + idx));
+		__m128 blendNorth = Lerp4(east, west, _mm_loadu_ps(corners[3] + idx), _mm_loadu_ps(corners[2] + idx));
+		__m128 blendTotal = Lerp4(south, north, blendSouth, blendNorth);
+		__m128 noise = _mm_mul_ps(two, _mm_sub_ps(blendTotal, half));
+		_mm_storeu_ps(total + idx, _mm_add_ps(_mm_loadu_ps(total + idx), _mm_mul_ps(noise, amp)));
+	}
+#endif
+
+	for (; idx < count; ++idx)
+	{
+		float weightEast = SmoothStep3(posX[idx] - cellMinX[idx]);
+		float weightWest = 1.f - weightEast;
+
+		float blendSouth = (weightEast * corners[1][idx]) + (weightWest * corners[0][idx]);
+		float blendNorth = (weightEast * corners[3][idx]) + (weightWest * corners[2][idx]);
+		float blendTotal = (weightSouth * blendSouth) + (weightNorth * blendNorth);
+		total[idx] += 2.f * (blendTotal - 0.5f) * amplitude;
+	}
+}
+
+static void Fractal3dOctave(const float* posX, const float* cellMinX, uint count, float posY, float cellMinY, float posZ, float cellMinZ,
+	const float corners[][NOISE_GRID_CHUNK], float amplitude, float* total)
+{
+	float weightNorth = SmoothStep3(posY - cellMinY);
+	float weightAbove = SmoothStep3(posZ - cellMinZ);
+	float weightSouth = 1.f - weightNorth;
+	float weightBelow = 1.f - weightAbove;
+	uint idx = 0;
+
+#if MATH_SIMD_SSE
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 half = _mm_set1_ps(0.5f);
+	__m128 two = _mm_set1_ps(2.f);
+	__m128 amp = _mm_set1_ps(amplitude);
+	__m128 north = _mm_set1_ps(weightNorth);
+	__m128 south = _mm_set1_ps(weightSouth);
+	__m128 above = _mm_set1_ps(weightAbove);
+	__m128 below = _mm_set1_ps(weightBelow);
+	for (; idx + 4 <= count; idx += 4)
+	{
+		__m128 east = SmoothStep3x4(_mm_sub_ps(_mm_loadu_ps(posX + idx), _mm_loadu_ps(cellMinX + idx)));
+		__m128 west = _mm_sub_ps(one, east);
+
+		__m128 blendBelowSouth = Lerp4(east, west, _mm_loadu_ps(corners[1] + idx), _mm_loadu_ps(corners[0] + idx));
+		__m128 blendBelowNorth = Lerp4(east, west, _mm_loadu_ps(corners[3] + idx), _mm_loadu_ps(corners[2] + idx));
+		__m128 blendAboveSouth = Lerp4(east, west, _mm_loadu_ps(corners[5] + idx), _mm_loadu_ps(corners[4] + idx));
+		__m128 blendAboveNorth = Lerp4(east, west, _mm_loadu_ps(corners[7] + idx), _mm_loadu_ps(corners[6] + idx));
+		__m128 blendBelow = Lerp4(south, north, blendBelowSouth, blendBelowNorth);
+		__m128 blendAbove = Lerp4(south, north, blendAboveSouth, blendAboveNorth);
+		__m128 blendTotal = Lerp4(below, above, blendBelow, blendAbove);
+		__m128 noise = _mm_mul_ps(two, _mm_sub_ps(blendTotal, half));
+		_mm_storeu_ps(total + idx, _mm_add_ps(_mm_loadu_ps(total + idx), _mm_mul_ps(noise, amp)));
+	}
+#endif
+
+	for (; idx < count; ++idx)
+	{
+		float weightEast = SmoothStep3(posX[idx] - cellMinX[idx]);
+		float weightWest = 1.f - weightEast;
+
+		float blendBelowSouth = (weightEast * corners[1][idx]) + (weightWest * corners[0][idx]);
+		float blendBelowNorth = (weightEast * corners[3][idx]) + (weightWest * corners[2][idx]);
+		float blendAboveSouth = (weightEast * corners[5][idx]) + (weightWest * corners[4][idx]);
+		float blendAboveNorth = (weightEast * corners[7][idx]) + (weightWest * corners[6][idx]);
+		float blendBelow = (weightSouth * blendBelowSouth) + (weightNorth * blendBelowNorth);
+		float blendAbove = (weightSouth * blendAboveSouth) + (weightNorth * blendAboveNorth);
+		float blendTotal = (weightBelow * blendBelow) + (weightAbove * blendAbove);
+		total[idx] += 2.f * (blendTotal - 0.5f) * amplitude;
+	}
+}
+
+static void Perlin2dOctave(const float* posX, const float* cellMinX, uint count, float posY, float cellMinY,
+	const unsigned int corners[][NOISE_GRID_CHUNK], float amplitude, float* total)
+{
+	float dispSouth = posY - cellMinY;
+	float dispNorth = posY - (cellMinY + 1.f);
+	float weightNorth = SmoothStep3(dispSouth);
+	float weightSouth = 1.f - weightNorth;
+	uint idx = 0;
+
+#if MATH_SIMD_SSE
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 normalize = _mm_set1_ps(NOISE_GRID_PERLIN_2D_NORMALIZE);
+	__m128 amp = _mm_set1_ps(amplitude);
+	__m128 south = _mm_set1_ps(dispSouth);
+	__m128 north = _mm_set1_ps(dispNorth);
+	__m128 weightN = _mm_set1_ps(weightNorth);
+	__m128 weightS = _mm_set1_ps(weightSouth);
+	for (; idx + 4 <= count; idx += 4)
+	{
+		__m128 pos = _mm_loadu_ps(posX + idx);
+		__m128 cell = _mm_loadu_ps(cellMinX + idx);
+		__m128 dispWest = _mm_sub_ps(pos, cell);
+		__m128 dispEast = _mm_sub_ps(pos, _mm_add_ps(cell, one));
+
+		__m128 dotSW = PerlinDot2dx4(corners[0] + idx, dispWest, south);
+		__m128 dotSE = PerlinDot2dx4(corners[1] + idx, dispEast, south);
+		__m128 dotNW = PerlinDot2dx4(corners[2] + idx, dispWest, north);
+		__m128 dotNE = PerlinDot2dx4(corners[3] + idx, dispEast, north);
+
+		__m128 east = SmoothStep3x4(dispWest);
+		__m128 west = _mm_sub_ps(one, east);
+		__m128 blendSouth = Lerp4(east, west, dotSE, dotSW);
+		__m128 blendNorth = Lerp4(east, west, dotNE, dotNW);
+		__m128 blendTotal = Lerp4(weightS, weightN, blendSouth, blendNorth);
+		__m128 noise = _mm_mul_ps(blendTotal, normalize);
+		_mm_storeu_ps(total + idx, _mm_add_ps(_mm_loadu_ps(total + idx), _mm_mul_ps(noise, amp)));
+	}
+#endif
+
+	for (; idx < count; ++idx)
+	{
+		float dispWest = posX[idx] - cellMinX[idx];
+		float dispEast = posX[idx] - (cellMinX[idx] + 1.f);
+
+		float dotSouthWest = PerlinDot2d(corners[0][idx], dispWest, dispSouth);
+		float dotSouthEast = PerlinDot2d(corners[1][idx], dispEast, dispSouth);
+		float dotNorthWest = PerlinDot2d(corners[2][idx], dispWest, dispNorth);
+		float dotNorthEast = PerlinDot2d(corners[3][idx], dispEast, dispNorth);
+
+		float weightEast = SmoothStep3(dispWest);
+		float weightWest = 1.f - weightEast;
+		float blendSouth = (weightEast * dotSouthEast) + (weightWest * dotSouthWest);
+		float blendNorth = (weightEast * dotNorthEast) + (weightWest * dotNorthWest);
+		float blendTotal = (weightSouth * blendSouth) + (weightNorth * blendNorth);
+		total[idx] += blendTotal * NOISE_GRID_PERLIN_2D_NORMALIZE * amplitude;
+	}
+}
+
+static void Perlin3dOctave(const float* posX, const float* cellMinX, uint count, float posY, float cellMinY, float posZ, float cellMinZ,
+	const unsigned int corners[][NOISE_GRID_CHUNK], float amplitude, float* total)
+{
+	float dispSouth = posY - cellMinY;
+	float dispNorth = posY - (cellMinY + 1.f);
+	float dispBelow = posZ - cellMinZ;
+	float dispAbove = posZ - (cellMinZ + 1.f);
+	float weightNorth = SmoothStep3(dispSouth);
+	float weightAbove = SmoothStep3(dispBelow);
+	float weightSouth = 1.f - weightNorth;
+	float weightBelow = 1.f - weightAbove;
+	uint idx = 0;
+
+#if MATH_SIMD_SSE
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 normalize = _mm_set1_ps(NOISE_GRID_PERLIN_3D_NORMALIZE);
+	__m128 amp = _mm_set1_ps(amplitude);
+	__m128 south = _mm_set1_ps(dispSouth);
+	__m128 north = _mm_set1_ps(dispNorth);
+	__m128 below = _mm_set1_ps(dispBelow);
+	__m128 above = _mm_set1_ps(dispAbove);
+	__m128 weightN = _mm_set1_ps(weightNorth);
+	__m128 weightS = _mm_set1_ps(weightSouth);
+	__m128 weightA = _mm_set1_ps(weightAbove);
+	__m128 weightB = _mm_set1_ps(weightBelow);
+	for (; idx + 4 <= count; idx += 4)
+	{
+		__m128 pos = _mm_loadu_ps(posX + idx);
+		__m128 cell = _mm_loadu_ps(cellMinX + idx);
+		__m128 dispWest = _mm_sub_ps(pos, cell);
+		__m128 dispEast = _mm_sub_ps(pos, _mm_add_ps(cell, one));
+
+		__m128 dotBelowSW = PerlinDot3dx4(_mm_loadu_si128((const __m128i*)(corners[0] + idx)), dispWest, south, below);
+		__m128 dotBelowSE = PerlinDot3dx4(_mm_loadu_si128((const __m128i*)(corners[1] + idx)), dispEast, south, below);
+		__m128 dotBelowNW = PerlinDot3dx4(_mm_loadu_si128((const __m128i*)(corners[2] + idx)), dispWest, north, below);
+		__m128 dotBelowNE = PerlinDot3dx4(_mm_loadu_si128((const __m128i*)(corners[3] + idx)), dispEast, north, below);
+		__m128 dotAboveSW = PerlinDot3dx4(_mm_loadu_si128((const __m128i*)(corners[4] + idx)), dispWest, south, above);
+		__m128 dotAboveSE = PerlinDot3dx4(_mm_loadu_si128((const __m128i*)(corners[5] + idx)), dispEast, south, above);
+		__m128 dotAboveNW = PerlinDot3dx4(_mm_loadu_si128((const __m128i*)(corners[6] + idx)), dispWest, north, above);
+		__m128 dotAboveNE = PerlinDot3dx4(_mm_loadu_si128((const __m128i*)(corners[7] + idx)), dispEast, north, above);
+
+		__m128 east = SmoothStep3x4(dispWest);
+		__m128 west = _mm_sub_ps(one, east);
+		__m128 blendBelowSouth = Lerp4(east, west, dotBelowSE, dotBelowSW);
+		__m128 blendBelowNorth = Lerp4(east, west, dotBelowNE, dotBelowNW);
+		__m128 blendAboveSouth = Lerp4(east, west, dotAboveSE, dotAboveSW);
+		__m128 blendAboveNorth = Lerp4(east, west, dotAboveNE, dotAboveNW);
+		__m128 blendBelow = Lerp4(weightS, weightN, blendBelowSouth, blendBelowNorth);
+		__m128 blendAbove = Lerp4(weightS, weightN, blendAboveSouth, blendAboveNorth);
+		__m128 blendTotal = Lerp4(weightB, weightA, blendBelow, blendAbove);
+		__m128 noise = _mm_mul_ps(blendTotal, normalize);
+		_mm_storeu_ps(total + idx, _mm_add_ps(_mm_loadu_ps(total + idx), _mm_mul_ps(noise, amp)));
+	}
+#endif
+
+	for (; idx < count; ++idx)
+	{
+		float dispWest = posX[idx] - cellMinX[idx];
+		float dispEast = posX[idx] - (cellMinX[idx] + 1.f);
+
+		float dotBelowSW = PerlinDot3d(corners[0][idx], dispWest, dispSouth, dispBelow);
+		float dotBelowSE = PerlinDot3d(corners[1][idx], dispEast, dispSouth, dispBelow);
+		float dotBelowNW = PerlinDot3d(corners[2][idx], dispWest, dispNorth, dispBelow);
+		float dotBelowNE = PerlinDot3d(corners[3][idx], dispEast, dispNorth, dispBelow);
+		float dotAboveSW = PerlinDot3d(corners[4][idx], dispWest, dispSouth, dispAbove);
+		float dotAboveSE = PerlinDot3d(corners[5][idx], dispEast, dispSouth, dispAbove);
+		float dotAboveNW = PerlinDot3d(corners[6][idx], dispWest, dispNorth, dispAbove);
+		float dotAboveNE = PerlinDot3d(corners[7][idx], dispEast, dispNorth, dispAbove);
+
+		float weightEast = SmoothStep3(dispWest);
+		float weightWest = 1.f - weightEast;
+		float blendBelowSouth = (weightEast * dotBelowSE) + (weightWest * dotBelowSW);
+		float blendBelowNorth = (weightEast * dotBelowNE) + (weightWest * dotBelowNW);
+		float blendAboveSouth = (weightEast * dotAboveSE) + (weightWest * dotAboveSW);
+		float blendAboveNorth = (weightEast * dotAboveNE) + (weightWest * dotAboveNW);
+		float blendBelow = (weightSouth * blendBelowSouth) + (weightNorth * blendBelowNorth);
+		float blendAbove = (weightSouth * blendAboveSouth) + (weightNorth * blendAboveNorth);
+		float blendTotal = (weightBelow * blendBelow) + (weightAbove * blendAbove);
+		total[idx] += blendTotal * NOISE_GRID_PERLIN_3D_NORMALIZE * amplitude;
+	}
+}
+
+#if MATH_SIMD_SSE
+// simplex octaves run whole groups of 4, ComputeRun pads posX so the lanes past count hold valid positions;
+// lattice indices are the ones Get2d/3d/4dNoiseUint combine, the corners stepping by 1 or a prime per axis
+static void Simplex2dOctave(const float* posX, uint count, float posY, unsigned int seed, float amplitude, float* total)
+{
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 skewScale = _mm_set1_ps(NOISE_GRID_SKEW_2D);
+	__m128 unskew1 = _mm_set1_ps(NOISE_GRID_UNSKEW_2D);
+	__m128 unskew2 = _mm_set1_ps(2.f * NOISE_GRID_UNSKEW_2D);
+	__m128 normalize = _mm_set1_ps(NOISE_GRID_SIMPLEX_2D_NORMALIZE);
+	__m128 amp = _mm_set1_ps(amplitude);
+	__m128i prime1 = _mm_set1_epi32(NOISE_GRID_PRIME1);
+	__m128i seedVec = _mm_set1_epi32((int)seed);
+	__m128 y = _mm_set1_ps(posY);
+
+	for (uint idx = 0; idx < count; idx += 4)
+	{
+		__m128 x = _mm_loadu_ps(posX + idx);
+		__m128 skew = _mm_mul_ps(_mm_add_ps(x, y), skewScale);
+		__m128 cellX = Floor4(_mm_add_ps(x, skew));
+		__m128 cellY = Floor4(_mm_add_ps(y, skew));
+		__m128 unskew = _mm_mul_ps(_mm_add_ps(cellX, cellY), unskew1);
+		__m128 disp0X = _mm_sub_ps(x, _mm_sub_ps(cellX, unskew));
+		__m128 disp0Y = _mm_sub_ps(y, _mm_sub_ps(cellY, unskew));
+
+		__m128i eastFirst = _mm_castps_si128(_mm_cmpgt_ps(disp0X, disp0Y));
+		__m128 stepX = StepMask4(eastFirst);
+		__m128 stepY = _mm_sub_ps(one, stepX);
+		__m128 disp1X = _mm_add_ps(_mm_sub_ps(disp0X, stepX), unskew1);
+		__m128 disp1Y = _mm_add_ps(_mm_sub_ps(disp0Y, stepY), unskew1);
+		__m128 disp2X = _mm_add_ps(_mm_sub_ps(disp0X, one), unskew2);
+		__m128 disp2Y = _mm_add_ps(_mm_sub_ps(disp0Y, one), unskew2);
+
+		__m128i index0 = _mm_add_epi32(_mm_cvttps_epi32(cellX), SIMDNoiseMulLo4(_mm_cvttps_epi32(cellY), prime1));
+		__m128i index1 = _mm_add_epi32(index0, _mm_or_si128(_mm_and_si128(eastFirst, _mm_set1_epi32(1)), _mm_andnot_si128(eastFirst, prime1)));
+		__m128i index2 = _mm_add_epi32(index0, _mm_set1_epi32(1 + NOISE_GRID_PRIME1));
+
+		__m128 blendTotal = SimplexCorner2dx4(SIMDNoiseHash4(index0, seedVec), disp0X, disp0Y);
+		blendTotal = _mm_add_ps(blendTotal, SimplexCorner2dx4(SIMDNoiseHash4(index1, seedVec), disp1X, disp1Y));
+		blendTotal = _mm_add_ps(blendTotal, SimplexCorner2dx4(SIMDNoiseHash4(index2, seedVec), disp2X, disp2Y));
+		__m128 noise = _mm_mul_ps(blendTotal, normalize);
+		_mm_storeu_ps(total + idx, _mm_add_ps(_mm_loadu_ps(total + idx), _mm_mul_ps(noise, amp)));
+	}
+}
+
+static void Simplex3dOctave(const float* posX, uint count, float posY, float posZ, unsigned int seed, float amplitude, float* total)
+{
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 skewScale = _mm_set1_ps(NOISE_GRID_SKEW_3D);
+	__m128 unskew1 = _mm_set1_ps(NOISE_GRID_UNSKEW_3D);
+	__m128 unskew2 = _mm_set1_ps(2.f * NOISE_GRID_UNSKEW_3D);
+	__m128 unskew3 = _mm_set1_ps(3.f * NOISE_GRID_UNSKEW_3D);
+	__m128 normalize = _mm_set1_ps(NOISE_GRID_SIMPLEX_3D_NORMALIZE);
+	__m128 amp = _mm_set1_ps(amplitude);
+	__m128i oneI = _mm_set1_epi32(1);
+	__m128i prime1 = _mm_set1_epi32(NOISE_GRID_PRIME1);
+	__m128i prime2 = _mm_set1_epi32(NOISE_GRID_PRIME2);
+	__m128i seedVec = _mm_set1_epi32((int)seed);
+	__m128 y = _mm_set1_ps(posY);
+	__m128 z = _mm_set1_ps(posZ);
+
+	for (uint idx = 0; idx < count; idx += 4)
+	{
+		__m128 x = _mm_loadu_ps(posX + idx);
+		__m128 skew = _mm_mul_ps(_mm_add_ps(_mm_add_ps(x, y), z), skewScale);
+		__m128 cellX = Floor4(_mm_add_ps(x, skew));
+		__m128 cellY = Floor4(_mm_add_ps(y, skew));
+		__m128 cellZ = Floor4(_mm_add_ps(z, skew));
+		__m128 unskew = _mm_mul_ps(_mm_add_ps(_mm_add_ps(cellX, cellY), cellZ), unskew1);
+		__m128 disp0X = _mm_sub_ps(x, _mm_sub_ps(cellX, unskew));
+		__m128 disp0Y = _mm_sub_ps(y, _mm_sub_ps(cellY, unskew));
+		__m128 disp0Z = _mm_sub_ps(z, _mm_sub_ps(cellZ, unskew));
+
+		// ranks, then an axis is stepped at corner k while its rank is above 2 - k
+		__m128i xy = _mm_castps_si128(_mm_cmpgt_ps(disp0X, disp0Y));
+		__m128i xz = _mm_castps_si128(_mm_cmpgt_ps(disp0X, disp0Z));
+		__m128i yz = _mm_castps_si128(_mm_cmpgt_ps(disp0Y, disp0Z));
+		__m128i rankX = _mm_add_epi32(_mm_and_si128(xy, oneI), _mm_and_si128(xz, oneI));
+		__m128i rankY = _mm_add_epi32(_mm_andnot_si128(xy, oneI), _mm_and_si128(yz, oneI));
+		__m128i rankZ = _mm_add_epi32(_mm_andnot_si128(xz, oneI), _mm_andnot_si128(yz, oneI));
+		__m128i step1X = _mm_cmpgt_epi32(rankX, oneI), step1Y = _mm_cmpgt_epi32(rankY, oneI), step1Z = _mm_cmpgt_epi32(rankZ, oneI);
+		__m128i step2X = _mm_cmpgt_epi32(rankX, _mm_setzero_si128()), step2Y = _mm_cmpgt_epi32(rankY, _mm_setzero_si128()), step2Z = _mm_cmpgt_epi32(rankZ, _mm_setzero_si128());
+
+		__m128 disp1X = _mm_add_ps(_mm_sub_ps(disp0X, StepMask4(step1X)), unskew1);
+		__m128 disp1Y = _mm_add_ps(_mm_sub_ps(disp0Y, StepMask4(step1Y)), unskew1);
+		__m128 disp1Z = _mm_add_ps(_mm_sub_ps(disp0Z, StepMask4(step1Z)), unskew1);
+		__m128 disp2X = _mm_add_ps(_mm_sub_ps(disp0X, StepMask4(step2X)), unskew2);
+		__m128 disp2Y = _mm_add_ps(_mm_sub_ps(disp0Y, StepMask4(step2Y)), unskew2);
+		__m128 disp2Z = _mm_add_ps(_mm_sub_ps(disp0Z, StepMask4(step2Z)), unskew2);
+		__m128 disp3X = _mm_add_ps(_mm_sub_ps(disp0X, one), unskew3);
+		__m128 disp3Y = _mm_add_ps(_mm_sub_ps(disp0Y, one), unskew3);
+		__m128 disp3Z = _mm_add_ps(_mm_sub_ps(disp0Z, one), unskew3);
+
+		__m128i index0 = _mm_add_epi32(_mm_cvttps_epi32(cellX), SIMDNoiseMulLo4(_mm_cvttps_epi32(cellY), prime1));
+		index0 = _mm_add_epi32(index0, SIMDNoiseMulLo4(_mm_cvttps_epi32(cellZ), prime2));
+		__m128i index1 = _mm_add_epi32(_mm_add_epi32(index0, _mm_and_si128(step1X, oneI)), _mm_add_epi32(_mm_and_si128(step1Y, prime1), _mm_and_si128(step1Z, prime2)));
+		__m128i index2 = _mm_add_epi32(_mm_add_epi32(index0, _mm_and_si128(step2X, oneI)), _mm_add_epi32(_mm_and_si128(step2Y, prime1), _mm_and_si128(step2Z, prime2)));
+		__m128i index3 = _mm_add_epi32(index0, _mm_set1_epi32(1 + NOISE_GRID_PRIME1 + NOISE_GRID_PRIME2));
+
+		__m128 blendTotal = SimplexCorner3dx4(SIMDNoiseHash4(index0, seedVec), disp0X, disp0Y, disp0Z);
+		blendTotal = _mm_add_ps(blendTotal, SimplexCorner3dx4(SIMDNoiseHash4(index1, seedVec), disp1X, disp1Y, disp1Z));
+		blendTotal = _mm_add_ps(blendTotal, SimplexCorner3dx4(SIMDNoiseHash4(index2, seedVec), disp2X, disp2Y, disp2Z));
+		blendTotal = _mm_add_ps(blendTotal, SimplexCorner3dx4(SIMDNoiseHash4(index3, seedVec), disp3X, disp3Y, disp3Z));
+		__m128 noise = _mm_mul_ps(blendTotal, normalize);
+		_mm_storeu_ps(total + idx, _mm_add_ps(_mm_loadu_ps(total + idx), _mm_mul_ps(noise, amp)));
+	}
+}
+
+static void Simplex4dOctave(const float* posX, uint count, float posY, float posZ, float posT, unsigned int seed, float amplitude, float* total)
+{
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 skewScale = _mm_set1_ps(NOISE_GRID_SKEW_4D);
+	__m128 unskew1 = _mm_set1_ps(NOISE_GRID_UNSKEW_4D);
+	__m128 unskew2 = _mm_set1_ps(2.f * NOISE_GRID_UNSKEW_4D);
+	__m128 unskew3 = _mm_set1_ps(3.f * NOISE_GRID_UNSKEW_4D);
+	__m128 unskew4 = _mm_set1_ps(4.f * NOISE_GRID_UNSKEW_4D);
+	__m128 normalize = _mm_set1_ps(NOISE_GRID_SIMPLEX_4D_NORMALIZE);
+	__m128 amp = _mm_set1_ps(amplitude);
+	__m128i zeroI = _mm_setzero_si128();
+	__m128i oneI = _mm_set1_epi32(1);
+	__m128i twoI = _mm_set1_epi32(2);
+	__m128i prime1 = _mm_set1_epi32(NOISE_GRID_PRIME1);
+	__m128i prime2 = _mm_set1_epi32(NOISE_GRID_PRIME2);
+	__m128i prime3 = _mm_set1_epi32(NOISE_GRID_PRIME3);
+	__m128i seedVec = _mm_set1_epi32((int)seed);
+	__m128 y = _mm_set1_ps(posY);
+	__m128 z = _mm_set1_ps(posZ);
+	__m128 t = _mm_set1_ps(posT);
+
+	for (uint idx = 0; idx < count; idx += 4)
+	{
+		__m128 x = _mm_loadu_ps(posX + idx);
+		__m128 skew = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(x, y), z), t), skewScale);
+		__m128 cellX = Floor4(_mm_add_ps(x, skew));
+		__m128 cellY = Floor4(_mm_add_ps(y, skew));
+		__m128 cellZ = Floor4(_mm_add_ps(z, skew));
+		__m128 cellT = Floor4(_mm_add_ps(t, skew));
+		__m128 unskew = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(cellX, cellY), cellZ), cellT), unskew1);
+		__m128 disp0X = _mm_sub_ps(x, _mm_sub_ps(cellX, unskew));
+		__m128 disp0Y = _mm_sub_ps(y, _mm_sub_ps(cellY, unskew));
+		__m128 disp0Z = _mm_sub_ps(z, _mm_sub_ps(cellZ, unskew));
+		__m128 disp0T = _mm_sub_ps(t, _mm_sub_ps(cellT, unskew));
+
+		// ranks, then an axis is stepped at corner k while its rank is above 3 - k
+		__m128i xy = _mm_castps_si128(_mm_cmpgt_ps(disp0X, disp0Y));
+		__m128i xz = _mm_castps_si128(_mm_cmpgt_ps(disp0X, disp0Z));
+		__m128i xt = _mm_castps_si128(_mm_cmpgt_ps(disp0X, disp0T));
+		__m128i yz = _mm_castps_si128(_mm_cmpgt_ps(disp0Y, disp0Z));
+		__m128i yt = _mm_castps_si128(_mm_cmpgt_ps(disp0Y, disp0T));
+		__m128i zt = _mm_castps_si128(_mm_cmpgt_ps(disp0Z, disp0T));
+		__m128i rankX = _mm_add_epi32(_mm_add_epi32(_mm_and_si128(xy, oneI), _mm_and_si128(xz, oneI)), _mm_and_si128(xt, oneI));
+		__m128i rankY = _mm_add_epi32(_mm_add_epi32(_mm_andnot_si128(xy, oneI), _mm_and_si128(yz, oneI)), _mm_and_si128(yt, oneI));
+		__m128i rankZ = _mm_add_epi32(_mm_add_epi32(_mm_andnot_si128(xz, oneI), _mm_andnot_si128(yz, oneI)), _mm_and_si128(zt, oneI));
+		__m128i rankT = _mm_add_epi32(_mm_add_epi32(_mm_andnot_si128(xt, oneI), _mm_andnot_si128(yt, oneI)), _mm_andnot_si128(zt, oneI));
+
+		__m128i stepX[3] = { _mm_cmpgt_epi32(rankX, twoI), _mm_cmpgt_epi32(rankX, oneI), _mm_cmpgt_epi32(rankX, zeroI) };
+		__m128i stepY[3] = { _mm_cmpgt_epi32(rankY, twoI), _mm_cmpgt_epi32(rankY, oneI), _mm_cmpgt_epi32(rankY, zeroI) };
+		__m128i stepZ[3] = { _mm_cmpgt_epi32(rankZ, twoI), _mm_cmpgt_epi32(rankZ, oneI), _mm_cmpgt_epi32(rankZ, zeroI) };
+		__m128i stepT[3] = { _mm_cmpgt_epi32(rankT, twoI), _mm_cmpgt_epi32(rankT, oneI), _mm_cmpgt_epi32(rankT, zeroI) };
+		__m128 unskewK[3] = { unskew1, unskew2, unskew3 };
+
+		__m128i index0 = _mm_add_epi32(_mm_cvttps_epi32(cellX), SIMDNoiseMulLo4(_mm_cvttps_epi32(cellY), prime1));
+		index0 = _mm_add_epi32(index0, SIMDNoiseMulLo4(_mm_cvttps_epi32(cellZ), prime2));
+		index0 = _mm_add_epi32(index0, SIMDNoiseMulLo4(_mm_cvttps_epi32(cellT), prime3));
+
+		__m128 blendTotal = SimplexCorner4dx4(SIMDNoiseHash4(index0, seedVec), disp0X, disp0Y, disp0Z, disp0T);
+		for (int corner = 0; corner < 3; ++corner)
+		{
+			__m128 dispX = _mm_add_ps(_mm_sub_ps(disp0X, StepMask4(stepX[corner])), unskewK[corner]);
+			__m128 dispY = _mm_add_ps(_mm_sub_ps(disp0Y, StepMask4(stepY[corner])), unskewK[corner]);
+			__m128 dispZ = _mm_add_ps(_mm_sub_ps(disp0Z, StepMask4(stepZ[corner])), unskewK[corner]);
+			__m128 dispT = _mm_add_ps(_mm_sub_ps(disp0T, StepMask4(stepT[corner])), unskewK[corner]);
+			__m128i index = _mm_add_epi32(_mm_add_epi32(index0, _mm_and_si128(stepX[corner], oneI)), _mm_and_si128(stepY[corner], prime1));
+			index = _mm_add_epi32(_mm_add_epi32(index, _mm_and_si128(stepZ[corner], prime2)), _mm_and_si128(stepT[corner], prime3));
+			blendTotal = _mm_add_ps(blendTotal, SimplexCorner4dx4(SIMDNoiseHash4(index, seedVec), dispX, dispY, dispZ, dispT));
+		}
+
+		__m128 disp4X = _mm_add_ps(_mm_sub_ps(disp0X, one), unskew4);
+		__m128 disp4Y = _mm_add_ps(_mm_sub_ps(disp0Y, one), unskew4);
+		__m128 disp4Z = _mm_add_ps(_mm_sub_ps(disp0Z, one), unskew4);
+		__m128 disp4T = _mm_add_ps(_mm_sub_ps(disp0T, one), unskew4);
+		__m128i index4 = _mm_add_epi32(index0, _mm_set1_epi32(1 + NOISE_GRID_PRIME1 + NOISE_GRID_PRIME2 + NOISE_GRID_PRIME3));
+		blendTotal = _mm_add_ps(blendTotal, SimplexCorner4dx4(SIMDNoiseHash4(index4, seedVec), disp4X, disp4Y, disp4Z, disp4T));
+
+		__m128 noise = _mm_mul_ps(blendTotal, normalize);
+		_mm_storeu_ps(total + idx, _mm_add_ps(_mm_loadu_ps(total + idx), _mm_mul_ps(noise, amp)));
+	}
+}
+#endif
+
+////////////////////////////////////// Grid //////////////////////////////////////
+#if !MATH_SIMD_SSE
+// no lanes to batch simplex over, the point functions already are the scalar path
+static void ComputeSimplexRunScalar(const sNoiseGridJob& job, uint x0, uint count, uint y, uint z, float* out)
+{
+	float posY = job.minY + (float)y * job.spacing;
+	float posZ = job.minZ + (float)z * job.spacing;
+	for (uint idx = 0; idx < count; ++idx)
+	{
+		float posX = job.minX + (float)(x0 + idx) * job.spacing;
+		if (job.dims == 2)
+			out[idx] = Compute2dSimplexNoise(posX, posY, job.scale, job.numOctaves, job.octavePersistence, job.octaveScale, job.renormalize, job.seed);
+		else if (job.dims == 3)
+			out[idx] = Compute3dSimplexNoise(posX, posY, posZ, job.scale, job.numOctaves, job.octavePersistence, job.octaveScale, job.renormalize, job.seed);
+		else
+			out[idx] = Compute4dSimplexNoise(posX, posY, posZ, job.posT, job.scale, job.numOctaves, job.octavePersistence, job.octaveScale, job.renormalize, job.seed);
+	}
+}
+#endif
+
+// count samples of one row starting at column x0
+static void ComputeRun(const sNoiseGridJob& job, uint x0, uint count, uint y, uint z, float* out)
+{
+#if !MATH_SIMD_SSE
+	if (job.kind == NOISE_GRID_SIMPLEX)
+	{
+		ComputeSimplexRunScalar(job, x0, count, y, z, out);
+		return;
+	}
+#endif
+
+	float posX[NOISE_GRID_CHUNK];
+	float cellMinX[NOISE_GRID_CHUNK];
+	int cellX[NOISE_GRID_CHUNK];
+	float total[NOISE_GRID_CHUNK];
+	union
+	{
+		float			values[8][NOISE_GRID_CHUNK];
+		unsigned int	hashes[8][NOISE_GRID_CHUNK];
+	} corners;
+
+	bool is3d = (job.dims == 3);
+	uint lanes = (job.kind == NOISE_GRID_SIMPLEX) ? (count + 3) & ~3u : count;
+
+	float invScale = 1.f / job.scale;
+	for (uint idx = 0; idx < lanes; ++idx)
+	{
+		posX[idx] = (job.minX + (float)(x0 + idx) * job.spacing) * invScale;
+		total[idx] = 0.f;
+	}
+	float posY = (job.minY + (float)y * job.spacing) * invScale;
+	float posZ = (job.minZ + (float)z * job.spacing) * invScale;
+	float posT = job.posT * invScale;
+
+	float amplitude = 1.f;
+	float totalAmplitude = 0.f;
+	unsigned int seed = job.seed;
+	for (uint octave = 0; octave < job.numOctaves; ++octave)
+	{
+		if (job.kind == NOISE_GRID_SIMPLEX)
+		{
+		#if MATH_SIMD_SSE
+			if (job.dims == 2)
+				Simplex2dOctave(posX, lanes, posY, seed, amplitude, total);
+			else if (job.dims == 3)
+				Simplex3dOctave(posX, lanes, posY, posZ, seed, amplitude, total);
+			else
+				Simplex4dOctave(posX, lanes, posY, posZ, posT, seed, amplitude, total);
+		#endif
+		}
+		else
+		{
+			float cellMinY = floorf(posY);
+			float cellMinZ = floorf(posZ);
+			for (uint idx = 0; idx < count; ++idx)
+			{
+				cellMinX[idx] = floorf(posX[idx]);
+				cellX[idx] = (int)cellMinX[idx];
+			}
+
+			if (job.kind == NOISE_GRID_FRACTAL)
+			{
+				GatherCorners(cellX, count, (int)cellMinY, (int)cellMinZ, is3d, seed, corners.values);
+				if (is3d)
+					Fractal3dOctave(posX, cellMinX, count, posY, cellMinY, posZ, cellMinZ, corners.values, amplitude, total);
+				else
+					Fractal2dOctave(posX, cellMinX, count, posY, cellMinY, corners.values, amplitude, total);
+			}
+			else
+			{
+				GatherCorners(cellX, count, (int)cellMinY, (int)cellMinZ, is3d, seed, corners.hashes);
+				if (is3d)
+					Perlin3dOctave(posX, cellMinX, count, posY, cellMinY, posZ, cellMinZ, corners.hashes, amplitude, total);
+				else
+					Perlin2dOctave(posX, cellMinX, count, posY, cellMinY, corners.hashes, amplitude, total);
+			}
+		}
+
+		totalAmplitude += amplitude;
+		amplitude *= job.octavePersistence;
+		for (uint idx = 0; idx < lanes; ++idx)
+		{
+			posX[idx] *= job.octaveScale;
+			posX[idx] += NOISE_GRID_OCTAVE_OFFSET;
+		}
+		posY *= job.octaveScale;
+		posY += NOISE_GRID_OCTAVE_OFFSET;
+		posZ *= job.octaveScale;
+		posZ += NOISE_GRID_OCTAVE_OFFSET;
+		posT *= job.octaveScale;
+		posT += NOISE_GRID_OCTAVE_OFFSET;
+		++seed;
+	}
+
+	if (job.renormalize && totalAmplitude > 0.f)
+	{
+		for (uint idx = 0; idx < count; ++idx)
+		{
+			float noise = total[idx] / totalAmplitude;
+			noise = (noise * 0.5f) + 0.5f;
+			noise = SmoothStep3(noise);
+			out[idx] = (noise * 2.0f) - 1.f;
+		}
+	}
+	else
+	{
+		for (uint idx = 0; idx < count; ++idx)
+			out[idx] = total[idx];
+	}
+}
+
+static void ComputeRow(uint row, void* userData)
+{
+	const sNoiseGridJob& job = *(const sNoiseGridJob*)(userData);
+
+	uint y = row % job.height;
+	uint z = row / job.height;
+	float* rowOut = job.out + (size_t)row * job.width;
+	for (uint x0 = 0; x0 < job.width; x0 += NOISE_GRID_CHUNK)
+	{
+		uint count = (job.width - x0 < NOISE_GRID_CHUNK) ? job.width - x0 : NOISE_GRID_CHUNK;
+		ComputeRun(job, x0, count, y, z, rowOut + x0);
+	}
+}
+
+static void ComputeGrid(eNoiseGridKind kind, uint dims, float minX, float minY, float minZ, float posT, float spacing, uint width, uint height, uint depth, float* out,
+	float scale, uint numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed)
+{
+	uint rows = height * depth;
+	if (width == 0 || rows == 0)
+		return;
+
+	sNoiseGridJob job;
+	job.kind = kind;
+	job.dims = dims;
+	job.minX = minX;
+	job.minY = minY;
+	job.minZ = minZ;
+	job.posT = posT;
+	job.spacing = spacing;
+	job.width = width;
+	job.height = height;
+	job.out = out;
+	job.scale = scale;
+	job.numOctaves = numOctaves;
+	job.octavePersistence = octavePersistence;
+	job.octaveScale = octaveScale;
+	job.renormalize = renormalize;
+	job.seed = seed;
+
+	uint maxThreads = ((size_t)width * rows < NOISE_GRID_PARALLEL_MIN) ? 1 : 0;
+	ParallelFor(rows, ComputeRow, &job, maxThreads);
+}
+
+////////////////////////////////////// API //////////////////////////////////////
+void Compute2dFractalNoiseGrid(float minX, float minY, float spacing, uint width, uint height, float* out,
+	float scale, uint numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed)
+{
+	ComputeGrid(NOISE_GRID_FRACTAL, 2, minX, minY, 0.f, 0.f, spacing, width, height, 1, out,
+		scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+}
+
+void Compute2dPerlinNoiseGrid(float minX, float minY, float spacing, uint width, uint height, float* out,
+	float scale, uint numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed)
+{
+	ComputeGrid(NOISE_GRID_PERLIN, 2, minX, minY, 0.f, 0.f, spacing, width, height, 1, out,
+		scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+}
+
+void Compute3dFractalNoiseGrid(float minX, float minY, float minZ, float spacing, uint width, uint height, uint depth, float* out,
+	float scale, uint numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed)
+{
+	ComputeGrid(NOISE_GRID_FRACTAL, 3, minX, minY, minZ, 0.f, spacing, width, height, depth, out,
+		scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+}
+
+void Compute3dPerlinNoiseGrid(float minX, float minY, float minZ, float spacing, uint width, uint height, uint depth, float* out,
+	float scale, uint numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed)
+{
+	ComputeGrid(NOISE_GRID_PERLIN, 3, minX, minY, minZ, 0.f, spacing, width, height, depth, out,
+		scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+}
+
+void Compute2dSimplexNoiseGrid(float minX, float minY, float spacing, uint width, uint height, float* out,
+	float scale, uint numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed)
+{
+	ComputeGrid(NOISE_GRID_SIMPLEX, 2, minX, minY, 0.f, 0.f, spacing, width, height, 1, out,
+		scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+}
+
+void Compute3dSimplexNoiseGrid(float minX, float minY, float minZ, float spacing, uint width, uint height, uint depth, float* out,
+	float scale, uint numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed)
+{
+	ComputeGrid(NOISE_GRID_SIMPLEX, 3, minX, minY, minZ, 0.f, spacing, width, height, depth, out,
+		scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+}
+
+void Compute4dSimplexNoiseGrid(float minX, float minY, float minZ, float posT, float spacing, uint width, uint height, uint depth, float* out,
+	float scale, uint numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed)
+{
+	ComputeGrid(NOISE_GRID_SIMPLEX, 4, minX, minY, minZ, posT, spacing, width, height, depth, out,
+		scale, numOctaves, octavePersistence, octaveScale, renormalize, seed);
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+
+/*
+ * Fractal, Perlin and simplex noise over whole regular grids, the same as calling the SmoothNoise.hpp
+ * functions once per sample up to float rounding (the two files may contract multiply-adds differently,
+ * so do not compare them with ==). Fractal and Perlin octaves hash the lattice rows under a run of samples
+ * once (RawNoiseBatch) and share the corners between neighbours; simplex cells differ per sample, so it
+ * hashes its corners in SSE lanes instead. Blending runs 4 samples at a time, and rows are spread over
+ * threads when the grid is large enough to pay for them.
+ */
+
+// out[y * width + x] = Compute2d*Noise(minX + x * spacing, minY + y * spacing, ...)
+void Compute2dFractalNoiseGrid(float minX, float minY, float spacing, uint width, uint height, float* out,
+	float scale = 1.f, uint numOctaves = 1, float octavePersistence = 0.5f, float octaveScale = 2.f, bool renormalize = true, unsigned int seed = 0);
+void Compute2dPerlinNoiseGrid(float minX, float minY, float spacing, uint width, uint height, float* out,
+	float scale = 1.f, uint numOctaves = 1, float octavePersistence = 0.5f, float octaveScale = 2.f, bool renormalize = true, unsigned int seed = 0);
+void Compute2dSimplexNoiseGrid(float minX, float minY, float spacing, uint width, uint height, float* out,
+	float scale = 1.f, uint numOctaves = 1, float octavePersistence = 0.5f, float octaveScale = 2.f, bool renormalize = true, unsigned int seed = 0);
+
+// out[(z * height + y) * width + x] = Compute3d*Noise(minX + x * spacing, minY + y * spacing, minZ + z * spacing, ...)
+void Compute3dFractalNoiseGrid(float minX, float minY, float minZ, float spacing, uint width, uint height, uint depth, float* out,
+	float scale = 1.f, uint numOctaves = 1, float octavePersistence = 0.5f, float octaveScale = 2.f, bool renormalize = true, unsigned int seed = 0);
+void Compute3dPerlinNoiseGrid(float minX, float minY, float minZ, float spacing, uint width, uint height, uint depth, float* out,
+	float scale = 1.f, uint numOctaves = 1, float octavePersistence = 0.5f, float octaveScale = 2.f, bool renormalize = true, unsigned int seed = 0);
+void Compute3dSimplexNoiseGrid(float minX, float minY, float minZ, float spacing, uint width, uint height, uint depth, float* out,
+	float scale = 1.f, uint numOctaves = 1, float octavePersistence = 0.5f, float octaveScale = 2.f, bool renormalize = true, unsigned int seed = 0);
+
+// one time slice of a 4d field, for animated volumes: out[(z * height + y) * width + x] = Compute4dSimplexNoise(..., posT, ...)
+void Compute4dSimplexNoiseGrid(float minX, float minY, float minZ, float posT, float spacing, uint width, uint height, uint depth, float* out,
+	float scale = 1.f, uint numOctaves = 1, float octavePersistence = 0.5f, float octaveScale = 2.f, bool renormalize = true, unsigned int seed = 0);
\ No newline at end of file
@@ -0,0 +1,388 @@
+#include "Engine/Math/TransformBatch.hpp"
+#include "Engine/Core/Thread/ParallelFor.hpp"
+
+#if defined(__AVX__)
+	#include <immintrin.h>
+#endif
+
+#include <stddef.h>
+
+struct sTransformBatchJob
+{
+	const float* m_mat;			// 16 column major floats
+	bool m_point;				// adds translation
+	bool m_normalize;
+
+	// SoA
+	const float* m_in[3];
+	float* m_out[3];
+
+	// strided
+	const unsigned char* m_in_base;
+	unsigned char* m_out_base;
+	uint m_in_stride;
+	uint m_out_stride;
+
+	uint m_count;
+};
+
+#if MATH_SIMD_SSE
+struct sTransformBatchSSE
+{
+	__m128 m_ix, m_iy, m_iz;
+	__m128 m_jx, m_jy, m_jz;
+	__m128 m_kx, m_ky, m_kz;
+	__m128 m_tx, m_ty, m_tz;
+};
+
+static inline void LoadTransformBatchSSE(const float* m, bool point, sTransformBatchSSE& out)
+{
+	out.m_ix = _mm_set1_ps(m[0]); out.m_iy = _mm_set1_ps(m[1]); out.m_iz = _mm_set1_ps(m[2]);
+	out.m_jx = _mm_set1_ps(m[4]); out.m_jy = _mm_set1_ps(m[5]); out.m_jz = _mm_set1_ps(m[6]);
+	out.m_kx = _mm_set1_ps(m[8]); out.m_ky = _mm_set1_ps(m[9]); out.m_kz = _mm_set1_ps(m[10]);
+	out.m_tx = _mm_set1_ps(point ? m[12] : 0.f);
+	out.m_ty = _mm_set1_ps(point ? m[13] : 0.f);
+	out.m_tz = _mm_set1_ps(point ? m[14] : 0.f);
+}
+
+// 4 elements as SoA lanes, shared by the SoA and strided paths
+static inline void TransformBatchSSE(const sTransformBatchSSE& mat, __m128& x, __m128& y, __m128& z)
+{
+	__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(mat.m_ix, x), _mm_mul_ps(mat.m_jx, y)), _mm_add_ps(_mm_mul_ps(mat.m_kx, z), mat.m_tx));
+	__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(mat.m_iy, x), _mm_mul_ps(mat.m_jy, y)), _mm_add_ps(_mm_mul_ps(mat.m_ky, z), mat.m_ty));
+	__m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(mat.m_iz, x), _mm_mul_ps(mat.m_jz, y)), _mm_add_ps(_mm_mul_ps(mat.m_kz, z), mat.m_tz));
+	x = rx;
+	y = ry;
+	z = rz;
+}
+
+static inline void NormalizeBatchSSE(__m128& x, __m128& y, __m128& z)
+{
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 len_sqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+
+	// zero length lanes divide by one and stay zero
+	__m128 nonzero = _mm_cmpgt_ps(len_sqr, _mm_setzero_ps());
+	__m128 len = _mm_or_ps(_mm_and_ps(nonzero, _mm_sqrt_ps(len_sqr)), _mm_andnot_ps(nonzero, one));
+	__m128 inv_len = _mm_div_ps(one, len);
+
+	x = _mm_mul_ps(x, inv_len);
+	y = _mm_mul_ps(y, inv_len);
+	z = _mm_mul_ps(z, inv_len);
+}
+#endif
+
+static void TransformRangeSoA(const sTransformBatchJob& job, uint begin, uint end)
+{
+	const float* m = job.m_mat;
+	float tx = job.m_point ? m[12] : 0.f;
+	float ty = job.m_point ? m[13] : 0.f;
+	float tz = job.m_point ? m[14] : 0.f;
+
+	const float* x = job.m_in[0];
+	const float* y = job.m_in[1];
+	const float* z = job.m_in[2];
+	float* ox = job.m_out[0];
+	float* oy = job.m_out[1];
+	float* oz = job.m_out[2];
+
+	uint idx = begin;
+
+#if defined(__AVX__)
+	{
+		__m256 ix = _mm256_set1_ps(m[0]), iy = _mm256_set1_ps(m[1]), iz = _mm256_set1_ps(m[2]);
+		__m256 jx = _mm256_set1_ps(m[4]), jy = _mm256_set1_ps(m[5]), jz = _mm256_set1_ps(m[6]);
+		__m256 kx = _mm256_set1_ps(m[8]), ky = _mm256_set1_ps(m[9]), kz = _mm256_set1_ps(m[10]);
+		__m256 vtx = _mm256_set1_ps(tx), vty = _mm256_set1_ps(ty), vtz = _mm256_set1_ps(tz);
+
+		for (; idx + 8 <= end; idx += 8)
+		{
+			__m256 vx = _mm256_loadu_ps(x + idx);
+			__m256 vy = _mm256_loadu_ps(y + idx);
+			__m256 vz = _mm256_loadu_ps(z + idx);
+
+			__m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ix, vx), _mm256_mul_ps(jx, vy)), _mm256_add_ps(_mm256_mul_ps(kx, vz), vtx));
+			__m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(iy, vx), _mm256_mul_ps(jy, vy)), _mm256_add_ps(_mm256_mul_ps(ky, vz), vty));
+			__m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(iz, vx), _mm256_mul_ps(jz, vy)), _mm256_add_ps(_mm256_mul_ps(kz, vz), vtz));
+
+			_mm256_storeu_ps(ox + idx, rx);
+			_mm256_storeu_ps(oy + idx, ry);
+			_mm256_storeu_ps(oz + idx, rz);
+		}
+	}
+#endif
+
+#if MATH_SIMD_SSE
+	{
+		sTransformBatchSSE mat;
+		LoadTransformBatchSSE(m, job.m_point, mat);
+
+		for (; idx + 4 <= end; idx += 4)
+		{
+			__m128 vx = _mm_loadu_ps(x + idx);
+			__m128 vy = _mm_loadu_ps(y + idx);
+			__m128 vz = _mm_loadu_ps(z + idx);
+
+			TransformBatchSSE(mat, vx, vy, vz);
+
+			_mm_storeu_ps(ox + idx, vx);
+			_mm_storeu_ps(oy + idx, vy);
+			_mm_storeu_ps(oz + idx, vz);
+		}
+	}
+#endif
+
+	// tail, and the whole range without simd
+	for (; idx < end; ++idx)
+	{
+		float vx = x[idx], vy = y[idx], vz = z[idx];
+		ox[idx] = (m[0] * vx + m[4] * vy) + (m[8] * vz + tx);
+		oy[idx] = (m[1] * vx + m[5] * vy) + (m[9] * vz + ty);
+		oz[idx] = (m[2] * vx + m[6] * vy) + (m[10] * vz + tz);
+	}
+}
+
+static void TransformRangeStrided(const sTransformBatchJob& job, uint begin, uint end)
+{
+	const float* m = job.m_mat;
+	const unsigned char* in_base = job.m_in_base;
+	unsigned char* out_base = job.m_out_base;
+	size_t in_stride = job.m_in_stride;
+	size_t out_stride = job.m_out_stride;
+
+	uint idx = begin;
+
+#if MATH_SIMD_SSE
+	{
+		sTransformBatchSSE mat;
+		LoadTransformBatchSSE(m, job.m_point, mat);
+
+		// each element is loaded 4 floats wide, the 4th is the next element's x, so the last
+		// element of the range is left to the scalar loop to never read past it
+		for (; idx + 4 < end; idx += 4)
+		{
+			const unsigned char* in = in_base + idx * in_stride;
+			__m128 v0 = _mm_loadu_ps((const float*)(in));
+			__m128 v1 = _mm_loadu_ps((const float*)(in + in_stride));
+			__m128 v2 = _mm_loadu_ps((const float*)(in + 2 * in_stride));
+			__m128 v3 = _mm_loadu_ps((const float*)(in + 3 * in_stride));
+
+			// AoS to SoA, v3 ends up as the unused 4th row
+			_MM_TRANSPOSE4_PS(v0, v1, v2, v3);
+
+			TransformBatchSSE(mat, v0, v1, v2);
+			if (job.m_normalize)
+				NormalizeBatchSSE(v0, v1, v2);
+
+			_MM_TRANSPOSE4_PS(v0, v1, v2, v3);
+
+			// only x, y, z go back, whatever follows them in the element is left alone
+			unsigned char* out = out_base + idx * out_stride;
+			_mm_storel_pi((__m64*)(out), v0);
+			_mm_store_ss((float*)(out) + 2, _mm_movehl_ps(v0, v0));
+			_mm_storel_pi((__m64*)(out + out_stride), v1);
+			_mm_store_ss((float*)(out + out_stride) + 2, _mm_movehl_ps(v1, v1));
+			_mm_storel_pi((__m64*)(out + 2 * out_stride), v2);
+			_mm_store_ss((float*)(out + 2 * out_stride) + 2, _mm_movehl_ps(v2, v2));
+			_mm_storel_pi((__m64*)(out + 3 * out_stride), v3);
+			_mm_store_ss((float*)(out + 3 * out_stride) + 2, _mm_movehl_ps(v3, v3));
+		}
+	}
+#endif
+
+	// tail, and the whole range without simd
+	float w = job.m_point ? 1.f : 0.f;
+	for (; idx < end; ++idx)
+	{
+		const float* in = (const float*)(in_base + idx * in_stride);
+		float* out = (float*)(out_base + idx * out_stride);
+
+		float v[4] = { in[0], in[1], in[2], w };
+		float res[4];
+		SIMDMat44MulVec4(m, v, res);
+
+		if (job.m_normalize)
+		{
+			float len_sqr = res[0] * res[0] + res[1] * res[1] + res[2] * res[2];
+			if (len_sqr > 0.f)
+			{
+				float inv_len = 1.f / sqrtf(len_sqr);
+				res[0] *= inv_len;
+				res[1] *= inv_len;
+				res[2] *= inv_len;
+			}
+		}
+
+		out[0] = res[0];
+		out[1] = res[1];
+		out[2] = res[2];
+	}
+}
+
+static void TransformBatchChunk(uint chunk, void* userData)
+{
+	const sTransformBatchJob& job = *(const sTransformBatchJob*)(userData);
+
+	uint begin = chunk * TRANSFORM_BATCH_CHUNK;
+	uint end = begin + TRANSFORM_BATCH_CHUNK;
+	if (end > job.m_count)
+		end = job.m_count;
+
+	if (job.m_in_base != nullptr)
+		TransformRangeStrided(job, begin, end);
+	else
+		TransformRangeSoA(job, begin, end);
+}
+
+static void RunTransformBatch(sTransformBatchJob& job)
+{
+	if (job.m_count == 0)
+		return;
+
+	if (job.m_count < TRANSFORM_BATCH_PARALLEL_MIN)
+	{
+		if (job.m_in_base != nullptr)
+			TransformRangeStrided(job, 0, job.m_count);
+		else
+			TransformRangeSoA(job, 0, job.m_count);
+		return;
+	}
+
+	uint chunks = (job.m_count + TRANSFORM_BATCH_CHUNK - 1) / TRANSFORM_BATCH_CHUNK;
+	ParallelFor(chunks, TransformBatchChunk, &job);
+}
+
+static sTransformBatchJob MakeSoAJob(const Matrix44& mat, bool point, const float* x, const float* y, const float* z,
+	float* out_x, float* out_y, float* out_z, uint count)
+{
+	sTransformBatchJob job = {};
+	job.m_mat = &mat.Ix;
+	job.m_point = point;
+	job.m_in[0] = x;
+	job.m_in[1] = y;
+	job.m_in[2] = z;
+	job.m_out[0] = out_x;
+	job.m_out[1] = out_y;
+	job.m_out[2] = out_z;
+	job.m_count = count;
+	return job;
+}
+
+static sTransformBatchJob MakeStridedJob(const Matrix44& mat, bool point, bool normalize,
+	const void* in, uint in_stride, void* out, uint out_stride, uint count)
+{
+	sTransformBatchJob job = {};
+	job.m_mat = &mat.Ix;
+	job.m_point = point;
+	job.m_normalize = normalize;
+	job.m_in_base = (const unsigned char*)(in);
+	job.m_out_base = (unsigned char*)(out);
+	job.m_in_stride = in_stride;
+	job.m_out_stride = out_stride;
+	job.m_count = count;
+	return job;
+}
+
+////////////////////////////////////// SoA //////////////////////////////////////
+void TransformPointsSoA(const Matrix44& mat, const float* x, const float* y, const float* z,
+	float* out_x, float* out_y, float* out_z, uint count)
+{
+	sTransformBatchJob job = MakeSoAJob(mat, true, x, y, z, out_x, out_y, out_z, count);
+	RunTransformBatch(job);
+}
+
+void TransformDirectionsSoA(const Matrix44& mat, const float* x, const float* y, const float* z,
+	float* out_x, float* out_y, float* out_z, uint count)
+{
+	sTransformBatchJob job = MakeSoAJob(mat, false, x, y, z, out_x, out_y, out_z, count);
+	RunTransformBatch(job);
+}
+
+void TransformPointsSoA(const Quaternion& rot, const Vector3& translation, const float* x, const float* y, const float* z,
+	float* out_x, float* out_y, float* out_z, uint count)
+{
+	Matrix44 mat = Quaternion::GetMatrixWithPosition(rot, translation);
+	TransformPointsSoA(mat, x, y, z, out_x, out_y, out_z, count);
+}
+
+void TransformDirectionsSoA(const Quaternion& rot, const float* x, const float* y, const float* z,
+	float* out_x, float* out_y, float* out_z, uint count)
+{
+	Matrix44 mat = Quaternion::GetMatrixRotation(rot);
+	TransformDirectionsSoA(mat, x, y, z, out_x, out_y, out_z, count);
+}
+
+////////////////////////////////////// AoS //////////////////////////////////////
+void TransformPoints(const Matrix44& mat, const Vector3* in, Vector3* out, uint count)
+{
+	TransformPointsStrided(mat, in, sizeof(Vector3), out, sizeof(Vector3), count);
+}
+
+void TransformDirections(const Matrix44& mat, const Vector3* in, Vector3* out, uint count)
+{
+	TransformDirectionsStrided(mat, in, sizeof(Vector3), out, sizeof(Vector3), count);
+}
+
+void TransformPoints(const Quaternion& rot, const Vector3& translation, const Vector3* in, Vector3* out, uint count)
+{
+	Matrix44 mat = Quaternion::GetMatrixWithPosition(rot, translation);
+	TransformPoints(mat, in, out, count);
+}
+
+void TransformDirections(const Quaternion& rot, const Vector3* in, Vector3* out, uint count)
+{
+	Matrix44 mat = Quaternion::GetMatrixRotation(rot);
+	TransformDirections(mat, in, out, count);
+}
+
+void TransformPointsStrided(const Matrix44& mat, const void* in, uint in_stride, void* out, uint out_stride, uint count)
+{
+	sTransformBatchJob job = MakeStridedJob(mat, true, false, in, in_stride, out, out_stride, count);
+	RunTransformBatch(job);
+}
+
+void TransformDirectionsStrided(const Matrix44& mat, const void* in, uint in_stride, void* out, uint out_stride, uint count, bool normalize)
+{
+	sTransformBatchJob job = MakeStridedJob(mat, false, normalize, in, in_stride, out, out_stride, count);
+	RunTransformBatch(job);
+}
+
+////////////////////////////////////// Vertices //////////////////////////////////////
+static Matrix44 GetNormalMatrix(const Matrix44& mat)
+{
+	// inverse transpose keeps normals perpendicular under non uniform scale
+	Matrix44 normal_mat = mat.InvertAffine().Transpose();
+	normal_mat.Tx = normal_mat.Ty = normal_mat.Tz = 0.f;
+	normal_mat.Iw = normal_mat.Jw = normal_mat.Kw = 0.f;
+	normal_mat.Tw = 1.f;
+	return normal_mat;
+}
+
+void TransformVertices(const Matrix44& mat, Vertex_3DPCU* verts, uint count)
+{
+	unsigned char* base = (unsigned char*)(verts);
+	TransformPointsStrided(mat, base + offsetof(Vertex_3DPCU, m_pos), sizeof(Vertex_3DPCU),
+		base + offsetof(Vertex_3DPCU, m_pos), sizeof(Vertex_3DPCU), count);
+}
+
+void TransformVertices(const Matrix44& mat, VertexLit* verts, uint count)
+{
+	unsigned char* base = (unsigned char*)(verts);
+	uint stride = sizeof(VertexLit);
+	Matrix44 normal_mat = GetNormalMatrix(mat);
+
+	TransformPointsStrided(mat, base + offsetof(VertexLit, m_pos), stride, base + offsetof(VertexLit, m_pos), stride, count);
+	TransformDirectionsStrided(normal_mat, base + offsetof(VertexLit, m_normal), stride, base + offsetof(VertexLit, m_normal), stride, count, true);
+	TransformDirectionsStrided(mat, base + offsetof(VertexLit, m_tangent), stride, base + offsetof(VertexLit, m_tangent), stride, count, true);
+}
+
+void TransformVertices(const Matrix44& mat, sVertexBuilder* verts, uint count)
+{
+	unsigned char* base = (unsigned char*)(verts);
+	uint stride = sizeof(sVertexBuilder);
+	Matrix44 normal_mat = GetNormalMatrix(mat);
+
+	TransformPointsStrided(mat, base + offsetof(sVertexBuilder, m_position), stride, base + offsetof(sVertexBuilder, m_position), stride, count);
+	TransformDirectionsStrided(normal_mat, base + offsetof(sVertexBuilder, m_normal), stride, base + offsetof(sVertexBuilder, m_normal), stride, count, true);
+	TransformDirectionsStrided(mat, base + offsetof(sVertexBuilder, m_tangent), stride, base + offsetof(sVertexBuilder, m_tangent), stride, count, true);
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Engine/Math/Matrix44.hpp"
+#include "Engine/Core/Quaternion.hpp"
+#include "Engine/Core/Vertex.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#define TRANSFORM_BATCH_CHUNK 4096				// elements per parallel job
+#define TRANSFORM_BATCH_PARALLEL_MIN 32768		// below this the thread start up costs more than it saves
+
+/*
+ * Transform many points or directions by one matrix (or quaternion plus translation).
+ * SoA input runs 4 or 8 wide; AoS and vertex input is read through a stride so any struct
+ * with 3 floats at some offset works, 4 at a time transposed into SoA registers for the same
+ * kernel. Large batches are split over threads. Output may alias input.
+ */
+
+// SoA
+void TransformPointsSoA(const Matrix44& mat, const float* x, const float* y, const float* z,
+	float* out_x, float* out_y, float* out_z, uint count);
+void TransformDirectionsSoA(const Matrix44& mat, const float* x, const float* y, const float* z,
+	float* out_x, float* out_y, float* out_z, uint count);
+void TransformPointsSoA(const Quaternion& rot, const Vector3& translation, const float* x, const float* y, const float* z,
+	float* out_x, float* out_y, float* out_z, uint count);
+void TransformDirectionsSoA(const Quaternion& rot, const float* x, const float* y, const float* z,
+	float* out_x, float* out_y, float* out_z, uint count);
+
+// AoS
+void TransformPoints(const Matrix44& mat, const Vector3* in, Vector3* out, uint count);
+void TransformDirections(const Matrix44& mat, const Vector3* in, Vector3* out, uint count);
+void TransformPoints(const Quaternion& rot, const Vector3& translation, const Vector3* in, Vector3* out, uint count);
+void TransformDirections(const Quaternion& rot, const Vector3* in, Vector3* out, uint count);
+
+// 3 floats at in, in + in_stride, ...
+void TransformPointsStrided(const Matrix44& mat, const void* in, uint in_stride, void* out, uint out_stride, uint count);
+void TransformDirectionsStrided(const Matrix44& mat, const void* in, uint in_stride, void* out, uint out_stride, uint count, bool normalize = false);
+
+// vertices in place; normals go through the inverse transpose and tangents keep their w
+void TransformVertices(const Matrix44& mat, Vertex_3DPCU* verts, uint count);
+void TransformVertices(const Matrix44& mat, VertexLit* verts, uint count);
+void TransformVertices(const Matrix44& mat, sVertexBuilder* verts, uint count);
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 #include "Engine/Math/Vector4.hpp"
 
+#include <limits>
+#include <math.h>
+
 #define VEC3_IDENTITY_THRESHOLD 0.001f
 
 class Vector3
@@ -12,44 +15,44 @@ public:
 	float z;
 
 	// Construction/Destruction
-	~Vector3() {}											
+	~Vector3() = default;
 	Vector3() {}						
-	Vector3(const Vector3& copyFrom);						
-	explicit Vector3( float initialX, float initialY, float initialZ );		
-	explicit Vector3(float initial);
+	constexpr Vector3(const Vector3& copyFrom);						
+	constexpr explicit Vector3( float initialX, float initialY, float initialZ );		
+	constexpr explicit Vector3(float initial);
 
 	// Operators
-	const Vector3 operator+( const Vector3& vecToAdd ) const;		
-	const Vector3 operator-( const Vector3& vecToSubtract ) const;	
-	const Vector3 operator*( float uniformScale ) const;
-	const Vector3 operator*(const Vector3& toMultiply) const;
-	const Vector3 operator/( float inverseScale ) const;			
+	constexpr const Vector3 operator+( const Vector3& vecToAdd ) const;		
+	constexpr const Vector3 operator-( const Vector3& vecToSubtract ) const;	
+	constexpr const Vector3 operator*( float uniformScale ) const;
+	constexpr const Vector3 operator*(const Vector3& toMultiply) const;
+	constexpr const Vector3 operator/( float inverseScale ) const;			
 	const bool operator<(const Vector3& compared) const;	// for std::set
 	const bool operator<=(const Vector3& compared) const;
 	const bool operator>(const Vector3& compared) const;
 	const bool operator>=(const Vector3& compared) const;
-	void operator+=( const Vector3& vecToAdd );						
-	void operator-=( const Vector3& vecToSubtract );				
-	void operator*=( const float& uniformScale );					
-	void operator/=( const float& uniformDivisor );					
-	void operator=( const Vector3& copyFrom );						
-	bool operator==( const Vector3& compare ) const;				
-	bool operator!=( const Vector3& compare ) const;	
+	constexpr void operator+=( const Vector3& vecToAdd );						
+	constexpr void operator-=( const Vector3& vecToSubtract );				
+	constexpr void operator*=( const float& uniformScale );					
+	constexpr void operator/=( const float& uniformDivisor );					
+	constexpr void operator=( const Vector3& copyFrom );						
+	constexpr bool operator==( const Vector3& compare ) const;				
+	constexpr bool operator!=( const Vector3& compare ) const;	
 	const float operator[](const int idx) const;
 	float& operator[](const int& idx);
-	const Vector3 operator-() const;
+	constexpr const Vector3 operator-() const;
  
-	float	GetLength() const;
-	float	GetLengthSquared() const;
-	float	NormalizeAndGetLength();
-	void	Normalize();
-	Vector3 Cross(const Vector3& rhs) const;
-	Vector3 GetNormalized() const;
+	inline float GetLength() const;
+	constexpr float GetLengthSquared() const;
+	inline float NormalizeAndGetLength();
+	inline void	Normalize();
+	constexpr Vector3 Cross(const Vector3& rhs) const;
+	inline Vector3 GetNormalized() const;
 
-	Vector4 ToVector4(float w) const;
+	constexpr Vector4 ToVector4(float w) const;
 
-	void Set(float newX, float newY, float newZ);
-	void ToDefault();
+	constexpr void Set(float newX, float newY, float newZ);
+	constexpr void ToDefault();
 
 	Vector3 RotateAboutAxisWithAngle(float angle, Vector3 axis);
 
@@ -66,3 +69,162 @@ public:
 
 const Vector3 GetProjectedVector( const Vector3& vectorToProject, const Vector3& projectOnto );
 Vector3 GetMiddlePoint(const Vector3& min, const Vector3& max);
+
+////////////////////////////////////// Inline //////////////////////////////////////
+constexpr Vector3::Vector3( const Vector3& copy )
+	: x( copy.x ), y( copy.y ), z( copy.z )
+{
+
+}
+
+constexpr Vector3::Vector3( float initialX, float initialY, float initialZ )
+	: x( initialX ), y( initialY ), z( initialZ )
+{
+
+}
+
+constexpr Vector3::Vector3( float initial )
+	: x( initial ), y( initial ), z( initial )
+{
+
+}
+
+inline constexpr Vector3 Vector3::ZERO = Vector3(0.f, 0.f, 0.f);
+inline constexpr Vector3 Vector3::ONE = Vector3(1.f, 1.f, 1.f);
+inline constexpr Vector3 Vector3::UP = Vector3(0.f, 1.f, 0.f);
+inline constexpr Vector3 Vector3::INVALID = Vector3(-std::numeric_limits<float>::infinity());
+
+constexpr const Vector3 Vector3::operator+( const Vector3& vecToAdd ) const
+{
+	return Vector3( x + vecToAdd.x, y + vecToAdd.y, z + vecToAdd.z );
+}
+
+constexpr const Vector3 Vector3::operator-( const Vector3& vecToSubtract ) const
+{
+	return Vector3( x - vecToSubtract.x, y - vecToSubtract.y, z - vecToSubtract.z );
+}
+
+constexpr const Vector3 Vector3::operator*( float uniformScale ) const
+{
+	return Vector3( x * uniformScale, y * uniformScale, z * uniformScale );
+}
+
+// component wise
+constexpr const Vector3 Vector3::operator*( const Vector3& toMultiply ) const
+{
+	return Vector3( x * toMultiply.x, y * toMultiply.y, z * toMultiply.z );
+}
+
+constexpr const Vector3 Vector3::operator/( float inverseScale ) const
+{
+	return Vector3( x / inverseScale, y / inverseScale, z / inverseScale );
+}
+
+constexpr void Vector3::operator+=( const Vector3& vecToAdd )
+{
+	x += vecToAdd.x;
+	y += vecToAdd.y;
+	z += vecToAdd.z;
+}
+
+constexpr void Vector3::operator-=( const Vector3& vecToSubtract )
+{
+	x -= vecToSubtract.x;
+	y -= vecToSubtract.y;
+	z -= vecToSubtract.z;
+}
+
+constexpr void Vector3::operator*=( const float& uniformScale )
+{
+	x *= uniformScale;
+	y *= uniformScale;
+	z *= uniformScale;
+}
+
+constexpr void Vector3::operator/=( const float& uniformDivisor )
+{
+	x /= uniformDivisor;
+	y /= uniformDivisor;
+	z /= uniformDivisor;
+}
+
+constexpr void Vector3::operator=( const Vector3& copyFrom )
+{
+	x = copyFrom.x;
+	y = copyFrom.y;
+	z = copyFrom.z;
+}
+
+constexpr bool Vector3::operator==( const Vector3& compare ) const
+{
+	return (x == compare.x) && (y == compare.y) && (z == compare.z);
+}
+
+constexpr bool Vector3::operator!=( const Vector3& compare ) const
+{
+	return !((*this) == compare);
+}
+
+constexpr const Vector3 Vector3::operator-() const
+{
+	return Vector3( -x, -y, -z );
+}
+
+constexpr float Vector3::GetLengthSquared() const
+{
+	return (x * x) + (y * y) + (z * z);
+}
+
+constexpr Vector3 Vector3::Cross( const Vector3& rhs ) const
+{
+	return Vector3( y * rhs.z - z * rhs.y, z * rhs.x - x * rhs.z, x * rhs.y - y * rhs.x );
+}
+
+inline float Vector3::GetLength() const
+{
+	return sqrtf( (x * x ) + (y * y) + (z * z) );
+}
+
+inline float Vector3::NormalizeAndGetLength()
+{
+	float length = GetLength();
+
+	float scale = 1.f / length;
+
+	x = x * scale;
+	y = y * scale;
+	z = z * scale;
+
+	return length;
+}
+
+inline void Vector3::Normalize()
+{
+	NormalizeAndGetLength();
+}
+
+inline Vector3 Vector3::GetNormalized() const
+{
+	float scale = 1.f / GetLength();
+
+	return Vector3(x * scale, y * scale, z * scale);
+}
+
+constexpr Vector4 Vector3::ToVector4(float w) const
+{
+	return Vector4(x, y, z, w);
+}
+
+constexpr void Vector3::Set(float newX, float newY, float newZ)
+{
+	x = newX;
+	y = newY;
+	z = newZ;
+}
+
+constexpr void Vector3::ToDefault()
+{
+	x = 0.f;
+	y = 0.f;
+	z = 0.f;
+}
\ No newline at end of file
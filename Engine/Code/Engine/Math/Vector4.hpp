@@ -1,8 +1,10 @@
 #pragma once
 
+#include "Engine/Math/MathSIMD.hpp"
+
 class Vector3;
 
-class Vector4
+class MATH_ALIGN16 Vector4
 {
 public:
 	float x;
@@ -11,10 +13,10 @@ public:
 	float w;
 
 	// Construction/Destruction
-	~Vector4() {}											
+	~Vector4() = default;
 	Vector4() {}								
-	Vector4( const Vector4& copyFrom );						
-	explicit Vector4( float initialX, float initialY, float initialZ, float initialW);		
+	constexpr Vector4( const Vector4& copyFrom );						
+	constexpr explicit Vector4( float initialX, float initialY, float initialZ, float initialW);		
 	explicit Vector4(const Vector3& base, float initialW);
 
 	// Operators
@@ -34,4 +36,77 @@ public:
 	static const Vector4 ZERO;
 
 	Vector3 ToVector3() const;
-};
\ No newline at end of file
+};
+
+////////////////////////////////////// Inline //////////////////////////////////////
+constexpr Vector4::Vector4( const Vector4& copy )
+	: x( copy.x ), y( copy.y ), z( copy.z ), w( copy.w )
+{
+
+}
+
+constexpr Vector4::Vector4( float initialX, float initialY, float initialZ, float initialW )
+	: x( initialX ), y( initialY ), z( initialZ ), w( initialW )
+{
+
+}
+
+inline constexpr Vector4 Vector4::ONE = Vector4(1.f, 1.f, 1.f, 1.f);
+inline constexpr Vector4 Vector4::ZERO = Vector4(0.f, 0.f, 0.f, 0.f);
+
+inline const Vector4 Vector4::operator+( const Vector4& vecToAdd ) const
+{
+	Vector4 res;
+	SIMDVec4Add(&x, &vecToAdd.x, &res.x);
+	return res;
+}
+
+inline const Vector4 Vector4::operator-( const Vector4& vecToSubtract ) const
+{
+	Vector4 res;
+	SIMDVec4Sub(&x, &vecToSubtract.x, &res.x);
+	return res;
+}
+
+inline const Vector4 Vector4::operator*( float uniformScale ) const
+{
+	Vector4 res;
+	SIMDVec4Scale(&x, uniformScale, &res.x);
+	return res;
+}
+
+inline const Vector4 Vector4::operator/( float inverseScale ) const
+{
+	return Vector4( x / inverseScale, y / inverseScale, z / inverseScale, w / inverseScale );
+}
+
+inline void Vector4::operator+=( const Vector4& vecToAdd )
+{
+	SIMDVec4Add(&x, &vecToAdd.x, &x);
+}
+
+inline void Vector4::operator-=( const Vector4& vecToSubtract )
+{
+	SIMDVec4Sub(&x, &vecToSubtract.x, &x);
+}
+
+inline void Vector4::operator*=( const float uniformScale )
+{
+	SIMDVec4Scale(&x, uniformScale, &x);
+}
+
+inline void Vector4::operator/=( const float uniformDivisor )
+{
+	x = x / uniformDivisor;
+	y = y / uniformDivisor;
+	z = z / uniformDivisor;
+	w = w / uniformDivisor;
+}
+
+inline void Vector4::operator=( const Vector4& copyFrom )
+{
+	x = copyFrom.x;
+	y = copyFrom.y;
+	z = copyFrom.z;
+	w = copyFrom.w;
+}
\ No newline at end of file
@@ -0,0 +1,259 @@
+#include "Engine/Physics/3D/RF/CollisionBroadphase.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <algorithm>
+
+void sBroadphaseProxy::ComputeBound()
+{
+	switch (m_shape)
+	{
+	case BROADPHASE_SPHERE:
+		m_bound = AABB3(m_center, m_radius, m_radius, m_radius);
+		break;
+	case BROADPHASE_BOX:
+	{
+		// extent of the oriented box along each world axis
+		float ext_x = abs(m_basis.Ix) * m_half_ext.x + abs(m_basis.Jx) * m_half_ext.y + abs(m_basis.Kx) * m_half_ext.z;
+		float ext_y = abs(m_basis.Iy) * m_half_ext.x + abs(m_basis.Jy) * m_half_ext.y + abs(m_basis.Ky) * m_half_ext.z;
+		float ext_z = abs(m_basis.Iz) * m_half_ext.x + abs(m_basis.Jz) * m_half_ext.y + abs(m_basis.Kz) * m_half_ext.z;
+		m_bound = AABB3(m_center, ext_x, ext_y, ext_z);
+	}
+		break;
+	case BROADPHASE_AABB:
+		m_bound = AABB3(m_center, m_half_ext.x, m_half_ext.y, m_half_ext.z);
+		break;
+	default:
+		ASSERT_OR_DIE(false, "unknown broadphase shape");
+		break;
+	}
+}
+
+uint CollisionBroadphase::AllocateProxy()
+{
+	m_dirty = true;
+
+	if (!m_free.empty())
+	{
+		uint id = m_free.back();
+		m_free.pop_back();
+		m_proxies[id] = sBroadphaseProxy();
+		return id;
+	}
+
+	m_proxies.push_back(sBroadphaseProxy());
+	return (uint)(m_proxies.size() - 1);
+}
+
+uint CollisionBroadphase::AddSphere(const Vector3& center, float radius, CollisionRigidBody* body, void* user, uint filter)
+{
+	uint id = AllocateProxy();
+	sBroadphaseProxy& proxy = m_proxies[id];
+
+	proxy.m_shape = BROADPHASE_SPHERE;
+	proxy.m_center = center;
+	proxy.m_radius = radius;
+	proxy.m_half_ext = Vector3(radius);
+	proxy.m_body = body;
+	proxy.m_user = user;
+	proxy.m_filter = filter;
+	proxy.ComputeBound();
+
+	return id;
+}
+
+uint CollisionBroadphase::AddBox(const Vector3& center, const Vector3& half_ext, const Matrix33& basis, CollisionRigidBody* body, void* user, uint filter)
+{
+	uint id = AllocateProxy();
+	sBroadphaseProxy& proxy = m_proxies[id];
+
+	proxy.m_shape = BROADPHASE_BOX;
+	proxy.m_center = center;
+	proxy.m_half_ext = half_ext;
+	proxy.m_radius = half_ext.GetLength();
+	proxy.m_basis = basis;
+	proxy.m_body = body;
+	proxy.m_user = user;
+	proxy.m_filter = filter;
+	proxy.ComputeBound();
+
+	return id;
+}
+
+uint CollisionBroadphase::AddAABB(const AABB3& box, void* user, uint filter)
+{
+	uint id = AllocateProxy();
+	sBroadphaseProxy& proxy = m_proxies[id];
+
+	proxy.m_shape = BROADPHASE_AABB;
+	proxy.m_center = box.GetCenter();
+	proxy.m_half_ext = box.GetHalfExt();
+	proxy.m_radius = proxy.m_half_ext.GetLength();
+	proxy.m_user = user;
+	proxy.m_filter = filter;
+	proxy.ComputeBound();
+
+	return id;
+}
+
+void CollisionBroadphase::RemoveProxy(uint id)
+{
+	ASSERT_OR_DIE(id < m_proxies.size() && m_proxies[id].m_alive, "removing invalid broadphase proxy");
+
+	m_proxies[id].m_alive = false;
+	m_proxies[id].m_body = nullptr;
+	m_proxies[id].m_user = nullptr;
+	m_free.push_back(id);
+
+	m_dirty = true;
+}
+
+void CollisionBroadphase::Clear()
+{
+	m_proxies.clear();
+	m_free.clear();
+	m_order.clear();
+	m_nodes.clear();
+
+	m_dirty = true;
+}
+
+void CollisionBroadphase::MoveProxy(uint id, const Vector3& center)
+{
+	sBroadphaseProxy& proxy = m_proxies[id];
+	proxy.m_center = center;
+	proxy.ComputeBound();
+
+	m_dirty = true;
+}
+
+void CollisionBroadphase::MoveProxy(uint id, const Vector3& center, const Matrix33& basis)
+{
+	sBroadphaseProxy& proxy = m_proxies[id];
+	proxy.m_center = center;
+	proxy.m_basis = basis;
+	proxy.ComputeBound();
+
+	m_dirty = true;
+}
+
+void CollisionBroadphase::SyncBodies()
+{
+	for (std::vector<sBroadphaseProxy>::size_type idx = 0; idx < m_proxies.size(); ++idx)
+	{
+		sBroadphaseProxy& proxy = m_proxies[idx];
+
+		if (!proxy.m_alive || proxy.m_body == nullptr)
+			continue;
+
+		// sleeping bodies do not move
+		if (!proxy.m_body->IsAwake())
+			continue;
+
+		proxy.m_center = proxy.m_body->GetCenter();
+		proxy.m_basis = proxy.m_body->GetTransformMat4().ExtractMat3();
+		proxy.ComputeBound();
+
+		m_dirty = true;
+	}
+}
+
+void CollisionBroadphase::Rebuild()
+{
+	m_order.clear();
+	m_nodes.clear();
+
+	for (std::vector<sBroadphaseProxy>::size_type idx = 0; idx < m_proxies.size(); ++idx)
+	{
+		if (m_proxies[idx].m_alive)
+			m_order.push_back((uint)idx);
+	}
+
+	if (!m_order.empty())
+	{
+		// a binary tree with leaves of up to BROADPHASE_LEAF_SIZE has at most this many nodes
+		m_nodes.reserve(2 * (m_order.size() / BROADPHASE_LEAF_SIZE + 1));
+		BuildRecursive(0, (uint)m_order.size());
+	}
+
+	m_dirty = false;
+}
+
+uint CollisionBroadphase::BuildRecursive(uint first, uint count)
+{
+	uint node_idx = (uint)m_nodes.size();
+	m_nodes.push_back(sBroadphaseNode());
+
+	AABB3 bound = AABB3::MakeEmpty();
+	AABB3 centers = AABB3::MakeEmpty();
+	for (uint i = first; i < first + count; ++i)
+	{
+		const sBroadphaseProxy& proxy = m_proxies[m_order[i]];
+		bound.StretchToIncludeBox(proxy.m_bound);
+		centers.StretchToIncludePoint(proxy.m_center);
+	}
+
+	m_nodes[node_idx].m_bound = bound;
+
+	if (count <= BROADPHASE_LEAF_SIZE)
+	{
+		m_nodes[node_idx].m_offset = first;
+		m_nodes[node_idx].m_count = count;
+		return node_idx;
+	}
+
+	// median split along the widest axis of the proxy centers
+	Vector3 spread = centers.GetDimensions();
+	int axis = 0;
+	if (spread.y > spread.x && spread.y >= spread.z)
+		axis = 1;
+	else if (spread.z > spread.x && spread.z > spread.y)
+		axis = 2;
+
+	uint half = count / 2;
+	const std::vector<sBroadphaseProxy>& proxies = m_proxies;
+	std::nth_element(m_order.begin() + first, m_order.begin() + first + half, m_order.begin() + first + count,
+		[&proxies, axis](uint a, uint b) { return proxies[a].m_center[axis] < proxies[b].m_center[axis]; });
+
+	BuildRecursive(first, half);
+	uint right = BuildRecursive(first + half, count - half);
+
+	m_nodes[node_idx].m_offset = right;
+	m_nodes[node_idx].m_count = 0;
+	return node_idx;
+}
+
+void CollisionBroadphase::QueryOverlap(const AABB3& box, std::vector<uint>& out, uint filter) const
+{
+	ASSERT_RECOVERABLE(!m_dirty, "broadphase queried before Rebuild");
+
+	if (m_nodes.empty())
+		return;
+
+	uint stack[64];
+	uint top = 0;
+	stack[top++] = 0;
+
+	while (top > 0)
+	{
+		const sBroadphaseNode& node = m_nodes[stack[--top]];
+
+		if (!node.m_bound.Overlaps(box))
+			continue;
+
+		if (node.IsLeaf())
+		{
+			for (uint i = node.m_offset; i < node.m_offset + node.m_count; ++i)
+			{
+				const sBroadphaseProxy& proxy = m_proxies[m_order[i]];
+				if ((proxy.m_filter & filter) && proxy.m_bound.Overlaps(box))
+					out.push_back(m_order[i]);
+			}
+		}
+		else
+		{
+			uint node_idx = (uint)(&node - &m_nodes[0]);
+			stack[top++] = node.m_offset;
+			stack[top++] = node_idx + 1;
+		}
+	}
+}
\ No newline at end of file
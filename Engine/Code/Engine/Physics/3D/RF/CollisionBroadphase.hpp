@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Engine/Physics/3D/RF/CollisionEntity.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <vector>
+
+#define BROADPHASE_LEAF_SIZE 4
+#define BROADPHASE_INVALID_PROXY 0xffffffff
+
+enum eBroadphaseShape
+{
+	BROADPHASE_SPHERE,
+	BROADPHASE_BOX,			// oriented box, basis taken from m_basis
+	BROADPHASE_AABB,
+	BROADPHASE_SHAPE_NUM
+};
+
+struct sBroadphaseProxy
+{
+	eBroadphaseShape m_shape;
+
+	Vector3 m_center;
+	Vector3 m_half_ext;
+	float m_radius;
+	Matrix33 m_basis;
+
+	// derived data
+	AABB3 m_bound;
+
+	// optional links back to the owner; body drives the proxy on SyncBodies
+	CollisionRigidBody* m_body = nullptr;
+	void* m_user = nullptr;
+
+	uint m_filter = 0xffffffff;
+	bool m_alive = true;
+
+	void ComputeBound();
+};
+
+// flattened in depth first order: the left child of an internal node always sits right after it
+struct sBroadphaseNode
+{
+	AABB3 m_bound;
+	uint m_offset;		// leaf: first entry in the proxy order; internal: index of right child
+	uint m_count;		// 0 for internal nodes
+
+	bool IsLeaf() const { return m_count != 0; }
+};
+
+class CollisionBroadphase
+{
+	std::vector<sBroadphaseProxy> m_proxies;
+	std::vector<uint> m_free;
+	std::vector<uint> m_order;
+	std::vector<sBroadphaseNode> m_nodes;
+
+	bool m_dirty = true;
+
+public:
+	CollisionBroadphase(){}
+	~CollisionBroadphase(){}
+
+	uint AddSphere(const Vector3& center, float radius, CollisionRigidBody* body = nullptr, void* user = nullptr, uint filter = 0xffffffff);
+	uint AddBox(const Vector3& center, const Vector3& half_ext, const Matrix33& basis, CollisionRigidBody* body = nullptr, void* user = nullptr, uint filter = 0xffffffff);
+	uint AddAABB(const AABB3& box, void* user = nullptr, uint filter = 0xffffffff);
+	void RemoveProxy(uint id);
+	void Clear();
+
+	void MoveProxy(uint id, const Vector3& center);
+	void MoveProxy(uint id, const Vector3& center, const Matrix33& basis);
+	void SyncBodies();
+
+	void Rebuild();
+	bool IsDirty() const { return m_dirty; }
+
+	const sBroadphaseProxy& GetProxy(uint id) const { return m_proxies[id]; }
+	const std::vector<sBroadphaseNode>& GetNodes() const { return m_nodes; }
+	const std::vector<uint>& GetOrder() const { return m_order; }
+	uint GetProxyCount() const { return (uint)(m_proxies.size() - m_free.size()); }
+
+	void QueryOverlap(const AABB3& box, std::vector<uint>& out, uint filter = 0xffffffff) const;
+
+private:
+	uint AllocateProxy();
+	uint BuildRecursive(uint first, uint count);
+};
\ No newline at end of file
@@ -13,6 +13,11 @@ void CollisionEntity::ClearAcc()
 
 }
 
+void CollisionEntity::ScaleAcc(float scale)
+{
+	m_net_force *= scale;
+}
+
 void CollisionEntity::SetSleepable(bool sleepable)
 {
 	m_sleepable = sleepable;
@@ -39,7 +44,7 @@ void CollisionEntity::AddForce(const Vector3& f)
 
 void CollisionRigidBody::Integrate(float deltaTime)
 {
-	if (!m_awake)
+	if (!m_awake || m_frozen)
 		return;
 
 	deltaTime *= m_slow;
@@ -183,6 +188,12 @@ void CollisionRigidBody::ClearAcc()
 	m_net_torque.ToDefault();
 }
 
+void CollisionRigidBody::ScaleAcc(float scale)
+{
+	m_net_force *= scale;
+	m_net_torque *= scale;
+}
+
 CollisionRigidBody::CollisionRigidBody(const float& mass, const Vector3& center, const Vector3& euler)
 {
 	// orientation from euler
@@ -50,6 +50,7 @@ protected:
 public:
 	virtual void Integrate(float deltaTime);
 	virtual void ClearAcc();
+	virtual void ScaleAcc(float scale);
 	virtual ~CollisionEntity() {}
 
 	void SetMass(const float& mass) { m_mass = mass; }
@@ -117,6 +118,7 @@ public:
 	void IntegrateVerletParticle(float dt);
 
 	void ClearAcc() override;
+	void ScaleAcc(float scale) override;
 	CollisionRigidBody(const float& mass, const Vector3& center, const Vector3& euler);
 	~CollisionRigidBody(){}
 
@@ -1,4 +1,18 @@
 #include "Engine/Physics/3D/RF/CollisionKeep.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <algorithm>
+
+static bool IsSamePair(const Collision& a, const Collision& b)
+{
+	return a.m_bodies[0] == b.m_bodies[0] && a.m_bodies[1] == b.m_bodies[1];
+}
+
+// twice the area of triangle abc, signed by its winding about n
+static float SignedTriangleArea(const Vector3& a, const Vector3& b, const Vector3& c, const Vector3& n)
+{
+	return DotProduct((b - a).Cross(c - a), n);
+}
 
 bool CollisionKeep::AllowMoreCollision()
 {
@@ -20,3 +34,176 @@ void CollisionKeep::NotifyAddedCollisions(uint count)
 	m_collision += count;
 }
 
+uint CollisionKeep::ReduceManifolds()
+{
+	if (m_collision_count < 2)
+		return m_collision_count;
+
+	// canonical body order so both orderings of a pair end up in one group,
+	// contacts against the static world are keyed (body, nullptr)
+	for (uint i = 0; i < m_collision_count; ++i)
+	{
+		Collision& col = m_collision_head[i];
+		if (col.m_bodies[0] == nullptr)
+			col.SwapRigidBodies();
+		else if (col.m_bodies[1] && col.m_bodies[0] > col.m_bodies[1])
+			col.SwapRigidBodies();
+	}
+
+	m_manifold_scratch.assign(m_collision_head, m_collision_head + m_collision_count);
+	std::stable_sort(m_manifold_scratch.begin(), m_manifold_scratch.end(),
+		[](const Collision& a, const Collision& b)
+	{
+		if (a.m_bodies[0] != b.m_bodies[0])
+			return a.m_bodies[0] < b.m_bodies[0];
+		return a.m_bodies[1] < b.m_bodies[1];
+	});
+
+	uint written = 0;
+	uint first = 0;
+	uint total = (uint)m_manifold_scratch.size();
+	while (first < total)
+	{
+		uint last = first + 1;
+		while (last < total && IsSamePair(m_manifold_scratch[first], m_manifold_scratch[last]))
+			++last;
+
+		uint kept = ReducePair(&m_manifold_scratch[first], last - first);
+		for (uint i = 0; i < kept; ++i)
+			m_collision_head[written++] = m_manifold_scratch[first + i];
+
+		first = last;
+	}
+
+	// give the dropped slots back to the contact generators
+	uint removed = m_collision_count - written;
+	m_collision_count = written;
+	m_collision_left += removed;
+	m_collision = m_collision_head + written;
+
+	return written;
+}
+
+uint CollisionKeep::ReducePair(Collision* pair, uint count)
+{
+	// drop near duplicates, keeping the deeper one with the averaged normal
+	float tolerance_sqr = m_tolerance * m_tolerance;
+	uint unique = 0;
+	for (uint i = 0; i < count; ++i)
+	{
+		Collision& candidate = pair[i];
+		bool merged = false;
+
+		for (uint j = 0; j < unique; ++j)
+		{
+			Collision& kept = pair[j];
+			if ((kept.m_pos - candidate.m_pos).GetLengthSquared() > tolerance_sqr)
+				continue;
+			if (DotProduct(kept.m_normal, candidate.m_normal) < MANIFOLD_NORMAL_COS)
+				continue;
+
+			Vector3 normal = (kept.m_normal + candidate.m_normal).GetNormalized();
+			if (candidate.m_penetration > kept.m_penetration)
+				kept = candidate;
+			kept.m_normal = normal;
+			merged = true;
+			break;
+		}
+
+		if (!merged)
+			pair[unique++] = candidate;
+	}
+
+	if (unique > MANIFOLD_MAX_POINTS)
+	{
+		// 1. deepest point
+		uint pick[MANIFOLD_MAX_POINTS];
+		pick[0] = 0;
+		for (uint i = 1; i < unique; ++i)
+		{
+			if (pair[i].m_penetration > pair[pick[0]].m_penetration)
+				pick[0] = i;
+		}
+
+		Vector3 n = pair[pick[0]].m_normal;
+		const Vector3& p0 = pair[pick[0]].m_pos;
+
+		// 2. farthest from the deepest
+		pick[1] = pick[0];
+		float best = -1.f;
+		for (uint i = 0; i < unique; ++i)
+		{
+			float dist_sqr = (pair[i].m_pos - p0).GetLengthSquared();
+			if (dist_sqr > best)
+			{
+				best = dist_sqr;
+				pick[1] = i;
+			}
+		}
+		const Vector3& p1 = pair[pick[1]].m_pos;
+
+		// 3. largest triangle with the first two
+		pick[2] = pick[0];
+		best = -1.f;
+		for (uint i = 0; i < unique; ++i)
+		{
+			float area = abs(SignedTriangleArea(p0, p1, pair[i].m_pos, n));
+			if (area > best)
+			{
+				best = area;
+				pick[2] = i;
+			}
+		}
+		const Vector3& p2 = pair[pick[2]].m_pos;
+
+		// 4. the point that adds the most area outside the triangle
+		float winding = (SignedTriangleArea(p0, p1, p2, n) < 0.f) ? -1.f : 1.f;
+		pick[3] = pick[0];
+		best = 0.f;
+		for (uint i = 0; i < unique; ++i)
+		{
+			const Vector3& q = pair[i].m_pos;
+			float outside = fminf(SignedTriangleArea(p0, p1, q, n) * winding,
+				fminf(SignedTriangleArea(p1, p2, q, n) * winding, SignedTriangleArea(p2, p0, q, n) * winding));
+			if (outside < best)
+			{
+				best = outside;
+				pick[3] = i;
+			}
+		}
+
+		// degenerate manifolds (colinear points) can pick the same point twice
+		Collision reduced[MANIFOLD_MAX_POINTS];
+		uint reduced_count = 0;
+		for (uint k = 0; k < MANIFOLD_MAX_POINTS; ++k)
+		{
+			bool taken = false;
+			for (uint m = 0; m < k; ++m)
+				taken = taken || (pick[m] == pick[k]);
+			if (!taken)
+				reduced[reduced_count++] = pair[pick[k]];
+		}
+
+		for (uint k = 0; k < reduced_count; ++k)
+			pair[k] = reduced[k];
+		unique = reduced_count;
+	}
+
+	// a manifold whose normals agree shares one normal, which keeps the solver from fighting itself
+	Vector3 sum = Vector3::ZERO;
+	for (uint i = 0; i < unique; ++i)
+		sum += pair[i].m_normal * fmaxf(pair[i].m_penetration, 0.f) + pair[i].m_normal * 1e-4f;
+	Vector3 merged = sum.GetNormalized();
+
+	bool coherent = true;
+	for (uint i = 0; i < unique; ++i)
+		coherent = coherent && (DotProduct(merged, pair[i].m_normal) >= MANIFOLD_NORMAL_COS);
+
+	if (coherent)
+	{
+		for (uint i = 0; i < unique; ++i)
+			pair[i].m_normal = merged;
+	}
+
+	return unique;
+}
\ No newline at end of file
@@ -3,6 +3,11 @@
 #include "Engine/Physics/3D/RF/TheCollision.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 
+#include <vector>
+
+#define MANIFOLD_MAX_POINTS 4
+#define MANIFOLD_NORMAL_COS 0.95f		// normals closer than ~18 degrees are merged
+
 class CollisionKeep
 {
 public:
@@ -16,11 +21,20 @@ public:
 
 	float m_global_friction = .5f;
 	float m_global_restitution = .6f;
-	float m_tolerance;
+	float m_tolerance = .01f;
 
 	bool AllowMoreCollision();
 
 	void Reset(uint contacts);
 
 	void NotifyAddedCollisions(uint count);
+
+	// keeps at most MANIFOLD_MAX_POINTS per body pair, returns the new collision count;
+	// CollisionSolver::SolveCollision(CollisionKeep*, ...) runs it once generation is done
+	uint ReduceManifolds();
+
+private:
+	std::vector<Collision> m_manifold_scratch;
+
+	uint ReducePair(Collision* pair, uint count);
 };
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include "Engine/Physics/3D/RF/CollisionLOD.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <float.h>
+
+uint CollisionLOD::Register(CollisionRigidBody* body)
+{
+	uint idx = FindEntry(body);
+	if (idx != SIM_LOD_INVALID)
+		return idx;
+
+	sSimLODEntry entry;
+	entry.m_body = body;
+	entry.m_tier = SIM_TIER_FULL;
+	entry.m_pending_dt = 0.f;
+	entry.m_pending_steps = 0;
+	entry.m_phase = (uint)m_entries.size();
+	m_entries.push_back(entry);
+
+	return (uint)m_entries.size() - 1;
+}
+
+void CollisionLOD::Unregister(CollisionRigidBody* body)
+{
+	uint idx = FindEntry(body);
+	if (idx == SIM_LOD_INVALID)
+		return;
+
+	// hand the body back unfrozen with nothing owed
+	SetTier(m_entries[idx], SIM_TIER_FULL);
+
+	m_entries[idx] = m_entries.back();
+	m_entries.pop_back();
+}
+
+void CollisionLOD::SetTierDistances(float full, float half, float quarter)
+{
+	ASSERT_RECOVERABLE(full <= half && half <= quarter, "tier distances should be increasing");
+
+	m_tier_dist[SIM_TIER_FULL] = full;
+	m_tier_dist[SIM_TIER_HALF] = half;
+	m_tier_dist[SIM_TIER_QUARTER] = quarter;
+}
+
+void CollisionLOD::UpdateTiers()
+{
+	// no one to look at anything, keep everything at full rate
+	if (m_focus.empty())
+	{
+		for (std::vector<sSimLODEntry>::size_type idx = 0; idx < m_entries.size(); ++idx)
+			SetTier(m_entries[idx], SIM_TIER_FULL);
+		return;
+	}
+
+	for (std::vector<sSimLODEntry>::size_type idx = 0; idx < m_entries.size(); ++idx)
+	{
+		sSimLODEntry& entry = m_entries[idx];
+		Vector3 center = entry.m_body->GetCenter();
+
+		float dist_sqr = FLT_MAX;
+		for (std::vector<Vector3>::size_type f = 0; f < m_focus.size(); ++f)
+			dist_sqr = fminf(dist_sqr, (m_focus[f] - center).GetLengthSquared());
+
+		// coarsen only past the far edge of the band and refine only inside the near edge,
+		// so a body sitting on a boundary does not flip every step
+		eSimTier coarse = ComputeTier(dist_sqr, 1.f + m_hysteresis);
+		eSimTier fine = ComputeTier(dist_sqr, 1.f - m_hysteresis);
+
+		if (coarse > entry.m_tier)
+			SetTier(entry, coarse);
+		else if (fine < entry.m_tier)
+			SetTier(entry, fine);
+	}
+}
+
+void CollisionLOD::Integrate(float deltaTime)
+{
+	for (std::vector<sSimLODEntry>::size_type idx = 0; idx < m_entries.size(); ++idx)
+	{
+		sSimLODEntry& entry = m_entries[idx];
+		CollisionRigidBody* body = entry.m_body;
+
+		// forces applied to a frozen body are dropped rather than piling up until it thaws
+		if (entry.m_tier == SIM_TIER_FROZEN)
+		{
+			body->ClearAcc();
+			continue;
+		}
+
+		// a sleeping body owes nothing, it would otherwise wake with a huge step
+		if (!body->IsAwake())
+		{
+			entry.m_pending_dt = 0.f;
+			entry.m_pending_steps = 0;
+			continue;
+		}
+
+		entry.m_pending_dt += deltaTime;
+		entry.m_pending_steps++;
+
+		uint period = GetTierPeriod(entry.m_tier);
+		if ((m_step + entry.m_phase) % period != 0 && entry.m_pending_steps < period)
+			continue;
+
+		// forces are added every step, average them over the aggregated step
+		if (entry.m_pending_steps > 1)
+			body->ScaleAcc(1.f / (float)entry.m_pending_steps);
+
+		body->Integrate(entry.m_pending_dt);
+		entry.m_pending_dt = 0.f;
+		entry.m_pending_steps = 0;
+	}
+
+	m_step++;
+}
+
+eSimTier CollisionLOD::GetTier(const CollisionRigidBody* body) const
+{
+	uint idx = FindEntry(body);
+	if (idx == SIM_LOD_INVALID)
+		return SIM_TIER_FULL;
+
+	return m_entries[idx].m_tier;
+}
+
+uint CollisionLOD::GetTierCount(eSimTier tier) const
+{
+	uint count = 0;
+	for (std::vector<sSimLODEntry>::size_type idx = 0; idx < m_entries.size(); ++idx)
+	{
+		if (m_entries[idx].m_tier == tier)
+			count++;
+	}
+	return count;
+}
+
+uint CollisionLOD::GetTierPeriod(eSimTier tier)
+{
+	switch (tier)
+	{
+	case SIM_TIER_HALF:
+		return 2;
+	case SIM_TIER_QUARTER:
+		return 4;
+	default:
+		return 1;
+	}
+}
+
+uint CollisionLOD::FindEntry(const CollisionRigidBody* body) const
+{
+	for (std::vector<sSimLODEntry>::size_type idx = 0; idx < m_entries.size(); ++idx)
+	{
+		if (m_entries[idx].m_body == body)
+			return (uint)idx;
+	}
+	return SIM_LOD_INVALID;
+}
+
+eSimTier CollisionLOD::ComputeTier(float dist_sqr, float scale) const
+{
+	for (int tier = SIM_TIER_FULL; tier < SIM_TIER_FROZEN; ++tier)
+	{
+		float dist = m_tier_dist[tier] * scale;
+		if (dist_sqr <= dist * dist)
+			return (eSimTier)tier;
+	}
+	return SIM_TIER_FROZEN;
+}
+
+void CollisionLOD::SetTier(sSimLODEntry& entry, eSimTier tier)
+{
+	if (entry.m_tier == tier)
+		return;
+
+	CollisionRigidBody* body = entry.m_body;
+
+	if (tier == SIM_TIER_FROZEN)
+	{
+		// settle what is owed before freezing, frozen bodies do not catch up later
+		if (entry.m_pending_steps > 0 && body->IsAwake())
+		{
+			if (entry.m_pending_steps > 1)
+				body->ScaleAcc(1.f / (float)entry.m_pending_steps);
+			body->Integrate(entry.m_pending_dt);
+		}
+		body->ClearAcc();
+		body->SetFrozen(true);
+		entry.m_pending_dt = 0.f;
+		entry.m_pending_steps = 0;
+	}
+	else if (entry.m_tier == SIM_TIER_FROZEN)
+		body->SetFrozen(false);
+
+	// pending dt carries over, a finer tier just steps it sooner (the pending step count forces it)
+	entry.m_tier = tier;
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Engine/Physics/3D/RF/CollisionEntity.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <vector>
+
+#define SIM_LOD_HYSTERESIS .1f			// fraction of a tier distance a body has to cross before switching
+#define SIM_LOD_INVALID 0xffffffff
+
+enum eSimTier
+{
+	SIM_TIER_FULL,			// every step
+	SIM_TIER_HALF,			// every 2nd step
+	SIM_TIER_QUARTER,		// every 4th step
+	SIM_TIER_FROZEN,		// kinematic, not integrated
+	SIM_TIER_NUM
+};
+
+struct sSimLODEntry
+{
+	CollisionRigidBody* m_body;
+	eSimTier m_tier;
+	float m_pending_dt;		// time since the body was last integrated
+	uint m_pending_steps;
+	uint m_phase;			// staggers bodies of a tier over the steps
+};
+
+/*
+ * Simulation level of detail. Bodies are put in update tiers by distance to the nearest
+ * focus point; coarser tiers are integrated less often with the dt of all the steps they skipped.
+ * Call UpdateTiers whenever focus points move, then Integrate once per step in place of
+ * integrating the bodies directly.
+ */
+class CollisionLOD
+{
+	std::vector<sSimLODEntry> m_entries;
+	std::vector<Vector3> m_focus;
+
+	// distance beyond which a body drops out of the tier
+	float m_tier_dist[SIM_TIER_FROZEN] = { 20.f, 50.f, 100.f };
+
+	float m_hysteresis = SIM_LOD_HYSTERESIS;
+
+	uint m_step = 0;
+
+public:
+	uint Register(CollisionRigidBody* body);
+	void Unregister(CollisionRigidBody* body);
+
+	void AddFocusPoint(const Vector3& pt) { m_focus.push_back(pt); }
+	void SetFocusPoint(uint idx, const Vector3& pt) { m_focus[idx] = pt; }
+	void ClearFocusPoints() { m_focus.clear(); }
+
+	void SetTierDistances(float full, float half, float quarter);
+	void SetHysteresis(float hysteresis) { m_hysteresis = hysteresis; }
+
+	void UpdateTiers();
+	void Integrate(float deltaTime);
+
+	eSimTier GetTier(const CollisionRigidBody* body) const;
+	uint GetTierCount(eSimTier tier) const;
+
+	static uint GetTierPeriod(eSimTier tier);
+
+private:
+	uint FindEntry(const CollisionRigidBody* body) const;
+	eSimTier ComputeTier(float dist_sqr, float scale) const;
+	void SetTier(sSimLODEntry& entry, eSimTier tier);
+};
\ No newline at end of file
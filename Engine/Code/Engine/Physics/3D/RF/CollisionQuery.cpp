@@ -0,0 +1,494 @@
+#include "Engine/Physics/3D/RF/CollisionQuery.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#else
+#include <xmmintrin.h>
+#endif
+
+#define QUERY_STACK_SIZE 64
+#define QUERY_PARALLEL_EPSILON 1e-8f
+
+static float SafeInverse(float v)
+{
+	// keeps the slab test free of inf * 0 when a ray starts exactly on a slab plane
+	if (abs(v) < QUERY_PARALLEL_EPSILON)
+		return (v < 0.f) ? -1e30f : 1e30f;
+	return 1.f / v;
+}
+
+static Vector3 ComputeInvDir(const Vector3& dir)
+{
+	return Vector3(SafeInverse(dir.x), SafeInverse(dir.y), SafeInverse(dir.z));
+}
+
+// ray against a box centered at origin, reports entry distance and entry face normal
+static bool RayVsCenteredBox(const Vector3& start, const Vector3& dir, const Vector3& half_ext, float max_dist, float& dist, Vector3& normal)
+{
+	float t_near = -INFINITY;
+	float t_far = INFINITY;
+	int near_axis = -1;
+	float near_sign = 0.f;
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		float s = start[axis];
+		float d = dir[axis];
+		float e = half_ext[axis];
+
+		if (abs(d) < QUERY_PARALLEL_EPSILON)
+		{
+			if (s < -e || s > e)
+				return false;
+			continue;
+		}
+
+		float inv = 1.f / d;
+		float t1 = (-e - s) * inv;
+		float t2 = (e - s) * inv;
+		float sign = -1.f;
+		if (t1 > t2)
+		{
+			SwapFloat(t1, t2);
+			sign = 1.f;
+		}
+
+		if (t1 > t_near)
+		{
+			t_near = t1;
+			near_axis = axis;
+			near_sign = sign;
+		}
+		t_far = fminf(t_far, t2);
+
+		if (t_near > t_far || t_far < 0.f)
+			return false;
+	}
+
+	if (t_near > max_dist)
+		return false;
+
+	if (t_near < 0.f || near_axis < 0)
+	{
+		// started inside
+		dist = 0.f;
+		normal = -dir;
+		return true;
+	}
+
+	dist = t_near;
+	normal = Vector3(near_axis == 0 ? near_sign : 0.f, near_axis == 1 ? near_sign : 0.f, near_axis == 2 ? near_sign : 0.f);
+	return true;
+}
+
+static bool RayVsSphere(const Vector3& start, const Vector3& dir, const Vector3& center, float radius, float max_dist, float& dist, Vector3& normal)
+{
+	Vector3 m = start - center;
+	float b = DotProduct(m, dir);
+	float c = DotProduct(m, m) - radius * radius;
+
+	// outside and pointing away
+	if (c > 0.f && b > 0.f)
+		return false;
+
+	float disc = b * b - c;
+	if (disc < 0.f)
+		return false;
+
+	float t = -b - sqrtf(disc);
+	if (t > max_dist)
+		return false;
+
+	if (t < 0.f)
+	{
+		dist = 0.f;
+		normal = -dir;
+		return true;
+	}
+
+	dist = t;
+	normal = (m + dir * t) / radius;
+	return true;
+}
+
+bool CollisionQuery::Raycast(const sQueryRay& ray, eQueryMode mode, std::vector<sQueryHit>& hits, uint filter) const
+{
+	return Sweep(ray, Vector3::ZERO, 0.f, mode, hits, filter);
+}
+
+bool CollisionQuery::SphereCast(const sQueryRay& ray, float radius, eQueryMode mode, std::vector<sQueryHit>& hits, uint filter) const
+{
+	return Sweep(ray, Vector3::ZERO, radius, mode, hits, filter);
+}
+
+bool CollisionQuery::BoxCast(const sQueryRay& ray, const Vector3& half_ext, eQueryMode mode, std::vector<sQueryHit>& hits, uint filter) const
+{
+	return Sweep(ray, half_ext, 0.f, mode, hits, filter);
+}
+
+bool CollisionQuery::SweepProxy(const sBroadphaseProxy& proxy, const sQueryRay& ray, float max_dist,
+	const Vector3& box_ext, float radius, float& dist, Vector3& normal) const
+{
+	bool cast_box = (box_ext.x > 0.f || box_ext.y > 0.f || box_ext.z > 0.f);
+
+	switch (proxy.m_shape)
+	{
+	case BROADPHASE_SPHERE:
+	{
+		if (!cast_box)
+			return RayVsSphere(ray.m_start, ray.m_dir, proxy.m_center, proxy.m_radius + radius, max_dist, dist, normal);
+
+		Vector3 ext = box_ext + Vector3(proxy.m_radius);
+		return RayVsCenteredBox(ray.m_start - proxy.m_center, ray.m_dir, ext, max_dist, dist, normal);
+	}
+	case BROADPHASE_AABB:
+	{
+		Vector3 ext = proxy.m_half_ext + box_ext + Vector3(radius);
+		return RayVsCenteredBox(ray.m_start - proxy.m_center, ray.m_dir, ext, max_dist, dist, normal);
+	}
+	case BROADPHASE_BOX:
+	{
+		const Matrix33& basis = proxy.m_basis;
+		Vector3 local_start = basis.MultiplyTranspose(ray.m_start - proxy.m_center);
+		Vector3 local_dir = basis.MultiplyTranspose(ray.m_dir);
+
+		// world aligned cast box projected onto the proxy axes
+		Vector3 local_box_ext = Vector3(
+			abs(basis.Ix) * box_ext.x + abs(basis.Iy) * box_ext.y + abs(basis.Iz) * box_ext.z,
+			abs(basis.Jx) * box_ext.x + abs(basis.Jy) * box_ext.y + abs(basis.Jz) * box_ext.z,
+			abs(basis.Kx) * box_ext.x + abs(basis.Ky) * box_ext.y + abs(basis.Kz) * box_ext.z);
+		Vector3 ext = proxy.m_half_ext + local_box_ext + Vector3(radius);
+
+		Vector3 local_normal;
+		if (!RayVsCenteredBox(local_start, local_dir, ext, max_dist, dist, local_normal))
+			return false;
+
+		normal = basis * local_normal;
+		return true;
+	}
+	default:
+		ASSERT_RECOVERABLE(false, "query against unknown broadphase shape");
+		return false;
+	}
+}
+
+bool CollisionQuery::Sweep(const sQueryRay& ray, const Vector3& box_ext, float radius, eQueryMode mode, std::vector<sQueryHit>& hits, uint filter) const
+{
+	ASSERT_RECOVERABLE(!m_broadphase->IsDirty(), "broadphase queried before Rebuild");
+
+	const std::vector<sBroadphaseNode>& nodes = m_broadphase->GetNodes();
+	const std::vector<uint>& order = m_broadphase->GetOrder();
+	if (nodes.empty())
+		return false;
+
+	Vector3 inv_dir = ComputeInvDir(ray.m_dir);
+	Vector3 pad = box_ext + Vector3(radius);
+
+	float max_dist = ray.m_max_dist;
+	size_t first_hit = hits.size();
+	sQueryHit closest;
+
+	uint stack[QUERY_STACK_SIZE];
+	uint top = 0;
+	stack[top++] = 0;
+
+	while (top > 0)
+	{
+		uint node_idx = stack[--top];
+		const sBroadphaseNode& node = nodes[node_idx];
+
+		AABB3 bound = node.m_bound;
+		bound.AddPadding(pad);
+
+		float t_node;
+		if (!bound.RaycastSlab(ray.m_start, inv_dir, max_dist, t_node))
+			continue;
+
+		if (!node.IsLeaf())
+		{
+			uint left = node_idx + 1;
+			uint right = node.m_offset;
+
+			// visit the nearer child first so closest queries shrink max_dist early
+			AABB3 left_bound = nodes[left].m_bound;
+			AABB3 right_bound = nodes[right].m_bound;
+			float left_dist = DotProduct(left_bound.GetCenter() - ray.m_start, ray.m_dir);
+			float right_dist = DotProduct(right_bound.GetCenter() - ray.m_start, ray.m_dir);
+
+			if (left_dist < right_dist)
+			{
+				stack[top++] = right;
+				stack[top++] = left;
+			}
+			else
+			{
+				stack[top++] = left;
+				stack[top++] = right;
+			}
+			continue;
+		}
+
+		for (uint i = node.m_offset; i < node.m_offset + node.m_count; ++i)
+		{
+			uint proxy_id = order[i];
+			const sBroadphaseProxy& proxy = m_broadphase->GetProxy(proxy_id);
+			if (!(proxy.m_filter & filter))
+				continue;
+
+			float dist;
+			Vector3 normal;
+			if (!SweepProxy(proxy, ray, max_dist, box_ext, radius, dist, normal))
+				continue;
+
+			sQueryHit hit;
+			hit.m_proxy = proxy_id;
+			hit.m_dist = dist;
+			hit.m_pos = ray.m_start + ray.m_dir * dist;
+			hit.m_normal = normal;
+
+			if (mode == QUERY_ANY)
+			{
+				hits.push_back(hit);
+				return true;
+			}
+			else if (mode == QUERY_CLOSEST)
+			{
+				closest = hit;
+				max_dist = dist;
+			}
+			else
+				hits.push_back(hit);
+		}
+	}
+
+	if (mode == QUERY_CLOSEST)
+	{
+		if (!closest.IsValid())
+			return false;
+
+		hits.push_back(closest);
+		return true;
+	}
+
+	std::sort(hits.begin() + first_hit, hits.end(),
+		[](const sQueryHit& a, const sQueryHit& b) { return a.m_dist < b.m_dist; });
+	return hits.size() > first_hit;
+}
+
+uint CollisionQuery::SweepLeafPacket(const sBroadphaseNode& leaf, const sQueryRay* rays, uint lanes, eQueryMode mode,
+	float* max_dist, sQueryHit* out_hits, uint filter) const
+{
+	const std::vector<uint>& order = m_broadphase->GetOrder();
+	uint finished = 0;
+
+	for (uint i = leaf.m_offset; i < leaf.m_offset + leaf.m_count; ++i)
+	{
+		uint proxy_id = order[i];
+		const sBroadphaseProxy& proxy = m_broadphase->GetProxy(proxy_id);
+		if (!(proxy.m_filter & filter))
+			continue;
+
+		for (uint lane = 0; lane < 8; ++lane)
+		{
+			uint bit = 1u << lane;
+			if (!(lanes & bit) || (finished & bit))
+				continue;
+
+			float dist;
+			Vector3 normal;
+			if (!SweepProxy(proxy, rays[lane], max_dist[lane], Vector3::ZERO, 0.f, dist, normal))
+				continue;
+
+			out_hits[lane].m_proxy = proxy_id;
+			out_hits[lane].m_dist = dist;
+			out_hits[lane].m_pos = rays[lane].m_start + rays[lane].m_dir * dist;
+			out_hits[lane].m_normal = normal;
+			max_dist[lane] = dist;
+
+			if (mode == QUERY_ANY)
+				finished |= bit;
+		}
+	}
+
+	return finished;
+}
+
+void CollisionQuery::RaycastPacket4(const sQueryRay* rays, eQueryMode mode, sQueryHit* out_hits, uint filter) const
+{
+	ASSERT_RECOVERABLE(mode != QUERY_ALL, "ray packets only support closest or any hit");
+	ASSERT_RECOVERABLE(!m_broadphase->IsDirty(), "broadphase queried before Rebuild");
+
+	for (int lane = 0; lane < 4; ++lane)
+		out_hits[lane] = sQueryHit();
+
+	const std::vector<sBroadphaseNode>& nodes = m_broadphase->GetNodes();
+	if (nodes.empty())
+		return;
+
+	// SoA packet
+	Vector3 inv[4];
+	for (int lane = 0; lane < 4; ++lane)
+		inv[lane] = ComputeInvDir(rays[lane].m_dir);
+
+	__m128 ox = _mm_setr_ps(rays[0].m_start.x, rays[1].m_start.x, rays[2].m_start.x, rays[3].m_start.x);
+	__m128 oy = _mm_setr_ps(rays[0].m_start.y, rays[1].m_start.y, rays[2].m_start.y, rays[3].m_start.y);
+	__m128 oz = _mm_setr_ps(rays[0].m_start.z, rays[1].m_start.z, rays[2].m_start.z, rays[3].m_start.z);
+	__m128 ix = _mm_setr_ps(inv[0].x, inv[1].x, inv[2].x, inv[3].x);
+	__m128 iy = _mm_setr_ps(inv[0].y, inv[1].y, inv[2].y, inv[3].y);
+	__m128 iz = _mm_setr_ps(inv[0].z, inv[1].z, inv[2].z, inv[3].z);
+	__m128 zero = _mm_setzero_ps();
+
+	float max_dist[8];
+	for (int lane = 0; lane < 4; ++lane)
+		max_dist[lane] = rays[lane].m_max_dist;
+	__m128 t_max = _mm_loadu_ps(max_dist);
+
+	uint active = 0xf;
+
+	uint stack[QUERY_STACK_SIZE];
+	uint top = 0;
+	stack[top++] = 0;
+
+	while (top > 0 && active != 0)
+	{
+		uint node_idx = stack[--top];
+		const sBroadphaseNode& node = nodes[node_idx];
+		const AABB3& bound = node.m_bound;
+
+		__m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bound.m_min.x), ox), ix);
+		__m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bound.m_max.x), ox), ix);
+		__m128 t_near = _mm_min_ps(t1, t2);
+		__m128 t_far = _mm_max_ps(t1, t2);
+
+		t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bound.m_min.y), oy), iy);
+		t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bound.m_max.y), oy), iy);
+		t_near = _mm_max_ps(t_near, _mm_min_ps(t1, t2));
+		t_far = _mm_min_ps(t_far, _mm_max_ps(t1, t2));
+
+		t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bound.m_min.z), oz), iz);
+		t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bound.m_max.z), oz), iz);
+		t_near = _mm_max_ps(_mm_max_ps(t_near, _mm_min_ps(t1, t2)), zero);
+		t_far = _mm_min_ps(_mm_min_ps(t_far, _mm_max_ps(t1, t2)), t_max);
+
+		uint lanes = (uint)_mm_movemask_ps(_mm_cmple_ps(t_near, t_far)) & active;
+		if (lanes == 0)
+			continue;
+
+		if (!node.IsLeaf())
+		{
+			stack[top++] = node.m_offset;
+			stack[top++] = node_idx + 1;
+			continue;
+		}
+
+		active &= ~SweepLeafPacket(node, rays, lanes, mode, max_dist, out_hits, filter);
+		t_max = _mm_loadu_ps(max_dist);
+	}
+}
+
+void CollisionQuery::RaycastPacket8(const sQueryRay* rays, eQueryMode mode, sQueryHit* out_hits, uint filter) const
+{
+#if defined(__AVX__)
+	ASSERT_RECOVERABLE(mode != QUERY_ALL, "ray packets only support closest or any hit");
+	ASSERT_RECOVERABLE(!m_broadphase->IsDirty(), "broadphase queried before Rebuild");
+
+	for (int lane = 0; lane < 8; ++lane)
+		out_hits[lane] = sQueryHit();
+
+	const std::vector<sBroadphaseNode>& nodes = m_broadphase->GetNodes();
+	if (nodes.empty())
+		return;
+
+	float ox_arr[8], oy_arr[8], oz_arr[8], ix_arr[8], iy_arr[8], iz_arr[8];
+	float max_dist[8];
+	for (int lane = 0; lane < 8; ++lane)
+	{
+		Vector3 inv = ComputeInvDir(rays[lane].m_dir);
+		ox_arr[lane] = rays[lane].m_start.x;
+		oy_arr[lane] = rays[lane].m_start.y;
+		oz_arr[lane] = rays[lane].m_start.z;
+		ix_arr[lane] = inv.x;
+		iy_arr[lane] = inv.y;
+		iz_arr[lane] = inv.z;
+		max_dist[lane] = rays[lane].m_max_dist;
+	}
+
+	__m256 ox = _mm256_loadu_ps(ox_arr);
+	__m256 oy = _mm256_loadu_ps(oy_arr);
+	__m256 oz = _mm256_loadu_ps(oz_arr);
+	__m256 ix = _mm256_loadu_ps(ix_arr);
+	__m256 iy = _mm256_loadu_ps(iy_arr);
+	__m256 iz = _mm256_loadu_ps(iz_arr);
+	__m256 zero = _mm256_setzero_ps();
+	__m256 t_max = _mm256_loadu_ps(max_dist);
+
+	uint active = 0xff;
+
+	uint stack[QUERY_STACK_SIZE];
+	uint top = 0;
+	stack[top++] = 0;
+
+	while (top > 0 && active != 0)
+	{
+		uint node_idx = stack[--top];
+		const sBroadphaseNode& node = nodes[node_idx];
+		const AABB3& bound = node.m_bound;
+
+		__m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(bound.m_min.x), ox), ix);
+		__m256 t2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(bound.m_max.x), ox), ix);
+		__m256 t_near = _mm256_min_ps(t1, t2);
+		__m256 t_far = _mm256_max_ps(t1, t2);
+
+		t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(bound.m_min.y), oy), iy);
+		t2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(bound.m_max.y), oy), iy);
+		t_near = _mm256_max_ps(t_near, _mm256_min_ps(t1, t2));
+		t_far = _mm256_min_ps(t_far, _mm256_max_ps(t1, t2));
+
+		t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(bound.m_min.z), oz), iz);
+		t2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(bound.m_max.z), oz), iz);
+		t_near = _mm256_max_ps(_mm256_max_ps(t_near, _mm256_min_ps(t1, t2)), zero);
+		t_far = _mm256_min_ps(_mm256_min_ps(t_far, _mm256_max_ps(t1, t2)), t_max);
+
+		uint lanes = (uint)_mm256_movemask_ps(_mm256_cmp_ps(t_near, t_far, _CMP_LE_OQ)) & active;
+		if (lanes == 0)
+			continue;
+
+		if (!node.IsLeaf())
+		{
+			stack[top++] = node.m_offset;
+			stack[top++] = node_idx + 1;
+			continue;
+		}
+
+		active &= ~SweepLeafPacket(node, rays, lanes, mode, max_dist, out_hits, filter);
+		t_max = _mm256_loadu_ps(max_dist);
+	}
+#else
+	// no AVX in this build, two SSE packets do the same work
+	RaycastPacket4(rays, mode, out_hits, filter);
+	RaycastPacket4(rays + 4, mode, out_hits + 4, filter);
+#endif
+}
+
+void CollisionQuery::RaycastBatch(const sQueryRay* rays, uint count, eQueryMode mode, sQueryHit* out_hits, uint filter) const
+{
+	uint idx = 0;
+
+	for (; idx + 8 <= count; idx += 8)
+		RaycastPacket8(rays + idx, mode, out_hits + idx, filter);
+
+	for (; idx + 4 <= count; idx += 4)
+		RaycastPacket4(rays + idx, mode, out_hits + idx, filter);
+
+	std::vector<sQueryHit> hits;
+	for (; idx < count; ++idx)
+	{
+		hits.clear();
+		out_hits[idx] = sQueryHit();
+		if (Raycast(rays[idx], mode, hits, filter))
+			out_hits[idx] = hits[0];
+	}
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Engine/Physics/3D/RF/CollisionBroadphase.hpp"
+
+#include <vector>
+
+enum eQueryMode
+{
+	QUERY_CLOSEST,		// single nearest hit
+	QUERY_ANY,			// first hit found, no ordering; cheapest, good for line of sight
+	QUERY_ALL,			// every hit sorted by distance
+	QUERY_MODE_NUM
+};
+
+struct sQueryRay
+{
+	Vector3 m_start;
+	Vector3 m_dir;			// expected normalized
+	float m_max_dist;
+
+	sQueryRay(){}
+	sQueryRay(const Vector3& start, const Vector3& dir, float max_dist)
+		: m_start(start), m_dir(dir), m_max_dist(max_dist){}
+};
+
+struct sQueryHit
+{
+	uint m_proxy = BROADPHASE_INVALID_PROXY;
+	float m_dist = 0.f;
+	Vector3 m_pos;
+	Vector3 m_normal;
+
+	bool IsValid() const { return m_proxy != BROADPHASE_INVALID_PROXY; }
+};
+
+/*
+ * Scene queries against a rebuilt CollisionBroadphase.
+ * Rays and sphere casts are exact against sphere proxies; sphere casts against boxes
+ * and box casts against anything test the Minkowski-inflated box, so they can report
+ * a hit slightly early near edges and corners.
+ */
+class CollisionQuery
+{
+	const CollisionBroadphase* m_broadphase;
+
+public:
+	explicit CollisionQuery(const CollisionBroadphase* broadphase) : m_broadphase(broadphase){}
+	~CollisionQuery(){}
+
+	bool Raycast(const sQueryRay& ray, eQueryMode mode, std::vector<sQueryHit>& hits, uint filter = 0xffffffff) const;
+	bool SphereCast(const sQueryRay& ray, float radius, eQueryMode mode, std::vector<sQueryHit>& hits, uint filter = 0xffffffff) const;
+	bool BoxCast(const sQueryRay& ray, const Vector3& half_ext, eQueryMode mode, std::vector<sQueryHit>& hits, uint filter = 0xffffffff) const;
+
+	// packet traversal for coherent rays, QUERY_CLOSEST or QUERY_ANY only
+	// out_hits holds one entry per ray, left invalid on a miss
+	void RaycastPacket4(const sQueryRay* rays, eQueryMode mode, sQueryHit* out_hits, uint filter = 0xffffffff) const;
+	void RaycastPacket8(const sQueryRay* rays, eQueryMode mode, sQueryHit* out_hits, uint filter = 0xffffffff) const;
+	void RaycastBatch(const sQueryRay* rays, uint count, eQueryMode mode, sQueryHit* out_hits, uint filter = 0xffffffff) const;
+
+private:
+	bool Sweep(const sQueryRay& ray, const Vector3& box_ext, float radius, eQueryMode mode, std::vector<sQueryHit>& hits, uint filter) const;
+	bool SweepProxy(const sBroadphaseProxy& proxy, const sQueryRay& ray, float max_dist,
+		const Vector3& box_ext, float radius, float& dist, Vector3& normal) const;
+	uint SweepLeafPacket(const sBroadphaseNode& leaf, const sQueryRay* rays, uint lanes, eQueryMode mode,
+		float* max_dist, sQueryHit* out_hits, uint filter) const;
+};
\ No newline at end of file
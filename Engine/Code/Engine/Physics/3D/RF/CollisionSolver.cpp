@@ -1,5 +1,18 @@
 #include "Engine/Physics/3D/RF/CollisionSolver.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/Time/TheTime.hpp"
+
+#include <algorithm>
+
+static uint FindIslandRoot(std::vector<uint>& parent, uint idx)
+{
+	while (parent[idx] != idx)
+	{
+		parent[idx] = parent[parent[idx]];
+		idx = parent[idx];
+	}
+	return idx;
+}
 
 CollisionSolver::CollisionSolver(uint itr, float v_threshold, float p_threshold)
 {
@@ -32,9 +45,22 @@ void CollisionSolver::SolveCollision(Collision* collisions, uint collision_num,
 
 	PrepareCollision(collisions, collision_num, duration);
 
-	SolvePositions(collisions, collision_num, duration);
+	if (m_adaptive)
+	{
+		SolveAdaptive(collisions, collision_num, duration);
+		return;
+	}
+
+	m_p_itr_used = SolvePositions(collisions, collision_num, duration, m_pos_iterations, 0.f);
 
-	SolveVelocities(collisions, collision_num, duration);
+	m_v_itr_used = SolveVelocities(collisions, collision_num, duration, m_vel_iterations, 0.f);
+}
+
+void CollisionSolver::SolveCollision(CollisionKeep* keep, float duration)
+{
+	uint collision_num = keep->ReduceManifolds();
+
+	SolveCollision(keep->m_collision_head, collision_num, duration);
 }
 
 void CollisionSolver::SetIterations(uint v_itr, uint p_itr)
@@ -54,24 +80,59 @@ void CollisionSolver::SetThresholds(const float& v_thres, const float& p_thres)
 	m_pos_threshold = p_thres;
 }
 
+void CollisionSolver::SetAdaptive(bool adaptive, float budget_seconds, float rel_tolerance)
+{
+	m_adaptive = adaptive;
+	m_budget = budget_seconds;
+	m_rel_tolerance = rel_tolerance;
+}
+
 void CollisionSolver::PrepareCollision(Collision* collisions, uint collision_num, float duration)
 {
 	Collision* last_collision = collisions + collision_num;
 
 	for (Collision* col = collisions; col != last_collision; ++col)
 	{
-		col->CacheData(duration);
+		col->CacheData(duration, m_fast_math);
 	}
 }
 
-void CollisionSolver::SolveVelocities(Collision* collisions, uint collision_num, float duration)
+// contact impulse matrices only depend on poses, so they are factored once for the velocity pass
+void CollisionSolver::FactorFrictionContacts(Collision* collisions, uint collision_num)
 {
+	m_friction_contacts.clear();
+	for (uint i = 0; i < collision_num; ++i)
+	{
+		if (collisions[i].NeedsFrictionFactor())
+			m_friction_contacts.push_back(i);
+	}
+
+	uint count = (uint)m_friction_contacts.size();
+	if (count == 0)
+		return;
+
+	m_kernel_inputs.resize(count);
+	m_kernel_factors.resize(count);
+	for (uint i = 0; i < count; ++i)
+		collisions[m_friction_contacts[i]].FillKernelInput(m_kernel_inputs[i]);
+
+	ComputeContactFactors(m_kernel_inputs.data(), count, m_kernel_factors.data());
+
+	for (uint i = 0; i < count; ++i)
+		collisions[m_friction_contacts[i]].SetFrictionFactor(m_kernel_factors[i]);
+}
+
+uint CollisionSolver::SolveVelocities(Collision* collisions, uint collision_num, float duration, uint max_itr, float rel_tolerance)
+{
+	FactorFrictionContacts(collisions, collision_num);
+
 	Vector3 velocityChange[2], rotationChange[2];
 	Vector3 deltaVel;
+	float initial = 0.f;
 
 	// iteratively handle impacts in order of severity.
-	m_v_itr_used = 0;
-	while (m_v_itr_used < m_vel_iterations)
+	uint itr_used = 0;
+	while (itr_used < max_itr)
 	{
 		// Find contact with maximum magnitude of probable velocity change.
 		float max = m_vel_threshold;
@@ -87,6 +148,12 @@ void CollisionSolver::SolveVelocities(Collision* collisions, uint collision_num,
 		if (index == collision_num)
 			break;
 
+		// converged relative to the residual we started with
+		if (itr_used == 0)
+			initial = max;
+		else if (max <= initial * rel_tolerance)
+			break;
+
 		// Match the awake state at the contact
 		collisions[index].CheckAwake();
 
@@ -121,20 +188,23 @@ void CollisionSolver::SolveVelocities(Collision* collisions, uint collision_num,
 				}
 			}
 		}
-		m_v_itr_used++;
+		itr_used++;
 	}
+
+	return itr_used;
 }
 
-void CollisionSolver::SolvePositions(Collision* collisions, uint collision_num, float)
+uint CollisionSolver::SolvePositions(Collision* collisions, uint collision_num, float, uint max_itr, float rel_tolerance)
 {
 	unsigned i, index;
 	Vector3 linearChange[2], angularChange[2];
 	float max;
+	float initial = 0.f;
 	Vector3 deltaPosition;
 
 	// iteratively resolve interpenetrations in order of severity.
-	m_p_itr_used = 0;
-	while (m_p_itr_used < m_pos_iterations)
+	uint itr_used = 0;
+	while (itr_used < max_itr)
 	{
 		// find biggest penetration
 		max = m_pos_threshold;
@@ -150,6 +220,11 @@ void CollisionSolver::SolvePositions(Collision* collisions, uint collision_num,
 		if (index == collision_num) 
 			break;
 
+		if (itr_used == 0)
+			initial = max;
+		else if (max <= initial * rel_tolerance)
+			break;
+
 		collisions[index].CheckAwake();
 
 		// resolve the penetration
@@ -178,7 +253,139 @@ void CollisionSolver::SolvePositions(Collision* collisions, uint collision_num,
 				}
 			}
 		}
-		m_p_itr_used++;
+		itr_used++;
 	}
+
+	return itr_used;
+}
+
+void CollisionSolver::SolveAdaptive(Collision* collisions, uint collision_num, float duration)
+{
+	uint64_t start = GetPerformanceCounter();
+
+	// islands are solved in a private copy sorted by island; the caller's array keeps its order
+	BuildIslands(collisions, collision_num);
+	Collision* sorted = m_island_scratch.data();
+
+	// turn the time budget into iterations with the cost measured on earlier frames
+	uint budget = 0xffffffff;
+	if (m_budget > 0.f && m_itr_cost > 0.0)
+		budget = (uint)fmin(m_budget / m_itr_cost, 4294967295.0);
+
+	// positions run first, whatever they leave over goes to velocities
+	uint pos_budget = (budget == 0xffffffff) ? budget : (budget / 2);
+	m_p_itr_used = SolveIslands(sorted, duration, true, pos_budget);
+
+	uint vel_budget = (budget == 0xffffffff) ? budget : (budget - m_p_itr_used);
+	m_v_itr_used = SolveIslands(sorted, duration, false, vel_budget);
+
+	for (uint i = 0; i < collision_num; ++i)
+		collisions[m_island_source[i]] = sorted[i];
+
+	uint total = m_p_itr_used + m_v_itr_used;
+	if (total > 0)
+	{
+		double cost = PerformanceCountToSeconds(GetPerformanceCounter() - start) / (double)total;
+		m_itr_cost = (m_itr_cost > 0.0) ? (m_itr_cost * .9 + cost * .1) : cost;
+	}
+}
+
+void CollisionSolver::BuildIslands(Collision* collisions, uint collision_num)
+{
+	// union contacts that touch the same movable body, static bodies do not join islands
+	m_island_parent.resize(collision_num);
+	for (uint i = 0; i < collision_num; ++i)
+		m_island_parent[i] = i;
+
+	m_island_body.clear();
+	for (uint i = 0; i < collision_num; ++i)
+	{
+		for (uint b = 0; b < 2; ++b)
+		{
+			CollisionRigidBody* body = collisions[i].m_bodies[b];
+			if (body == nullptr || body->GetInvMass() == 0.f)
+				continue;
+
+			std::unordered_map<CollisionRigidBody*, uint>::iterator it = m_island_body.find(body);
+			if (it == m_island_body.end())
+				m_island_body[body] = i;
+			else
+				m_island_parent[FindIslandRoot(m_island_parent, i)] = FindIslandRoot(m_island_parent, it->second);
+		}
+	}
+
+	// make each island a contiguous run in the scratch copy, m_island_source maps back to the caller's slots
+	m_island_source.resize(collision_num);
+	for (uint i = 0; i < collision_num; ++i)
+	{
+		m_island_source[i] = i;
+		m_island_parent[i] = FindIslandRoot(m_island_parent, i);
+	}
+	std::stable_sort(m_island_source.begin(), m_island_source.end(),
+		[this](uint a, uint b) { return m_island_parent[a] < m_island_parent[b]; });
+
+	m_island_scratch.resize(collision_num);
+	m_islands.clear();
+	for (uint i = 0; i < collision_num; ++i)
+	{
+		uint src = m_island_source[i];
+		m_island_scratch[i] = collisions[src];
+
+		if (i == 0 || m_island_parent[src] != m_island_parent[m_island_source[i - 1]])
+		{
+			sSolverIsland island;
+			island.m_first = i;
+			island.m_count = 0;
+			island.m_pos_error = 0.f;
+			island.m_vel_error = 0.f;
+			m_islands.push_back(island);
+		}
+
+		sSolverIsland& island = m_islands.back();
+		island.m_count++;
+		island.m_pos_error += fmaxf(m_island_scratch[i].GetPenetration() - m_pos_threshold, 0.f);
+		island.m_vel_error += fmaxf(m_island_scratch[i].m_desired_vel - m_vel_threshold, 0.f);
+	}
+}
+
+uint CollisionSolver::SolveIslands(Collision* collisions, float duration, bool positions, uint budget)
+{
+	// worst islands first, so when the budget runs short the easy ones are the ones that wait
+	float remaining_error = 0.f;
+	m_island_order.clear();
+	for (uint i = 0; i < (uint)m_islands.size(); ++i)
+	{
+		float error = positions ? m_islands[i].m_pos_error : m_islands[i].m_vel_error;
+		if (error <= 0.f)
+			continue;
+
+		m_island_order.push_back(i);
+		remaining_error += error;
+	}
+	std::sort(m_island_order.begin(), m_island_order.end(), [this, positions](uint a, uint b)
+	{
+		return positions ? (m_islands[a].m_pos_error > m_islands[b].m_pos_error) : (m_islands[a].m_vel_error > m_islands[b].m_vel_error);
+	});
+
+	uint cap = positions ? m_pos_iterations : m_vel_iterations;
+	uint used = 0;
+	for (uint k = 0; k < (uint)m_island_order.size() && used < budget; ++k)
+	{
+		const sSolverIsland& island = m_islands[m_island_order[k]];
+		float error = positions ? island.m_pos_error : island.m_vel_error;
+
+		// share of what is left by share of the error still unsolved, so unused iterations flow on
+		float share = (float)(budget - used) * (error / remaining_error);
+		uint max_itr = (uint)fmaxf(fminf(share, (float)cap), 1.f);
+		remaining_error -= error;
+
+		Collision* first = collisions + island.m_first;
+		if (positions)
+			used += SolvePositions(first, island.m_count, duration, max_itr, m_rel_tolerance);
+		else
+			used += SolveVelocities(first, island.m_count, duration, max_itr, m_rel_tolerance);
+	}
+
+	return used;
 }
 
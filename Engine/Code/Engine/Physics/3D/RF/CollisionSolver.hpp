@@ -2,6 +2,21 @@
 
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Physics/3D/RF/TheCollision.hpp"
+#include "Engine/Physics/3D/RF/CollisionKeep.hpp"
+
+#include <vector>
+#include <unordered_map>
+
+#define SOLVER_REL_TOLERANCE 0.01f		// adaptive islands stop once the residual drops to 1% of where it started
+
+// contiguous run of contacts that share dynamic bodies
+struct sSolverIsland
+{
+	uint m_first;
+	uint m_count;
+	float m_pos_error;
+	float m_vel_error;
+};
 
 class CollisionSolver
 {
@@ -14,6 +29,26 @@ class CollisionSolver
 	uint m_v_itr_used;
 	uint m_p_itr_used;
 
+	// adaptive mode: iterations are capped per island instead of per frame,
+	// and a frame budget in seconds is shared between islands by their error
+	bool m_adaptive = false;
+	float m_budget = 0.f;
+	float m_rel_tolerance = SOLVER_REL_TOLERANCE;
+	double m_itr_cost = 0.0;		// running average seconds per iteration
+
+	bool m_fast_math = false;		// contact bases built with FastMath.hpp
+
+	std::vector<sSolverIsland> m_islands;
+	std::vector<uint> m_island_parent;
+	std::vector<uint> m_island_order;
+	std::vector<uint> m_island_source;		// caller's index of each contact in m_island_scratch
+	std::vector<Collision> m_island_scratch;
+	std::unordered_map<CollisionRigidBody*, uint> m_island_body;
+
+	std::vector<uint> m_friction_contacts;
+	std::vector<sContactKernelInput> m_kernel_inputs;
+	std::vector<sContactFactor> m_kernel_factors;
+
 public:
 	CollisionSolver(){}
 	CollisionSolver(uint itr, float v_threshold, float p_threshold);
@@ -21,16 +56,30 @@ public:
 
 	bool IsValid();
 
+	// contacts stay in the caller's order, adaptive mode sorts a private copy by island
 	void SolveCollision(Collision* collisions, uint collision_num, float duration);
 
+	// reduces the manifolds generated into keep, then solves them
+	void SolveCollision(CollisionKeep* keep, float duration);
+
 	void SetIterations(uint v_itr, uint p_itr);
 
 	void SetIterations(uint itr);
 
 	void SetThresholds(const float& v_thres, const float& p_thres);
 
+	// budget of 0 means no time limit, only the per island iteration caps
+	void SetAdaptive(bool adaptive, float budget_seconds = 0.f, float rel_tolerance = SOLVER_REL_TOLERANCE);
+
+	void SetFastMath(bool fast_math) { m_fast_math = fast_math; }
+
 protected:
 	void PrepareCollision(Collision* collisions, uint collision_num, float duration);
-	void SolveVelocities(Collision* collisions, uint collision_num, float duration);
-	void SolvePositions(Collision* collisions, uint collision_num, float duration);
+	void FactorFrictionContacts(Collision* collisions, uint collision_num);
+	uint SolveVelocities(Collision* collisions, uint collision_num, float duration, uint max_itr, float rel_tolerance);
+	uint SolvePositions(Collision* collisions, uint collision_num, float duration, uint max_itr, float rel_tolerance);
+
+	void SolveAdaptive(Collision* collisions, uint collision_num, float duration);
+	void BuildIslands(Collision* collisions, uint collision_num);
+	uint SolveIslands(Collision* collisions, float duration, bool positions, uint budget);
 };
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "Engine/Physics/3D/RF/CollisionSpeculative.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+static float ComputeReach(const sBroadphaseProxy& proxy, float deltaTime)
+{
+	CollisionRigidBody* body = proxy.m_body;
+	if (body == nullptr || !body->IsAwake())
+		return 0.f;
+
+	// linear travel plus how far the farthest point of the shape can swing
+	float linear = body->GetLinearVelocity().GetLength();
+	float angular = body->GetAngularVelocity().GetLength() * proxy.m_radius;
+	return (linear + angular) * deltaTime;
+}
+
+uint CollisionSpeculative::GenerateContacts(const CollisionBroadphase& broadphase, CollisionKeep* keep, float deltaTime)
+{
+	const std::vector<uint>& order = broadphase.GetOrder();
+
+	float max_reach = 0.f;
+	for (std::vector<uint>::size_type idx = 0; idx < order.size(); ++idx)
+		max_reach = fmaxf(max_reach, ComputeReach(broadphase.GetProxy(order[idx]), deltaTime));
+
+	uint added = 0;
+	for (std::vector<uint>::size_type idx = 0; idx < order.size(); ++idx)
+	{
+		uint id = order[idx];
+		const sBroadphaseProxy& proxy = broadphase.GetProxy(id);
+		if (proxy.m_body == nullptr || !proxy.m_body->IsAwake())
+			continue;
+
+		float reach = ComputeReach(proxy, deltaTime);
+
+		// padded by the largest reach so the other side of every pair is found from here too
+		AABB3 swept = proxy.m_bound;
+		swept.AddPadding(Vector3(reach + max_reach + m_margin));
+
+		m_candidates.clear();
+		broadphase.QueryOverlap(swept, m_candidates);
+
+		for (std::vector<uint>::size_type c = 0; c < m_candidates.size(); ++c)
+		{
+			uint other_id = m_candidates[c];
+			if (other_id == id)
+				continue;
+
+			const sBroadphaseProxy& other = broadphase.GetProxy(other_id);
+			if (other.m_body == proxy.m_body)
+				continue;
+
+			// awake pairs are visited from both sides, only keep one
+			bool other_active = (other.m_body != nullptr && other.m_body->IsAwake());
+			if (other_active && other_id < id)
+				continue;
+
+			if (!keep->AllowMoreCollision())
+				return added;
+
+			float pair_reach = reach + ComputeReach(other, deltaTime) + m_margin;
+			if (GeneratePair(proxy, other, pair_reach, keep))
+				++added;
+		}
+	}
+
+	return added;
+}
+
+bool CollisionSpeculative::GeneratePair(const sBroadphaseProxy& a, const sBroadphaseProxy& b, float reach, CollisionKeep* keep)
+{
+	const sBroadphaseProxy* sphere = &a;
+	const sBroadphaseProxy* other = &b;
+	if (a.m_shape != BROADPHASE_SPHERE)
+	{
+		if (b.m_shape != BROADPHASE_SPHERE)
+			return false;
+
+		sphere = &b;
+		other = &a;
+	}
+
+	// gap along normal, normal points from other toward sphere
+	Vector3 normal;
+	Vector3 point;
+	float gap;
+
+	if (other->m_shape == BROADPHASE_SPHERE)
+	{
+		Vector3 disp = sphere->m_center - other->m_center;
+		float dist = disp.GetLength();
+		normal = (dist > 0.f) ? (disp / dist) : Vector3::UP;
+		gap = dist - sphere->m_radius - other->m_radius;
+		point = other->m_center + normal * (other->m_radius + gap * .5f);
+	}
+	else
+	{
+		Matrix33 basis = (other->m_shape == BROADPHASE_BOX) ? other->m_basis : Matrix33::IDENTITY;
+		const Vector3& ext = other->m_half_ext;
+
+		Vector3 local = basis.MultiplyTranspose(sphere->m_center - other->m_center);
+		Vector3 clamped = Vector3(ClampFloat(local.x, -ext.x, ext.x),
+			ClampFloat(local.y, -ext.y, ext.y),
+			ClampFloat(local.z, -ext.z, ext.z));
+		Vector3 closest = other->m_center + basis * clamped;
+
+		Vector3 disp = sphere->m_center - closest;
+		float dist = disp.GetLength();
+		if (dist > 1e-6f)
+		{
+			normal = disp / dist;
+			gap = dist - sphere->m_radius;
+			point = closest;
+		}
+		else
+		{
+			// center inside the box, push out through the nearest face
+			float depth_x = ext.x - abs(local.x);
+			float depth_y = ext.y - abs(local.y);
+			float depth_z = ext.z - abs(local.z);
+
+			Vector3 local_normal;
+			float depth;
+			if (depth_x <= depth_y && depth_x <= depth_z)
+			{
+				local_normal = Vector3(local.x < 0.f ? -1.f : 1.f, 0.f, 0.f);
+				depth = depth_x;
+			}
+			else if (depth_y <= depth_z)
+			{
+				local_normal = Vector3(0.f, local.y < 0.f ? -1.f : 1.f, 0.f);
+				depth = depth_y;
+			}
+			else
+			{
+				local_normal = Vector3(0.f, 0.f, local.z < 0.f ? -1.f : 1.f);
+				depth = depth_z;
+			}
+
+			normal = basis * local_normal;
+			gap = -depth - sphere->m_radius;
+			point = sphere->m_center;
+		}
+	}
+
+	if (gap > reach)
+		return false;
+
+	Collision* collision = keep->m_collision;
+	collision->SetBodies(sphere->m_body, other->m_body);
+	collision->SetCollisionNormalWorld(normal);
+	collision->SetCollisionPtWorld(point);
+	collision->SetPenetration(-gap);
+	collision->SetSpeculative(gap > 0.f);
+	collision->SetFriction(keep->m_global_friction);
+	collision->SetRestitution(keep->m_global_restitution);
+
+	keep->NotifyAddedCollisions(1);
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Engine/Physics/3D/RF/CollisionBroadphase.hpp"
+#include "Engine/Physics/3D/RF/CollisionKeep.hpp"
+
+#define SPECULATIVE_MARGIN 0.05f
+
+/*
+ * Speculative contact generation, a cheap stand-in for TOI based CCD.
+ * Every body proxy is grown by how far it can travel this step; pairs that come within
+ * that reach get a contact whose penetration is the negative gap. The velocity solver then only
+ * removes the part of the approach that would close the gap within the step
+ * (see Collision::ComputeDesiredDeltaVelocity), so touching contacts behave as before.
+ *
+ * Closest features are exact for pairs involving a sphere. Box vs box pairs are
+ * left to the regular contact generation.
+ */
+class CollisionSpeculative
+{
+	std::vector<uint> m_candidates;
+
+public:
+	float m_margin = SPECULATIVE_MARGIN;
+
+public:
+	uint GenerateContacts(const CollisionBroadphase& broadphase, CollisionKeep* keep, float deltaTime);
+
+private:
+	bool GeneratePair(const sBroadphaseProxy& a, const sBroadphaseProxy& b, float reach, CollisionKeep* keep);
+};
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include "Engine/Physics/3D/RF/ContactKernel.hpp"
+#include "Engine/Math/MathSIMD.hpp"
+
+#include <cstddef>
+
+// ((a.x * b.x + a.y * b.y) + a.z * b.z), the order the SIMD path uses as well
+static inline float ContactDot(float ax, float ay, float az, float bx, float by, float bz)
+{
+	return ax * bx + ay * by + az * bz;
+}
+
+void AccumulateContactSkewTerm(const Vector3& rel, const Matrix33& iit, const Matrix33& toWorld, sContactMatrix& k)
+{
+	const float* basis = &toWorld.Ix;
+	float u[3][3];
+	float w[3][3];
+
+	for (uint i = 0; i < 3; ++i)
+	{
+		// r x b_i, the impulse along b_i turned into torque
+		const float* e = basis + 3 * i;
+		u[i][0] = rel.y * e[2] - rel.z * e[1];
+		u[i][1] = rel.z * e[0] - rel.x * e[2];
+		u[i][2] = rel.x * e[1] - rel.y * e[0];
+
+		w[i][0] = iit.Ix * u[i][0] + iit.Jx * u[i][1] + iit.Kx * u[i][2];
+		w[i][1] = iit.Iy * u[i][0] + iit.Jy * u[i][1] + iit.Ky * u[i][2];
+		w[i][2] = iit.Iz * u[i][0] + iit.Jz * u[i][1] + iit.Kz * u[i][2];
+	}
+
+	k.m_xx += ContactDot(u[0][0], u[0][1], u[0][2], w[0][0], w[0][1], w[0][2]);
+	k.m_xy += ContactDot(u[0][0], u[0][1], u[0][2], w[1][0], w[1][1], w[1][2]);
+	k.m_xz += ContactDot(u[0][0], u[0][1], u[0][2], w[2][0], w[2][1], w[2][2]);
+	k.m_yy += ContactDot(u[1][0], u[1][1], u[1][2], w[1][0], w[1][1], w[1][2]);
+	k.m_yz += ContactDot(u[1][0], u[1][1], u[1][2], w[2][0], w[2][1], w[2][2]);
+	k.m_zz += ContactDot(u[2][0], u[2][1], u[2][2], w[2][0], w[2][1], w[2][2]);
+}
+
+void FactorContactMatrix(const sContactMatrix& k, sContactFactor& out)
+{
+	out.m_k_xx = k.m_xx;
+	out.m_k_xy = k.m_xy;
+	out.m_k_xz = k.m_xz;
+
+	float dx = (k.m_xx <= 0.f) ? 1.f : k.m_xx;
+	out.m_inv_dx = 1.f / dx;
+	out.m_l_yx = k.m_xy * out.m_inv_dx;
+	out.m_l_zx = k.m_xz * out.m_inv_dx;
+
+	float dy = k.m_yy - out.m_l_yx * k.m_xy;
+	dy = (dy <= 0.f) ? 1.f : dy;
+	out.m_inv_dy = 1.f / dy;
+
+	float yz = k.m_yz - out.m_l_zx * k.m_xy;
+	out.m_l_zy = yz * out.m_inv_dy;
+
+	float dz = k.m_zz - out.m_l_zx * k.m_xz - out.m_l_zy * yz;
+	dz = (dz <= 0.f) ? 1.f : dz;
+	out.m_inv_dz = 1.f / dz;
+}
+
+Vector3 SolveContactFactor(const sContactFactor& factor, const Vector3& rhs)
+{
+	// L y = rhs, then D z = y, then L^T x = z
+	float y0 = rhs.x;
+	float y1 = rhs.y - factor.m_l_yx * y0;
+	float y2 = rhs.z - factor.m_l_zx * y0 - factor.m_l_zy * y1;
+
+	float x2 = y2 * factor.m_inv_dz;
+	float x1 = y1 * factor.m_inv_dy - factor.m_l_zy * x2;
+	float x0 = y0 * factor.m_inv_dx - factor.m_l_yx * x1 - factor.m_l_zx * x2;
+
+	return Vector3(x0, x1, x2);
+}
+
+static void ComputeContactFactor(const sContactKernelInput& input, sContactFactor& out)
+{
+	sContactMatrix k;
+	AccumulateContactSkewTerm(input.m_rel[0], input.m_iit[0], input.m_to_world, k);
+	AccumulateContactSkewTerm(input.m_rel[1], input.m_iit[1], input.m_to_world, k);
+
+	k.m_xx += input.m_inv_mass;
+	k.m_yy += input.m_inv_mass;
+	k.m_zz += input.m_inv_mass;
+
+	FactorContactMatrix(k, out);
+}
+
+#if MATH_SIMD_SSE
+	// element idx of the float block at offset in each of 4 consecutive inputs
+	static inline __m128 GatherContactInput4(const sContactKernelInput* inputs, size_t offset, uint idx)
+	{
+		const float* a = (const float*)((const char*)(inputs + 0) + offset);
+		const float* b = (const float*)((const char*)(inputs + 1) + offset);
+		const float* c = (const float*)((const char*)(inputs + 2) + offset);
+		const float* d = (const float*)((const char*)(inputs + 3) + offset);
+		return _mm_set_ps(d[idx], c[idx], b[idx], a[idx]);
+	}
+
+	static inline __m128 SIMDContactDot4(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz)
+	{
+		return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+	}
+
+	// max(d, 0) is not enough, the scalar path swaps every non positive pivot for 1
+	static inline __m128 SIMDContactPivot4(__m128 d)
+	{
+		__m128 bad = _mm_cmple_ps(d, _mm_setzero_ps());
+		return _mm_or_ps(_mm_and_ps(bad, _mm_set1_ps(1.f)), _mm_andnot_ps(bad, d));
+	}
+
+	static void ComputeContactFactors4(const sContactKernelInput* inputs, sContactFactor* out)
+	{
+		__m128 basis[9];
+		for (uint i = 0; i < 9; ++i)
+			basis[i] = GatherContactInput4(inputs, offsetof(sContactKernelInput, m_to_world), i);
+
+		__m128 kxx = _mm_setzero_ps(), kxy = _mm_setzero_ps(), kxz = _mm_setzero_ps();
+		__m128 kyy = _mm_setzero_ps(), kyz = _mm_setzero_ps(), kzz = _mm_setzero_ps();
+
+		for (uint body = 0; body < 2; ++body)
+		{
+			size_t relOffset = offsetof(sContactKernelInput, m_rel) + body * sizeof(Vector3);
+			size_t iitOffset = offsetof(sContactKernelInput, m_iit) + body * sizeof(Matrix33);
+			__m128 rx = GatherContactInput4(inputs, relOffset, 0);
+			__m128 ry = GatherContactInput4(inputs, relOffset, 1);
+			__m128 rz = GatherContactInput4(inputs, relOffset, 2);
+
+			__m128 a[9];
+			for (uint i = 0; i < 9; ++i)
+				a[i] = GatherContactInput4(inputs, iitOffset, i);
+
+			__m128 u[3][3];
+			__m128 w[3][3];
+			for (uint i = 0; i < 3; ++i)
+			{
+				const __m128* e = basis + 3 * i;
+				u[i][0] = _mm_sub_ps(_mm_mul_ps(ry, e[2]), _mm_mul_ps(rz, e[1]));
+				u[i][1] = _mm_sub_ps(_mm_mul_ps(rz, e[0]), _mm_mul_ps(rx, e[2]));
+				u[i][2] = _mm_sub_ps(_mm_mul_ps(rx, e[1]), _mm_mul_ps(ry, e[0]));
+
+				// a is Ix Iy Iz Jx Jy Jz Kx Ky Kz
+				w[i][0] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], u[i][0]), _mm_mul_ps(a[3], u[i][1])), _mm_mul_ps(a[6], u[i][2]));
+				w[i][1] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[1], u[i][0]), _mm_mul_ps(a[4], u[i][1])), _mm_mul_ps(a[7], u[i][2]));
+				w[i][2] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[2], u[i][0]), _mm_mul_ps(a[5], u[i][1])), _mm_mul_ps(a[8], u[i][2]));
+			}
+
+			kxx = _mm_add_ps(kxx, SIMDContactDot4(u[0][0], u[0][1], u[0][2], w[0][0], w[0][1], w[0][2]));
+			kxy = _mm_add_ps(kxy, SIMDContactDot4(u[0][0], u[0][1], u[0][2], w[1][0], w[1][1], w[1][2]));
+			kxz = _mm_add_ps(kxz, SIMDContactDot4(u[0][0], u[0][1], u[0][2], w[2][0], w[2][1], w[2][2]));
+			kyy = _mm_add_ps(kyy, SIMDContactDot4(u[1][0], u[1][1], u[1][2], w[1][0], w[1][1], w[1][2]));
+			kyz = _mm_add_ps(kyz, SIMDContactDot4(u[1][0], u[1][1], u[1][2], w[2][0], w[2][1], w[2][2]));
+			kzz = _mm_add_ps(kzz, SIMDContactDot4(u[2][0], u[2][1], u[2][2], w[2][0], w[2][1], w[2][2]));
+		}
+
+		__m128 mass = GatherContactInput4(inputs, offsetof(sContactKernelInput, m_inv_mass), 0);
+		kxx = _mm_add_ps(kxx, mass);
+		kyy = _mm_add_ps(kyy, mass);
+		kzz = _mm_add_ps(kzz, mass);
+
+		// same steps as FactorContactMatrix
+		__m128 one = _mm_set1_ps(1.f);
+		__m128 invDx = _mm_div_ps(one, SIMDContactPivot4(kxx));
+		__m128 lyx = _mm_mul_ps(kxy, invDx);
+		__m128 lzx = _mm_mul_ps(kxz, invDx);
+
+		__m128 dy = _mm_sub_ps(kyy, _mm_mul_ps(lyx, kxy));
+		__m128 invDy = _mm_div_ps(one, SIMDContactPivot4(dy));
+
+		__m128 yz = _mm_sub_ps(kyz, _mm_mul_ps(lzx, kxy));
+		__m128 lzy = _mm_mul_ps(yz, invDy);
+
+		__m128 dz = _mm_sub_ps(_mm_sub_ps(kzz, _mm_mul_ps(lzx, kxz)), _mm_mul_ps(lzy, yz));
+		__m128 invDz = _mm_div_ps(one, SIMDContactPivot4(dz));
+
+		MATH_ALIGN16 float lanes[9][4];
+		_mm_store_ps(lanes[0], kxx);
+		_mm_store_ps(lanes[1], kxy);
+		_mm_store_ps(lanes[2], kxz);
+		_mm_store_ps(lanes[3], lyx);
+		_mm_store_ps(lanes[4], lzx);
+		_mm_store_ps(lanes[5], lzy);
+		_mm_store_ps(lanes[6], invDx);
+		_mm_store_ps(lanes[7], invDy);
+		_mm_store_ps(lanes[8], invDz);
+
+		for (uint lane = 0; lane < 4; ++lane)
+		{
+			sContactFactor& factor = out[lane];
+			factor.m_k_xx = lanes[0][lane];
+			factor.m_k_xy = lanes[1][lane];
+			factor.m_k_xz = lanes[2][lane];
+			factor.m_l_yx = lanes[3][lane];
+			factor.m_l_zx = lanes[4][lane];
+			factor.m_l_zy = lanes[5][lane];
+			factor.m_inv_dx = lanes[6][lane];
+			factor.m_inv_dy = lanes[7][lane];
+			factor.m_inv_dz = lanes[8][lane];
+		}
+	}
+#endif
+
+void ComputeContactFactors(const sContactKernelInput* inputs, uint count, sContactFactor* out)
+{
+	uint idx = 0;
+
+#if MATH_SIMD_SSE
+	for (; idx + 4 <= count; idx += 4)
+		ComputeContactFactors4(inputs + idx, out + idx);
+#endif
+
+	for (; idx < count; ++idx)
+		ComputeContactFactor(inputs[idx], out[idx]);
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Engine/Math/Matrix33.hpp"
+#include "Engine/Math/Vector3.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+/*
+ * Contact space math for frictional impulses, split out of Collision so it can run in batches.
+ * K maps an impulse in contact coord (x along the normal, y and z the tangents) to the change
+ * in relative velocity it causes:
+ *
+ *		K = sum over bodies of B^T [r]x^T A [r]x B + inverse mass * I
+ *
+ * with B the contact basis, r the relative contact position and A the world inverse inertia tensor.
+ * Entry (i, j) is (r x b_i) . A (r x b_j), so the skew matrices are never built and only the
+ * 6 unique entries of the symmetric K are computed. K is positive definite while either body has
+ * mass, so it is factored as L D L^T once per contact and solved by substitution per impulse.
+ */
+
+struct sContactMatrix
+{
+	float m_xx = 0.f, m_xy = 0.f, m_xz = 0.f;
+	float m_yy = 0.f, m_yz = 0.f;
+	float m_zz = 0.f;
+};
+
+struct sContactFactor
+{
+	float m_k_xx, m_k_xy, m_k_xz;			// first row of K, the friction cone clamp needs it
+	float m_l_yx, m_l_zx, m_l_zy;			// unit lower triangle of L
+	float m_inv_dx, m_inv_dy, m_inv_dz;		// inverse of D
+};
+
+// what ComputeContactFactors reads per contact; a missing second body is a zero tensor
+struct sContactKernelInput
+{
+	Matrix33 m_to_world;
+	Matrix33 m_iit[2];
+	Vector3 m_rel[2];
+	float m_inv_mass;						// sum over both bodies
+};
+
+// k += B^T [r]x^T A [r]x B
+void AccumulateContactSkewTerm(const Vector3& rel, const Matrix33& iit, const Matrix33& toWorld, sContactMatrix& k);
+
+// non positive pivots are taken as 1, like Matrix33::GetInverse falls back to identity
+void FactorContactMatrix(const sContactMatrix& k, sContactFactor& out);
+Vector3 SolveContactFactor(const sContactFactor& factor, const Vector3& rhs);
+
+// accumulate and factor for many contacts, 4 at a time in SSE lanes; matches the scalar path bit for bit
+void ComputeContactFactors(const sContactKernelInput* inputs, uint count, sContactFactor* out);
\ No newline at end of file
@@ -1,20 +1,26 @@
 #include "Engine/Physics/3D/RF/TheCollision.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/FastMath.hpp"
 
 void Collision::SetBodies(CollisionRigidBody* first, CollisionRigidBody* second)
 {
 	m_bodies[0] = first;
 	m_bodies[1] = second;
+
+	// contacts are written over the slots of the previous frame
+	m_speculative = false;
 }
 
-void Collision::CacheData(float deltaTime)
+void Collision::CacheData(float deltaTime, bool fastMath)
 {
 	if (!m_bodies[0])
 		SwapRigidBodies();
 	ASSERT_OR_DIE(m_bodies[0] != nullptr, "first body is empty when preparing for collision");
 
+	m_has_friction_factor = false;
+
 	// basis at contact
-	ComputeContactCoord();
+	ComputeContactCoord(fastMath);
 
 	// cache contact pos in world coord
 	ComputeRelativePosWorldCoord();
@@ -35,13 +41,15 @@ void Collision::SwapRigidBodies()
 	m_normal *= -1;
 }
 
-void Collision::ComputeContactCoord()
+// fastMath swaps the exact 1 / sqrt for FastRsqrt, the basis then is orthonormal to about 3e-7
+void Collision::ComputeContactCoord(bool fastMath)
 {
 	Vector3 contact_tangent[2];
 
 	if (abs(m_normal.x) > abs(m_normal.y))
 	{
-		const float s = 1.0f / sqrtf(m_normal.z * m_normal.z + m_normal.x * m_normal.x);
+		const float lengthSqr = m_normal.z * m_normal.z + m_normal.x * m_normal.x;
+		const float s = fastMath ? FastRsqrt(lengthSqr) : 1.0f / sqrtf(lengthSqr);
 
 		contact_tangent[0].x = m_normal.z * s;
 		contact_tangent[0].y = 0;
@@ -53,7 +61,8 @@ void Collision::ComputeContactCoord()
 	}
 	else
 	{
-		const float s = 1.0f / sqrtf(m_normal.z * m_normal.z + m_normal.y * m_normal.y);
+		const float lengthSqr = m_normal.z * m_normal.z + m_normal.y * m_normal.y;
+		const float s = fastMath ? FastRsqrt(lengthSqr) : 1.0f / sqrtf(lengthSqr);
 
 		contact_tangent[0].x = 0;
 		contact_tangent[0].y = -m_normal.z*s;
@@ -108,6 +117,14 @@ void Collision::ComputeDesiredDeltaVelocity(float deltaTime)
 {
 	static const float vel_limit = .25f;
 
+	if (IsSpeculative())
+	{
+		// the bodies may still close the gap this frame; only remove the approach beyond that, with no bounce
+		float gap_vel = -m_penetration / deltaTime;
+		m_desired_vel = fmaxf(-m_closing_vel.x - gap_vel, 0.f);
+		return;
+	}
+
 	float vel_from_acc = 0.f;
 
 	if (m_bodies[0]->IsAwake())
@@ -233,7 +250,8 @@ void Collision::ApplyVelocityChange(Vector3 linear[2], Vector3 angular[2])
 
 	Vector3 impulseContact;
 
-	if (m_mat.m_friction == 0.f)
+	// speculative contacts are not touching yet, so there is no friction to apply
+	if (!NeedsFrictionFactor())
 		impulseContact = ComputeFrictionlessImpulse(inverseInertiaTensor);
 	else
 		impulseContact = ComputeFrictionalImpulse(inverseInertiaTensor);
@@ -289,46 +307,57 @@ Vector3 Collision::ComputeFrictionlessImpulse(Matrix33* iit)
 	return impulseContact;
 }
 
-Vector3 Collision::ComputeFrictionalImpulse(Matrix33* iit)
+void Collision::FillKernelInput(sContactKernelInput& input) const
 {
-	Vector3 impulseContact;
-	float inverseMass = m_bodies[0]->GetInvMass();
-
-	Matrix33 impulseToTorque;
-	impulseToTorque.SetSkewSymmetric(m_relative_pos[0]);
-
-	Matrix33 deltaVelWorld = impulseToTorque;
-	deltaVelWorld *= iit[0];
-	deltaVelWorld *= impulseToTorque;
-	deltaVelWorld *= -1;
+	input.m_to_world = m_to_world;
+	input.m_rel[0] = m_relative_pos[0];
+	m_bodies[0]->GetIITWorld(&input.m_iit[0]);
+	input.m_inv_mass = m_bodies[0]->GetInvMass();
 
 	if (m_bodies[1])
 	{
-		impulseToTorque.SetSkewSymmetric(m_relative_pos[1]);
-
-		Matrix33 deltaVelWorld2 = impulseToTorque;
-		deltaVelWorld2 *= iit[1];
-		deltaVelWorld2 *= impulseToTorque;
-		deltaVelWorld2 *= -1;
+		input.m_rel[1] = m_relative_pos[1];
+		m_bodies[1]->GetIITWorld(&input.m_iit[1]);
+		input.m_inv_mass += m_bodies[1]->GetInvMass();
+	}
+	else
+	{
+		input.m_rel[1] = Vector3::ZERO;
+		input.m_iit[1] = Matrix33::ZERO;
+	}
+}
 
-		deltaVelWorld += deltaVelWorld2;
+void Collision::SetFrictionFactor(const sContactFactor& factor)
+{
+	m_friction_factor = factor;
+	m_has_friction_factor = true;
+}
 
-		inverseMass += m_bodies[1]->GetInvMass();
-	}
+Vector3 Collision::ComputeFrictionalImpulse(Matrix33* iit)
+{
+	if (!m_has_friction_factor)
+	{
+		sContactMatrix deltaVelocity;
+		AccumulateContactSkewTerm(m_relative_pos[0], iit[0], m_to_world, deltaVelocity);
+		float inverseMass = m_bodies[0]->GetInvMass();
 
-	Matrix33 deltaVelocity = m_to_world.GetTranspose();
-	deltaVelocity *= deltaVelWorld;
-	deltaVelocity *= m_to_world;
+		if (m_bodies[1])
+		{
+			AccumulateContactSkewTerm(m_relative_pos[1], iit[1], m_to_world, deltaVelocity);
+			inverseMass += m_bodies[1]->GetInvMass();
+		}
 
-	deltaVelocity.Ix += inverseMass;
-	deltaVelocity.Jy += inverseMass;
-	deltaVelocity.Kz += inverseMass;
+		deltaVelocity.m_xx += inverseMass;
+		deltaVelocity.m_yy += inverseMass;
+		deltaVelocity.m_zz += inverseMass;
 
-	Matrix33 impulseMatrix = deltaVelocity.GetInverse();
+		FactorContactMatrix(deltaVelocity, m_friction_factor);
+		m_has_friction_factor = true;
+	}
 
 	Vector3 velKill(m_desired_vel, -m_closing_vel.y, -m_closing_vel.z);
 
-	impulseContact = impulseMatrix * velKill;
+	Vector3 impulseContact = SolveContactFactor(m_friction_factor, velKill);
 
 	float planarImpulse = sqrtf(impulseContact.y * impulseContact.y + impulseContact.z * impulseContact.z );
 
@@ -337,7 +366,7 @@ Vector3 Collision::ComputeFrictionalImpulse(Matrix33* iit)
 		impulseContact.y /= planarImpulse;
 		impulseContact.z /= planarImpulse;
 
-		impulseContact.x = deltaVelocity.Ix + deltaVelocity.Jx * m_mat.m_friction * impulseContact.y + deltaVelocity.Kx * m_mat.m_friction * impulseContact.z;
+		impulseContact.x = m_friction_factor.m_k_xx + m_friction_factor.m_k_xy * m_mat.m_friction * impulseContact.y + m_friction_factor.m_k_xz * m_mat.m_friction * impulseContact.z;
 
 		impulseContact.x = m_desired_vel / impulseContact.x;
 		impulseContact.y *= m_mat.m_friction * impulseContact.x;
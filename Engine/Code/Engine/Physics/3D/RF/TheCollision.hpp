@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/Physics/3D/RF/CollisionEntity.hpp"
+#include "Engine/Physics/3D/RF/ContactKernel.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 
 struct PhysMaterialData
@@ -18,7 +19,8 @@ public:
 
 	Vector3 m_pos;
 	Vector3 m_normal;
-	float m_penetration;
+	float m_penetration;			// negative for speculative contacts, the gap still left between the bodies
+	bool m_speculative = false;		// set once at generation, the solver keeps changing m_penetration
 
 	Matrix33 m_to_world;
 	Vector3 m_relative_pos[2];
@@ -26,19 +28,24 @@ public:
 	Vector3 m_closing_vel;
 	float m_desired_vel;
 
+	// L D L^T of the contact impulse matrix, set by the solver for a whole batch of contacts
+	sContactFactor m_friction_factor;
+	bool m_has_friction_factor = false;
+
 public:
 	void SetCollisionNormalWorld(const Vector3& normal) { m_normal = normal; }
 	void SetCollisionPtWorld(const Vector3& pt) { m_pos = pt; }
 	void SetPenetration(const float& penetration) { m_penetration = penetration; }
-	void SetBodies(CollisionRigidBody* first, CollisionRigidBody* second);
+	void SetBodies(CollisionRigidBody* first, CollisionRigidBody* second);		// starts a new contact, not speculative
+	void SetSpeculative(bool speculative) { m_speculative = speculative; }
 	void SetFriction(const float& friction) { m_mat.m_friction = friction; }
 	void SetRestitution(const float& restitution) { m_mat.m_restitution = restitution; }
 
-	void CacheData(float deltaTime);
+	void CacheData(float deltaTime, bool fastMath = false);
 
 	void SwapRigidBodies();
 
-	void ComputeContactCoord();
+	void ComputeContactCoord(bool fastMath = false);
 	void ComputeRelativePosWorldCoord();
 	void ComputeClosingVelocityContactCoord(float deltaTime);
 	Vector3 ComputeLocalVelocity(uint idx, float deltaTime);
@@ -46,10 +53,15 @@ public:
 
 	void CheckAwake();
 
+	bool IsSpeculative() const { return m_speculative; }
 	float GetPenetration() const { return m_penetration; }
 	Vector3 GetNormal() const { return m_normal; }
 	Vector3 GetPos() const { return m_pos; }
 
+	bool NeedsFrictionFactor() const { return m_mat.m_friction != 0.f && !IsSpeculative(); }
+	void FillKernelInput(sContactKernelInput& input) const;
+	void SetFrictionFactor(const sContactFactor& factor);
+
 	void ApplyPositionChange(Vector3 linear[2], Vector3 angular[2], float penetration);
 	void ApplyVelocityChange(Vector3 linear[2], Vector3 angular[2]);
 
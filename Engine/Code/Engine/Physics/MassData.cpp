@@ -0,0 +1,109 @@
+#include "Engine/Physics/MassData.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/Thread/ParallelFor.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <vector>
+
+struct sMassPartial
+{
+	float m_volume6 = 0.f;				// 6x signed volume, the sum of determinants
+	Vector3 m_moment = Vector3::ZERO;	// determinant weighted tetrahedron centroids, times 4
+	Matrix33 m_cov = Matrix33::ZERO;	// covariance about the origin, unit density
+};
+
+struct sMassJob
+{
+	const Vector3* m_positions;
+	const uint* m_indices;
+	uint m_triCount;
+	Vector3 m_ref;
+	std::vector<sMassPartial>* m_partials;
+};
+
+static void AccumulateTriangles(const sMassJob& job, uint begin, uint end, sMassPartial& out)
+{
+	Matrix33 canonical = GetCanonicalTetrahedronCovariance();
+
+	for (uint i = begin; i < end; ++i)
+	{
+		Vector3 a = job.m_positions[job.m_indices[i * 3]] - job.m_ref;
+		Vector3 b = job.m_positions[job.m_indices[i * 3 + 1]] - job.m_ref;
+		Vector3 c = job.m_positions[job.m_indices[i * 3 + 2]] - job.m_ref;
+
+		// tetrahedron (ref, a, b, c) is the canonical one mapped by A = [a b c]
+		Matrix33 A = Matrix33(a, b, c);
+		float det = A.GetDeterminant();
+
+		Matrix33 cov = A * canonical * A.GetTranspose();
+		cov *= det;
+
+		out.m_volume6 += det;
+		out.m_moment += (a + b + c) * det;
+		out.m_cov += cov;
+	}
+}
+
+static void MassChunkCB(uint idx, void* userData)
+{
+	sMassJob* job = (sMassJob*)(userData);
+
+	uint begin = idx * MASS_CHUNK_TRIS;
+	uint end = begin + MASS_CHUNK_TRIS;
+	end = (end < job->m_triCount) ? end : job->m_triCount;
+
+	AccumulateTriangles(*job, begin, end, (*job->m_partials)[idx]);
+}
+
+MassData3 ComputeMeshMassData(const Vector3* positions, const uint* indices, uint triCount, float density,
+	Vector3* centerOfMass, bool parallel)
+{
+	uint chunkCount = (triCount + MASS_CHUNK_TRIS - 1) / MASS_CHUNK_TRIS;
+	std::vector<sMassPartial> partials(chunkCount);
+
+	sMassJob job;
+	job.m_positions = positions;
+	job.m_indices = indices;
+	job.m_triCount = triCount;
+	job.m_partials = &partials;
+
+	// tetrahedra fan out from a point on the mesh instead of the origin, far away meshes keep their precision
+	job.m_ref = (triCount > 0) ? positions[indices[0]] : Vector3::ZERO;
+
+	if (parallel)
+		ParallelFor(chunkCount, MassChunkCB, &job);
+	else
+	{
+		for (uint idx = 0; idx < chunkCount; ++idx)
+			MassChunkCB(idx, &job);
+	}
+
+	// reduce in chunk order so the result does not depend on thread timing
+	sMassPartial total;
+	for (uint idx = 0; idx < chunkCount; ++idx)
+	{
+		total.m_volume6 += partials[idx].m_volume6;
+		total.m_moment += partials[idx].m_moment;
+		total.m_cov += partials[idx].m_cov;
+	}
+
+	MassData3 data;
+	data.m_mass = density * total.m_volume6 / 6.f;
+	ASSERT_RECOVERABLE(data.m_mass > 0.f, "mesh has no volume, is it closed and wound outward?");
+
+	Vector3 com = (total.m_volume6 != 0.f) ? (total.m_moment / (total.m_volume6 * 4.f)) : Vector3::ZERO;
+	if (centerOfMass)
+		*centerOfMass = com + job.m_ref;
+
+	// move the covariance from the reference point to the center of mass
+	Matrix33 cov = total.m_cov;
+	cov *= density;
+	cov = TranslateCovariance(cov, com, data.m_mass, -com);
+
+	data.m_tensor = GetInertiaTensorFromCovariance(cov);
+	data.m_invMass = (data.m_mass > 0.f) ? (1.f / data.m_mass) : 0.f;
+	data.m_invTensor = data.m_tensor.GetInverse();
+	data.m_invTensorWorld = data.m_invTensor;
+
+	return data;
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Engine/Math/Matrix33.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#define MASS_CHUNK_TRIS 4096		// triangles per worker chunk
 
 struct MassData
 {
@@ -21,4 +24,11 @@ struct MassData3
 	Matrix33 m_tensor;
 	Matrix33 m_invTensor;
 	Matrix33 m_invTensorWorld;
-};
\ No newline at end of file
+};
+
+// Exact mass properties of a closed triangle mesh with outward winding and uniform density.
+// The mesh is cut into tetrahedra against one of its vertices and their covariances are summed,
+// chunks of triangles are reduced in parallel. m_tensor is about the center of mass,
+// ready for CollisionRigidBody::SetTensor.
+MassData3 ComputeMeshMassData(const Vector3* positions, const uint* indices, uint triCount, float density,
+	Vector3* centerOfMass = nullptr, bool parallel = true);
\ No newline at end of file
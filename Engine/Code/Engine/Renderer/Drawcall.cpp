@@ -3,6 +3,7 @@
 
 
 Drawcall::Drawcall()
+	: m_model_class(MAT_CLASS_GENERAL)
 {
 	for (int idx = 0; idx < MAX_LIGHTS; ++idx)
 	{
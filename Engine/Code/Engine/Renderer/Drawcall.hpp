@@ -17,6 +17,7 @@ public:
 	Mesh*		m_mesh;
 	Shader*		m_shader;
 	Matrix44	m_model;
+	eMatrixClass m_model_class;		// lets the renderer take the cheap inverse
 	Vector4		m_tint;
 
 	Texture*	m_diff;
@@ -38,10 +38,11 @@ void ForwardRenderPath::RenderScene(RenderSceneGraph* scene)
 void ForwardRenderPath::RenderSceneForCamera(Camera* camera, RenderSceneGraph* scene)
 {
 	std::vector<Drawcall*> dcs;
+	Vector3 eye = camera->GetWorldPosition();
 
 	for each (Renderable* rdb in scene->m_renderables)
 	{
-		Drawcall* dc = rdb->ComposeDrawcall();
+		Drawcall* dc = rdb->ComposeDrawcall(eye);
 
 		// only consider the single effective light
 		dc->m_light_mat_ambient = scene->m_single_light->m_mat_amb;
@@ -1,11 +1,51 @@
 #include "Engine/Renderer/Mesh.hpp"
 #include "Engine/Renderer/MeshBuilder.hpp"
+#include "Engine/Renderer/TypedMeshBuilder.hpp"
 #include "Engine/Math/Vector3.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/FastMath.hpp"
 #include "Engine/Core/Rgba.hpp"
 #include "Engine/Core/ModelLoader.hpp"
 #include "Engine/Core/Util/DataUtils.hpp"
 
+// triangle counts of model LODs against the full mesh
+static const float s_modelLODRatios[] = { .5f, .25f, .1f };
+
+// one builder per vertex type and thread, emptied and given a fresh stamp for every mesh; Clear
+// keeps the capacity, so immediate meshes stop allocating once the largest one has been built
+template<typename VERT>
+static TypedMeshBuilder<VERT>& GetImmediateBuilder()
+{
+	thread_local TypedMeshBuilder<VERT> t_builder;
+	t_builder.Clear();
+	t_builder.m_stamp = sVertexBuilder();
+	return t_builder;
+}
+
+// fill gets a TypedMeshBuilder of the vertex type asked for; immediate meshes are rebuilt
+// every time they are drawn, so they all go this way. fill must not make another immediate mesh
+template<typename FILL>
+static Mesh* CreateTypedMesh(eVertexType type, eDrawPrimitiveType drawType, uint vertexHint, uint indexHint, const FILL& fill)
+{
+	Mesh* mesh;
+	if (type == VERT_LIT)
+	{
+		TypedMeshBuilder<VertexLit>& mb = GetImmediateBuilder<VertexLit>();
+		mb.Reserve(vertexHint, indexHint);
+		fill(mb);
+		mesh = mb.CreateMesh(drawType);
+	}
+	else
+	{
+		TypedMeshBuilder<Vertex_3DPCU>& mb = GetImmediateBuilder<Vertex_3DPCU>();
+		mb.Reserve(vertexHint, indexHint);
+		fill(mb);
+		mesh = mb.CreateMesh(drawType);
+	}
+
+	return mesh;
+}
+
 Mesh::Mesh()
 {
 
@@ -60,19 +100,18 @@ Mesh* Mesh::CreatePointImmediate2D(eVertexType type, Vector2 pos, Rgba color)
 {
 	Vector3 position = pos.ToVector3(0.f);
 
-	MeshBuilder mb;
-
-	mb.Begin(DRAW_POINT, true);
-
-	mb.SetColor(color);
-	mb.SetUV(Vector2::ZERO);
-	uint idx = mb.PushVertex(position);
+	Mesh* mesh = CreateTypedMesh(type, DRAW_POINT, 1, 1, [&](auto& mb)
+	{
+		mb.Begin(DRAW_POINT, true);
 
-	mb.AddPoint(idx);
+		mb.SetColor(color);
+		mb.SetUV(Vector2::ZERO);
+		uint idx = mb.PushVertex(position);
 
-	mb.End();
+		mb.AddPoint(idx);
 
-	Mesh* mesh = mb.CreateMesh(type, DRAW_POINT);
+		mb.End();
+	});
 	mesh->m_immediate = true;
 	return mesh;
 }
@@ -80,41 +119,39 @@ Mesh* Mesh::CreatePointImmediate2D(eVertexType type, Vector2 pos, Rgba color)
 Mesh* Mesh::CreateLineImmediate(eVertexType type, const Vector3& startPos,
 	const Vector3& endPos, const Rgba& color)
 {
-	MeshBuilder mb;
-
-	mb.Begin( DRAW_LINE, true );
-	mb.SetColor(color);
-
-	mb.SetUV(Vector2(0.f, 0.f));
-	uint idx = mb.PushVertex(startPos);
+	Mesh* mesh = CreateTypedMesh(type, DRAW_LINE, 2, 2, [&](auto& mb)
+	{
+		mb.Begin( DRAW_LINE, true );
+		mb.SetColor(color);
 
-	mb.SetUV(Vector2(1.f, 1.f));
-	mb.PushVertex(endPos);
+		mb.SetUV(Vector2(0.f, 0.f));
+		uint idx = mb.PushVertex(startPos);
 
-	mb.AddLine(idx, idx + 1);
+		mb.SetUV(Vector2(1.f, 1.f));
+		mb.PushVertex(endPos);
 
-	mb.End();
+		mb.AddLine(idx, idx + 1);
 
-	Mesh* mesh = mb.CreateMesh(type, DRAW_LINE);
+		mb.End();
+	});
 	mesh->m_immediate = true;
 	return mesh;
 }
 
 Mesh* Mesh::CreatePointImmediate(eVertexType type, const Vector3& pos, const Rgba& color)
 {
-	MeshBuilder mb;
-
-	mb.Begin(DRAW_POINT, true);
-	mb.SetColor(color);
-
-	mb.SetUV(Vector2::ZERO);
-	uint idx = mb.PushVertex(pos);
+	Mesh* mesh = CreateTypedMesh(type, DRAW_POINT, 1, 1, [&](auto& mb)
+	{
+		mb.Begin(DRAW_POINT, true);
+		mb.SetColor(color);
 
-	mb.AddPoint(idx);
+		mb.SetUV(Vector2::ZERO);
+		uint idx = mb.PushVertex(pos);
 
-	mb.End();
+		mb.AddPoint(idx);
 
-	Mesh* mesh = mb.CreateMesh(type, DRAW_POINT);
+		mb.End();
+	});
 	mesh->m_immediate = true;
 	return mesh;
 }
@@ -312,28 +349,27 @@ Mesh* Mesh::CreateQuadTextured(eVertexType type, Vector2 uvBL, Vector2 uvBR, Vec
 Mesh* Mesh::CreateQuadImmediate(eVertexType type, const Vector3& bl, const Vector3& br, 
 	const Vector3& tl, const Vector3& tr, const Rgba& tint)
 {
-	MeshBuilder mb;
-
-	mb.Begin(DRAW_TRIANGLE, true);
-	mb.SetColor(tint);
-
-	mb.SetUV(Vector2::ZERO);
-	uint idx = mb.PushVertex(bl);
+	Mesh* mesh = CreateTypedMesh(type, DRAW_TRIANGLE, 4, 6, [&](auto& mb)
+	{
+		mb.Begin(DRAW_TRIANGLE, true);
+		mb.SetColor(tint);
 
-	mb.SetUV(Vector2(1.f, 0.f));
-	mb.PushVertex(br);
+		mb.SetUV(Vector2::ZERO);
+		uint idx = mb.PushVertex(bl);
 
-	mb.SetUV(Vector2(0.f, 1.f));
-	mb.PushVertex(tl);
+		mb.SetUV(Vector2(1.f, 0.f));
+		mb.PushVertex(br);
 
-	mb.SetUV(Vector2(1.f, 1.f));
-	mb.PushVertex(tr);
+		mb.SetUV(Vector2(0.f, 1.f));
+		mb.PushVertex(tl);
 
-	mb.AddQuad(idx, idx + 1, idx + 2, idx + 3);
+		mb.SetUV(Vector2(1.f, 1.f));
+		mb.PushVertex(tr);
 
-	mb.End();
+		mb.AddQuad(idx, idx + 1, idx + 2, idx + 3);
 
-	Mesh* mesh = mb.CreateMesh(type, DRAW_TRIANGLE);
+		mb.End();
+	});
 	mesh->m_immediate = true;
 	return mesh;
 }
@@ -345,28 +381,27 @@ Mesh* Mesh::CreatePolygonImmedidate(eVertexType type, const Vector2& bl, const V
 	Vector3 tlV3 = Vector3(tl.x, tl.y, 0.f);
 	Vector3 trV3 = Vector3(tr.x, tr.y, 0.f);
 
-	MeshBuilder mb;
-
-	mb.Begin(DRAW_TRIANGLE, true);
-	mb.SetColor(color);
-
-	mb.SetUV(Vector2(0.f, 0.f));
-	uint idx = mb.PushVertex(blV3);
+	Mesh* mesh = CreateTypedMesh(type, DRAW_TRIANGLE, 4, 6, [&](auto& mb)
+	{
+		mb.Begin(DRAW_TRIANGLE, true);
+		mb.SetColor(color);
 
-	mb.SetUV(Vector2(1.f, 0.f));
-	mb.PushVertex(brV3);
+		mb.SetUV(Vector2(0.f, 0.f));
+		uint idx = mb.PushVertex(blV3);
 
-	mb.SetUV(Vector2(0.f, 1.f));
-	mb.PushVertex(tlV3);
+		mb.SetUV(Vector2(1.f, 0.f));
+		mb.PushVertex(brV3);
 
-	mb.SetUV(Vector2(1.f, 1.f));
-	mb.PushVertex(trV3);
+		mb.SetUV(Vector2(0.f, 1.f));
+		mb.PushVertex(tlV3);
 
-	mb.AddQuad(idx + 0, idx + 1, idx + 2, idx + 3);
+		mb.SetUV(Vector2(1.f, 1.f));
+		mb.PushVertex(trV3);
 
-	mb.End();
+		mb.AddQuad(idx + 0, idx + 1, idx + 2, idx + 3);
 
-	Mesh* mesh = mb.CreateMesh(type, DRAW_TRIANGLE);
+		mb.End();
+	});
 	mesh->m_immediate = true;
 	return mesh;
 }
@@ -378,36 +413,36 @@ Mesh* Mesh::CreateQuadTexturedImmediate(eVertexType type,
 	Vector3 normRight = right.GetNormalized();
 	Vector3 normUp = up.GetNormalized();
 
-	MeshBuilder mb;
+	Mesh* mesh = CreateTypedMesh(type, DRAW_TRIANGLE, 4, 6, [&](auto& mb)
+	{
 	
-	mb.Begin(DRAW_TRIANGLE, true);
-	mb.SetColor(Rgba::WHITE);
+		mb.Begin(DRAW_TRIANGLE, true);
+		mb.SetColor(Rgba::WHITE);
 
-	Vector2 uv_bl = glyphbound.mins;
-	Vector3 bl = drawmin;
-	mb.SetUV(uv_bl);
-	uint idx = mb.PushVertex(bl);
+		Vector2 uv_bl = glyphbound.mins;
+		Vector3 bl = drawmin;
+		mb.SetUV(uv_bl);
+		uint idx = mb.PushVertex(bl);
 
-	Vector2 uv_br = glyphbound.mins + Vector2(glyphbound.GetDimensions().x, 0.f);
-	Vector3 br = drawmin + normRight * cellWidth;
-	mb.SetUV(uv_br);
-	mb.PushVertex(br);
+		Vector2 uv_br = glyphbound.mins + Vector2(glyphbound.GetDimensions().x, 0.f);
+		Vector3 br = drawmin + normRight * cellWidth;
+		mb.SetUV(uv_br);
+		mb.PushVertex(br);
 
-	Vector2 uv_tl = glyphbound.mins + Vector2(0.f, glyphbound.GetDimensions().y);
-	Vector3 tl = drawmin + normUp * cellHeight;
-	mb.SetUV(uv_tl);
-	mb.PushVertex(tl);
+		Vector2 uv_tl = glyphbound.mins + Vector2(0.f, glyphbound.GetDimensions().y);
+		Vector3 tl = drawmin + normUp * cellHeight;
+		mb.SetUV(uv_tl);
+		mb.PushVertex(tl);
 
-	Vector2 uv_tr = glyphbound.maxs;
-	Vector3 tr = drawmin + normUp * cellHeight + normRight * cellWidth;
-	mb.SetUV(uv_tr);
-	mb.PushVertex(tr);
-
-	mb.AddQuad(idx + 0, idx + 1, idx + 2, idx + 3);
+		Vector2 uv_tr = glyphbound.maxs;
+		Vector3 tr = drawmin + normUp * cellHeight + normRight * cellWidth;
+		mb.SetUV(uv_tr);
+		mb.PushVertex(tr);
 
-	mb.End();
+		mb.AddQuad(idx + 0, idx + 1, idx + 2, idx + 3);
 
-	Mesh* mesh = mb.CreateMesh(type, DRAW_TRIANGLE);
+		mb.End();
+	});
 	mesh->m_immediate = true;
 	return mesh;
 }
@@ -631,7 +666,7 @@ Mesh* Mesh::CreateCube(eVertexType type)
 	return mesh; 
 }
 
-Mesh* Mesh::CreateUVSphere( eVertexType type, uint slices, uint wedges )
+Mesh* Mesh::CreateUVSphere( eVertexType type, uint slices, uint wedges, bool fastTrig )
 {
 	// (0,0) to (1,1)
 
@@ -652,7 +687,16 @@ Mesh* Mesh::CreateUVSphere( eVertexType type, uint slices, uint wedges )
 			float rot = 360.f * u;
 
 			mb.SetUV( Vector2(u, v) ); 
-			Vector3 pos = position + PolarToCartesian( radius, rot, azimuth ); 
+			Vector3 pos;
+			if (fastTrig)
+			{
+				FastPolarToCartesian( radius, rot, azimuth, pos.x, pos.y, pos.z );
+				pos += position;
+			}
+			else
+			{
+				pos = position + PolarToCartesian( radius, rot, azimuth );
+			}
 			Vector3 normal = (pos - position).GetNormalized();
 			mb.SetNormal(normal);
 
@@ -685,16 +729,10 @@ Mesh* Mesh::CreateUVSphere( eVertexType type, uint slices, uint wedges )
 	return mb.CreateMesh(type, DRAW_TRIANGLE); 
 }
 
-Mesh* Mesh::CreateModel(std::string fp, eVertexType type)
+// obj faces come as separate triangles with a tangent each, welded so they share what they have in common
+template<typename BUILDER>
+static void FillModel(BUILDER& mb, const std::vector<Vector3>& verts, const std::vector<Vector3>& uvs, const std::vector<Vector3>& normals)
 {
-	std::vector<Vector3> verts;
-	std::vector<Vector3> uvs;
-	std::vector<Vector3> normals;
-
-	LoadObj(fp, verts, uvs, normals);
-
-	MeshBuilder mb;
-
 	mb.Begin(DRAW_TRIANGLE, true);
 	mb.SetColor(Rgba::WHITE);
 
@@ -735,62 +773,106 @@ Mesh* Mesh::CreateModel(std::string fp, eVertexType type)
 		mb.AddTriangle(vertIdx, vertIdx + 1, vertIdx + 2);
 	}
 
+	mb.Weld();
 	mb.End();
-
-	return mb.CreateMesh(type, DRAW_TRIANGLE);
 }
 
-Mesh* Mesh::CreateTerrainImmediateFromSurfacePatch(SurfacePatch* patch, eVertexType type)
+Mesh* Mesh::CreateModel(std::string fp, eVertexType type)
 {
-	std::vector<Vector3> verts = patch->m_verts;
-	std::vector<Vector2> uvs = patch->m_uvs;
-	std::vector<Vector3> normals = patch->m_normals;
-
-	MeshBuilder mb;
+	std::vector<Vector3> verts;
+	std::vector<Vector3> uvs;
+	std::vector<Vector3> normals;
 
-	mb.Begin(DRAW_TRIANGLE, true);
-	mb.SetColor(Rgba::WHITE);
+	LoadObj(fp, verts, uvs, normals);
 
-	// Add face by triangles
-	for (uint vertIdx = 0; vertIdx < verts.size(); vertIdx += 3)
+	return CreateTypedMesh(type, DRAW_TRIANGLE, (uint)verts.size(), (uint)verts.size(), [&](auto& mb)
 	{
-		Vector2 uv_0 = uvs[vertIdx];
-		Vector2 uv_1 = uvs[vertIdx + 1];
-		Vector2 uv_2 = uvs[vertIdx + 2];
-
-		Vector3 normal_0 = normals[vertIdx];
-		Vector3 normal_1 = normals[vertIdx + 1];
-		Vector3 normal_2 = normals[vertIdx + 2];
+		FillModel(mb, verts, uvs, normals);
 
-		Vector3 pos_0 = verts[vertIdx];
-		Vector3 pos_1 = verts[vertIdx + 1];
-		Vector3 pos_2 = verts[vertIdx + 2];
+		// order once for the cache and overdraw since models are loaded once
+		mb.Optimize(true);
+	});
+}
 
-		Vector3 e1 = pos_0 - pos_2;
-		Vector3 e2 = pos_1 - pos_2;
-		Vector2 uv1 = uv_0 - uv_2;
-		Vector2 uv2 = uv_1 - uv_2;
-		Vector4 tan = mb.CalcTangent(e1, e2, uv1, uv2);
-		mb.SetTangent(tan);
+std::vector<Mesh*> Mesh::CreateModelLODs(std::string fp, eVertexType type)
+{
+	std::vector<Vector3> verts;
+	std::vector<Vector3> uvs;
+	std::vector<Vector3> normals;
 
-		mb.SetUV(uv_0);
-		mb.SetNormal(normal_0);
-		mb.PushVertex(pos_0);
+	LoadObj(fp, verts, uvs, normals);
 
-		mb.SetUV(uv_1);
-		mb.SetNormal(normal_1);
-		mb.PushVertex(pos_1);
+	// every LOD is optimized on its own, so the full mesh is only welded
+	const uint ratioCount = sizeof(s_modelLODRatios) / sizeof(s_modelLODRatios[0]);
+	if (type == VERT_LIT)
+	{
+		TypedMeshBuilder<VertexLit>& mb = GetImmediateBuilder<VertexLit>();
+		mb.Reserve((uint)verts.size(), (uint)verts.size());
+		FillModel(mb, verts, uvs, normals);
+		return mb.CreateLODMeshes(s_modelLODRatios, ratioCount);
+	}
+	else
+	{
+		TypedMeshBuilder<Vertex_3DPCU>& mb = GetImmediateBuilder<Vertex_3DPCU>();
+		mb.Reserve((uint)verts.size(), (uint)verts.size());
+		FillModel(mb, verts, uvs, normals);
+		return mb.CreateLODMeshes(s_modelLODRatios, ratioCount);
+	}
+}
 
-		mb.SetUV(uv_2);
-		mb.SetNormal(normal_2);
-		mb.PushVertex(pos_2);
+Mesh* Mesh::CreateTerrainImmediateFromSurfacePatch(SurfacePatch* patch, eVertexType type)
+{
+	const std::vector<Vector3>& verts = patch->m_verts;
+	const std::vector<Vector2>& uvs = patch->m_uvs;
+	const std::vector<Vector3>& normals = patch->m_normals;
 
-		mb.AddTriangle(vertIdx, vertIdx + 1, vertIdx + 2);
-	}
+	Mesh* mesh = CreateTypedMesh(type, DRAW_TRIANGLE, (uint)verts.size(), (uint)verts.size(), [&](auto& mb)
+	{
+		mb.Begin(DRAW_TRIANGLE, true);
+		mb.SetColor(Rgba::WHITE);
+
+		// Add face by triangles
+		for (uint vertIdx = 0; vertIdx < verts.size(); vertIdx += 3)
+		{
+			Vector2 uv_0 = uvs[vertIdx];
+			Vector2 uv_1 = uvs[vertIdx + 1];
+			Vector2 uv_2 = uvs[vertIdx + 2];
+
+			Vector3 normal_0 = normals[vertIdx];
+			Vector3 normal_1 = normals[vertIdx + 1];
+			Vector3 normal_2 = normals[vertIdx + 2];
+
+			Vector3 pos_0 = verts[vertIdx];
+			Vector3 pos_1 = verts[vertIdx + 1];
+			Vector3 pos_2 = verts[vertIdx + 2];
+
+			Vector3 e1 = pos_0 - pos_2;
+			Vector3 e2 = pos_1 - pos_2;
+			Vector2 uv1 = uv_0 - uv_2;
+			Vector2 uv2 = uv_1 - uv_2;
+			Vector4 tan = mb.CalcTangent(e1, e2, uv1, uv2);
+			mb.SetTangent(tan);
+
+			mb.SetUV(uv_0);
+			mb.SetNormal(normal_0);
+			mb.PushVertex(pos_0);
+
+			mb.SetUV(uv_1);
+			mb.SetNormal(normal_1);
+			mb.PushVertex(pos_1);
+
+			mb.SetUV(uv_2);
+			mb.SetNormal(normal_2);
+			mb.PushVertex(pos_2);
+
+			mb.AddTriangle(vertIdx, vertIdx + 1, vertIdx + 2);
+		}
 
-	mb.End();
+		// the patch repeats every vertex for each triangle touching it
+		mb.Weld();
 
-	Mesh* mesh = mb.CreateMesh(type, DRAW_TRIANGLE);
+		mb.End();
+	});
 	mesh->m_immediate = true;
 	return mesh;
 }
@@ -798,92 +880,90 @@ Mesh* Mesh::CreateTerrainImmediateFromSurfacePatch(SurfacePatch* patch, eVertexT
 Mesh* Mesh::CreateTriangleImmediate(eVertexType type, const Rgba& color,
 	const Vector3& v1, const Vector3& v2, const Vector3& v3)
 {
-	MeshBuilder mb;
-
-	mb.Begin(DRAW_TRIANGLE, true);
-	mb.SetColor(color);
-
-	mb.SetUV(Vector2::ZERO);
-	uint idx = mb.PushVertex(v1);
+	Mesh* mesh = CreateTypedMesh(type, DRAW_TRIANGLE, 3, 3, [&](auto& mb)
+	{
+		mb.Begin(DRAW_TRIANGLE, true);
+		mb.SetColor(color);
 
-	mb.SetUV(Vector2(1.f, 0.f));
-	mb.PushVertex(v2);
+		mb.SetUV(Vector2::ZERO);
+		uint idx = mb.PushVertex(v1);
 
-	mb.SetUV(Vector2(0.f, 1.f));
-	mb.PushVertex(v3);
+		mb.SetUV(Vector2(1.f, 0.f));
+		mb.PushVertex(v2);
 
-	mb.AddTriangle(idx, idx + 1, idx + 2);
+		mb.SetUV(Vector2(0.f, 1.f));
+		mb.PushVertex(v3);
 
-	mb.End();
+		mb.AddTriangle(idx, idx + 1, idx + 2);
 
-	Mesh* mesh = mb.CreateMesh(type, DRAW_TRIANGLE);
+		mb.End();
+	});
 	mesh->m_immediate = true;
 	return mesh;
 }
 
 Mesh* Mesh::CreateTetrahedronImmediate(eVertexType type, const Rgba& color, const Vector3& v1, const Vector3& v2, const Vector3& v3, const Vector3& v4)
 {
-	MeshBuilder mb;
-
-	mb.Begin(DRAW_TRIANGLE, true);
-	mb.SetColor(color);
-
-	// f1
-	mb.SetUV(Vector2::ZERO);
-	uint idx = mb.PushVertex(v1);
+	Mesh* mesh = CreateTypedMesh(type, DRAW_TRIANGLE, 12, 12, [&](auto& mb)
+	{
+		mb.Begin(DRAW_TRIANGLE, true);
+		mb.SetColor(color);
 
-	mb.SetUV(Vector2(1.f, 0.f));
-	mb.PushVertex(v2);
+		// f1
+		mb.SetUV(Vector2::ZERO);
+		uint idx = mb.PushVertex(v1);
 
-	mb.SetUV(Vector2(0.f, 1.f));
-	mb.PushVertex(v3);
+		mb.SetUV(Vector2(1.f, 0.f));
+		mb.PushVertex(v2);
 
-	mb.AddTriangle(idx, idx + 1, idx + 2);
+		mb.SetUV(Vector2(0.f, 1.f));
+		mb.PushVertex(v3);
 
-	// f2
-	mb.SetUV(Vector2::ZERO);
-	idx = mb.PushVertex(v2);
+		mb.AddTriangle(idx, idx + 1, idx + 2);
 
-	mb.SetUV(Vector2(1.f, 0.f));
-	mb.PushVertex(v3);
+		// f2
+		mb.SetUV(Vector2::ZERO);
+		idx = mb.PushVertex(v2);
 
-	mb.SetUV(Vector2(0.f, 1.f));
-	mb.PushVertex(v4);
+		mb.SetUV(Vector2(1.f, 0.f));
+		mb.PushVertex(v3);
 
-	mb.AddTriangle(idx, idx + 1, idx + 2);
+		mb.SetUV(Vector2(0.f, 1.f));
+		mb.PushVertex(v4);
 
-	// f3
-	mb.SetUV(Vector2::ZERO);
-	idx = mb.PushVertex(v3);
+		mb.AddTriangle(idx, idx + 1, idx + 2);
 
-	mb.SetUV(Vector2(1.f, 0.f));
-	mb.PushVertex(v4);
+		// f3
+		mb.SetUV(Vector2::ZERO);
+		idx = mb.PushVertex(v3);
 
-	mb.SetUV(Vector2(0.f, 1.f));
-	mb.PushVertex(v1);
+		mb.SetUV(Vector2(1.f, 0.f));
+		mb.PushVertex(v4);
 
-	mb.AddTriangle(idx, idx + 1, idx + 2);
+		mb.SetUV(Vector2(0.f, 1.f));
+		mb.PushVertex(v1);
 
-	// f4
-	mb.SetUV(Vector2::ZERO);
-	idx = mb.PushVertex(v2);
+		mb.AddTriangle(idx, idx + 1, idx + 2);
 
-	mb.SetUV(Vector2(1.f, 0.f));
-	mb.PushVertex(v4);
+		// f4
+		mb.SetUV(Vector2::ZERO);
+		idx = mb.PushVertex(v2);
 
-	mb.SetUV(Vector2(0.f, 1.f));
-	mb.PushVertex(v1);
+		mb.SetUV(Vector2(1.f, 0.f));
+		mb.PushVertex(v4);
 
-	mb.AddTriangle(idx, idx + 1, idx + 2);
+		mb.SetUV(Vector2(0.f, 1.f));
+		mb.PushVertex(v1);
 
-	mb.End();
+		mb.AddTriangle(idx, idx + 1, idx + 2);
 
-	Mesh* mesh = mb.CreateMesh(type, DRAW_TRIANGLE);
+		mb.End();
+	});
 	mesh->m_immediate = true;
 	return mesh;
 }
 
-Mesh* Mesh::CreateCone(eVertexType type, int base_side)
+Mesh* Mesh::CreateCone(eVertexType type, int base_side, bool fastTrig)
 {
 	// apex
 	Vector3 apex = Vector3(0.f, 1.f, 0.f);
@@ -900,10 +980,19 @@ Mesh* Mesh::CreateCone(eVertexType type, int base_side)
 	{
 		float first_angle = del_deg * i;
 		float next_angle = del_deg * (i + 1);
-		float first_x = 1.f * CosDegrees(first_angle);
-		float first_z = 1.f * SinDegrees(first_angle);
-		float next_x = 1.f * CosDegrees(next_angle);
-		float next_z = 1.f * SinDegrees(next_angle);
+		float first_x, first_z, next_x, next_z;
+		if (fastTrig)
+		{
+			FastSinCosDegrees(first_angle, first_z, first_x);
+			FastSinCosDegrees(next_angle, next_z, next_x);
+		}
+		else
+		{
+			first_x = 1.f * CosDegrees(first_angle);
+			first_z = 1.f * SinDegrees(first_angle);
+			next_x = 1.f * CosDegrees(next_angle);
+			next_z = 1.f * SinDegrees(next_angle);
+		}
 		Vector3 bottom_vert_0 = Vector3(first_x, 0.f, first_z);
 		Vector3 bottom_vert_1 = Vector3(next_x, 0.f, next_z);
 
@@ -1028,64 +1117,63 @@ Mesh* Mesh::CreateDisc2D(eVertexType type, Rgba color /*= Rgba::WHITE*/)
 
 Mesh* Mesh::CreateDiscImmediate2D(Vector2 center, Rgba tint, float radius, int lineSegNum)
 {
-	MeshBuilder mb;
-	mb.Begin(DRAW_TRIANGLE, true);
-	mb.SetColor(tint);
-
-	float deltaAngle = 360.f / (float)lineSegNum;
-	Vector3 center3D = center.ToVector3(0.f);
-
-	for (int idx = 0; idx < lineSegNum; ++idx)
+	Mesh* mesh = CreateTypedMesh(VERT_PCU, DRAW_TRIANGLE, 3 * lineSegNum, 3 * lineSegNum, [&](auto& mb)
 	{
-		Vector2 startDeviation = Vector2(CosDegrees(idx * deltaAngle), SinDegrees(idx * deltaAngle)) * radius;
-		Vector2 endDeviation = Vector2(CosDegrees((idx + 1) * deltaAngle), SinDegrees((idx + 1) * deltaAngle)) * radius;
+		mb.Begin(DRAW_TRIANGLE, true);
+		mb.SetColor(tint);
 
-		Vector2 start = center + startDeviation;
-		Vector2 end = center + endDeviation;
+		float deltaAngle = 360.f / (float)lineSegNum;
+		Vector3 center3D = center.ToVector3(0.f);
 
-		Vector3 start3D = start.ToVector3(0.f);
-		Vector3 end3D = end.ToVector3(0.f);
+		for (int idx = 0; idx < lineSegNum; ++idx)
+		{
+			Vector2 startDeviation = Vector2(CosDegrees(idx * deltaAngle), SinDegrees(idx * deltaAngle)) * radius;
+			Vector2 endDeviation = Vector2(CosDegrees((idx + 1) * deltaAngle), SinDegrees((idx + 1) * deltaAngle)) * radius;
 
-		mb.SetUV(Vector2(0.f, 0.f));
-		uint vertIdx = mb.PushVertex(center3D);
+			Vector2 start = center + startDeviation;
+			Vector2 end = center + endDeviation;
 
-		mb.SetUV(Vector2(1.f, 0.f));
-		mb.PushVertex(start3D);
+			Vector3 start3D = start.ToVector3(0.f);
+			Vector3 end3D = end.ToVector3(0.f);
 
-		mb.SetUV(Vector2(0.f, 1.f));
-		mb.PushVertex(end3D);
+			mb.SetUV(Vector2(0.f, 0.f));
+			uint vertIdx = mb.PushVertex(center3D);
 
-		mb.AddTriangle(vertIdx + 0, vertIdx + 1, vertIdx + 2);
-	}
+			mb.SetUV(Vector2(1.f, 0.f));
+			mb.PushVertex(start3D);
 
-	mb.End();
+			mb.SetUV(Vector2(0.f, 1.f));
+			mb.PushVertex(end3D);
+
+			mb.AddTriangle(vertIdx + 0, vertIdx + 1, vertIdx + 2);
+		}
 
-	Mesh* mesh = mb.CreateMesh(VERT_PCU, DRAW_TRIANGLE);
+		mb.End();
+	});
 	mesh->m_immediate = true;
 	return mesh;
 }
 
 Mesh* Mesh::CreateLineImmediate2D(const Vector2& start, const Vector2& end, const Rgba& tint, eVertexType type)
 {
-	MeshBuilder mb;
-
-	Vector3 start3 = Vector3(start.x, start.y, 0.f);
-	Vector3 end3 = Vector3(end.x, end.y, 0.f);
-
-	mb.Begin( DRAW_LINE, true );
-	mb.SetColor(tint);
+	Mesh* mesh = CreateTypedMesh(type, DRAW_LINE, 2, 2, [&](auto& mb)
+	{
+		Vector3 start3 = Vector3(start.x, start.y, 0.f);
+		Vector3 end3 = Vector3(end.x, end.y, 0.f);
 
-	mb.SetUV(Vector2(0.f, 0.f));
-	uint idx = mb.PushVertex(start3);
+		mb.Begin( DRAW_LINE, true );
+		mb.SetColor(tint);
 
-	mb.SetUV(Vector2(1.f, 1.f));
-	mb.PushVertex(end3);
+		mb.SetUV(Vector2(0.f, 0.f));
+		uint idx = mb.PushVertex(start3);
 
-	mb.AddLine(idx + 0, idx + 1);
+		mb.SetUV(Vector2(1.f, 1.f));
+		mb.PushVertex(end3);
 
-	mb.End();
+		mb.AddLine(idx + 0, idx + 1);
 
-	Mesh* mesh = mb.CreateMesh(type, DRAW_LINE);
+		mb.End();
+	});
 	mesh->m_immediate = true;
 	return mesh;
 }
@@ -1093,48 +1181,48 @@ Mesh* Mesh::CreateLineImmediate2D(const Vector2& start, const Vector2& end, cons
 Mesh* Mesh::CreateTextImmediate(Rgba color, const Vector2& drawmin, const BitmapFont* font,
 	float cellHeight, float asepctScale, std::string text, eVertexType type)
 {
-	MeshBuilder mb;
-	mb.Begin(DRAW_TRIANGLE, true);
-	mb.SetColor(color);
-
-	// Create and attach new mesh.
-	// We have updated text stored.
-	// Process each character, and create an integrated mesh for it.
-	float cellWidth = cellHeight * (font->GetGlyphAspect() * asepctScale);
-	for (size_t charIdx = 0; charIdx < text.length(); ++charIdx)
+	Mesh* mesh = CreateTypedMesh(type, DRAW_TRIANGLE, 4 * (uint)text.length(), 6 * (uint)text.length(), [&](auto& mb)
 	{
-		const char& character = text.at(charIdx);
-		Vector2 bl = Vector2(drawmin.x + (charIdx * cellWidth), drawmin.y);			// pos is drawmin
-		Vector2 br = Vector2(bl.x + cellWidth, bl.y);
-		Vector2 tl = Vector2(bl.x, bl.y + cellHeight);
-		Vector2 tr = Vector2(bl.x + cellWidth, bl.y + cellHeight);
-
-		AABB2 uvBound = font->GetUVsForGlyph(character);
-		std::vector<Vector2> corners = uvBound.GetCornersFromBLInCounterClockwise();
-		Vector2 uvBL = corners[0];
-		Vector2 uvBR = corners[1];
-		Vector2 uvTL = corners[3];
-		Vector2 uvTR = corners[2];
-
-		// Glyph bl
-		mb.SetUV(uvBL);
-		uint idx = mb.PushVertex(bl.ToVector3(0.f));
-
-		mb.SetUV(uvBR);
-		mb.PushVertex(br.ToVector3(0.f));
-
-		mb.SetUV(uvTL);
-		mb.PushVertex(tl.ToVector3(0.f));
-
-		mb.SetUV(uvTR);
-		mb.PushVertex(tr.ToVector3(0.f));
-
-		mb.AddQuad(idx + 0, idx + 1, idx + 2, idx + 3);
-	}
-
-	mb.End();
+		mb.Begin(DRAW_TRIANGLE, true);
+		mb.SetColor(color);
+
+		// Create and attach new mesh.
+		// We have updated text stored.
+		// Process each character, and create an integrated mesh for it.
+		float cellWidth = cellHeight * (font->GetGlyphAspect() * asepctScale);
+		for (size_t charIdx = 0; charIdx < text.length(); ++charIdx)
+		{
+			const char& character = text.at(charIdx);
+			Vector2 bl = Vector2(drawmin.x + (charIdx * cellWidth), drawmin.y);			// pos is drawmin
+			Vector2 br = Vector2(bl.x + cellWidth, bl.y);
+			Vector2 tl = Vector2(bl.x, bl.y + cellHeight);
+			Vector2 tr = Vector2(bl.x + cellWidth, bl.y + cellHeight);
+
+			AABB2 uvBound = font->GetUVsForGlyph(character);
+			std::vector<Vector2> corners = uvBound.GetCornersFromBLInCounterClockwise();
+			Vector2 uvBL = corners[0];
+			Vector2 uvBR = corners[1];
+			Vector2 uvTL = corners[3];
+			Vector2 uvTR = corners[2];
+
+			// Glyph bl
+			mb.SetUV(uvBL);
+			uint idx = mb.PushVertex(bl.ToVector3(0.f));
+
+			mb.SetUV(uvBR);
+			mb.PushVertex(br.ToVector3(0.f));
+
+			mb.SetUV(uvTL);
+			mb.PushVertex(tl.ToVector3(0.f));
+
+			mb.SetUV(uvTR);
+			mb.PushVertex(tr.ToVector3(0.f));
+
+			mb.AddQuad(idx + 0, idx + 1, idx + 2, idx + 3);
+		}
 
-	Mesh* mesh = mb.CreateMesh(type, DRAW_TRIANGLE);
+		mb.End();
+	});
 	mesh->m_immediate = true;
 	mesh->m_textMesh = true;
 	mesh->m_textMeshColor = color;
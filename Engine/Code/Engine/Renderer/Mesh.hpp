@@ -33,8 +33,9 @@ public:
 	static Mesh* CreateUnitQuadInLine(eVertexType type, const Rgba& color);
 	static Mesh* CreatePolygonImmedidate(eVertexType type, const Vector2& bl, const Vector2& br, const Vector2& tl, const Vector2& tr, Rgba color);
 	static Mesh* CreateCube(eVertexType type);
-	static Mesh* CreateUVSphere( eVertexType type, uint slices, uint wedges );
+	static Mesh* CreateUVSphere( eVertexType type, uint slices, uint wedges, bool fastTrig = false );		// fastTrig: FastMath.hpp sin/cos
 	static Mesh* CreateModel(std::string fp, eVertexType type);
+	static std::vector<Mesh*> CreateModelLODs(std::string fp, eVertexType type);		// coarser meshes of the same model, see TypedMeshBuilder::CreateLODMeshes
 	static Mesh* CreateTextImmediate(Rgba color, const Vector2& drawmin, const BitmapFont* font,
 		float cellHeight, float asepctScale, std::string text, eVertexType type);
 	static Mesh* CreateTerrainImmediateFromSurfacePatch(SurfacePatch* patch, eVertexType type);
@@ -42,7 +43,7 @@ public:
 		const Vector3& v1, const Vector3& v2, const Vector3& v3);
 	static Mesh* CreateTetrahedronImmediate(eVertexType type, const Rgba& color,
 		const Vector3& v1, const Vector3& v2, const Vector3& v3, const Vector3& v4);
-	static Mesh* CreateCone(eVertexType type, int base_side);
+	static Mesh* CreateCone(eVertexType type, int base_side, bool fastTrig = false);
 
 	// 2D
 	static Mesh* CreateQuad2D(eVertexType type, Rgba color = Rgba::WHITE);
@@ -60,6 +61,10 @@ public:
 	template<typename T>
 	void FromBuilder(const MeshBuilder& builder);
 
+	// uploads T as they are and sets layout and counts, see TypedMeshBuilder; indexStride is 2 or 4
+	template<typename T>
+	void FromVertices(const T* vertices, uint vertexCount, const void* indices, uint indexCount, uint indexStride = sizeof(uint));
+
 public:
 	// Attempt in bringing mesh builder into the mesh so that
 	// push to vertex does not happen every frame.
@@ -94,13 +99,25 @@ void Mesh::FromBuilder(const MeshBuilder& builder)
 	size_t isize = sizeof(uint) * builder.GetIndexCount();
 
 	std::vector<T> vertices;
+	vertices.reserve(builder.m_vertices.size());
 	for (std::vector<sVertexBuilder>::size_type vbCount = 0; 
 		vbCount < builder.m_vertices.size(); ++vbCount)
 	{
-		T vt(builder.m_vertices[vbCount]);
-		vertices.push_back(vt);
+		vertices.emplace_back(builder.m_vertices[vbCount]);
 	}
 
-	m_vbo.CopyToGPU( vsize, &vertices[0] );
-	m_ibo.CopyToGPU( isize, &builder.m_indices[0] );
+	m_vbo.CopyToGPU( vsize, vertices.data() );
+	m_ibo.CopyToGPU( isize, builder.m_indices.data() );
+}
+
+template<typename T>
+void Mesh::FromVertices(const T* vertices, uint vertexCount, const void* indices, uint indexCount, uint indexStride)
+{
+	SetLayout(T::s_layout);
+
+	m_vbo.CopyToGPU( sizeof(T) * vertexCount, vertices );
+	m_ibo.CopyToGPU( (size_t)indexStride * indexCount, indices );
+
+	SetVertices( vertexCount, sizeof(T) );
+	SetIndices( indexCount, indexStride );
 }
\ No newline at end of file
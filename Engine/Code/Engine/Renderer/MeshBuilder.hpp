@@ -15,7 +15,7 @@ public:
 	void SetUV( Vector2 const &uv );
 	void SetNormal(Vector3 const &normal);
 	void SetTangent(Vector4 const &tangent);
-	Vector4 CalcTangent(Vector3 edge1, Vector3 edge2, Vector2 uv1, Vector2 uv2);
+	static Vector4 CalcTangent(Vector3 edge1, Vector3 edge2, Vector2 uv1, Vector2 uv2);
 	uint PushVertex( Vector3 position );
 	Mesh* CreateMesh(eVertexType vertType, eDrawPrimitiveType drawType);
 	void AddTriangle(uint idx1, uint idx2, uint idx3);
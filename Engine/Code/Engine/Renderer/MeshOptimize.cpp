@@ -0,0 +1,379 @@
+#include "Engine/Renderer/MeshOptimize.hpp"
+#include "Engine/Math/Vector3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#define MESH_OPT_INVALID 0xffffffffu
+
+// Forsyth, "Linear-Speed Vertex Cache Optimisation"
+#define FORSYTH_CACHE_DECAY_POWER 1.5f
+#define FORSYTH_LAST_TRI_SCORE 0.75f
+#define FORSYTH_VALENCE_BOOST_SCALE 2.f
+#define FORSYTH_VALENCE_BOOST_POWER 0.5f
+#define FORSYTH_MAX_VALENCE 64				// valence scores stop changing much past this
+
+struct sForsythTables
+{
+	float m_cache[MESH_CACHE_LRU_SIZE];
+	float m_valence[FORSYTH_MAX_VALENCE];
+
+	sForsythTables()
+	{
+		for (uint pos = 0; pos < MESH_CACHE_LRU_SIZE; ++pos)
+		{
+			// the last triangle's vertices score the same on purpose, so it is not repeated straight away
+			if (pos < 3)
+				m_cache[pos] = FORSYTH_LAST_TRI_SCORE;
+			else
+				m_cache[pos] = powf(1.f - (float)(pos - 3) / (float)(MESH_CACHE_LRU_SIZE - 3), FORSYTH_CACHE_DECAY_POWER);
+		}
+
+		m_valence[0] = 0.f;
+		for (uint valence = 1; valence < FORSYTH_MAX_VALENCE; ++valence)
+			m_valence[valence] = FORSYTH_VALENCE_BOOST_SCALE * powf((float)valence, -FORSYTH_VALENCE_BOOST_POWER);
+	}
+
+	float GetScore(int cachePos, uint valence) const
+	{
+		// no triangles left to draw with this vertex
+		if (valence == 0)
+			return -1.f;
+
+		float score = (cachePos < 0) ? 0.f : m_cache[cachePos];
+		return score + m_valence[(valence < FORSYTH_MAX_VALENCE) ? valence : (FORSYTH_MAX_VALENCE - 1)];
+	}
+};
+
+static const sForsythTables& GetForsythTables()
+{
+	static const sForsythTables tables;
+	return tables;
+}
+
+sVertexCacheStats AnalyzeVertexCache(const uint* indices, uint indexCount, uint vertexCount, uint cacheSize)
+{
+	sVertexCacheStats stats;
+	if (indexCount < 3)
+		return stats;
+
+	// fifo: a vertex is still cached while fewer than cacheSize others went in after it
+	std::vector<uint> timestamps(vertexCount, 0);
+	uint time = cacheSize + 1;
+	for (uint idx = 0; idx < indexCount; ++idx)
+	{
+		uint vertex = indices[idx];
+		if (time - timestamps[vertex] > cacheSize)
+		{
+			timestamps[vertex] = time++;
+			stats.m_transformed++;
+		}
+	}
+
+	uint referenced = 0;
+	for (uint vertex = 0; vertex < vertexCount; ++vertex)
+		referenced += (timestamps[vertex] != 0) ? 1 : 0;
+
+	stats.m_acmr = (float)stats.m_transformed / (float)(indexCount / 3);
+	stats.m_atvr = (float)stats.m_transformed / (float)referenced;
+	return stats;
+}
+
+void OptimizeVertexCache(uint* indices, uint indexCount, uint vertexCount)
+{
+	const uint triCount = indexCount / 3;
+	if (triCount == 0)
+		return;
+
+	const sForsythTables& tables = GetForsythTables();
+
+	// triangles around each vertex, packed; valence counts the ones not drawn yet and
+	// they are kept at the front of each vertex's run
+	std::vector<uint> valence(vertexCount, 0);
+	for (uint idx = 0; idx < triCount * 3; ++idx)
+		valence[indices[idx]]++;
+
+	std::vector<uint> offsets(vertexCount + 1, 0);
+	for (uint vertex = 0; vertex < vertexCount; ++vertex)
+		offsets[vertex + 1] = offsets[vertex] + valence[vertex];
+
+	std::vector<uint> adjacency(triCount * 3);
+	std::vector<uint> fill(offsets.begin(), offsets.end() - 1);
+	for (uint tri = 0; tri < triCount; ++tri)
+	{
+		for (uint corner = 0; corner < 3; ++corner)
+			adjacency[fill[indices[tri * 3 + corner]]++] = tri;
+	}
+
+	std::vector<int> cachePos(vertexCount, -1);
+	std::vector<float> vertexScore(vertexCount);
+	for (uint vertex = 0; vertex < vertexCount; ++vertex)
+		vertexScore[vertex] = tables.GetScore(-1, valence[vertex]);
+
+	std::vector<float> triScore(triCount);
+	std::vector<unsigned char> emitted(triCount, 0);
+	uint best = 0;
+	for (uint tri = 0; tri < triCount; ++tri)
+	{
+		const uint* corners = indices + tri * 3;
+		triScore[tri] = vertexScore[corners[0]] + vertexScore[corners[1]] + vertexScore[corners[2]];
+		if (triScore[tri] > triScore[best])
+			best = tri;
+	}
+
+	std::vector<uint> output(triCount * 3);
+	uint cache[MESH_CACHE_LRU_SIZE + 3];
+	uint cacheCount = 0;
+	uint scanCursor = 0;
+
+	for (uint outTri = 0; outTri < triCount; ++outTri)
+	{
+		// dead end, nothing in the cache has triangles left: carry on in input order
+		if (best == MESH_OPT_INVALID)
+		{
+			while (emitted[scanCursor])
+				++scanCursor;
+			best = scanCursor;
+		}
+
+		emitted[best] = 1;
+		const uint* corners = indices + best * 3;
+		output[outTri * 3 + 0] = corners[0];
+		output[outTri * 3 + 1] = corners[1];
+		output[outTri * 3 + 2] = corners[2];
+
+		// the triangle leaves the live run of each corner
+		for (uint corner = 0; corner < 3; ++corner)
+		{
+			uint vertex = corners[corner];
+			uint* run = adjacency.data() + offsets[vertex];
+			uint live = valence[vertex];
+			for (uint idx = 0; idx < live; ++idx)
+			{
+				if (run[idx] == best)
+				{
+					run[idx] = run[live - 1];
+					run[live - 1] = best;
+					valence[vertex]--;
+					break;
+				}
+			}
+		}
+
+		// lru: the corners move to the front, everything else shifts back
+		uint newCache[MESH_CACHE_LRU_SIZE + 3];
+		uint newCount = 0;
+		for (uint corner = 0; corner < 3; ++corner)
+		{
+			uint vertex = corners[corner];
+			if (std::find(newCache, newCache + newCount, vertex) == newCache + newCount)
+				newCache[newCount++] = vertex;
+		}
+		for (uint idx = 0; idx < cacheCount; ++idx)
+		{
+			uint vertex = cache[idx];
+			if (vertex != corners[0] && vertex != corners[1] && vertex != corners[2])
+				newCache[newCount++] = vertex;
+		}
+
+		// rescore what is cached and what just fell out, and pass the change on to their triangles
+		for (uint idx = 0; idx < newCount; ++idx)
+		{
+			uint vertex = newCache[idx];
+			cachePos[vertex] = (idx < MESH_CACHE_LRU_SIZE) ? (int)idx : -1;
+
+			float score = tables.GetScore(cachePos[vertex], valence[vertex]);
+			float delta = score - vertexScore[vertex];
+			vertexScore[vertex] = score;
+
+			const uint* run = adjacency.data() + offsets[vertex];
+			for (uint live = 0; live < valence[vertex]; ++live)
+				triScore[run[live]] += delta;
+		}
+
+		cacheCount = (newCount < MESH_CACHE_LRU_SIZE) ? newCount : MESH_CACHE_LRU_SIZE;
+		memcpy(cache, newCache, cacheCount * sizeof(uint));
+
+		best = MESH_OPT_INVALID;
+		float bestScore = -1.f;
+		for (uint idx = 0; idx < cacheCount; ++idx)
+		{
+			uint vertex = cache[idx];
+			const uint* run = adjacency.data() + offsets[vertex];
+			for (uint live = 0; live < valence[vertex]; ++live)
+			{
+				uint tri = run[live];
+				if (triScore[tri] > bestScore)
+				{
+					bestScore = triScore[tri];
+					best = tri;
+				}
+			}
+		}
+	}
+
+	memcpy(indices, output.data(), output.size() * sizeof(uint));
+}
+
+static Vector3 GetOptimizePosition(const void* vertices, uint vertexStride, uint vertex)
+{
+	float position[3];
+	memcpy(position, (const unsigned char*)vertices + (size_t)vertex * vertexStride, sizeof(position));
+	return Vector3(position[0], position[1], position[2]);
+}
+
+struct sOverdrawCluster
+{
+	uint m_first;
+	uint m_count;
+	float m_sortKey;
+};
+
+static void SplitOverdrawClusters(const uint* indices, uint triCount, uint vertexCount, float softLimit, std::vector<sOverdrawCluster>& clusters)
+{
+	// cluster boundaries: hard where the cache order jumped (a triangle misses all its corners),
+	// soft where the cluster so far transforms no more than softLimit per triangle, so drawing it
+	// elsewhere loses little reuse; a softLimit of 0 leaves only the hard ones
+	std::vector<uint> timestamps(vertexCount, 0);
+	uint time = MESH_CACHE_FIFO_SIZE + 1;
+	uint clusterMisses = 0;
+	uint clusterTris = 0;
+
+	clusters.clear();
+	for (uint tri = 0; tri < triCount; ++tri)
+	{
+		uint misses = 0;
+		for (uint corner = 0; corner < 3; ++corner)
+		{
+			uint vertex = indices[tri * 3 + corner];
+			if (time - timestamps[vertex] > MESH_CACHE_FIFO_SIZE)
+			{
+				timestamps[vertex] = time++;
+				misses++;
+			}
+		}
+
+		bool soft = (clusterTris > 0) && ((float)clusterMisses <= softLimit * (float)clusterTris);
+		if (clusters.empty() || misses == 3 || soft)
+		{
+			sOverdrawCluster cluster;
+			cluster.m_first = tri;
+			cluster.m_count = 0;
+			cluster.m_sortKey = 0.f;
+			clusters.push_back(cluster);
+			clusterMisses = 0;
+			clusterTris = 0;
+		}
+
+		clusters.back().m_count++;
+		clusterMisses += misses;
+		clusterTris++;
+	}
+}
+
+static void SortOverdrawClusters(const uint* indices, const void* vertices, uint vertexStride, std::vector<sOverdrawCluster>& clusters, std::vector<uint>& output)
+{
+	// view independent occlusion guess: clusters far out from the middle and facing away from it
+	// cover the rest from most directions, so they go first
+	std::vector<Vector3> centroids(clusters.size());
+	std::vector<Vector3> normals(clusters.size());
+	Vector3 meshCentroid = Vector3::ZERO;
+	float meshArea = 0.f;
+	for (size_t idx = 0; idx < clusters.size(); ++idx)
+	{
+		Vector3 centroid = Vector3::ZERO;
+		Vector3 normal = Vector3::ZERO;
+		float area = 0.f;
+		for (uint tri = clusters[idx].m_first; tri < clusters[idx].m_first + clusters[idx].m_count; ++tri)
+		{
+			Vector3 p0 = GetOptimizePosition(vertices, vertexStride, indices[tri * 3 + 0]);
+			Vector3 p1 = GetOptimizePosition(vertices, vertexStride, indices[tri * 3 + 1]);
+			Vector3 p2 = GetOptimizePosition(vertices, vertexStride, indices[tri * 3 + 2]);
+
+			Vector3 cross = (p1 - p0).Cross(p2 - p0);
+			float triArea = cross.GetLength();
+			centroid += (p0 + p1 + p2) * (triArea / 3.f);
+			normal += cross;
+			area += triArea;
+		}
+
+		meshCentroid += centroid;
+		meshArea += area;
+		centroids[idx] = (area > 0.f) ? (centroid * (1.f / area)) : centroid;
+		normals[idx] = normal;
+	}
+	if (meshArea > 0.f)
+		meshCentroid = meshCentroid * (1.f / meshArea);
+
+	for (size_t idx = 0; idx < clusters.size(); ++idx)
+	{
+		float length = normals[idx].GetLength();
+		clusters[idx].m_sortKey = (length > 0.f) ? (DotProduct(centroids[idx] - meshCentroid, normals[idx]) / length) : 0.f;
+	}
+
+	std::stable_sort(clusters.begin(), clusters.end(), [](const sOverdrawCluster& a, const sOverdrawCluster& b)
+	{
+		return a.m_sortKey > b.m_sortKey;
+	});
+
+	output.clear();
+	for (const sOverdrawCluster& cluster : clusters)
+		output.insert(output.end(), indices + cluster.m_first * 3, indices + (cluster.m_first + cluster.m_count) * 3);
+}
+
+void OptimizeOverdraw(uint* indices, uint indexCount, const void* vertices, uint vertexCount, uint vertexStride, float threshold)
+{
+	const uint triCount = indexCount / 3;
+	if (triCount == 0)
+		return;
+
+	// the soft splits only estimate what a cluster loses, so every order is measured against the
+	// budget; when soft clusters cost too much only the hard ones are tried, and when those do too
+	// the cache order is kept
+	const float acmr = AnalyzeVertexCache(indices, indexCount, vertexCount).m_acmr;
+	const float budget = threshold * acmr;
+
+	std::vector<sOverdrawCluster> clusters;
+	std::vector<uint> output;
+	output.reserve(triCount * 3);
+
+	const float softLimits[] = { budget, 0.f };
+	for (float softLimit : softLimits)
+	{
+		SplitOverdrawClusters(indices, triCount, vertexCount, softLimit, clusters);
+		if (clusters.size() < 2)
+			continue;
+
+		SortOverdrawClusters(indices, vertices, vertexStride, clusters, output);
+		if (AnalyzeVertexCache(output.data(), triCount * 3, vertexCount).m_acmr <= budget)
+		{
+			memcpy(indices, output.data(), output.size() * sizeof(uint));
+			return;
+		}
+	}
+}
+
+uint OptimizeVertexFetch(void* vertices, uint vertexCount, uint vertexStride, uint* indices, uint indexCount)
+{
+	std::vector<uint> remap(vertexCount, MESH_OPT_INVALID);
+	uint kept = 0;
+	for (uint idx = 0; idx < indexCount; ++idx)
+	{
+		uint& vertex = indices[idx];
+		if (remap[vertex] == MESH_OPT_INVALID)
+			remap[vertex] = kept++;
+		vertex = remap[vertex];
+	}
+
+	unsigned char* data = (unsigned char*)vertices;
+	std::vector<unsigned char> reordered((size_t)kept * vertexStride);
+	for (uint vertex = 0; vertex < vertexCount; ++vertex)
+	{
+		if (remap[vertex] != MESH_OPT_INVALID)
+			memcpy(reordered.data() + (size_t)remap[vertex] * vertexStride, data + (size_t)vertex * vertexStride, vertexStride);
+	}
+
+	memcpy(data, reordered.data(), reordered.size());
+	return kept;
+}
\ No newline at end of file
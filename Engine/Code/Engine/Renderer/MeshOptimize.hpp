@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Engine/Core/EngineCommon.hpp"
+
+#define MESH_CACHE_LRU_SIZE 32				// cache the Forsyth scores model
+#define MESH_CACHE_FIFO_SIZE 16				// post transform cache AnalyzeVertexCache simulates by default
+#define MESH_OVERDRAW_THRESHOLD 1.05f		// measured ACMR the reordered clusters may cost over the cache optimized order
+
+/*
+ * Index and vertex reordering for triangle lists, run after welding (MeshWeld.hpp):
+ *	OptimizeVertexCache	Forsyth's greedy order, so neighbouring triangles reuse transformed vertices
+ *	OptimizeOverdraw	splits the cache order into clusters and draws outward facing clusters first
+ *						for less overdraw from any view; an order costing more than threshold times
+ *						the ACMR it was given is dropped, so some meshes keep the cache order
+ *	OptimizeVertexFetch	stores vertices in the order the indices first use them and drops unused ones
+ * Run them in that order. AnalyzeVertexCache reports ACMR (vertices transformed per triangle,
+ * 0.5 is the ideal for a large grid, 3 the worst) and ATVR (per vertex, 1 is the ideal).
+ */
+
+struct sVertexCacheStats
+{
+	uint m_transformed = 0;
+	float m_acmr = 0.f;
+	float m_atvr = 0.f;
+};
+
+sVertexCacheStats AnalyzeVertexCache(const uint* indices, uint indexCount, uint vertexCount, uint cacheSize = MESH_CACHE_FIFO_SIZE);
+
+void OptimizeVertexCache(uint* indices, uint indexCount, uint vertexCount);
+
+// positions are the first 3 floats of each vertex, vertexStride bytes apart
+void OptimizeOverdraw(uint* indices, uint indexCount, const void* vertices, uint vertexCount, uint vertexStride, float threshold = MESH_OVERDRAW_THRESHOLD);
+
+// reorders vertices in place and rewrites indices; returns the vertex count that is left
+uint OptimizeVertexFetch(void* vertices, uint vertexCount, uint vertexStride, uint* indices, uint indexCount);
\ No newline at end of file
@@ -0,0 +1,458 @@
+#include "Engine/Renderer/MeshSimplify.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#define SIMPLIFY_INVALID 0xffffffffu
+#define SIMPLIFY_PASS_FRACTION 3		// a pass takes at most the cheapest third of the collapses on offer
+#define SIMPLIFY_FLIP_COS .25			// a surviving triangle may turn by up to about 75 degrees per collapse
+#define SIMPLIFY_DRIFT_COS 0.			// and by less than 90 degrees from the way it faced in the input, however many collapses it takes
+
+struct sQuadric
+{
+	double m_a00 = 0.0, m_a11 = 0.0, m_a22 = 0.0;
+	double m_a10 = 0.0, m_a20 = 0.0, m_a21 = 0.0;
+	double m_b0 = 0.0, m_b1 = 0.0, m_b2 = 0.0;
+	double m_c = 0.0;
+
+	void AddPlane(const double normal[3], double d, double weight)
+	{
+		m_a00 += weight * normal[0] * normal[0];
+		m_a11 += weight * normal[1] * normal[1];
+		m_a22 += weight * normal[2] * normal[2];
+		m_a10 += weight * normal[1] * normal[0];
+		m_a20 += weight * normal[2] * normal[0];
+		m_a21 += weight * normal[2] * normal[1];
+		m_b0 += weight * normal[0] * d;
+		m_b1 += weight * normal[1] * d;
+		m_b2 += weight * normal[2] * d;
+		m_c += weight * d * d;
+	}
+
+	void Add(const sQuadric& other)
+	{
+		m_a00 += other.m_a00; m_a11 += other.m_a11; m_a22 += other.m_a22;
+		m_a10 += other.m_a10; m_a20 += other.m_a20; m_a21 += other.m_a21;
+		m_b0 += other.m_b0; m_b1 += other.m_b1; m_b2 += other.m_b2;
+		m_c += other.m_c;
+	}
+
+	// sum of weight * (n.p + d)^2 over the planes
+	double Evaluate(const double p[3]) const
+	{
+		double rx = m_a00 * p[0] + m_a10 * p[1] + m_a20 * p[2];
+		double ry = m_a10 * p[0] + m_a11 * p[1] + m_a21 * p[2];
+		double rz = m_a20 * p[0] + m_a21 * p[1] + m_a22 * p[2];
+		double value = rx * p[0] + ry * p[1] + rz * p[2] + 2.0 * (m_b0 * p[0] + m_b1 * p[1] + m_b2 * p[2]) + m_c;
+		return (value > 0.0) ? value : 0.0;
+	}
+};
+
+struct sCollapse
+{
+	uint m_from;
+	uint m_to;
+	double m_cost;
+};
+
+static void GetTriangleCross(const double* a, const double* b, const double* c, double cross[3])
+{
+	double e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+	double e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+	cross[0] = e1[1] * e2[2] - e1[2] * e2[1];
+	cross[1] = e1[2] * e2[0] - e1[0] * e2[2];
+	cross[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+static inline unsigned long long GetEdgeKey(uint from, uint to)
+{
+	return ((unsigned long long)from << 32) | to;
+}
+
+// canonical[v] is the first vertex at the same position, wedges[c] how many share it
+static void GroupPositions(const std::vector<double>& positions, uint vertexCount, std::vector<uint>& canonical, std::vector<uint>& wedges)
+{
+	std::vector<uint> order(vertexCount);
+	for (uint vertex = 0; vertex < vertexCount; ++vertex)
+		order[vertex] = vertex;
+
+	std::sort(order.begin(), order.end(), [&](uint a, uint b)
+	{
+		const double* pa = &positions[a * 3];
+		const double* pb = &positions[b * 3];
+		if (pa[0] != pb[0]) return pa[0] < pb[0];
+		if (pa[1] != pb[1]) return pa[1] < pb[1];
+		if (pa[2] != pb[2]) return pa[2] < pb[2];
+		return a < b;
+	});
+
+	canonical.assign(vertexCount, 0);
+	wedges.assign(vertexCount, 0);
+	for (uint idx = 0; idx < vertexCount; ++idx)
+	{
+		uint vertex = order[idx];
+		uint first = vertex;
+		if (idx > 0)
+		{
+			uint prev = order[idx - 1];
+			if (positions[prev * 3] == positions[vertex * 3] && positions[prev * 3 + 1] == positions[vertex * 3 + 1]
+				&& positions[prev * 3 + 2] == positions[vertex * 3 + 2])
+				first = canonical[prev];
+		}
+		canonical[vertex] = first;
+		wedges[first]++;
+	}
+}
+
+uint SimplifyMesh(const VertexLayout& layout, const void* vertices, uint vertexCount, const uint* indices, uint indexCount,
+	uint targetIndexCount, float maxError, uint* outIndices, float* outError)
+{
+	ASSERT_OR_DIE(indexCount % 3 == 0, "simplify needs an indexed triangle list");
+	ASSERT_OR_DIE(layout.GetAttributeCount() > 0 && layout.m_attributes[0].m_type == RT_FLOAT, "simplify needs a float position first");
+
+	if (outIndices != indices)
+		memcpy(outIndices, indices, (size_t)indexCount * sizeof(uint));
+	if (outError != nullptr)
+		*outError = 0.f;
+	if (indexCount <= targetIndexCount || vertexCount == 0)
+		return indexCount;
+
+	const unsigned char* data = (const unsigned char*)vertices;
+	const uint stride = (uint)layout.m_stride;
+
+	// positions scaled into the unit box so errors read as fractions of the mesh extent
+	std::vector<double> positions((size_t)vertexCount * 3);
+	double lo[3] = { 1e30, 1e30, 1e30 };
+	double hi[3] = { -1e30, -1e30, -1e30 };
+	for (uint vertex = 0; vertex < vertexCount; ++vertex)
+	{
+		float position[3];
+		memcpy(position, data + (size_t)vertex * stride + layout.m_attributes[0].m_memberOffset, sizeof(position));
+		for (uint axis = 0; axis < 3; ++axis)
+		{
+			positions[vertex * 3 + axis] = position[axis];
+			lo[axis] = std::min(lo[axis], (double)position[axis]);
+			hi[axis] = std::max(hi[axis], (double)position[axis]);
+		}
+	}
+	double extent = std::max(hi[0] - lo[0], std::max(hi[1] - lo[1], hi[2] - lo[2]));
+	double scale = (extent > 0.0) ? (1.0 / extent) : 1.0;
+	for (uint vertex = 0; vertex < vertexCount; ++vertex)
+	{
+		for (uint axis = 0; axis < 3; ++axis)
+			positions[vertex * 3 + axis] = (positions[vertex * 3 + axis] - lo[axis]) * scale;
+	}
+
+	// everything after the position, bytes (colors) brought to 0..1
+	uint attributeCount = 0;
+	for (int idx = 1; idx < layout.GetAttributeCount(); ++idx)
+		attributeCount += (uint)layout.m_attributes[idx].m_elementCount;
+	std::vector<float> attributes((size_t)vertexCount * attributeCount);
+	for (uint vertex = 0; vertex < vertexCount; ++vertex)
+	{
+		const unsigned char* src = data + (size_t)vertex * stride;
+		float* dst = attributes.data() + (size_t)vertex * attributeCount;
+		for (int idx = 1; idx < layout.GetAttributeCount(); ++idx)
+		{
+			const VertexAttribute& attribute = layout.m_attributes[idx];
+			for (int element = 0; element < attribute.m_elementCount; ++element)
+			{
+				if (attribute.m_type == RT_FLOAT)
+					memcpy(dst, src + attribute.m_memberOffset + element * sizeof(float), sizeof(float));
+				else
+					*dst = src[attribute.m_memberOffset + element] / 255.f;
+				++dst;
+			}
+		}
+	}
+
+	std::vector<uint> canonical;
+	std::vector<uint> wedges;
+	GroupPositions(positions, vertexCount, canonical, wedges);
+
+	// quadrics and areas live on positions, so every wedge of a seam sees the same surface
+	uint triCount = indexCount / 3;
+	std::vector<sQuadric> quadrics(vertexCount);
+	std::vector<double> areas(vertexCount, 0.0);
+	std::vector<double> facing((size_t)triCount * 3, 0.0);		// unit normal each triangle had in the input, kept in step with outIndices
+	std::unordered_map<unsigned long long, uint> edgeUses;
+	edgeUses.reserve(indexCount);
+	for (uint tri = 0; tri < triCount; ++tri)
+	{
+		const uint* corners = outIndices + tri * 3;
+		double cross[3];
+		GetTriangleCross(&positions[corners[0] * 3], &positions[corners[1] * 3], &positions[corners[2] * 3], cross);
+
+		double length = sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+		if (length > 0.0)
+		{
+			double normal[3] = { cross[0] / length, cross[1] / length, cross[2] / length };
+			memcpy(&facing[tri * 3], normal, sizeof(normal));
+			const double* p0 = &positions[corners[0] * 3];
+			double d = -(normal[0] * p0[0] + normal[1] * p0[1] + normal[2] * p0[2]);
+			for (uint corner = 0; corner < 3; ++corner)
+			{
+				uint group = canonical[corners[corner]];
+				quadrics[group].AddPlane(normal, d, length * .5);
+				areas[group] += length / 6.0;
+			}
+		}
+
+		for (uint corner = 0; corner < 3; ++corner)
+			edgeUses[GetEdgeKey(canonical[corners[corner]], canonical[corners[(corner + 1) % 3]])]++;
+	}
+
+	// a vertex may move only if it is the sole wedge at its position and every edge around it
+	// is shared by exactly two triangles winding opposite ways
+	std::vector<unsigned char> locked(vertexCount, 0);
+	for (uint tri = 0; tri < triCount; ++tri)
+	{
+		const uint* corners = outIndices + tri * 3;
+		for (uint corner = 0; corner < 3; ++corner)
+		{
+			uint from = canonical[corners[corner]];
+			uint to = canonical[corners[(corner + 1) % 3]];
+			auto forward = edgeUses.find(GetEdgeKey(from, to));
+			auto backward = edgeUses.find(GetEdgeKey(to, from));
+			if (forward->second != 1 || backward == edgeUses.end() || backward->second != 1)
+			{
+				locked[from] = 1;
+				locked[to] = 1;
+			}
+		}
+	}
+	for (uint vertex = 0; vertex < vertexCount; ++vertex)
+	{
+		if (wedges[canonical[vertex]] > 1)
+			locked[canonical[vertex]] = 1;
+	}
+	edgeUses.clear();
+
+	// the wedges at each position, so a collapse onto a seam sees the whole fan there
+	std::vector<uint> wedgeOffsets(vertexCount + 1, 0);
+	for (uint vertex = 0; vertex < vertexCount; ++vertex)
+		wedgeOffsets[canonical[vertex] + 1]++;
+	for (uint vertex = 0; vertex < vertexCount; ++vertex)
+		wedgeOffsets[vertex + 1] += wedgeOffsets[vertex];
+	std::vector<uint> wedgeList(vertexCount);
+	std::vector<uint> wedgeFill(wedgeOffsets.begin(), wedgeOffsets.end() - 1);
+	for (uint vertex = 0; vertex < vertexCount; ++vertex)
+		wedgeList[wedgeFill[canonical[vertex]]++] = vertex;
+
+	const uint targetTris = targetIndexCount / 3;
+	const double maxCost = (double)maxError * (double)maxError;
+	double worstError = 0.0;
+
+	std::vector<uint> valence(vertexCount);
+	std::vector<uint> offsets(vertexCount + 1);
+	std::vector<uint> adjacency;
+	std::vector<uint> remap(vertexCount);
+	std::vector<unsigned char> touched(vertexCount);
+	std::vector<sCollapse> collapses;
+	std::vector<uint> ringFrom;
+	std::vector<uint> ringTo;
+
+	while (triCount > targetTris)
+	{
+		// triangles around each vertex
+		std::fill(valence.begin(), valence.end(), 0);
+		for (uint idx = 0; idx < triCount * 3; ++idx)
+			valence[outIndices[idx]]++;
+		offsets[0] = 0;
+		for (uint vertex = 0; vertex < vertexCount; ++vertex)
+			offsets[vertex + 1] = offsets[vertex] + valence[vertex];
+		adjacency.resize(triCount * 3);
+		std::fill(valence.begin(), valence.end(), 0);
+		for (uint tri = 0; tri < triCount; ++tri)
+		{
+			for (uint corner = 0; corner < 3; ++corner)
+			{
+				uint vertex = outIndices[tri * 3 + corner];
+				adjacency[offsets[vertex] + valence[vertex]++] = tri;
+			}
+		}
+
+		// cheapest way out for every vertex that may move
+		collapses.clear();
+		for (uint from = 0; from < vertexCount; ++from)
+		{
+			if (valence[from] == 0 || locked[canonical[from]])
+				continue;
+
+			sCollapse best = { from, SIMPLIFY_INVALID, 0.0 };
+			for (uint live = 0; live < valence[from]; ++live)
+			{
+				const uint* corners = outIndices + adjacency[offsets[from] + live] * 3;
+				for (uint corner = 0; corner < 3; ++corner)
+				{
+					uint to = corners[corner];
+					if (to == from)
+						continue;
+
+					sQuadric quadric = quadrics[from];
+					quadric.Add(quadrics[canonical[to]]);
+					double cost = quadric.Evaluate(&positions[to * 3]);
+
+					const float* attrFrom = attributes.data() + (size_t)from * attributeCount;
+					const float* attrTo = attributes.data() + (size_t)to * attributeCount;
+					double attributeError = 0.0;
+					for (uint element = 0; element < attributeCount; ++element)
+					{
+						double diff = attrFrom[element] - attrTo[element];
+						attributeError += diff * diff;
+					}
+					cost += MESH_SIMPLIFY_ATTRIBUTE_WEIGHT * areas[from] * attributeError;
+
+					// per unit of area, so the limit reads as a squared distance whatever the tessellation
+					double area = areas[from] + areas[canonical[to]];
+					cost = (area > 0.0) ? (cost / area) : cost;
+					if (best.m_to == SIMPLIFY_INVALID || cost < best.m_cost)
+					{
+						best.m_to = to;
+						best.m_cost = cost;
+					}
+				}
+			}
+
+			if (best.m_to != SIMPLIFY_INVALID && best.m_cost <= maxCost)
+				collapses.push_back(best);
+		}
+		if (collapses.empty())
+			break;
+
+		std::sort(collapses.begin(), collapses.end(), [](const sCollapse& a, const sCollapse& b)
+		{
+			return a.m_cost < b.m_cost;
+		});
+
+		// each collapse takes two triangles away; a pass leaves the rest for later so cheap
+		// collapses made possible by this one get their turn first
+		uint wanted = (triCount - targetTris + 1) / 2;
+		uint limit = std::min(wanted, (uint)collapses.size() / SIMPLIFY_PASS_FRACTION + 1);
+
+		for (uint vertex = 0; vertex < vertexCount; ++vertex)
+			remap[vertex] = vertex;
+		std::fill(touched.begin(), touched.end(), 0);
+
+		uint applied = 0;
+		for (size_t idx = 0; idx < collapses.size() && applied < limit; ++idx)
+		{
+			const sCollapse& collapse = collapses[idx];
+			const uint from = collapse.m_from;
+			const uint to = collapse.m_to;
+
+			// adjacency of both ends has to be what this pass saw
+			if (touched[canonical[from]] || touched[canonical[to]])
+				continue;
+
+			// link condition: on a closed fan the two ends share exactly the two opposite corners
+			ringFrom.clear();
+			ringTo.clear();
+			for (uint live = 0; live < valence[from]; ++live)
+			{
+				const uint* corners = outIndices + adjacency[offsets[from] + live] * 3;
+				for (uint corner = 0; corner < 3; ++corner)
+					ringFrom.push_back(canonical[corners[corner]]);
+			}
+			const uint group = canonical[to];
+			for (uint wedge = wedgeOffsets[group]; wedge < wedgeOffsets[group + 1]; ++wedge)
+			{
+				uint vertex = wedgeList[wedge];
+				for (uint live = 0; live < valence[vertex]; ++live)
+				{
+					const uint* corners = outIndices + adjacency[offsets[vertex] + live] * 3;
+					for (uint corner = 0; corner < 3; ++corner)
+						ringTo.push_back(canonical[corners[corner]]);
+				}
+			}
+			std::sort(ringFrom.begin(), ringFrom.end());
+			ringFrom.erase(std::unique(ringFrom.begin(), ringFrom.end()), ringFrom.end());
+			std::sort(ringTo.begin(), ringTo.end());
+			ringTo.erase(std::unique(ringTo.begin(), ringTo.end()), ringTo.end());
+
+			uint shared = 0;
+			for (uint vertex : ringFrom)
+			{
+				if (vertex != canonical[from] && vertex != canonical[to] && std::binary_search(ringTo.begin(), ringTo.end(), vertex))
+					shared++;
+			}
+			if (shared != 2)
+				continue;
+
+			// no triangle that survives may turn over, neither in one collapse nor by adding up small turns
+			bool flips = false;
+			for (uint live = 0; live < valence[from] && !flips; ++live)
+			{
+				const uint tri = adjacency[offsets[from] + live];
+				const uint* corners = outIndices + tri * 3;
+				if (corners[0] == to || corners[1] == to || corners[2] == to)
+					continue;
+
+				const double* before[3];
+				const double* after[3];
+				for (uint corner = 0; corner < 3; ++corner)
+				{
+					before[corner] = &positions[corners[corner] * 3];
+					after[corner] = (corners[corner] == from) ? &positions[to * 3] : before[corner];
+				}
+
+				double crossBefore[3];
+				double crossAfter[3];
+				GetTriangleCross(before[0], before[1], before[2], crossBefore);
+				GetTriangleCross(after[0], after[1], after[2], crossAfter);
+				double dot = crossBefore[0] * crossAfter[0] + crossBefore[1] * crossAfter[1] + crossBefore[2] * crossAfter[2];
+				double lengths = sqrt((crossBefore[0] * crossBefore[0] + crossBefore[1] * crossBefore[1] + crossBefore[2] * crossBefore[2])
+					* (crossAfter[0] * crossAfter[0] + crossAfter[1] * crossAfter[1] + crossAfter[2] * crossAfter[2]));
+				flips = !(dot > SIMPLIFY_FLIP_COS * lengths);
+
+				// triangles without area in the input have no facing to keep
+				const double* normal = &facing[tri * 3];
+				if (normal[0] != 0.0 || normal[1] != 0.0 || normal[2] != 0.0)
+				{
+					double lengthAfter = sqrt(crossAfter[0] * crossAfter[0] + crossAfter[1] * crossAfter[1] + crossAfter[2] * crossAfter[2]);
+					double drift = normal[0] * crossAfter[0] + normal[1] * crossAfter[1] + normal[2] * crossAfter[2];
+					flips = flips || !(drift > SIMPLIFY_DRIFT_COS * lengthAfter);
+				}
+			}
+			if (flips)
+				continue;
+
+			remap[from] = to;
+			quadrics[canonical[to]].Add(quadrics[from]);
+			areas[canonical[to]] += areas[from];
+			worstError = std::max(worstError, collapse.m_cost);
+			applied++;
+
+			for (uint vertex : ringFrom)
+				touched[vertex] = 1;
+			for (uint vertex : ringTo)
+				touched[vertex] = 1;
+		}
+		if (applied == 0)
+			break;
+
+		// rewrite, dropping the triangles that lost their area
+		uint kept = 0;
+		for (uint tri = 0; tri < triCount; ++tri)
+		{
+			uint a = remap[outIndices[tri * 3 + 0]];
+			uint b = remap[outIndices[tri * 3 + 1]];
+			uint c = remap[outIndices[tri * 3 + 2]];
+			if (canonical[a] == canonical[b] || canonical[b] == canonical[c] || canonical[a] == canonical[c])
+				continue;
+
+			outIndices[kept * 3 + 0] = a;
+			outIndices[kept * 3 + 1] = b;
+			outIndices[kept * 3 + 2] = c;
+			memmove(&facing[kept * 3], &facing[tri * 3], 3 * sizeof(double));
+			kept++;
+		}
+		triCount = kept;
+	}
+
+	if (outError != nullptr)
+		*outError = (float)sqrt(worstError);
+	return triCount * 3;
+}
\ No newline at end of file
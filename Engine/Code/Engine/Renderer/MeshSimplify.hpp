@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Engine/Core/Vertex.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#define MESH_SIMPLIFY_ANY_ERROR 1.f				// error is relative to the mesh extent, so 1 never stops a collapse
+#define MESH_SIMPLIFY_ATTRIBUTE_WEIGHT 0.1f		// squared uv/normal/color difference against squared relative distance
+
+/*
+ * Edge collapse simplification with quadric error metrics (Garland and Heckbert) for indexed
+ * triangle lists, usually welded (MeshWeld.hpp) first. Each collapse moves a vertex onto a
+ * neighbour and costs the area weighted squared distance to the planes it has absorbed, plus
+ * the area weighted attribute difference (every layout attribute after the position) to the
+ * neighbour it disappears into, so creases in normals and uv stretch cost as much as shape.
+ * Vertices on borders, non manifold edges and attribute seams (positions shared by several
+ * vertices) never move, so seams and outlines stay watertight; collapses that would flip a
+ * triangle (against the previous step or against how it faced in the input) or pinch the surface
+ * are skipped.
+ */
+
+// writes the simplified triangle list to outIndices (indexCount is enough, may alias indices) and
+// returns its index count; stops at targetIndexCount or when every collapse left would cost more
+// than maxError. Vertices are left alone, OptimizeVertexFetch drops the ones no longer used.
+// outError gets the largest error taken, relative to the mesh extent
+uint SimplifyMesh(const VertexLayout& layout, const void* vertices, uint vertexCount, const uint* indices, uint indexCount,
+	uint targetIndexCount, float maxError, uint* outIndices, float* outError = nullptr);
\ No newline at end of file
@@ -0,0 +1,256 @@
+#include "Engine/Renderer/MeshWeld.hpp"
+#include "Engine/Math/RawNoise.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <cmath>
+#include <vector>
+
+#define WELD_INVALID 0xffffffffu
+
+struct sWeldAttribute
+{
+	uint m_offset;
+	uint m_count;
+	bool m_isFloat;
+};
+
+static std::vector<sWeldAttribute> GetWeldAttributes(const VertexLayout& layout)
+{
+	std::vector<sWeldAttribute> attributes;
+	for (int idx = 0; idx < layout.GetAttributeCount(); ++idx)
+	{
+		const VertexAttribute& attribute = layout.m_attributes[idx];
+		if (attribute.m_handle == "TANGENT")
+			continue;
+
+		sWeldAttribute weld;
+		weld.m_offset = (uint)attribute.m_memberOffset;
+		weld.m_count = (uint)attribute.m_elementCount;
+		weld.m_isFloat = (attribute.m_type == RT_FLOAT);
+		attributes.push_back(weld);
+	}
+	return attributes;
+}
+
+static inline float ReadWeldFloat(const unsigned char* vertex, uint offset, uint element)
+{
+	float value;
+	memcpy(&value, vertex + offset + element * sizeof(float), sizeof(float));
+	return value;
+}
+
+static uint HashWeldVertex(const std::vector<sWeldAttribute>& attributes, const unsigned char* vertex)
+{
+	unsigned int bits = 2166136261u;
+	for (const sWeldAttribute& attribute : attributes)
+	{
+		for (uint element = 0; element < attribute.m_count; ++element)
+		{
+			int word;
+			if (attribute.m_isFloat)
+			{
+				// + 0 turns -0 into 0 so both land in one bucket
+				float value = ReadWeldFloat(vertex, attribute.m_offset, element) + 0.f;
+				memcpy(&word, &value, sizeof(int));
+			}
+			else
+				word = vertex[attribute.m_offset + element];
+
+			// fnv-1a a word at a time, squirrel noise per element costs more than the rest of the weld
+			bits = (bits ^ (unsigned int)word) * 16777619u;
+		}
+	}
+	return bits ^ (bits >> 15);
+}
+
+static bool IsWeldMatch(const std::vector<sWeldAttribute>& attributes, const unsigned char* a, const unsigned char* b, float epsilon)
+{
+	for (const sWeldAttribute& attribute : attributes)
+	{
+		for (uint element = 0; element < attribute.m_count; ++element)
+		{
+			if (attribute.m_isFloat)
+			{
+				float diff = fabsf(ReadWeldFloat(a, attribute.m_offset, element) - ReadWeldFloat(b, attribute.m_offset, element));
+				if (!(diff <= epsilon))
+					return false;
+			}
+			else if (a[attribute.m_offset + element] != b[attribute.m_offset + element])
+				return false;
+		}
+	}
+	return true;
+}
+
+static const VertexAttribute* FindWeldAttribute(const VertexLayout& layout, const char* handle)
+{
+	for (const VertexAttribute& attribute : layout.m_attributes)
+	{
+		if (attribute.m_handle == handle && attribute.m_type == RT_FLOAT && attribute.m_elementCount >= 3)
+			return &attribute;
+	}
+	return nullptr;
+}
+
+static inline Vector3 ReadWeldVector3(const unsigned char* vertex, const VertexAttribute& attribute)
+{
+	Vector3 value;
+	memcpy(&value, vertex + attribute.m_memberOffset, sizeof(Vector3));
+	return value;
+}
+
+// kept vertices get the sum of their group's tangents, orthogonal to their normal and unit length;
+// w stays that of the first vertex. Faces with degenerate uvs give no (or infinite) tangents and are
+// left out, a vertex left with nothing takes any direction orthogonal to its normal
+static void AverageWeldedTangents(const VertexLayout& layout, const unsigned char* src, uint vertexCount, const uint* remap,
+	unsigned char* dst, uint kept)
+{
+	const VertexAttribute* tangent = FindWeldAttribute(layout, "TANGENT");
+	const VertexAttribute* normal = FindWeldAttribute(layout, "NORMAL");
+	if (tangent == nullptr)
+		return;
+
+	const uint stride = (uint)layout.m_stride;
+	std::vector<Vector3> sums(kept, Vector3::ZERO);
+	for (uint idx = 0; idx < vertexCount; ++idx)
+	{
+		Vector3 face = ReadWeldVector3(src + (size_t)idx * stride, *tangent);
+		if (std::isfinite(face.x) && std::isfinite(face.y) && std::isfinite(face.z))
+			sums[remap[idx]] += face;
+	}
+
+	for (uint idx = 0; idx < kept; ++idx)
+	{
+		unsigned char* vertex = dst + (size_t)idx * stride;
+		Vector3 sum = sums[idx];
+		Vector3 n = Vector3::ZERO;
+		if (normal != nullptr)
+		{
+			n = ReadWeldVector3(vertex, *normal);
+			float normalSqr = n.GetLengthSquared();
+			n = (normalSqr > 0.f) ? n * (1.f / sqrtf(normalSqr)) : Vector3::ZERO;
+		}
+
+		// gram-schmidt
+		Vector3 t = sum - n * DotProduct(n, sum);
+		if (t.GetLengthSquared() <= 1e-12f * (sum.GetLengthSquared() + 1e-12f))
+		{
+			Vector3 axis = (fabsf(n.x) < .9f) ? Vector3(1.f, 0.f, 0.f) : Vector3(0.f, 1.f, 0.f);
+			t = axis - n * DotProduct(n, axis);
+		}
+		t.Normalize();
+
+		memcpy(vertex + tangent->m_memberOffset, &t, sizeof(Vector3));
+	}
+}
+
+static uint GetWeldBucketCount(uint vertexCount)
+{
+	uint count = 16;
+	while (count < 2 * vertexCount)
+		count <<= 1;
+	return count;
+}
+
+uint WeldVertices(const VertexLayout& layout, const void* vertices, uint vertexCount, float epsilon, void* outVertices, uint* remap)
+{
+	const std::vector<sWeldAttribute> attributes = GetWeldAttributes(layout);
+	const uint stride = (uint)layout.m_stride;
+	const unsigned char* src = (const unsigned char*)vertices;
+	unsigned char* dst = (unsigned char*)outVertices;
+
+	// buckets hold the last kept vertex that hashed there, next chains to the one before
+	const uint mask = GetWeldBucketCount(vertexCount) - 1;
+	std::vector<uint> buckets(mask + 1, WELD_INVALID);
+	std::vector<uint> next(vertexCount);
+	uint kept = 0;
+
+	// epsilon mode buckets by cells of the first float attribute, 2 * epsilon wide so a match
+	// within epsilon is in the same cell or the neighbour on the nearer side, per axis
+	const sWeldAttribute* spatial = nullptr;
+	for (const sWeldAttribute& attribute : attributes)
+	{
+		if (attribute.m_isFloat)
+		{
+			spatial = &attribute;
+			break;
+		}
+	}
+	const bool exact = (epsilon <= 0.f) || (spatial == nullptr);
+	const uint spatialCount = exact ? 0 : ((spatial->m_count < 3) ? spatial->m_count : 3);
+	const float cellScale = exact ? 0.f : (1.f / (2.f * epsilon));
+	const float matchEpsilon = exact ? 0.f : epsilon;
+
+	for (uint idx = 0; idx < vertexCount; ++idx)
+	{
+		const unsigned char* vertex = src + (size_t)idx * stride;
+
+		int cell[3] = { 0, 0, 0 };
+		int side[3] = { 0, 0, 0 };
+		uint hash;
+		if (exact)
+			hash = HashWeldVertex(attributes, vertex);
+		else
+		{
+			for (uint axis = 0; axis < spatialCount; ++axis)
+			{
+				float scaled = ReadWeldFloat(vertex, spatial->m_offset, axis) * cellScale;
+				float floored = floorf(scaled);
+				cell[axis] = (int)floored;
+				side[axis] = (scaled - floored < .5f) ? -1 : 1;
+			}
+			hash = Get3dNoiseUint(cell[0], cell[1], cell[2]);
+		}
+
+		uint match = WELD_INVALID;
+		uint probes = exact ? 1 : (1u << spatialCount);
+		for (uint probe = 0; probe < probes && match == WELD_INVALID; ++probe)
+		{
+			uint probeHash = hash;
+			if (probe != 0)
+			{
+				probeHash = Get3dNoiseUint(cell[0] + ((probe & 1) ? side[0] : 0),
+					cell[1] + ((probe & 2) ? side[1] : 0),
+					cell[2] + ((probe & 4) ? side[2] : 0));
+			}
+
+			for (uint candidate = buckets[probeHash & mask]; candidate != WELD_INVALID; candidate = next[candidate])
+			{
+				if (IsWeldMatch(attributes, vertex, dst + (size_t)candidate * stride, matchEpsilon))
+				{
+					match = candidate;
+					break;
+				}
+			}
+		}
+
+		if (match == WELD_INVALID)
+		{
+			match = kept++;
+			memcpy(dst + (size_t)match * stride, vertex, stride);
+			next[match] = buckets[hash & mask];
+			buckets[hash & mask] = match;
+		}
+
+		remap[idx] = match;
+	}
+
+	AverageWeldedTangents(layout, src, vertexCount, remap, dst, kept);
+	return kept;
+}
+
+void RemapIndices(uint* indices, uint indexCount, const uint* remap)
+{
+	for (uint idx = 0; idx < indexCount; ++idx)
+		indices[idx] = remap[indices[idx]];
+}
+
+void NarrowIndices(const uint* indices, uint indexCount, uint16_t* out)
+{
+	for (uint idx = 0; idx < indexCount; ++idx)
+	{
+		ASSERT_OR_DIE(indices[idx] <= MESH_SHORT_INDEX_LIMIT, "index does not fit in 16 bits");
+		out[idx] = (uint16_t)indices[idx];
+	}
+}
\ No newline at end of file
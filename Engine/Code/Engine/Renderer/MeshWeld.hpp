@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Engine/Core/Vertex.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <stdint.h>
+
+#define MESH_WELD_EXACT 0.f
+#define MESH_SHORT_INDEX_LIMIT 0xffff		// largest vertex count 16 bit indices can address
+
+/*
+ * Vertex welding: collapses vertices that agree in every attribute of their layout into one,
+ * so meshes built a triangle at a time (three fresh vertices each) end up sharing them.
+ * With epsilon MESH_WELD_EXACT float attributes must be equal (0 and -0 are); with a positive
+ * epsilon every float component may differ by up to epsilon from the first vertex of the group.
+ * Byte attributes (colors) always have to match exactly. Lookups hash the whole vertex when exact,
+ * and the cells of the first float attribute (the position) otherwise.
+ * A TANGENT attribute does not keep vertices apart, since tangents made per face differ on every
+ * triangle; each kept vertex gets the average of its group's, orthonormalized against its NORMAL.
+ */
+
+// writes each kept vertex once to outVertices (vertexCount * stride bytes is enough, may not alias vertices),
+// remap[i] is the new index of vertex i; returns how many were kept
+uint WeldVertices(const VertexLayout& layout, const void* vertices, uint vertexCount, float epsilon, void* outVertices, uint* remap);
+
+void RemapIndices(uint* indices, uint indexCount, const uint* remap);
+
+// 2 when every index of a mesh with vertexCount vertices fits in 16 bits, else 4
+inline uint GetIndexStride(uint vertexCount) { return (vertexCount <= MESH_SHORT_INDEX_LIMIT) ? (uint)sizeof(uint16_t) : (uint)sizeof(uint); }
+void NarrowIndices(const uint* indices, uint indexCount, uint16_t* out);
\ No newline at end of file
@@ -23,8 +23,8 @@ public:
 class IndexBuffer : public RenderBuffer
 {
 public:
-	uint m_indexStride; 
-	uint m_indexCount; 
+	uint m_indexStride = sizeof(uint);		// 2 for 16 bit indices
+	uint m_indexCount = 0; 
 };
 
 
@@ -1,6 +1,8 @@
 #include "Engine/Renderer/Renderable.hpp"
 #include "Engine/Renderer/Drawcall.hpp"
 
+#include <algorithm>
+
 Renderable::Renderable(const Material* mat, Mesh* mesh, Transform& transform, Vector4 tint)
 {
 	m_material = nullptr;
@@ -43,12 +45,63 @@ Material* Renderable::GetMaterial()
 	return m_material;
 }
 
+void Renderable::AddLOD(Mesh* mesh, float distance)
+{
+	sMeshLOD lod;
+	lod.m_mesh = mesh;
+	lod.m_distance = distance;
+
+	auto pos = std::upper_bound(m_lods.begin(), m_lods.end(), distance, [](float value, const sMeshLOD& other)
+	{
+		return value < other.m_distance;
+	});
+	m_lods.insert(pos, lod);
+}
+
+void Renderable::SetLODs(const std::vector<Mesh*>& meshes, float firstDistance)
+{
+	m_lods.clear();
+
+	float distance = firstDistance;
+	for (Mesh* mesh : meshes)
+	{
+		AddLOD(mesh, distance);
+		distance *= 2.f;
+	}
+}
+
+Mesh* Renderable::GetMeshForEye(const Vector3& eye)
+{
+	if (m_lods.empty())
+		return m_mesh;
+
+	float distSquared = (m_transform.GetWorldPosition() - eye).GetLengthSquared();
+
+	Mesh* mesh = m_mesh;
+	for (const sMeshLOD& lod : m_lods)
+	{
+		if (distSquared < lod.m_distance * lod.m_distance)
+			break;
+		mesh = lod.m_mesh;
+	}
+	return mesh;
+}
+
+Drawcall* Renderable::ComposeDrawcall(const Vector3& eye)
+{
+	Drawcall* dc = ComposeDrawcall();
+	dc->m_mesh = GetMeshForEye(eye);
+
+	return dc;
+}
+
 Drawcall* Renderable::ComposeDrawcall()
 {
 	Drawcall* dc = new Drawcall();
 
 	dc->m_mesh = m_mesh;
 	dc->m_model = m_transform.GetWorldMatrix();
+	dc->m_model_class = m_transform.GetWorldMatrixClass();
 	dc->m_shader = m_non_mat_shader;
 	dc->m_tint = m_tint;
 
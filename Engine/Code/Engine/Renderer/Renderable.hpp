@@ -4,6 +4,12 @@
 #include "Engine/Renderer/Mesh.hpp"
 #include "Engine/Core/Transform.hpp"
 
+struct sMeshLOD
+{
+	Mesh*	m_mesh;
+	float	m_distance;		// drawn from this far from the eye on
+};
+
 class Renderable
 {
 public:
@@ -12,6 +18,7 @@ public:
 
 	Shader*			m_non_mat_shader;
 	Mesh*			m_mesh;
+	std::vector<sMeshLOD> m_lods;		// coarser than m_mesh, by increasing distance
 	Transform		m_transform;
 	Vector4			m_tint;
 
@@ -27,12 +34,16 @@ public:
 
 	void SetMesh(Mesh* mesh) { m_mesh = mesh; }
 	void SetMaterial(Material* material) { m_material = material; }
+	void AddLOD(Mesh* mesh, float distance);
+	void SetLODs(const std::vector<Mesh*>& meshes, float firstDistance);		// each twice as far as the one before
 
 	Material*		GetMaterial();
 	const Material*	GetSharedMaterial() { return m_sharedMat; };
 	Mesh*			GetMesh() { return m_mesh; }
+	Mesh*			GetMeshForEye(const Vector3& eye);
 	Vector4			GetTint() const {return m_tint;}
 	Shader*			GetShader() { return m_non_mat_shader; }
 
 	Drawcall* ComposeDrawcall();
+	Drawcall* ComposeDrawcall(const Vector3& eye);		// picks the LOD for the eye position
 };
\ No newline at end of file
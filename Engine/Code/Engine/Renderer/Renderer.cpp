@@ -192,6 +192,12 @@ GLenum ToGLPrimitiveType(eDrawPrimitiveType type)
 }
 
 
+GLenum ToGLIndexType(uint stride)
+{
+	return (stride == sizeof(uint16_t)) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
+
+
 GLenum ToGLDataType( eRenderType type )
 {
 	switch (type)
@@ -619,6 +625,27 @@ Mesh* Renderer::CreateOrGetMesh(std::string meshName)
 }
 
 
+const std::vector<Mesh*>& Renderer::CreateOrGetMeshLODs(std::string meshName)
+{
+	bool lodsLoaded = ( m_loadedMeshLODs.count(meshName) > 0 );
+
+	if (!lodsLoaded)
+	{
+		// simplifying costs far more than loading, so only meshes that are drawn with LODs pay for it
+		std::vector<Mesh*> lods;
+
+		if (meshName == "ship_pcu")
+			lods = Mesh::CreateModelLODs(GetAbsModelPath("scifi_fighter_mk6"), VERT_PCU);
+		else if (meshName == "ship_lit")
+			lods = Mesh::CreateModelLODs(GetAbsModelPath("scifi_fighter_mk6"), VERT_LIT);
+
+		m_loadedMeshLODs.emplace(meshName, lods);
+	}
+
+	return m_loadedMeshLODs[meshName];
+}
+
+
 Sprite* Renderer::CreateOrGetSprite(std::string id)
 {
 	bool spriteLoaded = ( m_loadedSprites.count(id) > 0 );
@@ -1224,7 +1251,7 @@ void Renderer::Draw(const Drawcall& dc)
 
 	const Matrix44& model = dc.m_model;
 	m_objectData.model = model;
-	m_objectData.inv_model = model.Invert();
+	m_objectData.inv_model = model.Invert(dc.m_model_class);
 	SetObjectUBO(programHandle);
 	GL_CHECK_ERROR();
 
@@ -1318,7 +1345,7 @@ void Renderer::Draw(const Drawcall& dc)
 	if ( mesh->GetDrawInstruction().using_indices )
 	{
 		glDrawElements( ToGLPrimitiveType(mesh->GetDrawInstruction().primitive_type), 
-			mesh->GetIndexCount(), GL_UNSIGNED_INT, 0 );
+			mesh->GetIndexCount(), ToGLIndexType(mesh->m_ibo.m_indexStride), 0 );
 	}
 	else
 	{
@@ -1384,7 +1411,7 @@ void Renderer::Draw(const Drawcall& dc)
 				if ( mesh->GetDrawInstruction().using_indices )
 				{
 					glDrawElements( ToGLPrimitiveType(mesh->GetDrawInstruction().primitive_type), 
-						mesh->GetIndexCount(), GL_UNSIGNED_INT, 0 );
+						mesh->GetIndexCount(), ToGLIndexType(mesh->m_ibo.m_indexStride), 0 );
 				}
 				else
 				{
@@ -1448,7 +1475,7 @@ void Renderer::Draw(const Drawcall& dc)
 		if ( mesh->GetDrawInstruction().using_indices )
 		{
 			glDrawElements( ToGLPrimitiveType(mesh->GetDrawInstruction().primitive_type), 
-				mesh->GetIndexCount(), GL_UNSIGNED_INT, 0 );
+				mesh->GetIndexCount(), ToGLIndexType(mesh->m_ibo.m_indexStride), 0 );
 		}
 		else
 		{
@@ -1483,7 +1510,7 @@ void Renderer::Draw(Mesh* mesh, bool cull, bool depth, bool stencil, bool alpha)
 	if ( mesh->GetDrawInstruction().using_indices )
 	{
 		glDrawElements( ToGLPrimitiveType(mesh->GetDrawInstruction().primitive_type), 
-			mesh->GetIndexCount(), GL_UNSIGNED_INT, 0 );
+			mesh->GetIndexCount(), ToGLIndexType(mesh->m_ibo.m_indexStride), 0 );
 	}
 	else
 	{
@@ -1555,7 +1582,7 @@ void Renderer::DrawMesh(Mesh* mesh, bool culling, bool depth_test)
 	if ( mesh->GetDrawInstruction().using_indices )
 	{
 		glDrawElements( ToGLPrimitiveType(mesh->GetDrawInstruction().primitive_type), 
-			mesh->GetIndexCount(), GL_UNSIGNED_INT, 0 );
+			mesh->GetIndexCount(), ToGLIndexType(mesh->m_ibo.m_indexStride), 0 );
 	}
 	else
 	{
@@ -1587,7 +1614,7 @@ void Renderer::DrawMeshImmediate()
 	if ( m_immediateMesh->GetDrawInstruction().using_indices )
 	{
 		glDrawElements( ToGLPrimitiveType(m_immediateMesh->GetDrawInstruction().primitive_type), 
-			m_immediateMesh->GetIndexCount(), GL_UNSIGNED_INT, 0 );
+			m_immediateMesh->GetIndexCount(), ToGLIndexType(m_immediateMesh->m_ibo.m_indexStride), 0 );
 	}
 	else
 	{
@@ -1813,7 +1840,7 @@ void Renderer::DrawSkybox(TextureCube* cubemap, Mesh* mesh)
 	if ( mesh->GetDrawInstruction().using_indices )
 	{
 		glDrawElements( ToGLPrimitiveType(mesh->GetDrawInstruction().primitive_type), 
-			mesh->GetIndexCount(), GL_UNSIGNED_INT, 0 );
+			mesh->GetIndexCount(), ToGLIndexType(mesh->m_ibo.m_indexStride), 0 );
 	}
 	else
 	{
@@ -241,6 +241,7 @@ public:
 
 	Texture*		CreateOrGetTexture(std::string fp, bool mipmap = false);
 	Mesh*			CreateOrGetMesh(std::string meshName);
+	const std::vector<Mesh*>& CreateOrGetMeshLODs(std::string meshName);		// coarser versions built on first call, empty unless a model
 	Sprite*			CreateOrGetSprite(std::string id);
 	BitmapFont*		CreateOrGetBitmapFont(const char* bitmapFontName);
 	ShaderProgram*	CreateOrGetShaderProgram(const char* fileName, const char* delimited = "");
@@ -343,6 +344,7 @@ public:
 	std::map<std::string, BitmapFont*>		m_loadedFonts;
 	std::map<std::string, ShaderProgram*>	m_loadedShaderPrograms;
 	std::map<std::string, Mesh*>			m_loadedMeshes;
+	std::map<std::string, std::vector<Mesh*>>	m_loadedMeshLODs;
 	std::map<std::string, Shader*>			m_loadedShaders;
 	std::map<std::string, ShaderChannel*>	m_loadedChannels;
 	std::map<std::string, Material*>		m_loadedMaterials;
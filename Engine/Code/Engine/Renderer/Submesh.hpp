@@ -53,13 +53,13 @@ void Submesh::FromBuilder(const MeshBuilder& builder)
 	size_t isize = sizeof(uint) * builder.GetIndexCount();
 
 	std::vector<T> vertices;
+	vertices.reserve(builder.m_vertices.size());
 	for (std::vector<sVertexBuilder>::size_type vbCount = 0; 
 		vbCount < builder.m_vertices.size(); ++vbCount)
 	{
-		T vt(builder.m_vertices[vbCount]);
-		vertices.push_back(vt);
+		vertices.emplace_back(builder.m_vertices[vbCount]);
 	}
 
-	m_vbo.CopyToGPU( vsize, &vertices[0] );
-	m_ibo.CopyToGPU( isize, &builder.m_indices[0] );
+	m_vbo.CopyToGPU( vsize, vertices.data() );
+	m_ibo.CopyToGPU( isize, builder.m_indices.data() );
 }
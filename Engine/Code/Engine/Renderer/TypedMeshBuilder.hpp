@@ -0,0 +1,247 @@
+#pragma once
+
+#include "Engine/Renderer/MeshBuilder.hpp"
+#include "Engine/Renderer/MeshWeld.hpp"
+#include "Engine/Renderer/MeshOptimize.hpp"
+#include "Engine/Renderer/MeshSimplify.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+/*
+ * MeshBuilder that keeps finished VERT (Vertex_3DPCU, VertexLit) instead of sVertexBuilder.
+ * PushVertex turns the stamp into a VERT once, in the storage that is handed to the gpu as is,
+ * so making the mesh is a single upload without the fat vertex array or a second per vertex copy.
+ * Reserve with the expected counts when the mesh is rebuilt often; Clear keeps the capacity.
+ * CreateMesh picks 16 bit indices whenever the vertex count allows.
+ */
+template<typename VERT>
+class TypedMeshBuilder
+{
+public:
+	void Reserve(uint vertexCount, uint indexCount);
+	void Clear();		// drops vertices and indices, keeps their capacity
+
+	void Begin(eDrawPrimitiveType prim, bool use_indices);
+	void End();
+	void SetColor(Rgba const &c) { m_stamp.m_color = c; }
+	void SetUV(Vector2 const &uv) { m_stamp.m_uv = uv; }
+	void SetNormal(Vector3 const &normal) { m_stamp.m_normal = normal; }
+	void SetTangent(Vector4 const &tangent) { m_stamp.m_tangent = tangent; }
+	Vector4 CalcTangent(Vector3 edge1, Vector3 edge2, Vector2 uv1, Vector2 uv2) const { return MeshBuilder::CalcTangent(edge1, edge2, uv1, uv2); }
+	uint PushVertex(Vector3 position);
+	void AddTriangle(uint idx1, uint idx2, uint idx3);
+	void AddQuad(uint idx1, uint idx2, uint idx3, uint idx4);
+	void AddLine(uint idx1, uint idx2);
+	void AddPoint(uint idx);
+	int GetVertexCount() const { return (int)m_vertices.size(); }
+	int GetIndexCount() const { return (int)m_indices.size(); }
+
+	// shares equal vertices, see MeshWeld.hpp; a builder without indices gets them first
+	uint Weld(float epsilon = MESH_WELD_EXACT);
+
+	// reorders an indexed triangle list for the vertex cache (and overdraw), then the vertices
+	// for fetch, see MeshOptimize.hpp; run after Weld
+	void Optimize(bool overdraw = false);
+
+	// coarser meshes of the same vertices, one per ratio of the triangle count (largest first), each
+	// simplified from the one before, see MeshSimplify.hpp; a ratio that is not reached is reported
+	// in the debugger output, and the chain stops early once nothing more fits in maxError
+	std::vector<Mesh*> CreateLODMeshes(const float* ratios, uint ratioCount, float maxError = MESH_SIMPLIFY_ANY_ERROR) const;
+
+	Mesh* CreateMesh(eDrawPrimitiveType drawType);
+
+	// the storage moves out, the builder is left empty
+	std::vector<VERT> TakeVertices();
+	std::vector<uint> TakeIndices();
+
+public:
+	sVertexBuilder m_stamp;
+	std::vector<VERT> m_vertices;
+	std::vector<uint> m_indices;
+	std::vector<uint16_t> m_shortIndices;		// CreateMesh narrows into this, kept so reuse does not allocate
+
+	sDrawInstruction m_draw;
+};
+
+template<typename VERT>
+void TypedMeshBuilder<VERT>::Reserve(uint vertexCount, uint indexCount)
+{
+	m_vertices.reserve(vertexCount);
+	m_indices.reserve(indexCount);
+}
+
+template<typename VERT>
+void TypedMeshBuilder<VERT>::Clear()
+{
+	m_vertices.clear();
+	m_indices.clear();
+}
+
+template<typename VERT>
+void TypedMeshBuilder<VERT>::Begin(eDrawPrimitiveType prim, bool use_indices)
+{
+	m_draw.primitive_type = prim;
+	m_draw.using_indices = use_indices;
+	m_draw.start_index = use_indices ? (uint)m_indices.size() : (uint)m_vertices.size();
+}
+
+template<typename VERT>
+void TypedMeshBuilder<VERT>::End()
+{
+	uint end_idx = m_draw.using_indices ? (uint)m_indices.size() : (uint)m_vertices.size();
+	m_draw.elem_count = end_idx - m_draw.start_index;
+}
+
+template<typename VERT>
+uint TypedMeshBuilder<VERT>::PushVertex(Vector3 position)
+{
+	m_stamp.m_position = position;
+	m_vertices.emplace_back(m_stamp);
+
+	return (uint)(m_vertices.size() - 1);
+}
+
+template<typename VERT>
+void TypedMeshBuilder<VERT>::AddTriangle(uint idx1, uint idx2, uint idx3)
+{
+	m_indices.push_back(idx1);
+	m_indices.push_back(idx2);
+	m_indices.push_back(idx3);
+}
+
+template<typename VERT>
+void TypedMeshBuilder<VERT>::AddQuad(uint idx1, uint idx2, uint idx3, uint idx4)
+{
+	AddTriangle(idx1, idx2, idx3);
+	AddTriangle(idx3, idx2, idx4);
+}
+
+template<typename VERT>
+void TypedMeshBuilder<VERT>::AddLine(uint idx1, uint idx2)
+{
+	m_indices.push_back(idx1);
+	m_indices.push_back(idx2);
+}
+
+template<typename VERT>
+void TypedMeshBuilder<VERT>::AddPoint(uint idx)
+{
+	m_indices.push_back(idx);
+}
+
+template<typename VERT>
+uint TypedMeshBuilder<VERT>::Weld(float epsilon)
+{
+	uint count = (uint)m_vertices.size();
+	if (m_indices.empty())
+	{
+		m_indices.resize(count);
+		for (uint idx = 0; idx < count; ++idx)
+			m_indices[idx] = idx;
+	}
+
+	std::vector<VERT> welded(m_vertices);
+	std::vector<uint> remap(count);
+	uint kept = WeldVertices(VERT::s_layout, m_vertices.data(), count, epsilon, welded.data(), remap.data());
+	RemapIndices(m_indices.data(), (uint)m_indices.size(), remap.data());
+
+	welded.erase(welded.begin() + kept, welded.end());
+	m_vertices.swap(welded);
+	return kept;
+}
+
+template<typename VERT>
+void TypedMeshBuilder<VERT>::Optimize(bool overdraw)
+{
+	uint vertexCount = (uint)m_vertices.size();
+	uint indexCount = (uint)m_indices.size();
+	ASSERT_OR_DIE(indexCount % 3 == 0, "optimize needs an indexed triangle list");
+	if (indexCount == 0)
+		return;
+
+	OptimizeVertexCache(m_indices.data(), indexCount, vertexCount);
+	if (overdraw)
+		OptimizeOverdraw(m_indices.data(), indexCount, &m_vertices[0].m_pos, vertexCount, sizeof(VERT));
+
+	uint kept = OptimizeVertexFetch(m_vertices.data(), vertexCount, sizeof(VERT), m_indices.data(), indexCount);
+	m_vertices.erase(m_vertices.begin() + kept, m_vertices.end());
+}
+
+template<typename VERT>
+std::vector<Mesh*> TypedMeshBuilder<VERT>::CreateLODMeshes(const float* ratios, uint ratioCount, float maxError) const
+{
+	std::vector<Mesh*> meshes;
+	if (ratios == nullptr || ratioCount == 0)
+		return meshes;
+
+	std::vector<uint> indices(m_indices);
+	uint indexCount = (uint)indices.size();
+	for (uint idx = 0; idx < ratioCount; ++idx)
+	{
+		uint target = (uint)((float)(m_indices.size() / 3) * ratios[idx]) * 3;
+		float error = 0.f;
+		uint count = SimplifyMesh(VERT::s_layout, m_vertices.data(), (uint)m_vertices.size(),
+			indices.data(), indexCount, target, maxError, indices.data(), &error);
+		if (count == indexCount)
+		{
+			DebuggerPrintf("LOD %u of %u: %u triangles cannot go down to %u (ratio %.3f), keeping %u coarser meshes\n",
+				idx, ratioCount, count / 3, target / 3, ratios[idx], idx);
+			break;
+		}
+		if (count > target)
+		{
+			DebuggerPrintf("LOD %u of %u: %u triangles left of the %u wanted (ratio %.3f), error %.4f\n",
+				idx, ratioCount, count / 3, target / 3, ratios[idx], error);
+		}
+		indexCount = count;
+
+		TypedMeshBuilder<VERT> lod;
+		lod.m_vertices = m_vertices;
+		lod.m_indices.assign(indices.begin(), indices.begin() + indexCount);
+		lod.Optimize(true);
+		meshes.push_back(lod.CreateMesh(DRAW_TRIANGLE));
+	}
+	return meshes;
+}
+
+template<typename VERT>
+Mesh* TypedMeshBuilder<VERT>::CreateMesh(eDrawPrimitiveType drawType)
+{
+	Mesh* mesh = new Mesh();
+
+	// set draw call
+	m_draw.primitive_type = drawType;
+	m_draw.start_index = 0;
+	m_draw.using_indices = (m_indices.size() != 0);
+	m_draw.elem_count = m_draw.using_indices ? (uint)m_indices.size() : (uint)m_vertices.size();
+	mesh->SetDrawInstruction(m_draw.primitive_type, m_draw.using_indices,
+		m_draw.start_index, m_draw.elem_count);
+
+	uint vertexCount = (uint)m_vertices.size();
+	uint indexCount = (uint)m_indices.size();
+	if (GetIndexStride(vertexCount) == sizeof(uint16_t))
+	{
+		m_shortIndices.resize(indexCount);
+		NarrowIndices(m_indices.data(), indexCount, m_shortIndices.data());
+		mesh->FromVertices<VERT>(m_vertices.data(), vertexCount, m_shortIndices.data(), indexCount, sizeof(uint16_t));
+	}
+	else
+		mesh->FromVertices<VERT>(m_vertices.data(), vertexCount, m_indices.data(), indexCount, sizeof(uint));
+
+	return mesh;
+}
+
+template<typename VERT>
+std::vector<VERT> TypedMeshBuilder<VERT>::TakeVertices()
+{
+	std::vector<VERT> vertices;
+	vertices.swap(m_vertices);
+	return vertices;
+}
+
+template<typename VERT>
+std::vector<uint> TypedMeshBuilder<VERT>::TakeIndices()
+{
+	std::vector<uint> indices;
+	indices.swap(m_indices);
+	return indices;
+}
\ No newline at end of file
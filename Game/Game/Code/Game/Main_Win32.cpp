@@ -3,6 +3,7 @@
 #include "Engine/Core/Blackboard.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/Util/StringUtils.hpp"
+#include "Engine/Math/Random.hpp"
 #include "Engine/Core/Time/TheTime.hpp"
 #include "Engine/Renderer/GLFunctions.hpp"
 #include "Engine/Renderer/Window.hpp"
@@ -128,7 +129,7 @@ void Shutdown()
 int WINAPI WinMain( HINSTANCE applicationInstanceHandle, HINSTANCE, LPSTR commandLineString, int )
 {
 	UNUSED(commandLineString);
-	srand((unsigned int)time( NULL ));
+	SeedRandom((uint64_t)time( NULL ));
 
 	Initialize(applicationInstanceHandle);
 
@@ -0,0 +1,130 @@
+#include "Game/Test/NoiseBenchmark.hpp"
+#include "Engine/Math/SmoothNoise.hpp"
+#include "Engine/Math/SmoothNoiseGrid.hpp"
+#include "Engine/Core/Time/TheTime.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include <cmath>
+#include <vector>
+
+#define NOISE_BENCH_SIZE 256
+#define NOISE_BENCH_DEPTH 16
+#define NOISE_BENCH_SCALE 32.f
+#define NOISE_BENCH_OCTAVES 4
+#define NOISE_BENCH_MATCH_TOLERANCE 1e-4f		// grid and point code may round differently, e.g. where the compiler fuses multiply-adds
+
+static float s_noiseSink = 0.f;		// keeps the point loops from being optimized out
+
+void NoiseBenchmark::RunNoiseBenchmark()
+{
+	SimplexGridMatchTest();
+	PointNoiseBenchmark();
+	GridNoiseBenchmark();
+}
+
+void NoiseBenchmark::SimplexGridMatchTest()
+{
+	const uint width = 67;
+	const uint height = 9;
+	const uint depth = 5;
+	const float minX = -13.2f;
+	const float minY = 7.7f;
+	const float minZ = -3.1f;
+	const float posT = 2.4f;
+	const float spacing = 0.37f;
+	std::vector<float> grid(width * height * depth);
+
+	Compute2dSimplexNoiseGrid(minX, minY, spacing, width, height, grid.data(), 5.f, NOISE_BENCH_OCTAVES);
+	for (uint y = 0; y < height; ++y)
+	{
+		for (uint x = 0; x < width; ++x)
+		{
+			float expected = Compute2dSimplexNoise(minX + (float)x * spacing, minY + (float)y * spacing, 5.f, NOISE_BENCH_OCTAVES);
+			ASSERT_OR_DIE(abs(grid[y * width + x] - expected) <= NOISE_BENCH_MATCH_TOLERANCE, "2d simplex grid differs from point noise!");
+		}
+	}
+
+	Compute3dSimplexNoiseGrid(minX, minY, minZ, spacing, width, height, depth, grid.data(), 5.f, NOISE_BENCH_OCTAVES);
+	for (uint z = 0; z < depth; ++z)
+	{
+		for (uint y = 0; y < height; ++y)
+		{
+			for (uint x = 0; x < width; ++x)
+			{
+				float expected = Compute3dSimplexNoise(minX + (float)x * spacing, minY + (float)y * spacing, minZ + (float)z * spacing, 5.f, NOISE_BENCH_OCTAVES);
+				ASSERT_OR_DIE(abs(grid[(z * height + y) * width + x] - expected) <= NOISE_BENCH_MATCH_TOLERANCE, "3d simplex grid differs from point noise!");
+			}
+		}
+	}
+
+	Compute4dSimplexNoiseGrid(minX, minY, minZ, posT, spacing, width, height, depth, grid.data(), 5.f, NOISE_BENCH_OCTAVES);
+	for (uint z = 0; z < depth; ++z)
+	{
+		for (uint y = 0; y < height; ++y)
+		{
+			for (uint x = 0; x < width; ++x)
+			{
+				float expected = Compute4dSimplexNoise(minX + (float)x * spacing, minY + (float)y * spacing, minZ + (float)z * spacing, posT, 5.f, NOISE_BENCH_OCTAVES);
+				ASSERT_OR_DIE(abs(grid[(z * height + y) * width + x] - expected) <= NOISE_BENCH_MATCH_TOLERANCE, "4d simplex grid differs from point noise!");
+			}
+		}
+	}
+
+	DebuggerPrintf("simplex grids match point noise\n");
+}
+
+void NoiseBenchmark::PointNoiseBenchmark()
+{
+	const uint samples = NOISE_BENCH_SIZE * NOISE_BENCH_SIZE;
+	float sum = 0.f;
+
+	for (uint dims = 2; dims <= 4; ++dims)
+	{
+		for (uint kind = 0; kind < 2; ++kind)
+		{
+			bool simplex = (kind == 1);
+			uint64_t start = GetPerformanceCounter();
+			for (uint idx = 0; idx < samples; ++idx)
+			{
+				float x = (float)(idx % NOISE_BENCH_SIZE);
+				float y = (float)(idx / NOISE_BENCH_SIZE);
+				if (dims == 2)
+					sum += simplex ? Compute2dSimplexNoise(x, y, NOISE_BENCH_SCALE, NOISE_BENCH_OCTAVES) : Compute2dPerlinNoise(x, y, NOISE_BENCH_SCALE, NOISE_BENCH_OCTAVES);
+				else if (dims == 3)
+					sum += simplex ? Compute3dSimplexNoise(x, y, 1.5f, NOISE_BENCH_SCALE, NOISE_BENCH_OCTAVES) : Compute3dPerlinNoise(x, y, 1.5f, NOISE_BENCH_SCALE, NOISE_BENCH_OCTAVES);
+				else
+					sum += simplex ? Compute4dSimplexNoise(x, y, 1.5f, 0.25f, NOISE_BENCH_SCALE, NOISE_BENCH_OCTAVES) : Compute4dPerlinNoise(x, y, 1.5f, 0.25f, NOISE_BENCH_SCALE, NOISE_BENCH_OCTAVES);
+			}
+			double seconds = PerformanceCountToSeconds(GetPerformanceCounter() - start);
+			DebuggerPrintf("%dd %s point noise: %.1f ns/sample\n", (int)dims, simplex ? "simplex" : "perlin", seconds * 1e9 / (double)samples);
+		}
+	}
+
+	s_noiseSink += sum;
+}
+
+void NoiseBenchmark::GridNoiseBenchmark()
+{
+	std::vector<float> grid(NOISE_BENCH_SIZE * NOISE_BENCH_SIZE * NOISE_BENCH_DEPTH);
+	const double samples2d = (double)(NOISE_BENCH_SIZE * NOISE_BENCH_SIZE);
+	const double samples3d = samples2d * NOISE_BENCH_DEPTH;
+
+	uint64_t start = GetPerformanceCounter();
+	Compute2dPerlinNoiseGrid(0.f, 0.f, 1.f, NOISE_BENCH_SIZE, NOISE_BENCH_SIZE, grid.data(), NOISE_BENCH_SCALE, NOISE_BENCH_OCTAVES);
+	DebuggerPrintf("2d perlin grid: %.1f ns/sample\n", PerformanceCountToSeconds(GetPerformanceCounter() - start) * 1e9 / samples2d);
+
+	start = GetPerformanceCounter();
+	Compute2dSimplexNoiseGrid(0.f, 0.f, 1.f, NOISE_BENCH_SIZE, NOISE_BENCH_SIZE, grid.data(), NOISE_BENCH_SCALE, NOISE_BENCH_OCTAVES);
+	DebuggerPrintf("2d simplex grid: %.1f ns/sample\n", PerformanceCountToSeconds(GetPerformanceCounter() - start) * 1e9 / samples2d);
+
+	start = GetPerformanceCounter();
+	Compute3dPerlinNoiseGrid(0.f, 0.f, 0.f, 1.f, NOISE_BENCH_SIZE, NOISE_BENCH_SIZE, NOISE_BENCH_DEPTH, grid.data(), NOISE_BENCH_SCALE, NOISE_BENCH_OCTAVES);
+	DebuggerPrintf("3d perlin grid: %.1f ns/sample\n", PerformanceCountToSeconds(GetPerformanceCounter() - start) * 1e9 / samples3d);
+
+	start = GetPerformanceCounter();
+	Compute3dSimplexNoiseGrid(0.f, 0.f, 0.f, 1.f, NOISE_BENCH_SIZE, NOISE_BENCH_SIZE, NOISE_BENCH_DEPTH, grid.data(), NOISE_BENCH_SCALE, NOISE_BENCH_OCTAVES);
+	DebuggerPrintf("3d simplex grid: %.1f ns/sample\n", PerformanceCountToSeconds(GetPerformanceCounter() - start) * 1e9 / samples3d);
+
+	start = GetPerformanceCounter();
+	Compute4dSimplexNoiseGrid(0.f, 0.f, 0.f, 0.25f, 1.f, NOISE_BENCH_SIZE, NOISE_BENCH_SIZE, NOISE_BENCH_DEPTH, grid.data(), NOISE_BENCH_SCALE, NOISE_BENCH_OCTAVES);
+	DebuggerPrintf("4d simplex grid: %.1f ns/sample\n", PerformanceCountToSeconds(GetPerformanceCounter() - start) * 1e9 / samples3d);
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+class NoiseBenchmark
+{
+public:
+	static void RunNoiseBenchmark();
+
+private:
+	static void SimplexGridMatchTest();
+	static void PointNoiseBenchmark();
+	static void GridNoiseBenchmark();
+};
\ No newline at end of file
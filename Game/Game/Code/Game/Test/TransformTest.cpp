@@ -6,6 +6,7 @@ void TransformTest::RunTransformTest()
 {
 	LocalWorldTransformTest();
 	TransformBasisTest();
+	TransformHierarchyTest();
 }
 
 void TransformTest::LocalWorldTransformTest()
@@ -138,16 +139,42 @@ void TransformTest::TransformBasisTest()
 	ASSERT_OR_DIE(lr1 == true_lr1, "1 - local right does not match");
 	DebuggerPrintf("1 - local rightward matches\n");
 
-	// GetLocalMatrix used 
+	// GetLocalMatrix used, relative to the parent so it matches the world bases when there is none
 	Matrix44 localMat1 = t1.GetLocalMatrix();
 	lf1 = localMat1.GetForward();
 	lu1 = localMat1.GetUp();
 	lr1 = localMat1.GetRight();
 
-	ASSERT_OR_DIE(lf1 == true_lf1, "1,GetLocalMatrix - local forward does not match");
+	ASSERT_OR_DIE(Vector3::AreVectorsNearlyIdentical(lf1, true_wf1), "1,GetLocalMatrix - local forward does not match");
 	DebuggerPrintf("1,GetLocalMatrix - local forward matches\n");
-	ASSERT_OR_DIE(lu1 == true_lu1, "1,GetLocalMatrix - local upward does not match");
+	ASSERT_OR_DIE(Vector3::AreVectorsNearlyIdentical(lu1, true_wu1), "1,GetLocalMatrix - local upward does not match");
 	DebuggerPrintf("1,GetLocalMatrix - local upward matches\n");
-	ASSERT_OR_DIE(lr1 == true_lr1, "1,GetLocalMatrix - local right does not match");
+	ASSERT_OR_DIE(Vector3::AreVectorsNearlyIdentical(lr1, true_wr1), "1,GetLocalMatrix - local right does not match");
 	DebuggerPrintf("1,GetLocalMatrix - local rightward matches\n");
 }
+
+void TransformTest::TransformHierarchyTest()
+{
+	Transform parent = Transform(Vector3(10.f, 0.f, 0.f), Vector3(0.f, 90.f, 0.f), Vector3::ONE);
+	Transform child = Transform(Vector3(0.f, 0.f, 5.f), Vector3::ZERO, Vector3::ONE);
+	child.SetParentTransform(&parent);
+
+	// yaw 90 turns local forward into world left
+	Vector3 world_0 = child.GetWorldPosition();
+	Vector3 world_0_true = Vector3(5.f, 0.f, 0.f);
+	ASSERT_OR_DIE(Vector3::AreVectorsNearlyIdentical(world_0, world_0_true), "0: child world position is wrong!");
+	DebuggerPrintf("0: child world position is right\n");
+
+	// moving the parent has to reach the cached child matrix
+	parent.SetLocalPosition(Vector3(0.f, 3.f, 0.f));
+	Vector3 world_1 = child.GetWorldPosition();
+	Vector3 world_1_true = Vector3(-5.f, 3.f, 0.f);
+	ASSERT_OR_DIE(Vector3::AreVectorsNearlyIdentical(world_1, world_1_true), "1: child world position is stale!");
+	DebuggerPrintf("1: child world position follows the parent\n");
+
+	parent.SetLocalScale(Vector3(2.f, 2.f, 2.f));
+	ASSERT_OR_DIE(child.GetWorldMatrixClass() == MAT_CLASS_AFFINE, "2: scaled parent should make the child affine");
+	Vector3 local_2 = child.GetWorldMatrixInverse() * child.GetWorldPosition();
+	ASSERT_OR_DIE(Vector3::AreVectorsNearlyIdentical(local_2, Vector3::ZERO), "2: world inverse is wrong!");
+	DebuggerPrintf("2: world inverse is right\n");
+}
@@ -8,4 +8,5 @@ public:
 private:
 	static void LocalWorldTransformTest();
 	static void TransformBasisTest();
+	static void TransformHierarchyTest();
 };
\ No newline at end of file